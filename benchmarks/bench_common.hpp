@@ -0,0 +1,175 @@
+#ifndef BENCH_COMMON_HPP
+#define BENCH_COMMON_HPP
+
+/**
+ * @file bench_common.hpp
+ * @brief Shared inputs for the snazzydeets_bench suite.
+ *
+ * Every generator is seeded, so two runs (or two commits) measure the same
+ * keys and the same graphs and their numbers can be compared directly.
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <streambuf>
+#include <thread>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace bench {
+
+constexpr uint64_t SEED = 0x5eedULL;
+
+/**
+ * n distinct integers in random order
+ */
+inline std::vector<int> shuffledKeys(size_t n, uint64_t seed = SEED) {
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::mt19937_64 rng(seed);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    return keys;
+}
+
+/**
+ * n random integers, duplicates allowed (sort and lookup inputs)
+ */
+inline std::vector<int> randomValues(size_t n, uint64_t seed = SEED) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> dist(0, 1 << 30);
+    std::vector<int> values(n);
+    for (auto& v : values) v = dist(rng);
+    return values;
+}
+
+/**
+ * n distinct lowercase words: 4 to 12 random letters and a numeric suffix
+ */
+inline std::vector<std::string> randomWords(size_t n, uint64_t seed = SEED) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> length(4, 12);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<std::string> words;
+    words.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        std::string word(length(rng), 'a');
+        for (auto& c : word) c = static_cast<char>(letter(rng));
+        word += std::to_string(i);
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+// ==================== SYNTHETIC GRAPHS ====================
+using EdgeList = std::vector<std::tuple<int, int, int>>;
+
+/**
+ * Erdős–Rényi style G(n, m): m uniformly random edges over n vertices,
+ * plus a path through every vertex so BFS from 0 reaches the whole graph
+ */
+inline EdgeList randomGraph(int n, size_t m, uint64_t seed = SEED) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::uniform_int_distribution<int> weight(1, 100);
+    EdgeList edges;
+    edges.reserve(m + n);
+    for (int v = 1; v < n; ++v) edges.emplace_back(v - 1, v, weight(rng));
+    for (size_t i = 0; i < m; ++i) {
+        int a = vertex(rng), b = vertex(rng);
+        if (a != b) edges.emplace_back(a, b, weight(rng));
+    }
+    return edges;
+}
+
+/**
+ * side x side 4-neighbour lattice: long diameter, uniform degree
+ */
+inline EdgeList gridGraph(int side) {
+    EdgeList edges;
+    edges.reserve(2 * static_cast<size_t>(side) * side);
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int id = r * side + c;
+            if (c + 1 < side) edges.emplace_back(id, id + 1, 1);
+            if (r + 1 < side) edges.emplace_back(id, id + side, 1);
+        }
+    }
+    return edges;
+}
+
+/**
+ * Barabási–Albert preferential attachment: each new vertex links to
+ * `links` earlier vertices chosen by degree, giving a few huge hubs and a
+ * long tail of low-degree vertices (power-law degree distribution)
+ */
+inline EdgeList powerLawGraph(int n, int links = 4, uint64_t seed = SEED) {
+    std::mt19937_64 rng(seed);
+    EdgeList edges;
+    std::vector<int> endpoints;     // each vertex appears once per incident edge
+    edges.reserve(static_cast<size_t>(n) * links);
+    endpoints.reserve(2 * static_cast<size_t>(n) * links);
+    for (int v = 1; v <= links && v < n; ++v) {
+        edges.emplace_back(0, v, 1);
+        endpoints.push_back(0);
+        endpoints.push_back(v);
+    }
+    for (int v = links + 1; v < n; ++v) {
+        for (int k = 0; k < links; ++k) {
+            std::uniform_int_distribution<size_t> pick(0, endpoints.size() - 1);
+            int target = endpoints[pick(rng)];
+            edges.emplace_back(v, target, 1);
+            endpoints.push_back(v);
+            endpoints.push_back(target);
+        }
+    }
+    return edges;
+}
+
+/**
+ * Silences std::cout for its lifetime. The graph traversals print their
+ * progress; the benchmark reporter only writes between runs, after the
+ * guard has restored the stream.
+ */
+class QuietCout {
+    struct NullBuffer : std::streambuf {
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+    NullBuffer sink;
+    std::streambuf* saved;
+
+public:
+    QuietCout() : saved(std::cout.rdbuf(&sink)) {}
+    ~QuietCout() { std::cout.rdbuf(saved); }
+    QuietCout(const QuietCout&) = delete;
+    QuietCout& operator=(const QuietCout&) = delete;
+};
+
+/**
+ * Scratch file location for the snapshot benchmarks
+ */
+inline std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Size sweep shared by the container benchmarks: 1K .. 1M, x8 steps
+inline void sizeSweep(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+}
+
+// Thread-count sweep: 1, 2, 4, ... up to the hardware thread count
+inline void threadSweep(benchmark::internal::Benchmark* b) {
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned t = 1; t <= hw; t *= 2) b->Arg(static_cast<int64_t>(t));
+    b->UseRealTime();
+}
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,207 @@
+#include "bench_common.hpp"
+#include "../graphs/graphs.hpp"
+
+#include <cmath>
+
+// Every traversal runs on three synthetic shapes of roughly n vertices:
+//   Random   - G(n, 4n) plus a spanning path, small diameter
+//   Grid     - sqrt(n) x sqrt(n) lattice, diameter ~2 sqrt(n)
+//   PowerLaw - preferential attachment, a few hubs own most edges
+
+enum class Shape { Random, Grid, PowerLaw };
+
+static bench::EdgeList makeEdges(Shape shape, int n) {
+    switch (shape) {
+        case Shape::Random:
+            return bench::randomGraph(n, 4 * static_cast<size_t>(n));
+        case Shape::Grid: {
+            int side = std::max(2, static_cast<int>(std::sqrt(n)));
+            return bench::gridGraph(side);
+        }
+        case Shape::PowerLaw:
+            return bench::powerLawGraph(n);
+    }
+    return {};
+}
+
+static Graph<int> makeGraph(Shape shape, int n) {
+    auto edges = makeEdges(shape, n);
+    return Graph<int>::fromEdgeList(edges);
+}
+
+static void setGraphCounters(benchmark::State& state, const Graph<int>& graph) {
+    state.counters["V"] = graph.getNumVertices();
+    state.counters["E"] = graph.getNumEdges();
+}
+
+// ==================== CONSTRUCTION ====================
+template<Shape S>
+static void BM_GraphBuild(benchmark::State& state) {
+    auto edges = makeEdges(S, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        Graph<int> graph = Graph<int>::fromEdgeList(edges);
+        benchmark::DoNotOptimize(graph.getNumVertices());
+    }
+    state.SetItemsProcessed(state.iterations() * edges.size());
+}
+
+template<Shape S>
+static void BM_GraphFreeze(benchmark::State& state) {
+    Graph<int> graph = makeGraph(S, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        CSRGraph<int> csr = graph.freeze();
+        benchmark::DoNotOptimize(csr.getNumEdges());
+    }
+    setGraphCounters(state, graph);
+}
+
+// ==================== TRAVERSALS ====================
+// Graph<T>::BFS/DFS print as they go; QuietCout discards that output.
+// DFS prints an indented tree whose prefixes grow with depth, so both
+// sweeps stop well short of the CSR versions'.
+
+template<Shape S>
+static void BM_GraphBFS(benchmark::State& state) {
+    Graph<int> graph = makeGraph(S, static_cast<int>(state.range(0)));
+    bench::QuietCout quiet;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.BFS(0).size());
+    }
+    setGraphCounters(state, graph);
+}
+
+template<Shape S>
+static void BM_GraphDFS(benchmark::State& state) {
+    Graph<int> graph = makeGraph(S, static_cast<int>(state.range(0)));
+    bench::QuietCout quiet;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.DFS(0).size());
+    }
+    setGraphCounters(state, graph);
+}
+
+template<Shape S>
+static void BM_CSRGraphBFS(benchmark::State& state) {
+    Graph<int> graph = makeGraph(S, static_cast<int>(state.range(0)));
+    CSRGraph<int> csr = graph.freeze();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(csr.BFS(0).size());
+    }
+    setGraphCounters(state, graph);
+    state.SetItemsProcessed(state.iterations() * csr.getTargets().size());
+}
+
+template<Shape S>
+static void BM_CSRGraphDFS(benchmark::State& state) {
+    Graph<int> graph = makeGraph(S, static_cast<int>(state.range(0)));
+    CSRGraph<int> csr = graph.freeze();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(csr.DFS(0).size());
+    }
+    setGraphCounters(state, graph);
+    state.SetItemsProcessed(state.iterations() * csr.getTargets().size());
+}
+
+// One BFS per source vertex: O(V * (V + E))
+template<Shape S>
+static void BM_GraphDiameter(benchmark::State& state) {
+    Graph<int> graph = makeGraph(S, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.getDiameter());
+    }
+    setGraphCounters(state, graph);
+}
+
+// Fixed graph: after the first call, reads the cached union-find
+template<Shape S>
+static void BM_GraphIsConnected(benchmark::State& state) {
+    Graph<int> graph = makeGraph(S, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.isConnected());
+    }
+    setGraphCounters(state, graph);
+}
+
+// A live graph being monitored: one insertion, then the properties
+// displayProperties() leads with, all served from incremental counters
+template<Shape S>
+static void BM_GraphPollProperties(benchmark::State& state) {
+    int n = static_cast<int>(state.range(0));
+    Graph<int> graph = makeGraph(S, n);
+    std::vector<int> endpoints = bench::randomValues(1 << 16);
+    size_t next = 0;
+    for (auto _ : state) {
+        int src = endpoints[next++ & 0xFFFF] % n;
+        int dest = endpoints[next++ & 0xFFFF] % n;
+        graph.addEdge(src, dest);
+        benchmark::DoNotOptimize(graph.getNumEdges());
+        benchmark::DoNotOptimize(graph.getMinDegree());
+        benchmark::DoNotOptimize(graph.getMaxDegree());
+        benchmark::DoNotOptimize(graph.isConnected());
+    }
+    setGraphCounters(state, graph);
+}
+
+// One BFS per source, on Graph<T>'s own (dense-ID) scratch state
+template<Shape S>
+static void BM_GraphGirth(benchmark::State& state) {
+    Graph<int> graph = makeGraph(S, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.getGirth());
+    }
+    setGraphCounters(state, graph);
+}
+
+#define GRAPH_BENCHMARKS(S)                                                              \
+    BENCHMARK_TEMPLATE(BM_GraphBuild, S)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);   \
+    BENCHMARK_TEMPLATE(BM_GraphFreeze, S)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);  \
+    BENCHMARK_TEMPLATE(BM_GraphBFS, S)->RangeMultiplier(2)->Range(1 << 9, 1 << 12);      \
+    BENCHMARK_TEMPLATE(BM_GraphDFS, S)->RangeMultiplier(2)->Range(1 << 9, 1 << 12);      \
+    BENCHMARK_TEMPLATE(BM_CSRGraphBFS, S)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);  \
+    BENCHMARK_TEMPLATE(BM_CSRGraphDFS, S)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);  \
+    BENCHMARK_TEMPLATE(BM_GraphIsConnected, S)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM_GraphPollProperties, S)->RangeMultiplier(8)->Range(1 << 10, 1 << 19); \
+    BENCHMARK_TEMPLATE(BM_GraphGirth, S)->RangeMultiplier(2)->Range(1 << 9, 1 << 11)     \
+        ->Unit(benchmark::kMillisecond);                                                 \
+    BENCHMARK_TEMPLATE(BM_GraphDiameter, S)->RangeMultiplier(2)->Range(1 << 9, 1 << 12)  \
+        ->Unit(benchmark::kMillisecond)
+
+GRAPH_BENCHMARKS(Shape::Random);
+GRAPH_BENCHMARKS(Shape::Grid);
+GRAPH_BENCHMARKS(Shape::PowerLaw);
+
+// ==================== THREAD SCALING ====================
+// Fixed graph, thread count swept from 1 to the hardware thread count.
+
+static void BM_ParallelBFS(benchmark::State& state) {
+    static const CSRGraph<int> csr = makeGraph(Shape::Random, 1 << 20).freeze();
+    unsigned threads = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(csr.parallelBFSDistances(0, threads).size());
+    }
+    state.SetItemsProcessed(state.iterations() * csr.getTargets().size());
+}
+BENCHMARK(BM_ParallelBFS)->Apply(bench::threadSweep)->Unit(benchmark::kMillisecond);
+
+static void BM_ParallelEccentricities(benchmark::State& state) {
+    static const Graph<int> graph = makeGraph(Shape::PowerLaw, 1 << 13);
+    unsigned threads = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.getEccentricities(threads).diameter);
+    }
+}
+BENCHMARK(BM_ParallelEccentricities)->Apply(bench::threadSweep)->Unit(benchmark::kMillisecond);
+
+// ==================== SNAPSHOTS ====================
+static void BM_GraphLoadSnapshot(benchmark::State& state) {
+    Graph<int> graph = makeGraph(Shape::PowerLaw, static_cast<int>(state.range(0)));
+    std::string path = bench::tempPath("snazzydeets_bench_graph.csr");
+    graph.saveSnapshot(path);
+    for (auto _ : state) {
+        CSRGraph<int> csr = CSRGraph<int>::loadSnapshot(path);
+        benchmark::DoNotOptimize(csr.getNumEdges());
+    }
+    std::filesystem::remove(path);
+    setGraphCounters(state, graph);
+}
+BENCHMARK(BM_GraphLoadSnapshot)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
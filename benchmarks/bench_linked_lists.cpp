@@ -0,0 +1,117 @@
+#include "bench_common.hpp"
+#include "../linked_lists/linked_lists.hpp"
+
+// Each list type is filled with the same random values, then sorted or indexed.
+// Fixtures are built with addFirst, which is O(1) on every list type;
+// SinglyLinkedList::addLast walks to the tail, so its own sweep is shorter.
+
+template<typename List>
+static List makeList(size_t n) {
+    List list;
+    for (int value : bench::randomValues(n)) list.addFirst(value);
+    return list;
+}
+
+template<typename List>
+static void BM_ListAddLast(benchmark::State& state) {
+    auto values = bench::randomValues(state.range(0));
+    for (auto _ : state) {
+        List list;
+        for (int value : values) list.addLast(value);
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+template<typename List>
+static void BM_ListSort(benchmark::State& state) {
+    List source = makeList<List>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        List list(source);
+        state.ResumeTiming();
+        list.sort();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * source.size());
+}
+
+// get(i) walks from the nearest end, so random indices cost O(n) each
+template<typename List>
+static void BM_ListGet(benchmark::State& state) {
+    List list = makeList<List>(state.range(0));
+    std::mt19937 rng(bench::SEED);
+    size_t n = list.size();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.get(rng() % n));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define LIST_BENCHMARKS(List, AddLastRange)                                            \
+    BENCHMARK_TEMPLATE(BM_ListAddLast, List)->AddLastRange;                           \
+    BENCHMARK_TEMPLATE(BM_ListSort, List)->Apply(bench::sizeSweep);                   \
+    BENCHMARK_TEMPLATE(BM_ListGet, List)->RangeMultiplier(8)->Range(1 << 10, 1 << 17)
+
+using IntSingly = SinglyLinkedList<int>;
+using IntDoubly = DoublyLinkedList<int>;
+using IntCircular = CircularLinkedList<int>;
+using IntCircularDoubly = CircularDoublyLinkedList<int>;
+using IntUnrolled = UnrolledLinkedList<int>;
+
+LIST_BENCHMARKS(IntSingly, RangeMultiplier(4)->Range(1 << 8, 1 << 12));
+LIST_BENCHMARKS(IntDoubly, Apply(bench::sizeSweep));
+LIST_BENCHMARKS(IntCircular, Apply(bench::sizeSweep));
+LIST_BENCHMARKS(IntCircularDoubly, Apply(bench::sizeSweep));
+LIST_BENCHMARKS(IntUnrolled, Apply(bench::sizeSweep));
+
+// ==================== THREAD SCALING ====================
+// Parallel merge sort on a fixed 1M-element list, 1 .. hardware threads
+
+template<typename List>
+static void BM_ListParallelSort(benchmark::State& state) {
+    static const List source = makeList<List>(1 << 20);
+    unsigned threads = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        List list(source);
+        state.ResumeTiming();
+        list.sort(true, threads);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * source.size());
+}
+BENCHMARK_TEMPLATE(BM_ListParallelSort, IntSingly)->Apply(bench::threadSweep)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ListParallelSort, IntDoubly)->Apply(bench::threadSweep)->Unit(benchmark::kMillisecond);
+
+// Full scan (the value is absent) of a 1M-element unrolled list
+static void BM_UnrolledParallelIndexOf(benchmark::State& state) {
+    static const IntUnrolled list = makeList<IntUnrolled>(1 << 20);
+    unsigned threads = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.indexOf(parallel::par(threads), -1));
+    }
+    state.SetItemsProcessed(state.iterations() * list.size());
+}
+BENCHMARK(BM_UnrolledParallelIndexOf)->Apply(bench::threadSweep)->Unit(benchmark::kMillisecond);
+
+// ==================== LOCK-FREE QUEUE ====================
+// Every benchmark thread both enqueues and dequeues on one shared queue
+
+static LockFreeQueue<int>* sharedQueue = nullptr;
+
+static void BM_LockFreeQueuePingPong(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        sharedQueue = new LockFreeQueue<int>();
+    }
+    for (auto _ : state) {
+        sharedQueue->addLast(state.thread_index());
+        benchmark::DoNotOptimize(sharedQueue->tryRemoveFirst());
+    }
+    if (state.thread_index() == 0) {
+        delete sharedQueue;
+        sharedQueue = nullptr;
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_LockFreeQueuePingPong)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
@@ -0,0 +1,265 @@
+#include "bench_common.hpp"
+#include "../maps/maps.hpp"
+
+// Map engines compared on the same shuffled int keys. LinkedListMap is a
+// linear scan per operation, so its sweep stops well before the others'.
+
+template<typename Map>
+static void BM_MapInsert(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    for (auto _ : state) {
+        Map map;
+        for (int key : keys) map.insert(key, key);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<typename Map>
+static void BM_MapLookupHit(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    Map map;
+    for (int key : keys) map.insert(key, key);
+    auto probes = bench::shuffledKeys(keys.size(), bench::SEED + 1);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(probes[i]));
+        if (++i == probes.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Map>
+static void BM_MapLookupMiss(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    Map map;
+    for (int key : keys) map.insert(key, key);
+    int n = static_cast<int>(keys.size());
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(n + i));
+        if (++i == n) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Map>
+static void BM_MapErase(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Map map;
+        for (int key : keys) map.insert(key, key);
+        state.ResumeTiming();
+        for (int key : keys) map.erase(key);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+#define MAP_BENCHMARKS(Map, Apply)                                              \
+    BENCHMARK_TEMPLATE(BM_MapInsert, Map)->Apply;                               \
+    BENCHMARK_TEMPLATE(BM_MapLookupHit, Map)->Apply;                            \
+    BENCHMARK_TEMPLATE(BM_MapLookupMiss, Map)->Apply;                           \
+    BENCHMARK_TEMPLATE(BM_MapErase, Map)->Apply
+
+using IntHashMap = HashMap<int, int>;
+using IntFlatHashMap = FlatHashMap<int, int>;
+using IntTreeMap = TreeMap<int, int>;
+using IntLinkedListMap = LinkedListMap<int, int>;
+
+MAP_BENCHMARKS(IntHashMap, Apply(bench::sizeSweep));
+MAP_BENCHMARKS(IntFlatHashMap, Apply(bench::sizeSweep));
+MAP_BENCHMARKS(IntTreeMap, Apply(bench::sizeSweep));
+MAP_BENCHMARKS(IntLinkedListMap, RangeMultiplier(4)->Range(1 << 8, 1 << 12));
+
+// ==================== STRING KEYS ====================
+static void BM_HashMapStringLookup(benchmark::State& state) {
+    auto words = bench::randomWords(state.range(0));
+    HashMap<std::string, int> map;
+    for (size_t i = 0; i < words.size(); ++i) map.insert(words[i], static_cast<int>(i));
+    size_t i = 0;
+    for (auto _ : state) {
+        // string_view probe: no temporary std::string per lookup
+        benchmark::DoNotOptimize(map.find(std::string_view(words[i])));
+        if (++i == words.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HashMapStringLookup)->Apply(bench::sizeSweep);
+
+// ==================== TREE MAP ORDERED ACCESS ====================
+// Scan of a 1024-key window starting at a random key: one descent, then
+// cursor steps, no vector of entries
+static void BM_TreeMapRangeScan(benchmark::State& state) {
+    constexpr int WINDOW = 1024;
+    int n = static_cast<int>(state.range(0));
+    IntTreeMap map;
+    for (int key : bench::shuffledKeys(n)) map.insert(key, key);
+    auto starts = bench::shuffledKeys(n, bench::SEED + 1);
+    size_t i = 0;
+    int64_t visited = 0;
+    for (auto _ : state) {
+        long long sum = 0;
+        int lo = starts[i];
+        map.range(lo, lo + WINDOW, [&sum](const int&, const int& value) { sum += value; });
+        benchmark::DoNotOptimize(sum);
+        visited += std::min(WINDOW, n - lo);
+        if (++i == starts.size()) i = 0;
+    }
+    state.SetItemsProcessed(visited);
+}
+BENCHMARK(BM_TreeMapRangeScan)->Apply(bench::sizeSweep);
+
+// Sorted keys into an empty map: balanced build vs one insert per key
+static void BM_TreeMapBuildFromSorted(benchmark::State& state) {
+    std::vector<int> keys(state.range(0));
+    for (size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<int>(i);
+    for (auto _ : state) {
+        IntTreeMap map;
+        map.create_map_from_arrays(keys, keys);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_TreeMapBuildFromSorted)->Apply(bench::sizeSweep);
+
+static void BM_TreeMapInsertSorted(benchmark::State& state) {
+    int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        IntTreeMap map;
+        for (int key = 0; key < n; ++key) map.insert(key, key);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_TreeMapInsertSorted)->Apply(bench::sizeSweep);
+
+// ==================== PARALLEL BULK OPERATIONS ====================
+// parallel::par(t) over a fixed 1M-key input, 1 .. hardware threads;
+// t = 1 takes the sequential path
+
+static void BM_HashMapParallelBuild(benchmark::State& state) {
+    static const auto keys = bench::shuffledKeys(1 << 20);
+    unsigned threads = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        IntHashMap map;
+        map.create_map_from_arrays(parallel::par(threads), keys, keys);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_HashMapParallelBuild)->Apply(bench::threadSweep)->Unit(benchmark::kMillisecond);
+
+// A value that is never present, so every bucket is scanned
+static void BM_HashMapParallelExistsValue(benchmark::State& state) {
+    static const IntHashMap map = [] {
+        auto keys = bench::shuffledKeys(1 << 20);
+        IntHashMap built;
+        built.create_map_from_arrays(keys, keys);
+        return built;
+    }();
+    unsigned threads = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.existsValue(parallel::par(threads), -1));
+    }
+    state.SetItemsProcessed(state.iterations() * map.size());
+}
+BENCHMARK(BM_HashMapParallelExistsValue)->Apply(bench::threadSweep)->Unit(benchmark::kMillisecond);
+
+// ==================== CONCURRENT HASH MAP ====================
+// One map shared by all benchmark threads. Thread 0 creates it before the
+// timed loop and frees it after; the loop boundaries are barriers.
+static ConcurrentHashMap<int, int>* sharedMap = nullptr;
+
+static void BM_ConcurrentWrite(benchmark::State& state) {
+    // Writes only: each thread cycles insertOrAssign over its own 64K keys
+    constexpr int PER_THREAD = 1 << 16;
+    if (state.thread_index() == 0) {
+        sharedMap = new ConcurrentHashMap<int, int>();
+    }
+    int base = state.thread_index() * PER_THREAD;
+    int k = 0;
+    for (auto _ : state) {
+        sharedMap->insertOrAssign(base + k, k);
+        if (++k == PER_THREAD) k = 0;
+    }
+    if (state.thread_index() == 0) {
+        delete sharedMap;
+        sharedMap = nullptr;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConcurrentWrite)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+static void BM_ConcurrentMixed(benchmark::State& state) {
+    // 90% lookups, 10% updates over a pre-filled map
+    constexpr int KEYS = 1 << 18;
+    if (state.thread_index() == 0) {
+        sharedMap = new ConcurrentHashMap<int, int>();
+        for (int k = 0; k < KEYS; ++k) sharedMap->insert(k, k);
+    }
+    std::mt19937 rng(bench::SEED + state.thread_index());
+    for (auto _ : state) {
+        int key = static_cast<int>(rng() % KEYS);
+        if (rng() % 10 == 0) {
+            sharedMap->insertOrAssign(key, key);
+        } else {
+            benchmark::DoNotOptimize(sharedMap->find(key));
+        }
+    }
+    if (state.thread_index() == 0) {
+        delete sharedMap;
+        sharedMap = nullptr;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConcurrentMixed)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+// ==================== SNAPSHOTS ====================
+// Cold start: rebuilding by inserts vs loading or mapping a saved snapshot.
+
+static void BM_HashMapRebuildByInsert(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    for (auto _ : state) {
+        HashMap<int, int> map;
+        map.reserve(keys.size());
+        for (int key : keys) map.insert(key, key);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_HashMapRebuildByInsert)->Apply(bench::sizeSweep);
+
+static void BM_HashMapLoadSnapshot(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    std::string path = bench::tempPath("snazzydeets_bench_hashmap.snap");
+    {
+        HashMap<int, int> map;
+        for (int key : keys) map.insert(key, key);
+        map.saveSnapshot(path);
+    }
+    for (auto _ : state) {
+        auto map = HashMap<int, int>::loadSnapshot(path);
+        benchmark::DoNotOptimize(map.size());
+    }
+    std::filesystem::remove(path);
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_HashMapLoadSnapshot)->Apply(bench::sizeSweep);
+
+static void BM_HashMapViewOpenAndProbe(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    std::string path = bench::tempPath("snazzydeets_bench_view.snap");
+    {
+        HashMap<int, int> map;
+        for (int key : keys) map.insert(key, key);
+        map.saveSnapshot(path);
+    }
+    for (auto _ : state) {
+        HashMapView<int, int> view(path);
+        benchmark::DoNotOptimize(view.get(keys[0]));
+    }
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_HashMapViewOpenAndProbe)->Apply(bench::sizeSweep);
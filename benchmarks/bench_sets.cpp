@@ -0,0 +1,110 @@
+#include "bench_common.hpp"
+#include "../sets/sets.hpp"
+
+// Set containers on the same keys. Algebra benchmarks combine two sets of
+// n keys drawn from [0, 2n), so about half of each operand is shared.
+
+static std::vector<int> halfOverlapKeys(size_t n, uint64_t seed) {
+    auto keys = bench::shuffledKeys(2 * n, seed);
+    keys.resize(n);
+    return keys;
+}
+
+template<typename Set>
+static Set makeSet(const std::vector<int>& keys) {
+    if constexpr (std::is_same_v<Set, DenseBitset>) {
+        DenseBitset set;
+        for (int key : keys) set.insert(static_cast<size_t>(key));
+        return set;
+    } else {
+        return Set(keys);
+    }
+}
+
+// ==================== MEMBERSHIP ====================
+template<typename Set>
+static void BM_SetBuild(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    for (auto _ : state) {
+        Set set = makeSet<Set>(keys);
+        benchmark::DoNotOptimize(set.empty());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<typename Set>
+static void BM_SetContains(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    Set set = makeSet<Set>(keys);
+    // Probe [0, 2n): half hits, half misses
+    auto probes = bench::shuffledKeys(2 * keys.size(), bench::SEED + 1);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(set.contains(probes[i]));
+        if (++i == probes.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// ==================== ALGEBRA ====================
+template<typename Set>
+static void BM_SetUnion(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    Set a = makeSet<Set>(halfOverlapKeys(n, bench::SEED));
+    Set b = makeSet<Set>(halfOverlapKeys(n, bench::SEED + 1));
+    for (auto _ : state) {
+        Set c = setUnion(a, b);
+        benchmark::DoNotOptimize(c.empty());
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * n);
+}
+
+template<typename Set>
+static void BM_SetIntersection(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    Set a = makeSet<Set>(halfOverlapKeys(n, bench::SEED));
+    Set b = makeSet<Set>(halfOverlapKeys(n, bench::SEED + 1));
+    for (auto _ : state) {
+        Set c = setIntersection(a, b);
+        benchmark::DoNotOptimize(c.empty());
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * n);
+}
+
+template<typename Set>
+static void BM_SetIntersectionSize(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    Set a = makeSet<Set>(halfOverlapKeys(n, bench::SEED));
+    Set b = makeSet<Set>(halfOverlapKeys(n, bench::SEED + 1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(intersectionSize(a, b));
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * n);
+}
+
+// 1/64 of n keys against n keys: exercises SortedFlatSet's galloping path
+static void BM_SortedFlatSetSkewedIntersection(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    auto small = halfOverlapKeys(n / 64, bench::SEED + 2);
+    SortedFlatSet<int> a(small);
+    SortedFlatSet<int> b(bench::shuffledKeys(n));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(setIntersection(a, b).size());
+    }
+    state.SetItemsProcessed(state.iterations() * small.size());
+}
+BENCHMARK(BM_SortedFlatSetSkewedIntersection)->Apply(bench::sizeSweep);
+
+#define SET_BENCHMARKS(Set)                                                     \
+    BENCHMARK_TEMPLATE(BM_SetBuild, Set)->Apply(bench::sizeSweep);              \
+    BENCHMARK_TEMPLATE(BM_SetContains, Set)->Apply(bench::sizeSweep);           \
+    BENCHMARK_TEMPLATE(BM_SetUnion, Set)->Apply(bench::sizeSweep);              \
+    BENCHMARK_TEMPLATE(BM_SetIntersection, Set)->Apply(bench::sizeSweep);       \
+    BENCHMARK_TEMPLATE(BM_SetIntersectionSize, Set)->Apply(bench::sizeSweep)
+
+using IntHashSet = HashSet<int>;
+using IntSortedFlatSet = SortedFlatSet<int>;
+
+SET_BENCHMARKS(IntHashSet);
+SET_BENCHMARKS(IntSortedFlatSet);
+SET_BENCHMARKS(DenseBitset);
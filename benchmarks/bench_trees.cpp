@@ -0,0 +1,128 @@
+#include "bench_common.hpp"
+#include "../trees/trees.hpp"
+
+// Ordered trees are fed shuffled keys: sorted input would measure the
+// plain BST's degenerate O(n) path instead of its average case.
+
+template<typename Tree>
+static void BM_TreeInsert(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    for (auto _ : state) {
+        Tree tree;
+        for (int key : keys) tree.insert(key);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template<typename Tree>
+static void BM_TreeSearch(benchmark::State& state) {
+    auto keys = bench::shuffledKeys(state.range(0));
+    Tree tree;
+    for (int key : keys) tree.insert(key);
+    auto probes = bench::shuffledKeys(keys.size(), bench::SEED + 1);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.search(probes[i]));
+        if (++i == probes.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+using IntBST = BinarySearchTree<int>;
+using IntAVL = AVLTree<int>;
+using IntRedBlack = RedBlackTree<int>;
+using IntBTree = BTree<int>;
+
+BENCHMARK_TEMPLATE(BM_TreeInsert, IntBST)->Apply(bench::sizeSweep);
+BENCHMARK_TEMPLATE(BM_TreeSearch, IntBST)->Apply(bench::sizeSweep);
+BENCHMARK_TEMPLATE(BM_TreeInsert, IntAVL)->Apply(bench::sizeSweep);
+BENCHMARK_TEMPLATE(BM_TreeSearch, IntAVL)->Apply(bench::sizeSweep);
+BENCHMARK_TEMPLATE(BM_TreeInsert, IntRedBlack)->Apply(bench::sizeSweep);
+BENCHMARK_TEMPLATE(BM_TreeSearch, IntRedBlack)->Apply(bench::sizeSweep);
+BENCHMARK_TEMPLATE(BM_TreeInsert, IntBTree)->Apply(bench::sizeSweep);
+BENCHMARK_TEMPLATE(BM_TreeSearch, IntBTree)->Apply(bench::sizeSweep);
+
+// ==================== TRIES ====================
+template<typename TrieType>
+static void BM_TrieInsert(benchmark::State& state) {
+    auto words = bench::randomWords(state.range(0));
+    for (auto _ : state) {
+        TrieType trie;
+        for (const auto& word : words) trie.insert(word);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * words.size());
+}
+
+template<typename TrieType>
+static void BM_TrieSearch(benchmark::State& state) {
+    auto words = bench::randomWords(state.range(0));
+    TrieType trie;
+    for (const auto& word : words) trie.insert(word);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trie.search(words[i]));
+        if (++i == words.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_TrieInsert, Trie)->RangeMultiplier(8)->Range(1 << 10, 1 << 17);
+BENCHMARK_TEMPLATE(BM_TrieSearch, Trie)->RangeMultiplier(8)->Range(1 << 10, 1 << 17);
+BENCHMARK_TEMPLATE(BM_TrieInsert, RadixTrie)->RangeMultiplier(8)->Range(1 << 10, 1 << 17);
+BENCHMARK_TEMPLATE(BM_TrieSearch, RadixTrie)->RangeMultiplier(8)->Range(1 << 10, 1 << 17);
+
+// ==================== RANGE-QUERY TREES ====================
+// "insert" is a point update and "search" a range query for these
+
+static void BM_SegmentTreeUpdate(benchmark::State& state) {
+    auto values = bench::randomValues(state.range(0));
+    SegmentTree<long long> tree(std::vector<long long>(values.begin(), values.end()));
+    int n = static_cast<int>(values.size());
+    int i = 0;
+    for (auto _ : state) {
+        tree.update(i, values[n - 1 - i]);
+        if (++i == n) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SegmentTreeUpdate)->Apply(bench::sizeSweep);
+
+static void BM_SegmentTreeQuery(benchmark::State& state) {
+    auto values = bench::randomValues(state.range(0));
+    SegmentTree<long long> tree(std::vector<long long>(values.begin(), values.end()));
+    int n = static_cast<int>(values.size());
+    std::mt19937 rng(bench::SEED);
+    for (auto _ : state) {
+        int a = static_cast<int>(rng() % n), b = static_cast<int>(rng() % n);
+        benchmark::DoNotOptimize(tree.query(std::min(a, b), std::max(a, b)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SegmentTreeQuery)->Apply(bench::sizeSweep);
+
+static void BM_FenwickUpdate(benchmark::State& state) {
+    int n = static_cast<int>(state.range(0));
+    BinaryIndexedTree<long long> tree(n);
+    int i = 0;
+    for (auto _ : state) {
+        tree.update(i, 1);
+        if (++i == n) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FenwickUpdate)->Apply(bench::sizeSweep);
+
+static void BM_FenwickRangeQuery(benchmark::State& state) {
+    auto values = bench::randomValues(state.range(0));
+    BinaryIndexedTree<long long> tree(values);
+    int n = static_cast<int>(values.size());
+    std::mt19937 rng(bench::SEED);
+    for (auto _ : state) {
+        int a = static_cast<int>(rng() % n), b = static_cast<int>(rng() % n);
+        benchmark::DoNotOptimize(tree.rangeQuery(std::min(a, b), std::max(a, b)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FenwickRangeQuery)->Apply(bench::sizeSweep);
@@ -10,12 +10,529 @@
 #include <stdexcept>
 #include <sstream>
 #include "../console_colors/colours.hpp"
+#include "../snapshot/snapshot.hpp"
+#include "../instrumentation/instrumentation.hpp"
+#include "../output/output.hpp"
 #include<climits>
+#include <span>
+#include <thread>
+#include <atomic>
+#include <barrier>
+#include <mutex>
+#include <cstdint>
+#include <functional>
+#include <tuple>
 
 
 using namespace std;
 using namespace colors;
 
+template<typename T>
+class CSRGraph;
+
+/**
+ * Result of the all-sources eccentricity pass
+ * eccentricity is indexed by dense vertex ID (sorted vertex order)
+ * On a disconnected graph connected == false, diameter == radius == -1,
+ * and eccentricity/center/periphery are left empty
+ */
+template<typename T>
+struct GraphMetrics {
+    vector<long long> eccentricity;
+    long long diameter = 0;
+    long long radius = 0;
+    vector<T> center;       // vertices with eccentricity == radius
+    vector<T> periphery;    // vertices with eccentricity == diameter
+    bool connected = true;
+};
+
+/**
+ * Result of a point-to-point shortest path query
+ * path runs from source to target inclusive; empty when unreachable
+ */
+template<typename T>
+struct ShortestPath {
+    vector<T> path;
+    long long distance = -1;
+
+    bool found() const { return distance >= 0; }
+};
+
+/**
+ * Result of a single-source shortest path query
+ * Only reachable vertices appear in distance; parent has every reachable
+ * vertex except the source
+ */
+template<typename T>
+struct ShortestPathTree {
+    map<T, long long> distance;
+    map<T, T> parent;
+
+    /**
+     * Source -> target path through the parent links, empty if unreachable
+     */
+    vector<T> pathTo(const T& target) const {
+        vector<T> path;
+        if (distance.find(target) == distance.end()) return path;
+        path.push_back(target);
+        for (auto it = parent.find(target); it != parent.end(); it = parent.find(it->second)) {
+            path.push_back(it->second);
+        }
+        reverse(path.begin(), path.end());
+        return path;
+    }
+};
+
+/**
+ * Traversal counters kept by Graph and CSRGraph (see instrumentation.hpp)
+ * All zero unless built with SNAZZYDEETS_STATS
+ */
+struct GraphStats {
+    instrumentation::Counter traversals;            // BFS, getDistance and hop-distance passes
+    instrumentation::Counter edgesRelaxed;          // adjacency entries examined by them
+    instrumentation::Counter maxEdgesPerTraversal;  // most entries a single pass examined
+
+    double averageEdgesRelaxed() const { return instrumentation::ratio(edgesRelaxed, traversals); }
+
+    void recordTraversal(const char* structure, uint64_t edges) {
+        traversals.add();
+        edgesRelaxed.add(edges);
+        maxEdgesPerTraversal.raiseTo(edges);
+        instrumentation::emit({structure, "traversal", edges, 0});
+    }
+};
+
+// ============================================================================
+// DENSE VERTEX IDS
+// ============================================================================
+
+namespace graph_detail {
+    /**
+     * Vertex types whose values can index a vector directly
+     */
+    template<typename T>
+    concept DenseId = integral<T> && !same_as<T, bool>;
+
+    // IDs count as dense when max - min < SPAN_PER_VERTEX * V + SPAN_SLACK
+    constexpr uint64_t SPAN_PER_VERTEX = 4;
+    constexpr uint64_t SPAN_SLACK = 64;
+
+    /**
+     * [min, max] of a graph's vertex set when T is a DenseId type and the
+     * IDs are compact enough to index vectors with; size == 0 otherwise.
+     * O(1): the set is sorted, so min and max are its two ends.
+     */
+    template<typename T>
+    struct IdRange {
+        T base{};
+        size_t size = 0;
+
+        static IdRange of(const set<T>& vertices) {
+            IdRange range;
+            if constexpr (DenseId<T>) {
+                if (vertices.empty()) return range;
+                using U = make_unsigned_t<T>;
+                uint64_t span = static_cast<U>(static_cast<U>(*vertices.rbegin()) -
+                                               static_cast<U>(*vertices.begin()));
+                if (span < SPAN_PER_VERTEX * vertices.size() + SPAN_SLACK) {
+                    range.base = *vertices.begin();
+                    range.size = static_cast<size_t>(span) + 1;
+                }
+            }
+            return range;
+        }
+
+        bool dense() const { return size != 0; }
+
+        /**
+         * Slot of vertex, or size when it falls outside the range
+         */
+        size_t index(const T& vertex) const {
+            if constexpr (DenseId<T>) {
+                using U = make_unsigned_t<T>;
+                uint64_t offset = static_cast<U>(static_cast<U>(vertex) - static_cast<U>(base));
+                return offset < size ? static_cast<size_t>(offset) : size;
+            } else {
+                return size;
+            }
+        }
+    };
+
+    /**
+     * Per-call vertex -> V scratch (visited marks, distances, colors).
+     * A flat vector over a dense IdRange, a std::map otherwise; a vertex
+     * outside the range also falls back to the map. Vertices never put()
+     * read as `missing`.
+     */
+    template<typename T, typename V>
+    class VertexTable {
+    private:
+        IdRange<T> range;
+        vector<V> slots;
+        map<T, V> keyed;
+        V missing;
+
+    public:
+        VertexTable(const IdRange<T>& ids, V absent)
+            : range(ids), slots(ids.size, absent), missing(absent) {}
+
+        const V& get(const T& vertex) const {
+            size_t i = range.index(vertex);
+            if (i < range.size) return slots[i];
+            auto it = keyed.find(vertex);
+            return it == keyed.end() ? missing : it->second;
+        }
+
+        bool has(const T& vertex) const { return !(get(vertex) == missing); }
+
+        /**
+         * Entry for vertex, created as `missing` if absent
+         */
+        V& operator[](const T& vertex) {
+            size_t i = range.index(vertex);
+            if (i < range.size) return slots[i];
+            return keyed.try_emplace(vertex, missing).first->second;
+        }
+
+        V& put(const T& vertex, V value) {
+            size_t i = range.index(vertex);
+            if (i < range.size) return slots[i] = std::move(value);
+            return keyed[vertex] = std::move(value);
+        }
+
+        void erase(const T& vertex) {
+            size_t i = range.index(vertex);
+            if (i < range.size) slots[i] = missing;
+            else keyed.erase(vertex);
+        }
+
+        /**
+         * Forget every entry, keeping the allocation
+         */
+        void reset() {
+            fill(slots.begin(), slots.end(), missing);
+            keyed.clear();
+        }
+    };
+
+    /**
+     * Neighbor lists of an adjacency map, found by slot instead of a tree
+     * lookup when the IDs are dense. Built in one O(V) walk; valid until
+     * the graph changes.
+     */
+    template<typename T>
+    class AdjacencyIndex {
+    public:
+        using List = vector<pair<T, int>>;
+
+    private:
+        IdRange<T> range;
+        const map<T, List>* adjList;
+        vector<const List*> lists;
+
+    public:
+        AdjacencyIndex(const map<T, List>& adjacency, const IdRange<T>& ids)
+            : range(ids), adjList(&adjacency), lists(ids.size, nullptr) {
+            if (!range.dense()) return;
+            for (const auto& [vertex, neighbors] : adjacency) {
+                size_t i = range.index(vertex);
+                if (i < range.size) lists[i] = &neighbors;
+            }
+        }
+
+        /**
+         * Neighbors of vertex, nullptr if it has no adjacency entry
+         */
+        const List* of(const T& vertex) const {
+            size_t i = range.index(vertex);
+            if (i < range.size) return lists[i];
+            auto it = adjList->find(vertex);
+            return it == adjList->end() ? nullptr : &it->second;
+        }
+    };
+
+    /**
+     * Explicit stack for the iterative searches, replacing recursion.
+     * Its buffer is borrowed from a per-thread spare and handed back on
+     * destruction, so repeated calls don't reallocate; a nested search
+     * using the same Frame type simply gets a fresh buffer.
+     */
+    template<typename Frame>
+    class ScratchStack {
+    private:
+        vector<Frame> frames;
+
+        static vector<Frame>& spare() {
+            thread_local vector<Frame> buffer;
+            return buffer;
+        }
+
+    public:
+        ScratchStack() : frames(std::move(spare())) { frames.clear(); }
+
+        ~ScratchStack() {
+            frames.clear();
+            if (frames.capacity() > spare().capacity()) spare() = std::move(frames);
+        }
+
+        ScratchStack(const ScratchStack&) = delete;
+        ScratchStack& operator=(const ScratchStack&) = delete;
+
+        void push(Frame frame) { frames.push_back(std::move(frame)); }
+        void pop() { frames.pop_back(); }
+        Frame& top() { return frames.back(); }
+        bool empty() const { return frames.empty(); }
+        size_t size() const { return frames.size(); }
+    };
+
+    /**
+     * Visited set kept across calls: reset() is O(1) (it bumps an epoch)
+     * while the vertex IDs stay within the slots already allocated, which
+     * grow by doubling. Sparse or non-integral IDs use a std::set.
+     */
+    template<typename T>
+    class VisitMarks {
+    private:
+        IdRange<T> range;       // size == stamps.size()
+        vector<uint32_t> stamps;
+        uint32_t epoch = 0;
+        set<T> keyed;
+
+    public:
+        void reset(const IdRange<T>& ids) {
+            keyed.clear();
+            bool fits = ids.dense() && range.dense() && range.index(ids.base) + ids.size <= range.size;
+            if (ids.dense() && !fits) {
+                range.base = ids.base;
+                range.size = max(ids.size, 2 * range.size);
+                stamps.assign(range.size, 0);
+                epoch = 0;
+            }
+            if (++epoch == 0) {
+                fill(stamps.begin(), stamps.end(), 0);
+                epoch = 1;
+            }
+        }
+
+        /**
+         * @return true if vertex was not marked yet
+         */
+        bool insert(const T& vertex) {
+            size_t i = range.index(vertex);
+            if (i >= range.size) return keyed.insert(vertex).second;
+            if (stamps[i] == epoch) return false;
+            stamps[i] = epoch;
+            return true;
+        }
+
+        bool contains(const T& vertex) const {
+            size_t i = range.index(vertex);
+            if (i >= range.size) return keyed.count(vertex) != 0;
+            return stamps[i] == epoch;
+        }
+    };
+
+    /**
+     * How many vertices have each degree, plus the sum of all degrees.
+     * Kept up to date by every Graph edit, so edge counts and min/max
+     * degree are read instead of recomputed.
+     */
+    class DegreeHistogram {
+    private:
+        vector<size_t> counts;  // counts[d] = vertices of degree d; no trailing zeros
+        size_t total = 0;       // sum of degrees (adjacency entries)
+
+    public:
+        void add(size_t degree) {
+            if (degree >= counts.size()) counts.resize(degree + 1, 0);
+            counts[degree]++;
+            total += degree;
+        }
+
+        void remove(size_t degree) {
+            counts[degree]--;
+            total -= degree;
+            while (!counts.empty() && counts.back() == 0) counts.pop_back();
+        }
+
+        void change(size_t before, size_t after) {
+            if (before == after) return;
+            add(after);
+            remove(before);
+        }
+
+        void clear() {
+            counts.clear();
+            total = 0;
+        }
+
+        size_t degreeSum() const { return total; }
+
+        /**
+         * O(min degree): the first non-empty bucket. 0 when there are no vertices
+         */
+        size_t minDegree() const {
+            size_t d = 0;
+            while (d < counts.size() && counts[d] == 0) d++;
+            return d < counts.size() ? d : 0;
+        }
+
+        size_t maxDegree() const { return counts.empty() ? 0 : counts.size() - 1; }
+
+        const vector<size_t>& buckets() const { return counts; }
+    };
+
+    /**
+     * Union-find over an undirected graph's vertices, with each vertex's
+     * parity (side) relative to its root, so it answers both "how many
+     * components" and "is there an odd cycle" in O(1).
+     * Single edge insertions are merged in as they happen (near O(1)).
+     * Deletions can split components, which union-find cannot undo, so
+     * they only mark it stale, as do batch inserts; the next query
+     * rebuilds it in O(V + E). A rebuild also re-derives the IdRange, so
+     * dense integer vertices find their slot without a map lookup.
+     */
+    template<typename T>
+    class Components {
+    private:
+        IdRange<T> range;         // slots [0, range.size) are range vertices
+        map<T, uint32_t> keyed;   // slots of vertices outside the range
+        vector<uint32_t> parent;
+        vector<uint8_t> parity;   // side relative to parent
+        vector<uint8_t> rank;
+        vector<uint32_t> path;    // find() scratch
+        size_t count = 0;
+        size_t unranged = 0;      // vertices added outside the range since rebuild()
+        size_t rebuiltFor = 0;    // vertex count at the last rebuild()
+        bool oddCycle = false;
+        bool stale = false;
+
+        uint32_t slotOf(const T& vertex) const {
+            size_t i = range.index(vertex);
+            return i < range.size ? static_cast<uint32_t>(i) : keyed.at(vertex);
+        }
+
+        uint32_t newSlot() {
+            uint32_t id = static_cast<uint32_t>(parent.size());
+            parent.push_back(id);
+            parity.push_back(0);
+            rank.push_back(0);
+            return id;
+        }
+
+        /**
+         * Root of x and x's parity relative to it; compresses the path
+         */
+        pair<uint32_t, uint8_t> find(uint32_t x) {
+            path.clear();
+            while (parent[x] != x) {
+                path.push_back(x);
+                x = parent[x];
+            }
+            uint8_t side = 0;
+            for (size_t i = path.size(); i-- > 0;) {
+                side ^= parity[path[i]];
+                parity[path[i]] = side;
+                parent[path[i]] = x;
+            }
+            return {x, path.empty() ? 0 : parity[path.front()]};
+        }
+
+    public:
+        bool isStale() const { return stale; }
+        size_t size() const { return count; }
+        bool hasOddCycle() const { return oddCycle; }
+
+        /**
+         * Drops the structure until the next rebuild()
+         */
+        void invalidate() {
+            stale = true;
+            range = IdRange<T>();
+            keyed.clear();
+            unranged = 0;
+            parent.clear();
+            parity.clear();
+            rank.clear();
+            count = 0;
+            oddCycle = false;
+        }
+
+        /**
+         * Records a vertex new to the graph
+         */
+        void addVertex(const T& vertex) {
+            if (stale) return;
+            count++;
+            if (range.index(vertex) < range.size) return;  // slot reserved by rebuild()
+            keyed.emplace(vertex, newSlot());
+            // Integer IDs that outgrew the range: let the next rebuild pick a new one
+            if (DenseId<T> && ++unranged > rebuiltFor + SPAN_SLACK) invalidate();
+        }
+
+        /**
+         * True if an edge a-b would close an odd cycle (a and b are on the
+         * same side of one component). Both must have been added.
+         */
+        bool sameSide(const T& a, const T& b) {
+            auto [rootA, sideA] = find(slotOf(a));
+            auto [rootB, sideB] = find(slotOf(b));
+            return rootA == rootB && sideA == sideB;
+        }
+
+        /**
+         * Records an edge a-b between added vertices
+         */
+        void link(const T& a, const T& b) {
+            if (stale) return;
+            auto [rootA, sideA] = find(slotOf(a));
+            auto [rootB, sideB] = find(slotOf(b));
+            if (rootA == rootB) {
+                if (sideA == sideB) oddCycle = true;
+                return;
+            }
+            if (rank[rootA] < rank[rootB]) swap(rootA, rootB);
+            parent[rootB] = rootA;
+            parity[rootB] = sideA ^ sideB ^ 1;  // puts a and b on opposite sides
+            if (rank[rootA] == rank[rootB]) rank[rootA]++;
+            count--;
+        }
+
+        void rebuild(const set<T>& vertices, const map<T, vector<pair<T, int>>>& adjList) {
+            invalidate();
+            stale = false;
+            range = IdRange<T>::of(vertices);
+            parent.resize(range.size);
+            for (uint32_t i = 0; i < range.size; i++) parent[i] = i;
+            parity.assign(range.size, 0);
+            rank.assign(range.size, 0);
+            if (!range.dense()) {
+                for (const auto& vertex : vertices) keyed.emplace_hint(keyed.end(), vertex, newSlot());
+            }
+            count = vertices.size();
+            rebuiltFor = count;
+            for (const auto& [vertex, neighbors] : adjList) {
+                for (const auto& neighbor : neighbors) {
+                    // Undirected: each edge is listed from both ends; once is enough
+                    if (!(neighbor.first < vertex)) link(vertex, neighbor.first);
+                }
+            }
+        }
+    };
+
+    /**
+     * Mutex for caches that const queries fill in lazily. Copies and moves
+     * get a fresh, unlocked mutex, so the owning class stays copyable.
+     */
+    struct CacheMutex {
+        mutable mutex lock;
+
+        CacheMutex() = default;
+        CacheMutex(const CacheMutex&) {}
+        CacheMutex& operator=(const CacheMutex&) { return *this; }
+    };
+}
+
 // ============================================================================
 // BASE GRAPH CLASS WITH TEMPLATE SUPPORT
 // ============================================================================
@@ -33,6 +550,219 @@ protected:
     bool isWeighted;
     map<T, vector<pair<T, int>>> adjList; // vertex -> [(neighbor, weight)]
     set<T> vertices;
+    bool reverseIndexed = false;
+    map<T, vector<T>> inList; // vertex -> source of each in-edge (directed, when indexed)
+    graph_detail::DegreeHistogram degrees; // (out-)degree of every vertex, kept by each edit
+    mutable graph_detail::Components<T> components; // undirected only; rebuilt after deletions
+    mutable int8_t reachesAll = -1; // directed isConnected() result, -1 until computed
+    graph_detail::CacheMutex cacheMutex; // guards the lazy fill of components and reachesAll
+    [[no_unique_address]] mutable instrumentation::Slot<GraphStats> counters;
+
+    /**
+     * True when in-edges are tracked in inList
+     * Undirected graphs never need it: adjacency is already symmetric
+     */
+    bool tracksInEdges() const { return reverseIndexed && isDirected; }
+
+    /**
+     * Union-find of the undirected graph, rebuilt first if a deletion
+     * left it stale. Safe to call from several threads at once.
+     */
+    const graph_detail::Components<T>& connectivity() const {
+        lock_guard<mutex> guard(cacheMutex.lock);
+        if (components.isStale()) components.rebuild(vertices, adjList);
+        return components;
+    }
+
+    /**
+     * After an edit that can split components or change which vertices
+     * the first one reaches
+     */
+    void connectivityChanged() {
+        if (!isDirected) components.invalidate();
+        reachesAll = -1;
+    }
+
+    /**
+     * Appends one arc to vertex's list, keeping the degree histogram current
+     */
+    void appendArc(vector<pair<T, int>>& neighbors, const T& target, int weight) {
+        neighbors.push_back({target, weight});
+        degrees.change(neighbors.size() - 1, neighbors.size());
+    }
+
+    /**
+     * eraseNeighbor plus the degree histogram
+     * @return True if any entry was removed
+     */
+    bool dropNeighbor(vector<pair<T, int>>& neighbors, const T& target) {
+        size_t before = neighbors.size();
+        eraseNeighbor(neighbors, target);
+        degrees.change(before, neighbors.size());
+        return neighbors.size() != before;
+    }
+
+    /**
+     * Recomputes the degree histogram and drops the connectivity caches,
+     * after adjList was replaced wholesale
+     */
+    void rebuildMetadata() {
+        degrees.clear();
+        for (const auto& pair : adjList) degrees.add(pair.second.size());
+        components.invalidate();
+        reachesAll = -1;
+    }
+
+    /**
+     * Vector slots for the vertex IDs when T is integral and they are
+     * compact; algorithms size their scratch tables from it
+     */
+    graph_detail::IdRange<T> idRange() const { return graph_detail::IdRange<T>::of(vertices); }
+
+    /**
+     * Removes every entry equal to target from a neighbor list
+     */
+    static void eraseNeighbor(vector<pair<T, int>>& neighbors, const T& target) {
+        neighbors.erase(
+            remove_if(neighbors.begin(), neighbors.end(),
+                      [&target](const pair<T, int>& p) { return p.first == target; }),
+            neighbors.end()
+        );
+    }
+
+    /**
+     * Removes every in-edge from src recorded for dest
+     */
+    void eraseInEdges(const T& dest, const T& src) {
+        auto it = inList.find(dest);
+        if (it == inList.end()) return;
+        it->second.erase(remove(it->second.begin(), it->second.end(), src), it->second.end());
+    }
+
+    /**
+     * Calls fn(src, dest, weight) per edge; an undirected edge is visited
+     * once, from its smaller endpoint (a self-loop is stored twice)
+     */
+    template<typename Fn>
+    void forEachExportedEdge(Fn&& fn) const {
+        for (const auto& [vertex, neighbors] : adjList) {
+            bool pendingLoop = false;
+            for (const auto& [neighbor, weight] : neighbors) {
+                if (!isDirected) {
+                    if (neighbor < vertex) continue;
+                    if (neighbor == vertex) {
+                        pendingLoop = !pendingLoop;
+                        if (!pendingLoop) continue;
+                    }
+                }
+                fn(vertex, neighbor, weight);
+            }
+        }
+    }
+
+    /**
+     * Canonical, deduplicated subset of edges not yet in the graph
+     * Undirected edges are keyed as (min, max); the first weight seen for a
+     * repeated pair wins. The result is sorted by (src, dest).
+     */
+    vector<tuple<T, T, int>> freshEdges(span<const tuple<T, T, int>> edges) const {
+        struct Entry {
+            T src;
+            T dest;
+            int weight;
+            size_t order;
+        };
+        vector<Entry> entries;
+        entries.reserve(edges.size());
+        for (size_t i = 0; i < edges.size(); i++) {
+            const auto& [src, dest, weight] = edges[i];
+            if (!isDirected && dest < src) {
+                entries.push_back({dest, src, weight, i});
+            } else {
+                entries.push_back({src, dest, weight, i});
+            }
+        }
+        sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            if (a.src < b.src) return true;
+            if (b.src < a.src) return false;
+            if (a.dest < b.dest) return true;
+            if (b.dest < a.dest) return false;
+            return a.order < b.order;
+        });
+
+        vector<tuple<T, T, int>> fresh;
+        fresh.reserve(entries.size());
+        vector<T> existing;
+        for (size_t begin = 0, end; begin < entries.size(); begin = end) {
+            end = begin + 1;
+            while (end < entries.size() && !(entries[begin].src < entries[end].src)) end++;
+
+            // Sorted neighbors already present for this source
+            existing.clear();
+            auto it = adjList.find(entries[begin].src);
+            if (it != adjList.end()) {
+                for (const auto& neighbor : it->second) existing.push_back(neighbor.first);
+                sort(existing.begin(), existing.end());
+            }
+
+            for (size_t i = begin; i < end; i++) {
+                if (i > begin && !(entries[i - 1].dest < entries[i].dest)) continue;
+                if (binary_search(existing.begin(), existing.end(), entries[i].dest)) continue;
+                fresh.emplace_back(entries[i].src, entries[i].dest, entries[i].weight);
+            }
+        }
+        return fresh;
+    }
+
+    /**
+     * Appends edges known to be new, reserving each adjacency vector once
+     */
+    void insertEdges(const vector<tuple<T, T, int>>& fresh) {
+        vector<T> endpoints;
+        endpoints.reserve(2 * fresh.size());
+        for (const auto& [src, dest, weight] : fresh) {
+            endpoints.push_back(src);
+            endpoints.push_back(dest);
+        }
+        sort(endpoints.begin(), endpoints.end());
+        endpoints.erase(unique(endpoints.begin(), endpoints.end()), endpoints.end());
+        for (const auto& vertex : endpoints) addVertex(vertex);
+
+        // fresh is already grouped by source. Undirected graphs also need the
+        // mirrored arcs; a stable sort keeps forward arcs ahead of them,
+        // matching the per-vertex order addEdge would produce.
+        vector<tuple<T, T, int>> mirrored;
+        if (!isDirected) {
+            mirrored.reserve(2 * fresh.size());
+            mirrored = fresh;
+            for (const auto& [src, dest, weight] : fresh) mirrored.emplace_back(dest, src, weight);
+            stable_sort(mirrored.begin(), mirrored.end(), [](const auto& a, const auto& b) {
+                return get<0>(a) < get<0>(b);
+            });
+        }
+        const vector<tuple<T, T, int>>& arcs = isDirected ? fresh : mirrored;
+
+        for (size_t begin = 0, end; begin < arcs.size(); begin = end) {
+            end = begin + 1;
+            while (end < arcs.size() && !(get<0>(arcs[begin]) < get<0>(arcs[end]))) end++;
+            auto& neighbors = adjList[get<0>(arcs[begin])];
+            size_t before = neighbors.size();
+            neighbors.reserve(before + (end - begin));
+            for (size_t i = begin; i < end; i++) {
+                neighbors.push_back({get<1>(arcs[i]), get<2>(arcs[i])});
+            }
+            degrees.change(before, neighbors.size());
+        }
+        if (tracksInEdges()) {
+            for (const auto& [src, dest, weight] : fresh) inList[dest].push_back(src);
+        }
+        // A batch is merged by the next query's rebuild rather than edge by edge
+        if (isDirected) {
+            if (reachesAll == 0) reachesAll = -1;
+        } else if (!fresh.empty()) {
+            components.invalidate();
+        }
+    }
     
 public:
     /**
@@ -52,6 +782,9 @@ public:
             vertices.insert(vertex);
             adjList[vertex] = vector<pair<T, int>>();
             numVertices++;
+            degrees.add(0);
+            if (isDirected) reachesAll = -1;
+            else components.addVertex(vertex);
         }
     }
     
@@ -65,12 +798,42 @@ public:
         addVertex(src);
         addVertex(dest);
         
-        adjList[src].push_back({dest, weight});
+        appendArc(adjList[src], dest, weight);
         if (!isDirected) {
-            adjList[dest].push_back({src, weight});
+            appendArc(adjList[dest], src, weight);
+            components.link(src, dest);
+        } else {
+            if (tracksInEdges()) inList[dest].push_back(src);
+            // New reachability only matters if the answer was "no"
+            if (reachesAll == 0) reachesAll = -1;
         }
     }
 
+    /**
+     * Adds a batch of edges in one pass
+     * The batch is sorted once, repeated pairs collapse to their first
+     * weight, edges already in the graph are skipped, and each adjacency
+     * vector grows by one exact reservation. On undirected graphs (a, b)
+     * and (b, a) are the same edge.
+     * @param edges: (src, dest, weight) triples
+     */
+    virtual void addEdges(span<const tuple<T, T, int>> edges) {
+        insertEdges(freshEdges(edges));
+    }
+
+    /**
+     * Builds a graph from an edge list via addEdges
+     * @param edges: (src, dest, weight) triples
+     * @param directed: Whether graph is directed
+     * @param weighted: Whether graph is weighted
+     */
+    static Graph<T> fromEdgeList(span<const tuple<T, T, int>> edges,
+                                 bool directed = false, bool weighted = false) {
+        Graph<T> graph(directed, weighted);
+        graph.addEdges(edges);
+        return graph;
+    }
+
     /**
      * Deletes a vertex and all edges connected to it
      * @param vertex: The vertex to delete
@@ -85,21 +848,40 @@ public:
         vertices.erase(vertex);
         numVertices--;
 
-        // Remove the vertex's adjacency list entry
-        adjList.erase(vertex);
+        // Remove all edges pointing to this vertex from other vertices.
+        // Undirected adjacency is symmetric and an indexed directed graph
+        // knows its in-edges, so only the affected lists are touched;
+        // otherwise every list has to be scanned.
+        vector<T> sources;
+        if (!isDirected) {
+            for (const auto& neighbor : adjList[vertex]) sources.push_back(neighbor.first);
+        } else if (tracksInEdges()) {
+            auto in = inList.find(vertex);
+            if (in != inList.end()) sources = move(in->second);
+            inList.erase(vertex);
+            for (const auto& neighbor : adjList[vertex]) {
+                if (!(neighbor.first == vertex)) eraseInEdges(neighbor.first, vertex);
+            }
+        }
 
-        // Remove all edges pointing to this vertex from other vertices
-        for (auto& _pair : adjList) {
-            auto& neighbors = _pair.second;
-            neighbors.erase(
-                remove_if(neighbors.begin(), neighbors.end(),
-                         [vertex](const pair<T, int>& p) {
-                             return p.first == vertex;
-                         }),
-                neighbors.end()
-            );
+        if (!isDirected || tracksInEdges()) {
+            sort(sources.begin(), sources.end());
+            sources.erase(unique(sources.begin(), sources.end()), sources.end());
+            for (const auto& src : sources) {
+                if (!(src == vertex)) dropNeighbor(adjList[src], vertex);
+            }
+        } else {
+            for (auto& _pair : adjList) {
+                dropNeighbor(_pair.second, vertex);
+            }
         }
 
+        // Remove the vertex's adjacency list entry
+        auto own = adjList.find(vertex);
+        degrees.remove(own->second.size());
+        adjList.erase(own);
+        connectivityChanged();
+
         return true;
     }
 
@@ -118,31 +900,38 @@ public:
         bool found = false;
 
         // Remove edge from src to dest
-        auto& srcNeighbors = adjList[src];
-        auto it = remove_if(srcNeighbors.begin(), srcNeighbors.end(),
-                           [dest](const pair<T, int>& p) {
-                               return p.first == dest;
-                           });
-        if (it != srcNeighbors.end()) {
-            srcNeighbors.erase(it, srcNeighbors.end());
-            found = true;
-        }
+        found = dropNeighbor(adjList[src], dest);
 
         // For undirected graphs, also remove dest to src
         if (!isDirected) {
-            auto& destNeighbors = adjList[dest];
-            auto it2 = remove_if(destNeighbors.begin(), destNeighbors.end(),
-                                [src](const pair<T, int>& p) {
-                                    return p.first == src;
-                                });
-            if (it2 != destNeighbors.end()) {
-                destNeighbors.erase(it2, destNeighbors.end());
-            }
+            dropNeighbor(adjList[dest], src);
+        } else if (found && tracksInEdges()) {
+            eraseInEdges(dest, src);
         }
 
+        if (found) connectivityChanged();
         return found;
     }
 
+    /**
+     * Enables or disables the reverse adjacency (in-edge) index
+     * While enabled, a directed graph records the source of every in-edge,
+     * so deleteVertex and getInDegree cost O(degree) instead of O(V + E).
+     * Enabling builds the index from the current edges. Undirected graphs
+     * get the same costs without it, so the flag has no effect there.
+     */
+    void setReverseIndex(bool enabled) {
+        reverseIndexed = enabled;
+        inList.clear();
+        if (tracksInEdges()) {
+            for (const auto& pair : adjList) {
+                for (const auto& neighbor : pair.second) inList[neighbor.first].push_back(pair.first);
+            }
+        }
+    }
+
+    bool hasReverseIndex() const { return reverseIndexed; }
+
     /**
      * Joins another graph with this graph (union operation)
      * @param other: The graph to join with
@@ -162,33 +951,17 @@ public:
             addVertex(vertex);
         }
 
-        // Add all edges from other graph
+        // Add all edges from other graph in one batch; addEdges drops the
+        // ones already present. Undirected edges are listed once (src < dest).
+        vector<tuple<T, T, int>> edges;
         for (const auto& pair : other.adjList) {
-            T src = pair.first;
             for (const auto& neighbor : pair.second) {
-                T dest = neighbor.first;
-                int weight = neighbor.second;
-
-                // Check if edge already exists to avoid duplicates
-                bool exists = false;
-                auto it = adjList.find(src);
-                if (it != adjList.end()) {
-                    for (const auto& existing : it->second) {
-                        if (existing.first == dest) {
-                            exists = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (!exists) {
-                    // For undirected graphs, only add if we haven't added reverse
-                    if (isDirected || src < dest) {
-                        addEdge(src, dest, weight);
-                    }
+                if (isDirected || pair.first < neighbor.first) {
+                    edges.emplace_back(pair.first, neighbor.first, neighbor.second);
                 }
             }
         }
+        addEdges(edges);
     }
 
     /**
@@ -199,20 +972,13 @@ public:
     Graph<T> operator+(const Graph<T>& other) const {
         Graph<T> result(this->isDirected, this->isWeighted);
 
-        // Add all vertices and edges from this graph
-        for (const auto& vertex : this->vertices) {
-            result.addVertex(vertex);
-        }
-        for (const auto& pair : this->adjList) {
-            T src = pair.first;
-            for (const auto& neighbor : pair.second) {
-                T dest = neighbor.first;
-                int weight = neighbor.second;
-                if (isDirected || src < dest) {
-                    result.addEdge(src, dest, weight);
-                }
-            }
-        }
+        // Start from a copy of this graph's vertices and edges
+        result.vertices = this->vertices;
+        result.adjList = this->adjList;
+        result.numVertices = this->numVertices;
+        result.degrees = this->degrees;
+        result.components = this->components;
+        result.setReverseIndex(this->reverseIndexed);
 
         // Join with other graph
         result.join(other);
@@ -232,15 +998,14 @@ public:
         }
 
         vector<T> traversal;
-        set<T> visited;
+        auto ids = idRange();
+        graph_detail::AdjacencyIndex<T> adjacency(adjList, ids);
+        graph_detail::VertexTable<T, int> level(ids, -1);           // -1: not reached yet
+        graph_detail::VertexTable<T, vector<T>> children(ids, {});  // BFS tree, for printing
         queue<T> q;
-        map<T, T> parent;  // For path tracking
-        map<T, int> level;  // For level tracking
 
         q.push(start);
-        visited.insert(start);
-        parent[start] = start;
-        level[start] = 0;
+        level.put(start, 0);
 
         // Print header
         cprint(use_colored_output, "\n╔════════════════════════════════════════╗\n",
@@ -255,10 +1020,11 @@ public:
         cout << "\n\n";
 
         int step = 0;
+        [[maybe_unused]] uint64_t relaxed = 0;
         while (!q.empty()) {
             int levelSize = q.size();
 
-            cprint(use_colored_output, "Level " + to_string(level[q.front()]) + ": ",
+            cprint(use_colored_output, "Level " + to_string(level.get(q.front())) + ": ",
                    BRIGHT_YELLOW, true);
 
             for (int i = 0; i < levelSize; i++) {
@@ -273,13 +1039,12 @@ public:
                 cprint(use_colored_output, "]", BRIGHT_WHITE);
 
                 // Explore neighbors
-                auto it = adjList.find(current);
-                if (it != adjList.end()) {
-                    for (const auto& neighbor : it->second) {
-                        if (visited.find(neighbor.first) == visited.end()) {
-                            visited.insert(neighbor.first);
-                            parent[neighbor.first] = current;
-                            level[neighbor.first] = level[current] + 1;
+                if (const auto* neighbors = adjacency.of(current)) {
+                    SNAZZYDEETS_STAT(relaxed += neighbors->size());
+                    for (const auto& neighbor : *neighbors) {
+                        if (!level.has(neighbor.first)) {
+                            level.put(neighbor.first, level.get(current) + 1);
+                            children[current].push_back(neighbor.first);
                             q.push(neighbor.first);
                         }
                     }
@@ -287,12 +1052,15 @@ public:
             }
             cout << "\n";
         }
+        SNAZZYDEETS_STAT(counters.recordTraversal("Graph", relaxed));
 
         // Print tree structure
         cout << "\n";
         cprint(use_colored_output, "BFS Tree Structure:\n", BRIGHT_GREEN, true);
         cprint(use_colored_output, "───────────────────\n", BRIGHT_GREEN);
-        printBFSTree(start, parent, level, use_colored_output);
+        printTree(start, children, use_colored_output, [&level](const T& vertex, int) {
+            return " (L" + to_string(level.get(vertex)) + ")\n";
+        });
 
         // Print summary
         cout << "\n";
@@ -310,6 +1078,21 @@ public:
         return traversal;
     }
 
+    /**
+     * Parallel, direction-optimizing BFS (quiet, no printing)
+     * Freezes the graph and expands each level across numThreads workers
+     * @param start: Starting vertex for BFS
+     * @param numThreads: Worker count (0 = hardware concurrency)
+     * @return Reachable vertices ordered by level, sorted within a level
+     * Use freeze().parallelBFSDistances() for a per-vertex distance array
+     */
+    vector<T> parallelBFS(T start, unsigned numThreads = 0) const {
+        if (vertices.find(start) == vertices.end()) {
+            throw invalid_argument("Start vertex not found in graph");
+        }
+        return freeze().parallelBFS(start, numThreads);
+    }
+
     /**
      * Performs Depth-First Search traversal from a starting vertex
      * @param start: Starting vertex for DFS
@@ -322,10 +1105,11 @@ public:
         }
 
         vector<T> traversal;
-        set<T> visited;
-        map<T, int> discoveryTime;
-        map<T, int> finishTime;
-        map<T, T> parent;
+        auto ids = idRange();
+        graph_detail::AdjacencyIndex<T> adjacency(adjList, ids);
+        graph_detail::VertexTable<T, int> discoveryTime(ids, 0);    // 0: not visited yet
+        graph_detail::VertexTable<T, int> finishTime(ids, 0);
+        graph_detail::VertexTable<T, vector<T>> children(ids, {});  // DFS tree, for printing
         int time = 0;
 
         // Print header
@@ -340,17 +1124,17 @@ public:
         cprint(use_colored_output, start, BRIGHT_BLUE);
         cout << "\n\n";
 
-        parent[start] = start;
-
         // Perform DFS
-        DFSUtil(start, visited, traversal, discoveryTime, finishTime,
-                parent, time, use_colored_output);
+        DFSUtil(start, adjacency, traversal, discoveryTime, finishTime,
+                children, time, use_colored_output);
 
         // Print DFS tree
         cout << "\n";
         cprint(use_colored_output, "DFS Tree Structure:\n", BRIGHT_GREEN, true);
         cprint(use_colored_output, "───────────────────\n", BRIGHT_GREEN);
-        printDFSTree(start, parent, 0, use_colored_output, set<T>());
+        printTree(start, children, use_colored_output, [](const T&, int depth) {
+            return " (depth " + to_string(depth) + ")\n";
+        });
 
         // Print summary
         cout << "\n";
@@ -374,48 +1158,116 @@ public:
      * @param use_colored_output: Enable colored output (default: false)
      */
     virtual void display(bool use_colored_output = false) const {
+        displayTo(cout, use_colored_output);
+    }
+
+    /**
+     * What display() prints, into any stream or chunk callback through
+     * one buffer; subclasses add their banner through writeDisplay
+     */
+    void displayTo(output::Target target, bool use_colored_output = false) const {
+        output::Writer w(std::move(target), use_colored_output);
+        writeDisplay(w);
+    }
+
+protected:
+    /**
+     * Writes the adjacency list. Subclasses override it to put their
+     * header first, then call this one.
+     */
+    virtual void writeDisplay(output::Writer& w) const {
         if (vertices.empty()) {
-            cprint(use_colored_output, "  Empty Graph\n", BRIGHT_WHITE, true);
+            w.paint("  Empty Graph\n", BRIGHT_WHITE, true);
             return;
         }
         
-        cprint(use_colored_output, "Graph (Adjacency List", BRIGHT_WHITE, true);
-        if (isDirected) cprint(use_colored_output, " for directed", BRIGHT_GREEN);
-        if (isWeighted) cprint(use_colored_output, " & weighted", YELLOW);
-        cprint(use_colored_output, " graph):\n", BRIGHT_WHITE, true);
-        cprint(use_colored_output, "-----------------------\n", BRIGHT_WHITE);
+        w.paint("Graph (Adjacency List", BRIGHT_WHITE, true);
+        if (isDirected) w.paint(" for directed", BRIGHT_GREEN);
+        if (isWeighted) w.paint(" & weighted", YELLOW);
+        w.paint(" graph):\n", BRIGHT_WHITE, true);
+        w.paint("-----------------------\n", BRIGHT_WHITE);
         
-        for (const auto& vertex : vertices) {
-            cprint(use_colored_output, "  ", RESET);
-            cprint(use_colored_output, vertex, BLUE);
+        for (const auto& [vertex, neighbors] : adjList) {
+            w.paint("  ", RESET);
+            w.paint(vertex, BLUE);
             
-            if (adjList.at(vertex).empty()) {
-                cprint(use_colored_output, " --> ", isDirected ? BRIGHT_GREEN : BRIGHT_YELLOW);
-                cprint(use_colored_output, "∅\n", BRIGHT_RED);
-            } else {
-                if (isDirected) {
-                    cprint(use_colored_output, " -->", BRIGHT_GREEN);
-                } else {
-                    cprint(use_colored_output, " ---", BRIGHT_YELLOW);
-                }
-                
-                bool first = true;
-                for (const auto& neighbor : adjList.at(vertex)) {
-                    if (!first) cprint(use_colored_output, ",", BRIGHT_WHITE);
-                    
-                    if (isWeighted) {
-                        cprint(use_colored_output, " (", YELLOW);
-                        cprint(use_colored_output, neighbor.second, CYAN);
-                        cprint(use_colored_output, ")---> ", YELLOW);
-                    } else {
-                        cprint(use_colored_output, " ", RESET);
-                    }
-                    cprint(use_colored_output, neighbor.first, BLUE);
-                    first = false;
+            if (neighbors.empty()) {
+                w.paint(" --> ", isDirected ? BRIGHT_GREEN : BRIGHT_YELLOW);
+                w.paint("∅\n", BRIGHT_RED);
+                continue;
+            }
+            w.paint(isDirected ? " -->" : " ---", isDirected ? BRIGHT_GREEN : BRIGHT_YELLOW);
+            
+            bool first = true;
+            for (const auto& neighbor : neighbors) {
+                if (!first) w.paint(",", BRIGHT_WHITE);
+                
+                if (isWeighted) {
+                    w.paint(" (", YELLOW);
+                    w.paint(neighbor.second, CYAN);
+                    w.paint(")---> ", YELLOW);
+                } else {
+                    w.paint(" ", RESET);
                 }
-                cout << endl;
+                w.paint(neighbor.first, BLUE);
+                first = false;
             }
+            w << '\n';
+        }
+    }
+
+public:
+    /**
+     * Graphviz DOT: "digraph" for directed graphs, "graph" otherwise
+     * Undirected edges are written once; weights become weight and label
+     */
+    void exportDOT(output::Target target) const {
+        output::Writer w(std::move(target));
+        w << (isDirected ? "digraph G {\n" : "graph G {\n");
+        for (const auto& vertex : vertices) {
+            w << "  ";
+            output::writeDOTId(w, vertex);
+            w << ";\n";
         }
+        const char* arrow = isDirected ? " -> " : " -- ";
+        forEachExportedEdge([&](const T& src, const T& dest, int weight) {
+            w << "  ";
+            output::writeDOTId(w, src);
+            w << arrow;
+            output::writeDOTId(w, dest);
+            if (isWeighted) w << " [weight=" << weight << ", label=\"" << weight << "\"]";
+            w << ";\n";
+        });
+        w << "}\n";
+    }
+
+    /**
+     * JSON: {"directed": b, "weighted": b, "vertices": [...],
+     *        "edges": [{"source": u, "target": v, "weight": w}, ...]}
+     * Undirected edges are listed once; "weight" only on weighted graphs
+     */
+    void exportJSON(output::Target target) const {
+        output::Writer w(std::move(target));
+        w << "{\"directed\":" << (isDirected ? "true" : "false")
+          << ",\"weighted\":" << (isWeighted ? "true" : "false") << ",\"vertices\":[";
+        bool first = true;
+        for (const auto& vertex : vertices) {
+            if (!first) w << ',';
+            output::writeJSONValue(w, vertex);
+            first = false;
+        }
+        w << "],\"edges\":[";
+        first = true;
+        forEachExportedEdge([&](const T& src, const T& dest, int weight) {
+            w << (first ? "{\"source\":" : ",{\"source\":");
+            output::writeJSONValue(w, src);
+            w << ",\"target\":";
+            output::writeJSONValue(w, dest);
+            if (isWeighted) w << ",\"weight\":" << weight;
+            w << '}';
+            first = false;
+        });
+        w << "]}\n";
     }
     
     /**
@@ -426,49 +1278,99 @@ public:
     
     /**
      * Gets the number of edges in the graph
+     * O(1): read from the degree histogram
      * @return Number of edges
      */
     int getNumEdges() const {
-        int count = 0;
-        for (const auto& pair : adjList) {
-            count += pair.second.size();
-        }
-        return isDirected ? count : count / 2;
+        size_t count = degrees.degreeSum();
+        return static_cast<int>(isDirected ? count : count / 2);
     }
+
+    /**
+     * Number of vertices with each degree (out-degree when directed):
+     * entry d counts the vertices of degree d, up to the maximum degree.
+     * Maintained by every edit, so this is a copy, not a scan.
+     */
+    vector<size_t> getDegreeHistogram() const { return degrees.buckets(); }
     
     /**
-     * Checks if the graph is connected using BFS
+     * Checks if the graph is connected
+     * Undirected: O(1) from the incremental union-find, except the first
+     * call after a deletion, which rebuilds it in O(V + E).
+     * Directed: whether every vertex is reachable from the smallest one,
+     * found by BFS and cached until an edit can change the answer.
+     * The caches are filled under a lock, so concurrent calls on a const
+     * graph are safe.
      * @return True if graph is connected
      */
     bool isConnected() const {
         if (vertices.empty()) return true;
-        
-        set<T> visited;
-        queue<T> q;
-        T start = *vertices.begin();
-        q.push(start);
-        visited.insert(start);
-        
-        while (!q.empty()) {
-            T vertex = q.front();
-            q.pop();
-            
-            for (const auto& neighbor : adjList.at(vertex)) {
-                if (visited.find(neighbor.first) == visited.end()) {
-                    visited.insert(neighbor.first);
-                    q.push(neighbor.first);
-                }
-            }
-        }
-        
-        return visited.size() == vertices.size();
+        if (!isDirected) return connectivity().size() <= 1;
+        lock_guard<mutex> guard(cacheMutex.lock);
+        if (reachesAll < 0) reachesAll = reachesAllFromFirst() ? 1 : 0;
+        return reachesAll == 1;
     }
-    
+
     /**
      * Gets all vertices in the graph
      * @return Set of vertices
      */
     set<T> getVertices() const { return vertices; }
+
+    /**
+     * Takes an immutable, cache-friendly snapshot of the graph
+     * Vertices get dense integer IDs (in sorted order) and adjacency is
+     * packed into contiguous offset/target/weight arrays (CSR layout)
+     * @return CSRGraph snapshot; later edits to this graph are not reflected
+     */
+    CSRGraph<T> freeze() const {
+        return CSRGraph<T>(vertices, adjList, isDirected, isWeighted);
+    }
+
+    /**
+     * Writes the graph as a binary CSR snapshot (see CSRGraph::saveSnapshot)
+     * Open it read-only with CSRGraphView<T> to skip rebuilding altogether
+     * @param path: File to create or overwrite
+     */
+    void saveSnapshot(const string& path) const
+        requires snapshot::Storable<T>
+    {
+        freeze().saveSnapshot(path);
+    }
+
+    /**
+     * Replaces this graph's vertices and edges with a snapshot's contents
+     * Vertices arrive sorted, so the vertex set and adjacency map are filled
+     * by appending at the end instead of one lookup-and-insert per edge
+     * @param path: Snapshot written by saveSnapshot
+     * @throws logic_error: If the snapshot's directed/weighted flags differ from this graph's
+     * @throws snapshot::SnapshotError: If the file cannot be read
+     */
+    void loadSnapshot(const string& path)
+        requires snapshot::Storable<T>
+    {
+        CSRGraph<T> csr = CSRGraph<T>::loadSnapshot(path);
+        if (csr.directedGraph() != isDirected || csr.weightedGraph() != isWeighted) {
+            throw logic_error("Snapshot direction/weighting does not match this graph");
+        }
+        const vector<T>& order = csr.getVertices();
+        vertices.clear();
+        adjList.clear();
+        for (int id = 0; id < csr.getNumVertices(); id++) {
+            vertices.emplace_hint(vertices.end(), order[id]);
+            span<const int> targets = csr.neighbors(id);
+            span<const int> weights = csr.neighborWeights(id);
+            vector<pair<T, int>> neighbors;
+            neighbors.reserve(targets.size());
+            for (size_t e = 0; e < targets.size(); e++) {
+                neighbors.emplace_back(order[targets[e]], weights[e]);
+            }
+            adjList.emplace_hint(adjList.end(), order[id], std::move(neighbors));
+        }
+        numVertices = csr.getNumVertices();
+        rebuildMetadata();
+        setReverseIndex(reverseIndexed);
+    }
     
     /**
      * Gets the degree of a specified vertex
@@ -505,6 +1407,10 @@ public:
         if (!isDirected) {
             return getDegree(vertex);  // Same as degree for undirected
         }
+        if (tracksInEdges()) {
+            auto it = inList.find(vertex);
+            return it == inList.end() ? 0 : static_cast<int>(it->second.size());
+        }
         
         int inDegree = 0;
         for (const auto& pair : adjList) {
@@ -519,32 +1425,20 @@ public:
     
     /**
      * Gets the minimum degree among all vertices (Graph Radius)
+     * O(min degree) from the degree histogram
      * @return Minimum vertex degree
      */
     int getMinDegree() const {
-        if (vertices.empty()) return 0;
-        
-        int minDeg = INT_MAX;
-        for (const auto& vertex : vertices) {
-            int deg = getDegree(vertex);
-            minDeg = min(minDeg, deg);
-        }
-        return minDeg;
+        return static_cast<int>(degrees.minDegree());
     }
     
     /**
      * Gets the maximum degree among all vertices (Graph Diameter in terms of degree)
+     * O(1) from the degree histogram
      * @return Maximum vertex degree
      */
     int getMaxDegree() const {
-        if (vertices.empty()) return 0;
-        
-        int maxDeg = 0;
-        for (const auto& vertex : vertices) {
-            int deg = getDegree(vertex);
-            maxDeg = max(maxDeg, deg);
-        }
-        return maxDeg;
+        return static_cast<int>(degrees.maxDegree());
     }
     
     /**
@@ -561,13 +1455,13 @@ public:
         
         if (src == dest) return 0;
         
-        map<T, int> distance;
+        auto ids = idRange();
+        graph_detail::VertexTable<T, int> distance(ids, -1);  // -1: not reached yet
         queue<T> q;
-        set<T> visited;
+        [[maybe_unused]] uint64_t relaxed = 0;
         
         q.push(src);
-        visited.insert(src);
-        distance[src] = 0;
+        distance.put(src, 0);
         
         while (!q.empty()) {
             T current = q.front();
@@ -576,366 +1470,1713 @@ public:
             auto it = adjList.find(current);
             if (it != adjList.end()) {
                 for (const auto& neighbor : it->second) {
-                    if (visited.find(neighbor.first) == visited.end()) {
-                        visited.insert(neighbor.first);
-                        distance[neighbor.first] = distance[current] + 1;
+                    SNAZZYDEETS_STAT(++relaxed);
+                    if (!distance.has(neighbor.first)) {
+                        int d = distance.put(neighbor.first, distance.get(current) + 1);
                         q.push(neighbor.first);
                         
                         if (neighbor.first == dest) {
-                            return distance[neighbor.first];
+                            SNAZZYDEETS_STAT(counters.recordTraversal("Graph", relaxed));
+                            return d;
                         }
                     }
                 }
             }
         }
         
+        SNAZZYDEETS_STAT(counters.recordTraversal("Graph", relaxed));
         return -1;  // No path exists
     }
+
+    /**
+     * Traversal counters. All zero unless built with SNAZZYDEETS_STATS.
+     */
+    GraphStats stats() const {
+#ifdef SNAZZYDEETS_STATS
+        return counters;
+#else
+        return GraphStats{};
+#endif
+    }
+
+    void resetStats() {
+#ifdef SNAZZYDEETS_STATS
+        counters = GraphStats{};
+#endif
+    }
     
     /**
      * Calculates the graph diameter (maximum shortest path between any two vertices)
+     * Hop count, consistent with getDistance; one BFS per source
      * @return Graph diameter, -1 if graph is disconnected
      */
     int getDiameter() const {
-        if (vertices.empty()) return 0;
-        if (vertices.size() == 1) return 0;
+        if (vertices.size() <= 1) return 0;
+        return static_cast<int>(freeze().computeEccentricities(false).diameter);
+    }
+    
+    /**
+     * Calculates the graph radius (minimum eccentricity among all vertices)
+     * Eccentricity of a vertex = maximum distance from it to any other vertex
+     * @return Graph radius, -1 if graph is disconnected
+     */
+    int getRadius() const {
+        if (vertices.size() <= 1) return 0;
+        return static_cast<int>(freeze().computeEccentricities(false).radius);
+    }
+
+    /**
+     * Computes eccentricity, diameter, radius, center and periphery in one pass
+     * Runs one shortest-path search per source: Dijkstra on weighted graphs,
+     * BFS otherwise
+     * @param numThreads: Worker threads to spread sources over (0 = all cores)
+     * @return GraphMetrics with per-vertex eccentricity in sorted vertex order
+     */
+    GraphMetrics<T> getEccentricities(unsigned numThreads = 1) const {
+        return freeze().computeEccentricities(isWeighted, numThreads);
+    }
+    
+    /**
+     * Calculates the girth (length of shortest cycle) of the graph
+     * Also known as circumference when referring to smallest cycle
+     * @return Girth of the graph, -1 if no cycle exists, INT_MAX if acyclic
+     */
+    int getGirth() const {
+        if (vertices.empty()) return -1;
+        
+        int girth = INT_MAX;
+        auto ids = idRange();
+        graph_detail::AdjacencyIndex<T> adjacency(adjList, ids);
+        graph_detail::VertexTable<T, int> distance(ids, -1);  // reset per start
         
-        int diameter = 0;
+        // For each vertex, do BFS and find shortest cycle through it
+        for (const auto& start : vertices) {
+            distance.reset();
+            queue<pair<T, T>> q;  // (current vertex, parent vertex)
+            
+            distance.put(start, 0);
+            
+            if (const auto* neighbors = adjacency.of(start)) {
+                for (const auto& neighbor : *neighbors) {
+                    q.push({neighbor.first, start});
+                    distance.put(neighbor.first, 1);
+                }
+            }
+            
+            while (!q.empty()) {
+                T current = q.front().first;
+                T parent = q.front().second;
+                q.pop();
+                
+                if (const auto* neighbors = adjacency.of(current)) {
+                    for (const auto& neighbor : *neighbors) {
+                        if (!distance.has(neighbor.first)) {
+                            distance.put(neighbor.first, distance.get(current) + 1);
+                            q.push({neighbor.first, current});
+                        } else if (neighbor.first != parent) {
+                            // Found a cycle
+                            int cycleLength = distance.get(current) + distance.get(neighbor.first) + 1;
+                            girth = min(girth, cycleLength);
+                        }
+                    }
+                }
+            }
+        }
         
-        for (const auto& src : vertices) {
-            for (const auto& dest : vertices) {
-                if (src != dest) {
-                    int dist = getDistance(src, dest);
-                    if (dist == -1) {
-                        return -1;  // Graph is disconnected
+        return (girth == INT_MAX) ? -1 : girth;
+    }
+    
+    /**
+     * Strongly connected components (Tarjan), on explicit stacks
+     * Components come in reverse topological order: each is listed before
+     * every component that has an edge into it. Within a component,
+     * vertices are in the order they leave Tarjan's stack. On an undirected
+     * graph the components are the connected components.
+     * Time Complexity: O(V + E)
+     */
+    vector<vector<T>> stronglyConnectedComponents() const {
+        struct Frame {
+            T vertex;
+            const vector<pair<T, int>>* neighbors;
+            size_t next;
+        };
+        auto ids = idRange();
+        graph_detail::AdjacencyIndex<T> adjacency(adjList, ids);
+        graph_detail::VertexTable<T, int> index(ids, -1);  // discovery order, -1: unvisited
+        graph_detail::VertexTable<T, int> low(ids, -1);    // lowest index reachable in the subtree
+        graph_detail::VertexTable<T, char> onStack(ids, 0);
+        graph_detail::ScratchStack<Frame> calls;
+        graph_detail::ScratchStack<T> pending;             // Tarjan's stack of open vertices
+        vector<vector<T>> components;
+        int counter = 0;
+
+        auto visit = [&](const T& vertex) {
+            index.put(vertex, counter);
+            low.put(vertex, counter);
+            counter++;
+            pending.push(vertex);
+            onStack.put(vertex, 1);
+            calls.push({vertex, adjacency.of(vertex), 0});
+        };
+
+        for (const auto& root : vertices) {
+            if (index.has(root)) continue;
+            visit(root);
+            while (!calls.empty()) {
+                Frame& frame = calls.top();
+                if (frame.neighbors && frame.next < frame.neighbors->size()) {
+                    const T& neighbor = (*frame.neighbors)[frame.next++].first;
+                    if (!index.has(neighbor)) {
+                        visit(neighbor);
+                    } else if (onStack.has(neighbor)) {
+                        low[frame.vertex] = min(low.get(frame.vertex), index.get(neighbor));
                     }
-                    diameter = max(diameter, dist);
+                    continue;
+                }
+
+                T vertex = frame.vertex;
+                calls.pop();
+                if (low.get(vertex) == index.get(vertex)) {
+                    vector<T> component;
+                    T member;
+                    do {
+                        member = pending.top();
+                        pending.pop();
+                        onStack.erase(member);
+                        component.push_back(member);
+                    } while (!(member == vertex));
+                    components.push_back(std::move(component));
+                }
+                if (!calls.empty()) {
+                    T parent = calls.top().vertex;
+                    low[parent] = min(low.get(parent), low.get(vertex));
+                }
+            }
+        }
+        return components;
+    }
+    
+    /**
+     * Gets the circumference (length of longest cycle) of the graph
+     * @return Circumference of the graph, -1 if no cycle exists
+     */
+    int getCircumference() const {
+        if (vertices.empty()) return -1;
+        
+        int circumference = 0;
+        auto ids = idRange();
+        graph_detail::AdjacencyIndex<T> adjacency(adjList, ids);
+        graph_detail::VertexTable<T, char> onPath(ids, 0);  // empty again after each search
+        
+        // For each vertex, do DFS to find longest cycle
+        for (const auto& start : vertices) {
+            circumference = max(circumference, 
+                               dfsLongestCycle(start, adjacency, onPath));
+        }
+        
+        return (circumference == 0) ? -1 : circumference;
+    }
+    
+    /**
+     * Displays comprehensive graph properties
+     * @param use_colored_output: Enable colored output (default: false)
+     */
+    void displayProperties(bool use_colored_output = false) const {
+        cprint(use_colored_output, "\n=== Graph Properties ===\n", BRIGHT_WHITE, true);
+        
+        cprint(use_colored_output, "Number of Vertices: ", BRIGHT_WHITE, true);
+        cprint(use_colored_output, to_string(getNumVertices()) + "\n", BRIGHT_BLUE);
+        
+        cprint(use_colored_output, "Number of Edges: ", BRIGHT_WHITE, true);
+        cprint(use_colored_output, to_string(getNumEdges()) + "\n", BRIGHT_BLUE);
+        
+        if (!vertices.empty()) {
+            cprint(use_colored_output, "Minimum Degree (Min vertex connections): ", BRIGHT_WHITE, true);
+            cprint(use_colored_output, to_string(getMinDegree()) + "\n", BRIGHT_CYAN);
+            
+            cprint(use_colored_output, "Maximum Degree (Max vertex connections): ", BRIGHT_WHITE, true);
+            cprint(use_colored_output, to_string(getMaxDegree()) + "\n", BRIGHT_CYAN);
+            
+            GraphMetrics<T> metrics = freeze().computeEccentricities(false);
+            int radius = static_cast<int>(metrics.radius);
+            cprint(use_colored_output, "Graph Radius (Min eccentricity): ", BRIGHT_WHITE, true);
+            if (radius == -1) {
+                cprint(use_colored_output, "Undefined (disconnected)\n", BRIGHT_RED);
+            } else {
+                cprint(use_colored_output, to_string(radius) + "\n", BRIGHT_GREEN);
+            }
+            
+            int diameter = static_cast<int>(metrics.diameter);
+            cprint(use_colored_output, "Graph Diameter (Max shortest path): ", BRIGHT_WHITE, true);
+            if (diameter == -1) {
+                cprint(use_colored_output, "Undefined (disconnected)\n", BRIGHT_RED);
+            } else {
+                cprint(use_colored_output, to_string(diameter) + "\n", BRIGHT_GREEN);
+            }
+            
+            int girth = getGirth();
+            cprint(use_colored_output, "Girth (Shortest cycle): ", BRIGHT_WHITE, true);
+            if (girth == -1) {
+                cprint(use_colored_output, "No cycle (Acyclic)\n", BRIGHT_YELLOW);
+            } else {
+                cprint(use_colored_output, to_string(girth) + "\n", BRIGHT_MAGNETA);
+            }
+            
+            int circumference = getCircumference();
+            cprint(use_colored_output, "Circumference (Longest cycle): ", BRIGHT_WHITE, true);
+            if (circumference == -1) {
+                cprint(use_colored_output, "No cycle (Acyclic)\n", BRIGHT_YELLOW);
+            } else {
+                cprint(use_colored_output, to_string(circumference) + "\n", BRIGHT_MAGNETA);
+            }
+        }
+        
+        cprint(use_colored_output, "Connected: ", BRIGHT_WHITE, true);
+        if (isConnected()) {
+            cprint(use_colored_output, "Yes\n", BRIGHT_GREEN);
+        } else {
+            cprint(use_colored_output, "No\n", BRIGHT_RED);
+        }
+        
+        cprint(use_colored_output, "========================\n", BRIGHT_WHITE, true);
+        cout << endl;
+    }
+    
+    virtual ~Graph() {}
+
+private:
+    /**
+     * BFS from the smallest vertex, for directed isConnected()
+     */
+    bool reachesAllFromFirst() const {
+        auto ids = idRange();
+        graph_detail::AdjacencyIndex<T> adjacency(adjList, ids);
+        graph_detail::VertexTable<T, char> visited(ids, 0);
+        size_t reached = 1;
+        queue<T> q;
+        T start = *vertices.begin();
+        q.push(start);
+        visited.put(start, 1);
+        
+        while (!q.empty()) {
+            T vertex = q.front();
+            q.pop();
+            
+            const auto* neighbors = adjacency.of(vertex);
+            if (!neighbors) continue;
+            for (const auto& neighbor : *neighbors) {
+                if (!visited.has(neighbor.first)) {
+                    visited.put(neighbor.first, 1);
+                    reached++;
+                    q.push(neighbor.first);
                 }
             }
         }
         
-        return diameter;
+        return reached == vertices.size();
+    }
+
+    /**
+     * DFS traversal with timing, on an explicit stack
+     * Prints each vertex when discovered and when finished, in the order
+     * the recursive definition would
+     */
+    void DFSUtil(T start, const graph_detail::AdjacencyIndex<T>& adjacency, vector<T>& traversal,
+                 graph_detail::VertexTable<T, int>& discoveryTime,
+                 graph_detail::VertexTable<T, int>& finishTime,
+                 graph_detail::VertexTable<T, vector<T>>& children,
+                 int& time, bool use_colored_output) const {
+        struct Frame {
+            T vertex;
+            const vector<pair<T, int>>* neighbors;
+            size_t next;
+        };
+        graph_detail::ScratchStack<Frame> stack;
+
+        auto discover = [&](const T& vertex) {
+            traversal.push_back(vertex);
+            discoveryTime.put(vertex, ++time);
+
+            // Print discovery
+            cprint(use_colored_output, "  Discovered: ", BRIGHT_WHITE);
+            cprint(use_colored_output, "[", BRIGHT_WHITE);
+            cprint(use_colored_output, vertex, BRIGHT_BLUE);
+            cprint(use_colored_output, "]", BRIGHT_WHITE);
+            cprint(use_colored_output, " at time ", BRIGHT_WHITE);
+            cprint(use_colored_output, to_string(discoveryTime.get(vertex)), BRIGHT_CYAN);
+
+            const auto* neighbors = adjacency.of(vertex);
+            if (neighbors) {
+                cprint(use_colored_output, " → Exploring: ", BRIGHT_YELLOW);
+                bool first = true;
+                for (const auto& neighbor : *neighbors) {
+                    if (!first) cprint(use_colored_output, ", ", BRIGHT_WHITE);
+                    cprint(use_colored_output, neighbor.first,
+                           !discoveryTime.has(neighbor.first) ?
+                           BRIGHT_GREEN : BRIGHT_RED);
+                    first = false;
+                }
+            }
+            cout << "\n";
+            stack.push({vertex, neighbors, 0});
+        };
+
+        discover(start);
+        while (!stack.empty()) {
+            Frame& frame = stack.top();
+
+            // Next unvisited neighbor becomes a tree child
+            if (frame.neighbors && frame.next < frame.neighbors->size()) {
+                const T& neighbor = (*frame.neighbors)[frame.next++].first;
+                if (!discoveryTime.has(neighbor)) {
+                    children[frame.vertex].push_back(neighbor);
+                    discover(neighbor);
+                }
+                continue;
+            }
+
+            finishTime.put(frame.vertex, ++time);
+
+            // Print finish
+            cprint(use_colored_output, "  Finished:   ", BRIGHT_WHITE);
+            cprint(use_colored_output, "[", BRIGHT_WHITE);
+            cprint(use_colored_output, frame.vertex, BRIGHT_BLUE);
+            cprint(use_colored_output, "]", BRIGHT_WHITE);
+            cprint(use_colored_output, " at time ", BRIGHT_WHITE);
+            cprint(use_colored_output, to_string(finishTime.get(frame.vertex)) + "\n", BRIGHT_CYAN);
+            stack.pop();
+        }
+    }
+
+    /**
+     * Prints a BFS/DFS tree preorder with box-drawing branches, children
+     * sorted. One prefix string is shared by the whole walk: each stack
+     * entry records how much of it belongs to its parent.
+     * @param label: (vertex, depth) -> text printed after [vertex]
+     */
+    template<typename Label>
+    void printTree(const T& root, const graph_detail::VertexTable<T, vector<T>>& tree,
+                   bool use_colored_output, Label label) const {
+        struct Frame {
+            T vertex;
+            int depth;
+            size_t prefixLength;
+            bool isLast;
+        };
+        graph_detail::ScratchStack<Frame> stack;
+        string prefix;
+        stack.push({root, 0, 0, true});
+        while (!stack.empty()) {
+            Frame frame = stack.top();
+            stack.pop();
+            prefix.resize(frame.prefixLength);
+
+            // Print current vertex
+            cprint(use_colored_output, prefix, BRIGHT_WHITE);
+            cprint(use_colored_output, frame.isLast ? "└── " : "├── ", BRIGHT_GREEN);
+            cprint(use_colored_output, "[", YELLOW);
+            cprint(use_colored_output, frame.vertex, BRIGHT_BLUE);
+            cprint(use_colored_output, "]", YELLOW);
+            cprint(use_colored_output, label(frame.vertex, frame.depth), BRIGHT_YELLOW);
+
+            // Sort children for consistent output; push last first so the
+            // first child is printed next
+            vector<T> children = tree.get(frame.vertex);
+            sort(children.begin(), children.end());
+            prefix += frame.isLast ? "    " : "│   ";
+            for (size_t i = children.size(); i-- > 0;) {
+                stack.push({children[i], frame.depth + 1, prefix.size(), i == children.size() - 1});
+            }
+        }
+    }
+
+    /**
+     * Longest simple cycle through start: exhaustive DFS over simple paths
+     * on an explicit stack (onPath marks the current path and is empty
+     * again on return)
+     */
+    int dfsLongestCycle(T start, const graph_detail::AdjacencyIndex<T>& adjacency,
+                        graph_detail::VertexTable<T, char>& onPath) const {
+        struct Frame {
+            T vertex;
+            const vector<pair<T, int>>* neighbors;
+            size_t next;
+        };
+        graph_detail::ScratchStack<Frame> stack;
+        int maxCycle = 0;
+
+        onPath.put(start, 1);
+        stack.push({start, adjacency.of(start), 0});
+        while (!stack.empty()) {
+            Frame& frame = stack.top();
+            if (!frame.neighbors || frame.next == frame.neighbors->size()) {
+                onPath.erase(frame.vertex);
+                stack.pop();
+                continue;
+            }
+            const T& neighbor = (*frame.neighbors)[frame.next++].first;
+            int dist = static_cast<int>(stack.size()) - 1;  // edges from start to frame.vertex
+            if (neighbor == start && dist > 1) {
+                // Found a cycle back to start
+                maxCycle = max(maxCycle, dist + 1);
+            } else if (!onPath.has(neighbor)) {
+                onPath.put(neighbor, 1);
+                stack.push({neighbor, adjacency.of(neighbor), 0});
+            }
+        }
+        return maxCycle;
+    }
+};
+
+// ============================================================================
+// COMPACT CSR SNAPSHOT
+// ============================================================================
+
+/**
+ * Read-only Compressed Sparse Row snapshot of a Graph<T>
+ * Obtained through Graph<T>::freeze(). Vertices are mapped to dense IDs
+ * 0..V-1 (in sorted order) and the neighbors of vertex i are
+ * targets[offsets[i] .. offsets[i+1]), with matching weights.
+ * Algorithms work on integer IDs and flat arrays instead of map/set lookups,
+ * and keep the same neighbor order (and therefore traversal order) as the
+ * source graph.
+ */
+template<typename T>
+class CSRGraph {
+private:
+    vector<T> idToVertex;    // dense ID -> vertex, sorted
+    vector<int> offsets;     // size V + 1
+    vector<int> targets;     // neighbor IDs
+    vector<int> weights;     // parallel to targets
+    vector<int> inOffsets;   // reverse (in-edge) CSR, directed graphs only
+    vector<int> inSources;
+    vector<int> inWeights;   // parallel to inSources
+    bool directed;
+    bool weighted;
+    bool negativeWeights = false;
+    [[no_unique_address]] mutable instrumentation::Slot<GraphStats> counters;
+
+    // Direction-optimizing BFS switch thresholds (Beamer et al.)
+    static constexpr long long BFS_ALPHA = 14;
+    static constexpr long long BFS_BETA = 24;
+    static constexpr size_t BFS_CHUNK = 256;
+
+    int inBegin(int id) const { return directed ? inOffsets[id] : offsets[id]; }
+    int inEnd(int id) const { return directed ? inOffsets[id + 1] : offsets[id + 1]; }
+    int inSource(int e) const { return directed ? inSources[e] : targets[e]; }
+    int inWeight(int e) const { return directed ? inWeights[e] : weights[e]; }
+
+    static constexpr long long UNSETTLED = LLONG_MAX;
+
+    /**
+     * Lazy-deletion d-ary min-heap of (distance, vertex ID) entries
+     * Wider nodes make the tree shallower, trading a few extra compares
+     * per pop for fewer cache misses per push
+     */
+    template<unsigned Arity>
+    class DaryHeap {
+        vector<pair<long long, int>> items;
+
+    public:
+        bool empty() const { return items.empty(); }
+        size_t size() const { return items.size(); }
+        const pair<long long, int>& top() const { return items.front(); }
+
+        void push(long long key, int vertex) {
+            size_t i = items.size();
+            items.push_back({key, vertex});
+            while (i > 0) {
+                size_t p = (i - 1) / Arity;
+                if (items[p] <= items[i]) break;
+                swap(items[p], items[i]);
+                i = p;
+            }
+        }
+
+        pair<long long, int> pop() {
+            pair<long long, int> result = items.front();
+            items.front() = items.back();
+            items.pop_back();
+            size_t i = 0;
+            while (true) {
+                size_t first = i * Arity + 1;
+                if (first >= items.size()) break;
+                size_t last = min(first + Arity, items.size());
+                size_t smallest = first;
+                for (size_t c = first + 1; c < last; c++) {
+                    if (items[c] < items[smallest]) smallest = c;
+                }
+                if (items[i] <= items[smallest]) break;
+                swap(items[i], items[smallest]);
+                i = smallest;
+            }
+            return result;
+        }
+    };
+
+    /**
+     * Throws unless offsets is a non-decreasing 0..E prefix sum and every
+     * entry of ids names a vertex
+     */
+    static void checkAdjacency(span<const int> offsets, span<const int> ids, size_t numV,
+                               const string& path) {
+        bool valid = offsets.size() == numV + 1 && offsets.front() == 0 &&
+                     static_cast<size_t>(offsets.back()) == ids.size();
+        for (size_t i = 0; valid && i < numV; i++) valid = offsets[i] <= offsets[i + 1];
+        for (size_t i = 0; valid && i < ids.size(); i++) {
+            valid = ids[i] >= 0 && static_cast<size_t>(ids[i]) < numV;
+        }
+        if (!valid) {
+            throw snapshot::SnapshotError("'" + path + "' has corrupt adjacency arrays");
+        }
+    }
+
+    // Empty shell filled in by loadSnapshot
+    CSRGraph() : directed(false), weighted(false) {}
+
+    // The mapped view validates its arrays with checkAdjacency too
+    template<typename U>
+        requires snapshot::Storable<U>
+    friend class CSRGraphView;
+
+    int requireId(const T& vertex) const {
+        int id = idOf(vertex);
+        if (id < 0) {
+            throw invalid_argument("Vertex not found in graph");
+        }
+        return id;
+    }
+
+    /**
+     * Validates a shortest-path source/target ID and the edge weights
+     */
+    void requireSearchable(int id) const {
+        if (id < 0 || static_cast<size_t>(id) >= idToVertex.size()) {
+            throw invalid_argument("Vertex not found in graph");
+        }
+        if (negativeWeights) {
+            throw invalid_argument("Shortest paths require non-negative edge weights");
+        }
+    }
+
+    /**
+     * Walks parent links back from dst into a src -> dst path
+     * @return dist, or -1 (with an empty path) if dst was never reached
+     */
+    long long tracePath(int src, int dst, long long dist, const vector<int>& parent,
+                        vector<int>& path) const {
+        path.clear();
+        if (dist == UNSETTLED) return -1;
+        for (int v = dst; v != src; v = parent[v]) path.push_back(v);
+        path.push_back(src);
+        reverse(path.begin(), path.end());
+        return dist;
+    }
+
+    /**
+     * Per-worker buffers reused across single-source searches
+     */
+    struct SearchScratch {
+        vector<int> hops;
+        vector<int> queue;
+        vector<long long> dist;
+        vector<pair<long long, int>> heap;
+    };
+
+    /**
+     * Hop eccentricity of src, -1 if some vertex is unreachable
+     */
+    long long bfsEccentricity(int src, SearchScratch& scratch) const {
+        int farthest = bfsDistances(src, scratch.hops, scratch.queue);
+        for (int d : scratch.hops) {
+            if (d < 0) return -1;
+        }
+        return farthest;
+    }
+
+    /**
+     * Weighted eccentricity of src via binary-heap Dijkstra,
+     * -1 if some vertex is unreachable
+     */
+    long long dijkstraEccentricity(int src, SearchScratch& scratch) const {
+        const long long UNREACHED = LLONG_MAX;
+        auto& dist = scratch.dist;
+        auto& heap = scratch.heap;
+        dist.assign(idToVertex.size(), UNREACHED);
+        heap.clear();
+
+        dist[src] = 0;
+        heap.push_back({0, src});
+        size_t settled = 0;
+        long long farthest = 0;
+        while (!heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), greater<pair<long long, int>>());
+            auto [d, u] = heap.back();
+            heap.pop_back();
+            if (d != dist[u]) continue; // stale entry
+            settled++;
+            farthest = d;
+            for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                long long nd = d + weights[e];
+                int v = targets[e];
+                if (nd < dist[v]) {
+                    dist[v] = nd;
+                    heap.push_back({nd, v});
+                    push_heap(heap.begin(), heap.end(), greater<pair<long long, int>>());
+                }
+            }
+        }
+        return settled == idToVertex.size() ? farthest : -1;
+    }
+
+    /**
+     * Longest simple cycle through start, found by exhaustive DFS on an
+     * explicit stack of (vertex, next edge) frames
+     */
+    int dfsLongestCycle(int start, vector<char>& onPath) const {
+        graph_detail::ScratchStack<pair<int, int>> stack;
+        int maxCycle = 0;
+        onPath[start] = 1;
+        stack.push({start, offsets[start]});
+        while (!stack.empty()) {
+            auto& [current, e] = stack.top();
+            if (e == offsets[current + 1]) {
+                onPath[current] = 0;
+                stack.pop();
+                continue;
+            }
+            int next = targets[e++];
+            int dist = static_cast<int>(stack.size()) - 1;
+            if (next == start && dist > 1) {
+                maxCycle = max(maxCycle, dist + 1);
+            } else if (!onPath[next]) {
+                onPath[next] = 1;
+                stack.push({next, offsets[next]});
+            }
+        }
+        return maxCycle;
+    }
+
+public:
+    /**
+     * Builds the snapshot from a graph's vertex set and adjacency list
+     * Normally called through Graph<T>::freeze()
+     */
+    CSRGraph(const set<T>& vertices, const map<T, vector<pair<T, int>>>& adjList,
+             bool isDirected, bool isWeighted)
+        : idToVertex(vertices.begin(), vertices.end()),
+          directed(isDirected), weighted(isWeighted) {
+        offsets.assign(idToVertex.size() + 1, 0);
+
+        size_t totalEdges = 0;
+        for (const auto& entry : adjList) {
+            totalEdges += entry.second.size();
+        }
+        targets.reserve(totalEdges);
+        weights.reserve(totalEdges);
+
+        for (size_t i = 0; i < idToVertex.size(); i++) {
+            auto it = adjList.find(idToVertex[i]);
+            if (it != adjList.end()) {
+                for (const auto& neighbor : it->second) {
+                    targets.push_back(requireId(neighbor.first));
+                    weights.push_back(neighbor.second);
+                }
+            }
+            offsets[i + 1] = static_cast<int>(targets.size());
+        }
+        negativeWeights = any_of(weights.begin(), weights.end(), [](int w) { return w < 0; });
+
+        if (directed) {
+            // Counting sort of edges by target gives the in-edge arrays
+            inOffsets.assign(idToVertex.size() + 1, 0);
+            for (int t : targets) inOffsets[t + 1]++;
+            for (size_t i = 0; i < idToVertex.size(); i++) inOffsets[i + 1] += inOffsets[i];
+            inSources.resize(targets.size());
+            inWeights.resize(targets.size());
+            vector<int> cursor(inOffsets.begin(), inOffsets.end() - 1);
+            for (size_t u = 0; u < idToVertex.size(); u++) {
+                for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                    int slot = cursor[targets[e]]++;
+                    inSources[slot] = static_cast<int>(u);
+                    inWeights[slot] = weights[e];
+                }
+            }
+        }
+    }
+
+    // Snapshot flag bits, stored in the file header
+    static constexpr uint32_t SNAPSHOT_DIRECTED = 1;
+    static constexpr uint32_t SNAPSHOT_WEIGHTED = 2;
+    static constexpr uint32_t SNAPSHOT_NEGATIVE = 4;
+
+    /**
+     * Writes the CSR arrays as a binary snapshot: vertices, offsets, targets
+     * and weights, plus the in-edge arrays for directed graphs. The file can
+     * be opened zero-copy with CSRGraphView or copied back with loadSnapshot.
+     * Requires a trivially copyable vertex type (int, char, POD structs)
+     * @param path: File to create or overwrite
+     * @throws snapshot::SnapshotError: If the file cannot be written
+     */
+    void saveSnapshot(const string& path) const
+        requires snapshot::Storable<T>
+    {
+        auto writer = snapshot::Writer::forTypes<T, int>(path, snapshot::Kind::Graph);
+        writer.section(idToVertex.data(), idToVertex.size());
+        writer.section(offsets.data(), offsets.size());
+        writer.section(targets.data(), targets.size());
+        writer.section(weights.data(), weights.size());
+        if (directed) {
+            writer.section(inOffsets.data(), inOffsets.size());
+            writer.section(inSources.data(), inSources.size());
+            writer.section(inWeights.data(), inWeights.size());
+        }
+        uint32_t flags = (directed ? SNAPSHOT_DIRECTED : 0) | (weighted ? SNAPSHOT_WEIGHTED : 0) |
+                         (negativeWeights ? SNAPSHOT_NEGATIVE : 0);
+        writer.finish(idToVertex.size(), targets.size(), flags);
+    }
+
+    /**
+     * Reads a snapshot written by saveSnapshot. Every array is bulk-copied,
+     * nothing is re-sorted or re-indexed; the offsets and targets are
+     * range-checked once so a damaged file cannot cause out-of-bounds reads.
+     * @throws snapshot::SnapshotError: If the file is missing, of another
+     *         kind or vertex type, or inconsistent
+     */
+    static CSRGraph loadSnapshot(const string& path)
+        requires snapshot::Storable<T>
+    {
+        snapshot::MappedFile file(path);
+        file.expect<T, int>(snapshot::Kind::Graph);
+        const snapshot::Header& header = file.header();
+        size_t numV = header.count;
+        size_t numE = header.extra;
+
+        auto copy = [&file](auto& out, size_t index, size_t n) {
+            using Elem = typename remove_reference_t<decltype(out)>::value_type;
+            auto section = file.section<Elem>(index, n);
+            out.assign(section.begin(), section.end());
+        };
+
+        CSRGraph result;
+        result.directed = header.flags & SNAPSHOT_DIRECTED;
+        result.weighted = header.flags & SNAPSHOT_WEIGHTED;
+        result.negativeWeights = header.flags & SNAPSHOT_NEGATIVE;
+        copy(result.idToVertex, 0, numV);
+        copy(result.offsets, 1, numV + 1);
+        copy(result.targets, 2, numE);
+        copy(result.weights, 3, numE);
+        checkAdjacency(result.offsets, result.targets, numV, path);
+        if (result.directed) {
+            copy(result.inOffsets, 4, numV + 1);
+            copy(result.inSources, 5, numE);
+            copy(result.inWeights, 6, numE);
+            checkAdjacency(result.inOffsets, result.inSources, numV, path);
+        }
+        return result;
+    }
+
+    /**
+     * Dense ID of a vertex, -1 if absent. O(log V)
+     */
+    int idOf(const T& vertex) const {
+        auto it = lower_bound(idToVertex.begin(), idToVertex.end(), vertex);
+        if (it == idToVertex.end() || *it != vertex) return -1;
+        return static_cast<int>(it - idToVertex.begin());
+    }
+
+    /**
+     * Vertex stored under a dense ID
+     */
+    const T& vertexAt(int id) const { return idToVertex.at(id); }
+
+    /**
+     * Neighbor IDs of a vertex ID, contiguous in memory
+     */
+    span<const int> neighbors(int id) const {
+        return span<const int>(targets.data() + offsets[id],
+                               static_cast<size_t>(offsets[id + 1] - offsets[id]));
+    }
+
+    /**
+     * Weights matching neighbors(id) element by element
+     */
+    span<const int> neighborWeights(int id) const {
+        return span<const int>(weights.data() + offsets[id],
+                               static_cast<size_t>(offsets[id + 1] - offsets[id]));
+    }
+
+    const vector<int>& getOffsets() const { return offsets; }
+    const vector<int>& getTargets() const { return targets; }
+    const vector<int>& getWeights() const { return weights; }
+    bool directedGraph() const { return directed; }
+    bool weightedGraph() const { return weighted; }
+
+    int getNumVertices() const { return static_cast<int>(idToVertex.size()); }
+
+    int getNumEdges() const {
+        int count = static_cast<int>(targets.size());
+        return directed ? count : count / 2;
+    }
+
+    const vector<T>& getVertices() const { return idToVertex; }
+
+    int getDegree(const T& vertex) const {
+        int id = requireId(vertex);
+        return offsets[id + 1] - offsets[id];
+    }
+
+    int getInDegree(const T& vertex) const {
+        int id = requireId(vertex);
+        return inEnd(id) - inBegin(id);
+    }
+
+    int getMinDegree() const {
+        if (idToVertex.empty()) return 0;
+        int minDeg = INT_MAX;
+        for (size_t i = 0; i < idToVertex.size(); i++) {
+            minDeg = min(minDeg, offsets[i + 1] - offsets[i]);
+        }
+        return minDeg;
+    }
+
+    int getMaxDegree() const {
+        int maxDeg = 0;
+        for (size_t i = 0; i < idToVertex.size(); i++) {
+            maxDeg = max(maxDeg, offsets[i + 1] - offsets[i]);
+        }
+        return maxDeg;
+    }
+
+    /**
+     * Hop distances from src to every vertex ID (-1 = unreachable)
+     * @param dist: Output buffer, resized and reused across calls
+     * @param queue: Scratch buffer, reused across calls
+     * @return Eccentricity of src over the reached vertices
+     */
+    int bfsDistances(int src, vector<int>& dist, vector<int>& queue) const {
+        dist.assign(idToVertex.size(), -1);
+        queue.resize(idToVertex.size());
+        size_t head = 0, tail = 0;
+        queue[tail++] = src;
+        dist[src] = 0;
+        int farthest = 0;
+        [[maybe_unused]] uint64_t relaxed = 0;
+        while (head < tail) {
+            int current = queue[head++];
+            SNAZZYDEETS_STAT(relaxed += offsets[current + 1] - offsets[current]);
+            for (int e = offsets[current]; e < offsets[current + 1]; e++) {
+                int next = targets[e];
+                if (dist[next] < 0) {
+                    dist[next] = dist[current] + 1;
+                    farthest = dist[next];
+                    queue[tail++] = next;
+                }
+            }
+        }
+        SNAZZYDEETS_STAT(counters.recordTraversal("CSRGraph", relaxed));
+        return farthest;
+    }
+
+    /**
+     * Parallel level-synchronous BFS from a vertex ID
+     * Each level's frontier is split into chunks claimed by a fixed set of
+     * workers that meet at a barrier between levels; visited state is an
+     * atomic bitmap. Expansion runs top-down while the frontier is small and
+     * switches to bottom-up (every unvisited vertex scans its in-edges for a
+     * frontier parent) once the frontier's edges outweigh the unexplored
+     * ones, switching back when the frontier shrinks again.
+     * @param src: Source vertex ID
+     * @param numThreads: Worker count (0 = hardware concurrency)
+     * @return Hop distance per vertex ID, -1 if unreachable
+     */
+    vector<int> parallelBFSDistances(int src, unsigned numThreads = 0) const {
+        size_t n = idToVertex.size();
+        if (src < 0 || static_cast<size_t>(src) >= n) {
+            throw invalid_argument("Start vertex not found in graph");
+        }
+        if (numThreads == 0) numThreads = max(1u, thread::hardware_concurrency());
+
+        vector<int> dist(n, -1);
+        size_t words = (n + 63) / 64;
+        vector<atomic<uint64_t>> visited(words);
+        vector<uint64_t> frontierBits(words, 0);
+        vector<int> frontier{src};
+        vector<vector<int>> nextLocal(numThreads);
+        atomic<size_t> cursor{0};
+        int level = 0;
+        bool bottomUp = false;
+        bool done = false;
+        long long unexploredEdges = static_cast<long long>(targets.size()) -
+                                    (offsets[src + 1] - offsets[src]);
+
+        dist[src] = 0;
+        visited[src >> 6].store(uint64_t{1} << (src & 63), memory_order_relaxed);
+
+        // Runs on one thread while the others wait at the barrier
+        auto endLevel = [&]() noexcept {
+            frontier.clear();
+            for (auto& local : nextLocal) {
+                frontier.insert(frontier.end(), local.begin(), local.end());
+                local.clear();
+            }
+            level++;
+            cursor.store(0, memory_order_relaxed);
+            if (frontier.empty()) {
+                done = true;
+                return;
+            }
+
+            long long frontierEdges = 0;
+            for (int v : frontier) frontierEdges += offsets[v + 1] - offsets[v];
+            unexploredEdges -= frontierEdges;
+
+            if (!bottomUp && frontierEdges > unexploredEdges / BFS_ALPHA) {
+                bottomUp = true;
+            } else if (bottomUp && frontier.size() < n / BFS_BETA) {
+                bottomUp = false;
+            }
+            if (bottomUp) {
+                fill(frontierBits.begin(), frontierBits.end(), 0);
+                for (int v : frontier) frontierBits[v >> 6] |= uint64_t{1} << (v & 63);
+            }
+        };
+        barrier sync(static_cast<ptrdiff_t>(numThreads), endLevel);
+
+        auto worker = [&](unsigned tid) {
+            vector<int>& local = nextLocal[tid];
+            while (!done) {
+                if (!bottomUp) {
+                    size_t len = frontier.size();
+                    for (size_t b; (b = cursor.fetch_add(BFS_CHUNK, memory_order_relaxed)) < len; ) {
+                        size_t e = min(b + BFS_CHUNK, len);
+                        for (size_t i = b; i < e; i++) {
+                            int u = frontier[i];
+                            for (int k = offsets[u]; k < offsets[u + 1]; k++) {
+                                int v = targets[k];
+                                uint64_t bit = uint64_t{1} << (v & 63);
+                                if (visited[v >> 6].load(memory_order_relaxed) & bit) continue;
+                                if (!(visited[v >> 6].fetch_or(bit, memory_order_relaxed) & bit)) {
+                                    dist[v] = level + 1;
+                                    local.push_back(v);
+                                }
+                            }
+                        }
+                    }
+                } else {
+                    for (size_t b; (b = cursor.fetch_add(BFS_CHUNK, memory_order_relaxed)) < n; ) {
+                        size_t e = min(b + BFS_CHUNK, n);
+                        for (size_t v = b; v < e; v++) {
+                            if (dist[v] >= 0) continue;
+                            for (int k = inBegin(static_cast<int>(v)); k < inEnd(static_cast<int>(v)); k++) {
+                                int u = inSource(k);
+                                if (frontierBits[u >> 6] & (uint64_t{1} << (u & 63))) {
+                                    dist[v] = level + 1;
+                                    visited[v >> 6].fetch_or(uint64_t{1} << (v & 63), memory_order_relaxed);
+                                    local.push_back(static_cast<int>(v));
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+                sync.arrive_and_wait();
+            }
+        };
+
+        vector<thread> pool;
+        pool.reserve(numThreads - 1);
+        for (unsigned t = 1; t < numThreads; t++) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : pool) th.join();
+        return dist;
+    }
+
+    /**
+     * Parallel BFS traversal from start, grouped level by level
+     * Within a level vertices appear in sorted order, so the result is
+     * deterministic regardless of thread count
+     * @param numThreads: Worker count (0 = hardware concurrency)
+     */
+    vector<T> parallelBFS(const T& start, unsigned numThreads = 0) const {
+        vector<int> dist = parallelBFSDistances(requireId(start), numThreads);
+        int maxLevel = *max_element(dist.begin(), dist.end());
+        vector<size_t> levelStart(maxLevel + 2, 0);
+        for (int d : dist) {
+            if (d >= 0) levelStart[d + 1]++;
+        }
+        for (int l = 0; l <= maxLevel; l++) levelStart[l + 1] += levelStart[l];
+
+        vector<T> traversal(levelStart.back());
+        for (size_t id = 0; id < dist.size(); id++) {
+            if (dist[id] >= 0) traversal[levelStart[dist[id]]++] = idToVertex[id];
+        }
+        return traversal;
+    }
+
+    /**
+     * Breadth-first traversal order from start (quiet, no printing)
+     */
+    vector<T> BFS(const T& start) const {
+        int src = requireId(start);
+        vector<char> visited(idToVertex.size(), 0);
+        vector<int> queue;
+        queue.reserve(idToVertex.size());
+        queue.push_back(src);
+        visited[src] = 1;
+        for (size_t head = 0; head < queue.size(); head++) {
+            int current = queue[head];
+            for (int e = offsets[current]; e < offsets[current + 1]; e++) {
+                int next = targets[e];
+                if (!visited[next]) {
+                    visited[next] = 1;
+                    queue.push_back(next);
+                }
+            }
+        }
+        SNAZZYDEETS_STAT(
+            uint64_t relaxed = 0;
+            for (int id : queue) relaxed += offsets[id + 1] - offsets[id];
+            counters.recordTraversal("CSRGraph", relaxed));
+        vector<T> traversal;
+        traversal.reserve(queue.size());
+        for (int id : queue) traversal.push_back(idToVertex[id]);
+        return traversal;
+    }
+
+    /**
+     * Depth-first traversal order from start (quiet, no printing)
+     * Iterative, visits neighbors in the same order as Graph<T>::DFS
+     */
+    vector<T> DFS(const T& start) const {
+        int src = requireId(start);
+        vector<char> visited(idToVertex.size(), 0);
+        vector<pair<int, int>> stack; // (vertex, next edge index)
+        vector<T> traversal;
+
+        visited[src] = 1;
+        traversal.push_back(idToVertex[src]);
+        stack.push_back({src, offsets[src]});
+        while (!stack.empty()) {
+            auto& top = stack.back();
+            if (top.second == offsets[top.first + 1]) {
+                stack.pop_back();
+                continue;
+            }
+            int next = targets[top.second++];
+            if (!visited[next]) {
+                visited[next] = 1;
+                traversal.push_back(idToVertex[next]);
+                stack.push_back({next, offsets[next]});
+            }
+        }
+        return traversal;
+    }
+
+    /**
+     * Shortest hop distance between two vertices, -1 if unreachable
+     */
+    int getDistance(const T& src, const T& dest) const {
+        int s = requireId(src);
+        int d = requireId(dest);
+        if (s == d) return 0;
+        vector<int> dist, queue;
+        bfsDistances(s, dist, queue);
+        return dist[d];
+    }
+
+    /**
+     * Traversal counters. All zero unless built with SNAZZYDEETS_STATS.
+     */
+    GraphStats stats() const {
+#ifdef SNAZZYDEETS_STATS
+        return counters;
+#else
+        return GraphStats{};
+#endif
+    }
+
+    void resetStats() {
+#ifdef SNAZZYDEETS_STATS
+        counters = GraphStats{};
+#endif
+    }
+
+    bool isConnected() const {
+        if (idToVertex.empty()) return true;
+        vector<int> dist, queue;
+        bfsDistances(0, dist, queue);
+        return find(dist.begin(), dist.end(), -1) == dist.end();
+    }
+
+    /**
+     * Maximum eccentricity (hops), -1 if some pair is unreachable
+     */
+    int getDiameter() const {
+        if (idToVertex.size() <= 1) return 0;
+        return static_cast<int>(computeEccentricities(false).diameter);
+    }
+
+    /**
+     * Minimum eccentricity (hops), -1 if some pair is unreachable
+     */
+    int getRadius() const {
+        if (idToVertex.size() <= 1) return 0;
+        return static_cast<int>(computeEccentricities(false).radius);
+    }
+
+    /**
+     * All-sources eccentricity engine
+     * Runs one BFS (or Dijkstra when useWeights) per source vertex, with
+     * scratch buffers allocated once per worker, and derives diameter,
+     * radius, center and periphery in the same pass. Stops early as soon
+     * as any source cannot reach every vertex.
+     * @param useWeights: Sum edge weights instead of counting hops
+     * @param numThreads: Worker threads (0 = hardware concurrency)
+     * @throws invalid_argument: If useWeights and a weight is negative
+     */
+    GraphMetrics<T> computeEccentricities(bool useWeights, unsigned numThreads = 1) const {
+        GraphMetrics<T> result;
+        size_t n = idToVertex.size();
+        if (n <= 1) {
+            result.eccentricity.assign(n, 0);
+            result.center = idToVertex;
+            result.periphery = idToVertex;
+            return result;
+        }
+        if (useWeights && negativeWeights) {
+            throw invalid_argument("Eccentricity requires non-negative edge weights");
+        }
+
+        result.eccentricity.assign(n, 0);
+        atomic<size_t> nextSource{0};
+        atomic<bool> disconnected{false};
+
+        auto worker = [&]() {
+            SearchScratch scratch;
+            while (!disconnected.load(memory_order_relaxed)) {
+                size_t s = nextSource.fetch_add(1, memory_order_relaxed);
+                if (s >= n) break;
+                long long ecc = useWeights
+                    ? dijkstraEccentricity(static_cast<int>(s), scratch)
+                    : bfsEccentricity(static_cast<int>(s), scratch);
+                if (ecc < 0) {
+                    disconnected.store(true, memory_order_relaxed);
+                    break;
+                }
+                result.eccentricity[s] = ecc;
+            }
+        };
+
+        if (numThreads == 0) numThreads = max(1u, thread::hardware_concurrency());
+        numThreads = static_cast<unsigned>(min<size_t>(numThreads, n));
+        if (numThreads <= 1) {
+            worker();
+        } else {
+            vector<thread> pool;
+            pool.reserve(numThreads);
+            for (unsigned t = 0; t < numThreads; t++) pool.emplace_back(worker);
+            for (auto& th : pool) th.join();
+        }
+
+        if (disconnected) {
+            result.connected = false;
+            result.diameter = result.radius = -1;
+            result.eccentricity.clear();
+            return result;
+        }
+
+        result.diameter = *max_element(result.eccentricity.begin(), result.eccentricity.end());
+        result.radius = *min_element(result.eccentricity.begin(), result.eccentricity.end());
+        for (size_t i = 0; i < n; i++) {
+            if (result.eccentricity[i] == result.radius) result.center.push_back(idToVertex[i]);
+            if (result.eccentricity[i] == result.diameter) result.periphery.push_back(idToVertex[i]);
+        }
+        return result;
+    }
+
+    // ------------------------------------------------------------------
+    // Weighted shortest paths
+    // Distances are sums of edge weights (all 1 on unweighted graphs);
+    // every routine throws invalid_argument on negative weights.
+    // ------------------------------------------------------------------
+
+    /**
+     * Single-source Dijkstra over a 4-ary heap
+     * @param src: Source vertex ID
+     * @param dist: Filled with the distance per vertex ID, -1 if unreachable
+     * @param parent: Filled with the predecessor per vertex ID on a shortest
+     *                path, -1 for the source and unreachable vertices
+     */
+    void dijkstra(int src, vector<long long>& dist, vector<int>& parent) const {
+        requireSearchable(src);
+        size_t n = idToVertex.size();
+        dist.assign(n, UNSETTLED);
+        parent.assign(n, -1);
+        DaryHeap<4> heap;
+
+        dist[src] = 0;
+        heap.push(0, src);
+        while (!heap.empty()) {
+            auto [d, u] = heap.pop();
+            if (d != dist[u]) continue; // stale entry
+            for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                long long nd = d + weights[e];
+                int v = targets[e];
+                if (nd < dist[v]) {
+                    dist[v] = nd;
+                    parent[v] = u;
+                    heap.push(nd, v);
+                }
+            }
+        }
+        for (auto& d : dist) {
+            if (d == UNSETTLED) d = -1;
+        }
+    }
+
+    /**
+     * Point-to-point Dijkstra that stops once dst is settled
+     * @param path: Filled with the vertex IDs from src to dst (empty if none)
+     * @return Path length, -1 if dst is unreachable
+     */
+    long long shortestPath(int src, int dst, vector<int>& path) const {
+        return aStar(src, dst, [](int) { return 0LL; }, path);
+    }
+
+    /**
+     * A* search guided by a heuristic estimate of the remaining distance
+     * The heuristic must never overestimate (admissible) for the result to
+     * be optimal; vertices are reopened, so it need not be consistent.
+     * @param heuristic: Lower bound on the distance from a vertex ID to dst
+     * @param path: Filled with the vertex IDs from src to dst (empty if none)
+     * @return Path length, -1 if dst is unreachable
+     */
+    long long aStar(int src, int dst, const function<long long(int)>& heuristic,
+                    vector<int>& path) const {
+        requireSearchable(src);
+        requireSearchable(dst);
+        size_t n = idToVertex.size();
+        vector<long long> g(n, UNSETTLED);
+        vector<long long> h(n, UNSETTLED); // heuristic cache
+        vector<int> parent(n, -1);
+        DaryHeap<4> heap;
+        auto estimate = [&](int v) {
+            if (h[v] == UNSETTLED) h[v] = heuristic(v);
+            return h[v];
+        };
+
+        g[src] = 0;
+        heap.push(estimate(src), src);
+        while (!heap.empty()) {
+            auto [f, u] = heap.pop();
+            if (f != g[u] + h[u]) continue; // stale entry
+            if (u == dst) break;
+            for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                long long ng = g[u] + weights[e];
+                int v = targets[e];
+                if (ng < g[v]) {
+                    g[v] = ng;
+                    parent[v] = u;
+                    heap.push(ng + estimate(v), v);
+                }
+            }
+        }
+        return tracePath(src, dst, g[dst], parent, path);
+    }
+
+    /**
+     * Bidirectional Dijkstra: grows one search from src over out-edges and
+     * one from dst over in-edges, always advancing the smaller frontier,
+     * and stops once the two heap minima can no longer improve the best
+     * meeting point found so far
+     * @param path: Filled with the vertex IDs from src to dst (empty if none)
+     * @return Path length, -1 if dst is unreachable
+     */
+    long long bidirectionalShortestPath(int src, int dst, vector<int>& path) const {
+        requireSearchable(src);
+        requireSearchable(dst);
+        size_t n = idToVertex.size();
+        vector<long long> dist[2] = {vector<long long>(n, UNSETTLED), vector<long long>(n, UNSETTLED)};
+        vector<int> parent[2] = {vector<int>(n, -1), vector<int>(n, -1)};
+        DaryHeap<4> heap[2];
+        long long best = UNSETTLED;
+        int meet = -1;
+
+        dist[0][src] = 0;
+        dist[1][dst] = 0;
+        heap[0].push(0, src);
+        heap[1].push(0, dst);
+        if (src == dst) {
+            best = 0;
+            meet = src;
+        }
+
+        while (!heap[0].empty() && !heap[1].empty()) {
+            if (heap[0].top().first + heap[1].top().first >= best) break;
+            int side = heap[0].size() <= heap[1].size() ? 0 : 1;
+            auto [d, u] = heap[side].pop();
+            if (d != dist[side][u]) continue;
+
+            int begin = side == 0 ? offsets[u] : inBegin(u);
+            int end = side == 0 ? offsets[u + 1] : inEnd(u);
+            for (int e = begin; e < end; e++) {
+                int v = side == 0 ? targets[e] : inSource(e);
+                long long nd = d + (side == 0 ? weights[e] : inWeight(e));
+                if (nd < dist[side][v]) {
+                    dist[side][v] = nd;
+                    parent[side][v] = u;
+                    heap[side].push(nd, v);
+                }
+                if (dist[1 - side][v] != UNSETTLED && dist[side][v] + dist[1 - side][v] < best) {
+                    best = dist[side][v] + dist[1 - side][v];
+                    meet = v;
+                }
+            }
+        }
+
+        path.clear();
+        if (meet < 0) return -1;
+        for (int v = meet; v != -1; v = parent[0][v]) path.push_back(v);
+        reverse(path.begin(), path.end());
+        for (int v = parent[1][meet]; v != -1; v = parent[1][v]) path.push_back(v);
+        return best;
+    }
+
+    /**
+     * Parallel delta-stepping single-source shortest paths
+     * Tentative distances are kept in buckets of width delta. Workers relax
+     * the light edges (weight <= delta) of the current bucket until it stops
+     * refilling, then its heavy edges once, meeting at a barrier between
+     * rounds; distances are lowered with an atomic compare-and-swap.
+     * @param src: Source vertex ID
+     * @param delta: Bucket width (0 = average edge weight)
+     * @param numThreads: Worker count (0 = hardware concurrency)
+     * @return Distance per vertex ID, -1 if unreachable
+     */
+    vector<long long> deltaStepping(int src, long long delta = 0, unsigned numThreads = 0) const {
+        requireSearchable(src);
+        size_t n = idToVertex.size();
+        if (numThreads == 0) numThreads = max(1u, thread::hardware_concurrency());
+
+        long long maxWeight = 0, weightSum = 0;
+        for (int w : weights) {
+            maxWeight = max<long long>(maxWeight, w);
+            weightSum += w;
+        }
+        if (delta <= 0) {
+            delta = weights.empty() ? 1 : max(1LL, weightSum / static_cast<long long>(weights.size()));
+        }
+
+        // Every tentative distance lies within maxWeight of the current
+        // bucket, so a ring of buckets covers all live entries
+        size_t ringSize = static_cast<size_t>(maxWeight / delta) + 2;
+        vector<vector<int>> buckets(ringSize);
+        vector<atomic<long long>> dist(n);
+        for (auto& d : dist) d.store(UNSETTLED, memory_order_relaxed);
+
+        vector<int> frontier{src};
+        vector<int> settled;
+        vector<char> queued(n, 0);
+        vector<vector<int>> improvedLocal(numThreads);
+        atomic<size_t> cursor{0};
+        long long current = 0;
+        bool heavyRound = false;
+        bool done = false;
+        dist[src].store(0, memory_order_relaxed);
+
+        auto bucketOf = [&](long long d) { return static_cast<size_t>((d / delta) % static_cast<long long>(ringSize)); };
+
+        // Moves the live entries of the current bucket into the frontier
+        auto drainCurrent = [&]() {
+            vector<int>& bucket = buckets[bucketOf(current * delta)];
+            frontier.clear();
+            for (int v : bucket) {
+                if (!queued[v] && dist[v].load(memory_order_relaxed) / delta == current) {
+                    queued[v] = 1;
+                    frontier.push_back(v);
+                }
+            }
+            bucket.clear();
+            for (int v : frontier) queued[v] = 0;
+        };
+
+        // Runs on one thread while the others wait at the barrier
+        auto endRound = [&]() noexcept {
+            for (auto& local : improvedLocal) {
+                for (int v : local) buckets[bucketOf(dist[v].load(memory_order_relaxed))].push_back(v);
+                local.clear();
+            }
+            cursor.store(0, memory_order_relaxed);
+            if (!heavyRound) {
+                settled.insert(settled.end(), frontier.begin(), frontier.end());
+                drainCurrent();
+                if (!frontier.empty()) return;
+                // Bucket stopped refilling: its distances are final
+                sort(settled.begin(), settled.end());
+                settled.erase(unique(settled.begin(), settled.end()), settled.end());
+                frontier.swap(settled);
+                settled.clear();
+                heavyRound = true;
+                return;
+            }
+            heavyRound = false;
+            for (size_t step = 1; step < ringSize; step++) {
+                current++;
+                drainCurrent();
+                if (!frontier.empty()) return;
+            }
+            done = true;
+        };
+        barrier sync(static_cast<ptrdiff_t>(numThreads), endRound);
+
+        auto worker = [&](unsigned tid) {
+            vector<int>& local = improvedLocal[tid];
+            while (!done) {
+                size_t len = frontier.size();
+                for (size_t b; (b = cursor.fetch_add(BFS_CHUNK, memory_order_relaxed)) < len; ) {
+                    size_t end = min(b + BFS_CHUNK, len);
+                    for (size_t i = b; i < end; i++) {
+                        int u = frontier[i];
+                        long long du = dist[u].load(memory_order_relaxed);
+                        for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                            if ((weights[e] > delta) != heavyRound) continue;
+                            long long nd = du + weights[e];
+                            int v = targets[e];
+                            long long old = dist[v].load(memory_order_relaxed);
+                            while (nd < old && !dist[v].compare_exchange_weak(old, nd, memory_order_relaxed)) {}
+                            if (nd < old) local.push_back(v);
+                        }
+                    }
+                }
+                sync.arrive_and_wait();
+            }
+        };
+
+        vector<thread> pool;
+        pool.reserve(numThreads - 1);
+        for (unsigned t = 1; t < numThreads; t++) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : pool) th.join();
+
+        vector<long long> result(n);
+        for (size_t v = 0; v < n; v++) {
+            long long d = dist[v].load(memory_order_relaxed);
+            result[v] = d == UNSETTLED ? -1 : d;
+        }
+        return result;
     }
-    
+
     /**
-     * Calculates the graph radius (minimum eccentricity among all vertices)
-     * Eccentricity of a vertex = maximum distance from it to any other vertex
-     * @return Graph radius, -1 if graph is disconnected
+     * Recovers a shortest-path tree from a finished distance array (e.g. the
+     * output of deltaStepping) by walking tight edges outward from src
+     * @return Predecessor per vertex ID, -1 for src and unreachable vertices
      */
-    int getRadius() const {
-        if (vertices.empty()) return 0;
-        if (vertices.size() == 1) return 0;
-        
-        int radius = INT_MAX;
-        
-        for (const auto& src : vertices) {
-            int eccentricity = 0;
-            
-            for (const auto& dest : vertices) {
-                if (src != dest) {
-                    int dist = getDistance(src, dest);
-                    if (dist == -1) {
-                        return -1;  // Graph is disconnected
-                    }
-                    eccentricity = max(eccentricity, dist);
+    vector<int> shortestPathParents(int src, const vector<long long>& dist) const {
+        size_t n = idToVertex.size();
+        vector<int> parent(n, -1);
+        vector<char> reached(n, 0);
+        vector<int> queue{src};
+        reached[src] = 1;
+        for (size_t head = 0; head < queue.size(); head++) {
+            int u = queue[head];
+            for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+                int v = targets[e];
+                if (!reached[v] && dist[v] == dist[u] + weights[e]) {
+                    reached[v] = 1;
+                    parent[v] = u;
+                    queue.push_back(v);
                 }
             }
-            
-            radius = min(radius, eccentricity);
         }
-        
-        return radius;
+        return parent;
     }
-    
+
     /**
-     * Calculates the girth (length of shortest cycle) of the graph
-     * Also known as circumference when referring to smallest cycle
-     * @return Girth of the graph, -1 if no cycle exists, INT_MAX if acyclic
+     * Length of the shortest cycle, -1 if acyclic
+     * Same BFS-per-vertex scheme as Graph<T>::getGirth
      */
     int getGirth() const {
-        if (vertices.empty()) return -1;
-        
+        if (idToVertex.empty()) return -1;
         int girth = INT_MAX;
-        
-        // For each vertex, do BFS and find shortest cycle through it
-        for (const auto& start : vertices) {
-            map<T, int> distance;
-            queue<pair<T, T>> q;  // (current vertex, parent vertex)
-            
-            distance[start] = 0;
-            
-            auto it = adjList.find(start);
-            if (it != adjList.end()) {
-                for (const auto& neighbor : it->second) {
-                    q.push({neighbor.first, start});
-                    distance[neighbor.first] = 1;
-                }
+        vector<int> dist(idToVertex.size(), -1);
+        vector<pair<int, int>> queue; // (vertex, parent)
+        queue.reserve(idToVertex.size());
+
+        for (size_t start = 0; start < idToVertex.size(); start++) {
+            fill(dist.begin(), dist.end(), -1);
+            queue.clear();
+            int s = static_cast<int>(start);
+            dist[s] = 0;
+            for (int e = offsets[s]; e < offsets[s + 1]; e++) {
+                queue.push_back({targets[e], s});
+                dist[targets[e]] = 1;
             }
-            
-            while (!q.empty()) {
-                T current = q.front().first;
-                T parent = q.front().second;
-                q.pop();
-                
-                auto currentIt = adjList.find(current);
-                if (currentIt != adjList.end()) {
-                    for (const auto& neighbor : currentIt->second) {
-                        if (distance.find(neighbor.first) == distance.end()) {
-                            distance[neighbor.first] = distance[current] + 1;
-                            q.push({neighbor.first, current});
-                        } else if (neighbor.first != parent) {
-                            // Found a cycle
-                            int cycleLength = distance[current] + distance[neighbor.first] + 1;
-                            girth = min(girth, cycleLength);
-                        }
+            for (size_t head = 0; head < queue.size(); head++) {
+                int current = queue[head].first;
+                int parent = queue[head].second;
+                for (int e = offsets[current]; e < offsets[current + 1]; e++) {
+                    int next = targets[e];
+                    if (dist[next] < 0) {
+                        dist[next] = dist[current] + 1;
+                        queue.push_back({next, current});
+                    } else if (next != parent) {
+                        girth = min(girth, dist[current] + dist[next] + 1);
                     }
                 }
             }
         }
-        
         return (girth == INT_MAX) ? -1 : girth;
     }
-    
+
     /**
-     * Gets the circumference (length of longest cycle) of the graph
-     * @return Circumference of the graph, -1 if no cycle exists
+     * Length of the longest cycle, -1 if acyclic (exponential search)
      */
     int getCircumference() const {
-        if (vertices.empty()) return -1;
-        
+        if (idToVertex.empty()) return -1;
         int circumference = 0;
-        
-        // For each vertex, do DFS to find longest cycle
-        for (const auto& start : vertices) {
-            map<T, int> distance;
-            set<T> visited;
-            circumference = max(circumference, 
-                               dfsLongestCycle(start, start, visited, distance, 0));
+        vector<char> onPath(idToVertex.size(), 0);
+        for (size_t s = 0; s < idToVertex.size(); s++) {
+            circumference = max(circumference,
+                                dfsLongestCycle(static_cast<int>(s), onPath));
         }
-        
         return (circumference == 0) ? -1 : circumference;
     }
-    
-    /**
-     * Displays comprehensive graph properties
-     * @param use_colored_output: Enable colored output (default: false)
-     */
-    void displayProperties(bool use_colored_output = false) const {
-        cprint(use_colored_output, "\n=== Graph Properties ===\n", BRIGHT_WHITE, true);
-        
-        cprint(use_colored_output, "Number of Vertices: ", BRIGHT_WHITE, true);
-        cprint(use_colored_output, to_string(getNumVertices()) + "\n", BRIGHT_BLUE);
-        
-        cprint(use_colored_output, "Number of Edges: ", BRIGHT_WHITE, true);
-        cprint(use_colored_output, to_string(getNumEdges()) + "\n", BRIGHT_BLUE);
-        
-        if (!vertices.empty()) {
-            cprint(use_colored_output, "Minimum Degree (Min vertex connections): ", BRIGHT_WHITE, true);
-            cprint(use_colored_output, to_string(getMinDegree()) + "\n", BRIGHT_CYAN);
-            
-            cprint(use_colored_output, "Maximum Degree (Max vertex connections): ", BRIGHT_WHITE, true);
-            cprint(use_colored_output, to_string(getMaxDegree()) + "\n", BRIGHT_CYAN);
-            
-            int radius = getRadius();
-            cprint(use_colored_output, "Graph Radius (Min eccentricity): ", BRIGHT_WHITE, true);
-            if (radius == -1) {
-                cprint(use_colored_output, "Undefined (disconnected)\n", BRIGHT_RED);
-            } else {
-                cprint(use_colored_output, to_string(radius) + "\n", BRIGHT_GREEN);
-            }
-            
-            int diameter = getDiameter();
-            cprint(use_colored_output, "Graph Diameter (Max shortest path): ", BRIGHT_WHITE, true);
-            if (diameter == -1) {
-                cprint(use_colored_output, "Undefined (disconnected)\n", BRIGHT_RED);
-            } else {
-                cprint(use_colored_output, to_string(diameter) + "\n", BRIGHT_GREEN);
-            }
-            
-            int girth = getGirth();
-            cprint(use_colored_output, "Girth (Shortest cycle): ", BRIGHT_WHITE, true);
-            if (girth == -1) {
-                cprint(use_colored_output, "No cycle (Acyclic)\n", BRIGHT_YELLOW);
-            } else {
-                cprint(use_colored_output, to_string(girth) + "\n", BRIGHT_MAGNETA);
-            }
-            
-            int circumference = getCircumference();
-            cprint(use_colored_output, "Circumference (Longest cycle): ", BRIGHT_WHITE, true);
-            if (circumference == -1) {
-                cprint(use_colored_output, "No cycle (Acyclic)\n", BRIGHT_YELLOW);
-            } else {
-                cprint(use_colored_output, to_string(circumference) + "\n", BRIGHT_MAGNETA);
-            }
-        }
-        
-        cprint(use_colored_output, "Connected: ", BRIGHT_WHITE, true);
-        if (isConnected()) {
-            cprint(use_colored_output, "Yes\n", BRIGHT_GREEN);
-        } else {
-            cprint(use_colored_output, "No\n", BRIGHT_RED);
-        }
-        
-        cprint(use_colored_output, "========================\n", BRIGHT_WHITE, true);
-        cout << endl;
-    }
-    
-    virtual ~Graph() {}
+};
+
+// ============================================================================
+// MEMORY-MAPPED CSR VIEW
+// ============================================================================
 
+/**
+ * Read-only CSR graph over a memory-mapped snapshot file
+ * Opening one maps the file and reads only its header; the vertex, offset,
+ * target and weight arrays are used in place, so a large graph is ready
+ * immediately and pages load as traversals touch them. Opening checks the
+ * offsets and IDs once, as CSRGraph<T>::loadSnapshot does; use that for an
+ * owning copy with the full algorithm suite.
+ */
+template<typename T>
+    requires snapshot::Storable<T>
+class CSRGraphView {
 private:
+    snapshot::MappedFile file;
+    span<const T> idToVertex;
+    span<const int> offsets;
+    span<const int> targets;
+    span<const int> weights;
+    span<const int> inOffsets;  // directed graphs only
+    span<const int> inSources;
+    bool directed;
+    bool weighted;
+
+    int requireId(const T& vertex) const {
+        int id = idOf(vertex);
+        if (id < 0) {
+            throw invalid_argument("Vertex not found in graph");
+        }
+        return id;
+    }
 
+public:
     /**
-     * Helper function for DFS traversal with timing
+     * Maps a snapshot written by CSRGraph<T>::saveSnapshot or Graph<T>::saveSnapshot
+     * @throws snapshot::SnapshotError: If the file is missing, truncated,
+     *         holds another kind or vertex type, or is inconsistent
      */
-    void DFSUtil(T vertex, set<T>& visited, vector<T>& traversal,
-                 map<T, int>& discoveryTime, map<T, int>& finishTime,
-                 map<T, T>& parent, int& time, bool use_colored_output) const {
-        visited.insert(vertex);
-        traversal.push_back(vertex);
-        discoveryTime[vertex] = ++time;
-
-        // Print discovery
-        cprint(use_colored_output, "  Discovered: ", BRIGHT_WHITE);
-        cprint(use_colored_output, "[", BRIGHT_WHITE);
-        cprint(use_colored_output, vertex, BRIGHT_BLUE);
-        cprint(use_colored_output, "]", BRIGHT_WHITE);
-        cprint(use_colored_output, " at time ", BRIGHT_WHITE);
-        cprint(use_colored_output, to_string(discoveryTime[vertex]), BRIGHT_CYAN);
-
-        auto it = adjList.find(vertex);
-        if (it != adjList.end()) {
-            cprint(use_colored_output, " → Exploring: ", BRIGHT_YELLOW);
-            bool first = true;
-            for (const auto& neighbor : it->second) {
-                if (!first) cprint(use_colored_output, ", ", BRIGHT_WHITE);
-                cprint(use_colored_output, neighbor.first,
-                       visited.find(neighbor.first) == visited.end() ?
-                       BRIGHT_GREEN : BRIGHT_RED);
-                first = false;
-            }
-        }
-        cout << "\n";
-
-        // Explore neighbors
-        if (it != adjList.end()) {
-            for (const auto& neighbor : it->second) {
-                if (visited.find(neighbor.first) == visited.end()) {
-                    parent[neighbor.first] = vertex;
-                    DFSUtil(neighbor.first, visited, traversal, discoveryTime,
-                           finishTime, parent, time, use_colored_output);
-                }
-            }
+    explicit CSRGraphView(const string& path) : file(path) {
+        file.expect<T, int>(snapshot::Kind::Graph);
+        const snapshot::Header& header = file.header();
+        size_t numV = header.count;
+        size_t numE = header.extra;
+        directed = header.flags & CSRGraph<T>::SNAPSHOT_DIRECTED;
+        weighted = header.flags & CSRGraph<T>::SNAPSHOT_WEIGHTED;
+        idToVertex = file.section<T>(0, numV);
+        offsets = file.section<int>(1, numV + 1);
+        targets = file.section<int>(2, numE);
+        weights = file.section<int>(3, numE);
+        CSRGraph<T>::checkAdjacency(offsets, targets, numV, path);
+        if (directed) {
+            inOffsets = file.section<int>(4, numV + 1);
+            inSources = file.section<int>(5, numE);
+            CSRGraph<T>::checkAdjacency(inOffsets, inSources, numV, path);
         }
-
-        finishTime[vertex] = ++time;
-
-        // Print finish
-        cprint(use_colored_output, "  Finished:   ", BRIGHT_WHITE);
-        cprint(use_colored_output, "[", BRIGHT_WHITE);
-        cprint(use_colored_output, vertex, BRIGHT_BLUE);
-        cprint(use_colored_output, "]", BRIGHT_WHITE);
-        cprint(use_colored_output, " at time ", BRIGHT_WHITE);
-        cprint(use_colored_output, to_string(finishTime[vertex]) + "\n", BRIGHT_CYAN);
     }
 
     /**
-     * Helper function to print BFS tree structure
+     * Dense ID of a vertex, -1 if absent. O(log V)
      */
-    void printBFSTree(T vertex, const map<T, T>& parent,
-                     const map<T, int>& level, bool use_colored_output,
-                     const string& prefix = "", bool isLast = true) const {
-        // Print current vertex
-        cprint(use_colored_output, prefix);
-        cprint(use_colored_output, isLast ? "└── " : "├── ", BRIGHT_GREEN);
-        cprint(use_colored_output, "[", YELLOW);
-        cprint(use_colored_output, vertex, BRIGHT_BLUE);
-        cprint(use_colored_output, "]", YELLOW);
-
-        int currentLevel = level.at(vertex);
-        cprint(use_colored_output, " (L" + to_string(currentLevel) + ")\n",
-               BRIGHT_YELLOW);
+    int idOf(const T& vertex) const {
+        auto it = lower_bound(idToVertex.begin(), idToVertex.end(), vertex);
+        if (it == idToVertex.end() || *it != vertex) return -1;
+        return static_cast<int>(it - idToVertex.begin());
+    }
 
-        // Find children (vertices whose parent is current vertex)
-        vector<T> children;
-        for (const auto& p : parent) {
-            if (p.second == vertex && p.first != vertex) {
-                children.push_back(p.first);
-            }
-        }
+    const T& vertexAt(int id) const { return idToVertex[id]; }
 
-        // Sort children for consistent output
-        sort(children.begin(), children.end());
+    span<const int> neighbors(int id) const {
+        return targets.subspan(offsets[id], static_cast<size_t>(offsets[id + 1] - offsets[id]));
+    }
 
-        // Print children
-        for (size_t i = 0; i < children.size(); i++) {
-            string newPrefix = prefix + (isLast ? "    " : "│   ");
-            printBFSTree(children[i], parent, level, use_colored_output,
-                        newPrefix, i == children.size() - 1);
-        }
+    span<const int> neighborWeights(int id) const {
+        return weights.subspan(offsets[id], static_cast<size_t>(offsets[id + 1] - offsets[id]));
     }
 
     /**
-     * Helper function to print DFS tree structure
+     * Source IDs of the edges into id; the same as neighbors(id) when undirected
      */
-    void printDFSTree(T vertex, const map<T, T>& parent, int depth,
-                     bool use_colored_output, set<T> printed,
-                     const string& prefix = "", bool isLast = true) const {
-        if (printed.find(vertex) != printed.end()) return;
-        printed.insert(vertex);
+    span<const int> inNeighbors(int id) const {
+        if (!directed) return neighbors(id);
+        return inSources.subspan(inOffsets[id], static_cast<size_t>(inOffsets[id + 1] - inOffsets[id]));
+    }
 
-        // Print current vertex
-        cprint(use_colored_output, prefix, BRIGHT_WHITE);
-        cprint(use_colored_output, isLast ? "└── " : "├── ", BRIGHT_GREEN);
-        cprint(use_colored_output, "[", YELLOW);
-        cprint(use_colored_output, vertex, BRIGHT_BLUE);
-        cprint(use_colored_output, "]", YELLOW);
-        cprint(use_colored_output, " (depth " + to_string(depth) + ")\n",
-               BRIGHT_YELLOW);
+    span<const T> getVertices() const { return idToVertex; }
+    span<const int> getOffsets() const { return offsets; }
+    span<const int> getTargets() const { return targets; }
+    span<const int> getWeights() const { return weights; }
+    bool directedGraph() const { return directed; }
+    bool weightedGraph() const { return weighted; }
+    bool isMapped() const { return file.isMapped(); }
 
-        // Find children
-        vector<T> children;
-        for (const auto& p : parent) {
-            if (p.second == vertex && p.first != vertex) {
-                children.push_back(p.first);
-            }
-        }
+    int getNumVertices() const { return static_cast<int>(idToVertex.size()); }
 
-        sort(children.begin(), children.end());
+    int getNumEdges() const {
+        int count = static_cast<int>(targets.size());
+        return directed ? count : count / 2;
+    }
 
-        // Print children
-        for (size_t i = 0; i < children.size(); i++) {
-            string newPrefix = prefix + (isLast ? "    " : "│   ");
-            printDFSTree(children[i], parent, depth + 1, use_colored_output,
-                        printed, newPrefix, i == children.size() - 1);
-        }
+    int getDegree(const T& vertex) const {
+        int id = requireId(vertex);
+        return offsets[id + 1] - offsets[id];
+    }
+
+    int getInDegree(const T& vertex) const {
+        return static_cast<int>(inNeighbors(requireId(vertex)).size());
     }
 
     /**
-     * Helper function for finding longest cycle using DFS
+     * Hop distances from src to every vertex ID (-1 = unreachable),
+     * same contract as CSRGraph<T>::bfsDistances
+     * @return Eccentricity of src over the reached vertices
      */
-    int dfsLongestCycle(T start, T current, set<T>& visited, 
-                        map<T, int>& distance, int dist) const {
-        visited.insert(current);
-        distance[current] = dist;
-        
-        int maxCycle = 0;
-        
-        auto it = adjList.find(current);
-        if (it != adjList.end()) {
-            for (const auto& neighbor : it->second) {
-                if (neighbor.first == start && dist > 1) {
-                    // Found a cycle back to start
-                    maxCycle = max(maxCycle, dist + 1);
-                } else if (visited.find(neighbor.first) == visited.end()) {
-                    maxCycle = max(maxCycle, 
-                                  dfsLongestCycle(start, neighbor.first, visited, 
-                                                 distance, dist + 1));
+    int bfsDistances(int src, vector<int>& dist, vector<int>& queue) const {
+        dist.assign(idToVertex.size(), -1);
+        queue.resize(idToVertex.size());
+        size_t head = 0, tail = 0;
+        queue[tail++] = src;
+        dist[src] = 0;
+        int farthest = 0;
+        while (head < tail) {
+            int current = queue[head++];
+            for (int next : neighbors(current)) {
+                if (dist[next] < 0) {
+                    dist[next] = dist[current] + 1;
+                    farthest = dist[next];
+                    queue[tail++] = next;
                 }
             }
         }
-        
-        visited.erase(current);
-        return maxCycle;
+        return farthest;
     }
 };
 
@@ -968,21 +3209,26 @@ public:
     void addEdge(T src, T dest, int weight = 1) override {
         throw logic_error("Cannot add edges to a Null Graph");
     }
+
+    void addEdges(span<const tuple<T, T, int>> edges) override {
+        if (!edges.empty()) throw logic_error("Cannot add edges to a Null Graph");
+    }
     
-    void display(bool use_colored_output = false) const override {
-        cprint(use_colored_output, "Null Graph with ", BRIGHT_YELLOW, true);
-        cprint(use_colored_output, this->numVertices, BRIGHT_BLUE);
-        cprint(use_colored_output, " vertices and 0 edges\n", BRIGHT_YELLOW);
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w.paint("Null Graph with ", BRIGHT_YELLOW, true);
+        w.paint(this->numVertices, BRIGHT_BLUE);
+        w.paint(" vertices and 0 edges\n", BRIGHT_YELLOW);
         
         if (!this->vertices.empty()) {
-            cprint(use_colored_output, "Vertices: ", BRIGHT_MAGNETA, true);
+            w.paint("Vertices: ", BRIGHT_MAGNETA, true);
             bool first = true;
             for (const auto& v : this->vertices) {
-                if (!first) cout << ", ";
-                cprint(use_colored_output, v, BRIGHT_CYAN);
+                if (!first) w << ", ";
+                w.paint(v, BRIGHT_CYAN);
                 first = false;
             }
-            cout << endl;
+            w << '\n';
         }
     }
 };
@@ -1007,12 +3253,17 @@ public:
     void addEdge(T src, T dest, int weight = 1) override {
         throw logic_error("Cannot add edges to a Trivial Graph");
     }
+
+    void addEdges(span<const tuple<T, T, int>> edges) override {
+        if (!edges.empty()) throw logic_error("Cannot add edges to a Trivial Graph");
+    }
     
-    void display(bool use_colored_output = false) const override {
-        cprint(use_colored_output, "Trivial Graph with 1 vertex and 0 edges\n", BRIGHT_YELLOW, true);
-        cprint(use_colored_output, "Vertex: ", BRIGHT_MAGNETA, true);
-        cprint(use_colored_output, *this->vertices.begin(), BRIGHT_BLUE);
-        cout << endl;
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w.paint("Trivial Graph with 1 vertex and 0 edges\n", BRIGHT_YELLOW, true);
+        w.paint("Vertex: ", BRIGHT_MAGNETA, true);
+        w.paint(*this->vertices.begin(), BRIGHT_BLUE);
+        w << '\n';
     }
 };
 
@@ -1028,9 +3279,10 @@ public:
      */
     UndirectedGraph() : Graph<T>(false, false) {}
     
-    void display(bool use_colored_output = false) const override {
-        cprint(use_colored_output, "Undirected Graph:\n", BRIGHT_YELLOW, true);
-        Graph<T>::display(use_colored_output);
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w.paint("Undirected Graph:\n", BRIGHT_YELLOW, true);
+        Graph<T>::writeDisplay(w);
     }
 };
 
@@ -1046,9 +3298,10 @@ public:
      */
     DirectedGraph() : Graph<T>(true, false) {}
     
-    void display(bool use_colored_output = false) const override {
-        cprint(use_colored_output, "Directed Graph:\n", BRIGHT_GREEN, true);
-        Graph<T>::display(use_colored_output);
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w.paint("Directed Graph:\n", BRIGHT_GREEN, true);
+        Graph<T>::writeDisplay(w);
     }
 };
 
@@ -1067,15 +3320,16 @@ public:
     /**
      * Validates and displays connection status
      */
-    void display(bool use_colored_output = false) const override {
-        cprint(use_colored_output, "Connected Graph (Connected: ", BRIGHT_CYAN, true);
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w.paint("Connected Graph (Connected: ", BRIGHT_CYAN, true);
         if (this->isConnected()) {
-            cprint(use_colored_output, "Yes", BRIGHT_GREEN);
+            w.paint("Yes", BRIGHT_GREEN);
         } else {
-            cprint(use_colored_output, "No", BRIGHT_RED);
+            w.paint("No", BRIGHT_RED);
         }
-        cprint(use_colored_output, "):\n", BRIGHT_CYAN, true);
-        Graph<T>::display(use_colored_output);
+        w.paint("):\n", BRIGHT_CYAN, true);
+        Graph<T>::writeDisplay(w);
     }
 };
 
@@ -1091,15 +3345,16 @@ public:
      */
     DisconnectedGraph() : Graph<T>(false, false) {}
     
-    void display(bool use_colored_output = false) const override {
-        cprint(use_colored_output, "Disconnected Graph (Connected: ", BRIGHT_MAGNETA, true);
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w.paint("Disconnected Graph (Connected: ", BRIGHT_MAGNETA, true);
         if (this->isConnected()) {
-            cprint(use_colored_output, "Yes", BRIGHT_GREEN);
+            w.paint("Yes", BRIGHT_GREEN);
         } else {
-            cprint(use_colored_output, "No", BRIGHT_RED);
+            w.paint("No", BRIGHT_RED);
         }
-        cprint(use_colored_output, "):\n", BRIGHT_MAGNETA, true);
-        Graph<T>::display(use_colored_output);
+        w.paint("):\n", BRIGHT_MAGNETA, true);
+        Graph<T>::writeDisplay(w);
     }
 };
 
@@ -1134,12 +3389,13 @@ public:
         Graph<T>::addVertex(vertex);
     }
     
-    void display(bool use_colored_output = false) const override {
-        cout << "Complete Graph K" << this->numVertices << " (All vertices connected):" << endl;
-        cprint(use_colored_output, "Complete Graph\nNo of Vertices: ", BRIGHT_WHITE, true);
-        cprint(use_colored_output, this->numVertices, GREEN, true);
-        cprint(use_colored_output, "\n(All vertices are connected)\n", BRIGHT_WHITE, true);
-        Graph<T>::display();
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w << "Complete Graph K" << this->numVertices << " (All vertices connected):\n";
+        w.paint("Complete Graph\nNo of Vertices: ", BRIGHT_WHITE, true);
+        w.paint(this->numVertices, GREEN, true);
+        w.paint("\n(All vertices are connected)\n", BRIGHT_WHITE, true);
+        Graph<T>::writeDisplay(w);
     }
 };
 
@@ -1151,17 +3407,32 @@ template<typename T>
 class CyclicGraph : public Graph<T> {
 private:
     /**
-     * Helper function to detect cycle using DFS
+     * Helper function to detect cycle using DFS, on an explicit stack
+     * A visited neighbor other than the vertex's DFS parent closes a cycle
      */
-    bool hasCycleDFS(T vertex, set<T>& visited, T parent) const {
-        visited.insert(vertex);
+    bool hasCycleDFS(T root, const graph_detail::AdjacencyIndex<T>& adjacency,
+                     graph_detail::VertexTable<T, char>& visited, T rootParent) const {
+        struct Frame {
+            T vertex;
+            T parent;
+            const vector<pair<T, int>>* neighbors;
+            size_t next;
+        };
+        graph_detail::ScratchStack<Frame> stack;
+        visited.put(root, 1);
+        stack.push({root, rootParent, adjacency.of(root), 0});
         
-        for (const auto& neighbor : this->adjList.at(vertex)) {
-            if (visited.find(neighbor.first) == visited.end()) {
-                if (hasCycleDFS(neighbor.first, visited, vertex)) {
-                    return true;
-                }
-            } else if (neighbor.first != parent) {
+        while (!stack.empty()) {
+            Frame& frame = stack.top();
+            if (!frame.neighbors || frame.next == frame.neighbors->size()) {
+                stack.pop();
+                continue;
+            }
+            const T& neighbor = (*frame.neighbors)[frame.next++].first;
+            if (!visited.has(neighbor)) {
+                visited.put(neighbor, 1);
+                stack.push({neighbor, frame.vertex, adjacency.of(neighbor), 0});
+            } else if (neighbor != frame.parent) {
                 return true;
             }
         }
@@ -1180,11 +3451,13 @@ public:
      * @return True if graph has at least one cycle
      */
     bool hasCycle() const {
-        set<T> visited;
+        auto ids = this->idRange();
+        graph_detail::AdjacencyIndex<T> adjacency(this->adjList, ids);
+        graph_detail::VertexTable<T, char> visited(ids, 0);
         for (const auto& vertex : this->vertices) {
-            if (visited.find(vertex) == visited.end()) {
+            if (!visited.has(vertex)) {
                 T parent = T();
-                if (hasCycleDFS(vertex, visited, parent)) {
+                if (hasCycleDFS(vertex, adjacency, visited, parent)) {
                     return true;
                 }
             }
@@ -1192,15 +3465,16 @@ public:
         return false;
     }
     
-    void display(bool use_colored_output = false) const override {
-        cprint(use_colored_output, "Cyclic Graph (Has Cycle: ", BRIGHT_MAGNETA, true);
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w.paint("Cyclic Graph (Has Cycle: ", BRIGHT_MAGNETA, true);
         if (hasCycle()) {
-            cprint(use_colored_output, "Yes", BRIGHT_GREEN);
+            w.paint("Yes", BRIGHT_GREEN);
         } else {
-            cprint(use_colored_output, "No", BRIGHT_RED);
+            w.paint("No", BRIGHT_RED);
         }
-        cprint(use_colored_output, "):\n", BRIGHT_MAGNETA, true);
-        Graph<T>::display(use_colored_output);
+        w.paint("):\n", BRIGHT_MAGNETA, true);
+        Graph<T>::writeDisplay(w);
     }
 };
 
@@ -1211,24 +3485,28 @@ public:
 template<typename T>
 class DirectedAcyclicGraph : public Graph<T> {
 private:
+    graph_detail::VisitMarks<T> reached;  // reused by every addEdge check
+
     /**
-     * Helper function to detect cycle in directed graph using DFS
+     * Whether target can be reached from source (iterative DFS)
+     * Only the part of the graph reachable from source is visited
      */
-    bool hasCycleDFS(T vertex, set<T>& visited, set<T>& recStack) const {
-        visited.insert(vertex);
-        recStack.insert(vertex);
-        
-        for (const auto& neighbor : this->adjList.at(vertex)) {
-            if (visited.find(neighbor.first) == visited.end()) {
-                if (hasCycleDFS(neighbor.first, visited, recStack)) {
-                    return true;
-                }
-            } else if (recStack.find(neighbor.first) != recStack.end()) {
-                return true;
+    bool reaches(const T& source, const T& target) {
+        if (source == target) return true;
+        reached.reset(this->idRange());
+        graph_detail::ScratchStack<T> stack;
+        reached.insert(source);
+        stack.push(source);
+        while (!stack.empty()) {
+            T vertex = stack.top();
+            stack.pop();
+            auto it = this->adjList.find(vertex);
+            if (it == this->adjList.end()) continue;
+            for (const auto& neighbor : it->second) {
+                if (neighbor.first == target) return true;
+                if (reached.insert(neighbor.first)) stack.push(neighbor.first);
             }
         }
-        
-        recStack.erase(vertex);
         return false;
     }
     
@@ -1240,31 +3518,57 @@ public:
     
     /**
      * Validates that adding edge doesn't create a cycle
+     * The graph was acyclic before, so src -> dest closes a cycle exactly
+     * when dest already reaches src; only that search is run, not a
+     * whole-graph cycle check.
      */
     void addEdge(T src, T dest, int weight = 1) override {
         Graph<T>::addEdge(src, dest, weight);
         
-        // Check if adding this edge created a cycle
-        set<T> visited, recStack;
-        for (const auto& vertex : this->vertices) {
-            if (visited.find(vertex) == visited.end()) {
-                if (hasCycleDFS(vertex, visited, recStack)) {
-                    // Remove the edge that created the cycle
-                    auto& neighbors = this->adjList[src];
-                    neighbors.erase(
-                        remove_if(neighbors.begin(), neighbors.end(),
-                                  [dest](const pair<T,int>& p) { return p.first == dest; }),
-                        neighbors.end()
-                    );
-                    throw logic_error("Adding this edge would create a cycle in DAG");
-                }
+        if (reaches(dest, src)) {
+            // Remove the edge that created the cycle
+            this->deleteEdge(src, dest);
+            throw logic_error("Adding this edge would create a cycle in DAG");
+        }
+    }
+
+    /**
+     * Batch insert, validating each new edge through addEdge
+     */
+    void addEdges(span<const tuple<T, T, int>> edges) override {
+        for (const auto& [src, dest, weight] : this->freshEdges(edges)) {
+            addEdge(src, dest, weight);
+        }
+    }
+
+    /**
+     * Orders the vertices so that every edge points forward
+     * Built on stronglyConnectedComponents(): in a DAG each component is a
+     * single vertex, and Tarjan emits them in reverse topological order.
+     * Iterative, so chains of any length are fine. O(V + E)
+     * @throws logic_error: If the graph has a cycle (only possible after
+     *                      loadSnapshot, which bypasses addEdge)
+     */
+    vector<T> topologicalSort() const {
+        vector<vector<T>> components = this->stronglyConnectedComponents();
+        vector<T> order;
+        order.reserve(components.size());
+        for (auto it = components.rbegin(); it != components.rend(); ++it) {
+            if (it->size() > 1) throw logic_error("Graph has a cycle: no topological order");
+            order.push_back(it->front());
+        }
+        for (const auto& [vertex, neighbors] : this->adjList) {
+            for (const auto& neighbor : neighbors) {
+                if (neighbor.first == vertex) throw logic_error("Graph has a cycle: no topological order");
             }
         }
+        return order;
     }
     
-    void display(bool use_colored_output = false) const override {
-        cprint(use_colored_output, "Directed Acyclic Graph (DAG):\n", BRIGHT_GREEN, true);
-        Graph<T>::display(use_colored_output);
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w.paint("Directed Acyclic Graph (DAG):\n", BRIGHT_GREEN, true);
+        Graph<T>::writeDisplay(w);
     }
 };
 
@@ -1276,35 +3580,11 @@ template<typename T>
 class BipartiteGraph : public Graph<T> {
 private:
     /**
-     * Checks if graph is bipartite using BFS coloring
+     * Checks if graph is bipartite: no odd cycle in the union-find with
+     * side parity. O(1), plus an O(V + E) rebuild after a deletion.
      */
     bool isBipartiteCheck() const {
-        if (this->vertices.empty()) return true;
-        
-        map<T, int> color; // -1: uncolored, 0: color1, 1: color2
-        
-        for (const auto& start : this->vertices) {
-            if (color.find(start) != color.end()) continue;
-            
-            queue<T> q;
-            q.push(start);
-            color[start] = 0;
-            
-            while (!q.empty()) {
-                T vertex = q.front();
-                q.pop();
-                
-                for (const auto& neighbor : this->adjList.at(vertex)) {
-                    if (color.find(neighbor.first) == color.end()) {
-                        color[neighbor.first] = 1 - color[vertex];
-                        q.push(neighbor.first);
-                    } else if (color[neighbor.first] == color[vertex]) {
-                        return false;
-                    }
-                }
-            }
-        }
-        return true;
+        return !this->connectivity().hasOddCycle();
     }
     
 public:
@@ -1317,37 +3597,36 @@ public:
      * Validates that graph remains bipartite after adding edge
      */
     void addEdge(T src, T dest, int weight = 1) override {
-        Graph<T>::addEdge(src, dest, weight);
+        this->addVertex(src);
+        this->addVertex(dest);
         
-        if (!isBipartiteCheck()) {
-            // Remove the edge that broke bipartiteness
-            auto& neighbors = this->adjList[src];
-            neighbors.erase(
-                remove_if(neighbors.begin(), neighbors.end(),
-                          [dest](const pair<T,int>& p) { return p.first == dest; }),
-                neighbors.end()
-            );
-            
-            auto& neighbors2 = this->adjList[dest];
-            neighbors2.erase(
-                remove_if(neighbors2.begin(), neighbors2.end(),
-                          [src](const pair<T,int>& p) { return p.first == src; }),
-                neighbors2.end()
-            );
-            
+        // An edge between two vertices on the same side closes an odd cycle
+        this->connectivity();
+        if (this->components.sameSide(src, dest)) {
             throw logic_error("Adding this edge would break bipartite property");
         }
+        Graph<T>::addEdge(src, dest, weight);
+    }
+
+    /**
+     * Batch insert, validating each new edge through addEdge
+     */
+    void addEdges(span<const tuple<T, T, int>> edges) override {
+        for (const auto& [src, dest, weight] : this->freshEdges(edges)) {
+            addEdge(src, dest, weight);
+        }
     }
     
-    void display(bool use_colored_output = false) const override {
-        cprint(use_colored_output, "Bipartite Graph (Is Bipartite: ", BRIGHT_CYAN, true);
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w.paint("Bipartite Graph (Is Bipartite: ", BRIGHT_CYAN, true);
         if (isBipartiteCheck()) {
-            cprint(use_colored_output, "Yes", BRIGHT_GREEN);
+            w.paint("Yes", BRIGHT_GREEN);
         } else {
-            cprint(use_colored_output, "No", BRIGHT_RED);
+            w.paint("No", BRIGHT_RED);
         }
-        cprint(use_colored_output, "):\n", BRIGHT_CYAN, true);
-        Graph<T>::display(use_colored_output);
+        w.paint("):\n", BRIGHT_CYAN, true);
+        Graph<T>::writeDisplay(w);
     }
 };
 
@@ -1363,10 +3642,102 @@ public:
      * @param directed: Whether graph is directed
      */
     WeightedGraph(bool directed = false) : Graph<T>(directed, true) {}
+
+    // Each query below freezes the graph first; for repeated queries on an
+    // unchanged graph, call freeze() once and use the CSRGraph<T> methods.
+
+    /**
+     * Single-source shortest paths (Dijkstra, 4-ary heap)
+     * @throws invalid_argument: If source is missing or a weight is negative
+     */
+    ShortestPathTree<T> dijkstra(const T& source) const {
+        CSRGraph<T> csr = this->freeze();
+        vector<long long> dist;
+        vector<int> parent;
+        csr.dijkstra(requireVertex(csr, source), dist, parent);
+        return makeTree(csr, dist, parent);
+    }
+
+    /**
+     * Point-to-point Dijkstra, stopping as soon as target is settled
+     */
+    ShortestPath<T> shortestPath(const T& source, const T& target) const {
+        CSRGraph<T> csr = this->freeze();
+        vector<int> ids;
+        long long d = csr.shortestPath(requireVertex(csr, source), requireVertex(csr, target), ids);
+        return makePath(csr, ids, d);
+    }
+
+    /**
+     * Point-to-point Dijkstra searching from both ends at once
+     */
+    ShortestPath<T> bidirectionalShortestPath(const T& source, const T& target) const {
+        CSRGraph<T> csr = this->freeze();
+        vector<int> ids;
+        long long d = csr.bidirectionalShortestPath(requireVertex(csr, source),
+                                                    requireVertex(csr, target), ids);
+        return makePath(csr, ids, d);
+    }
+
+    /**
+     * A* search
+     * @param heuristic: Lower bound on the remaining distance from a vertex
+     *                   to target (e.g. straight-line distance)
+     */
+    ShortestPath<T> aStar(const T& source, const T& target,
+                          const function<long long(const T&)>& heuristic) const {
+        CSRGraph<T> csr = this->freeze();
+        vector<int> ids;
+        long long d = csr.aStar(requireVertex(csr, source), requireVertex(csr, target),
+                                [&](int id) { return heuristic(csr.vertexAt(id)); }, ids);
+        return makePath(csr, ids, d);
+    }
+
+    /**
+     * Parallel single-source shortest paths (delta-stepping)
+     * @param delta: Bucket width (0 = average edge weight)
+     * @param numThreads: Worker count (0 = hardware concurrency)
+     */
+    ShortestPathTree<T> deltaStepping(const T& source, long long delta = 0,
+                                      unsigned numThreads = 0) const {
+        CSRGraph<T> csr = this->freeze();
+        int src = requireVertex(csr, source);
+        vector<long long> dist = csr.deltaStepping(src, delta, numThreads);
+        return makeTree(csr, dist, csr.shortestPathParents(src, dist));
+    }
     
-    void display(bool use_colored_output = false) const override {
-        cprint(use_colored_output, "Weighted Graph:\n", BRIGHT_MAGNETA, true);
-        Graph<T>::display(use_colored_output);
+protected:
+    void writeDisplay(output::Writer& w) const override {
+        w.paint("Weighted Graph:\n", BRIGHT_MAGNETA, true);
+        Graph<T>::writeDisplay(w);
+    }
+
+private:
+    static int requireVertex(const CSRGraph<T>& csr, const T& vertex) {
+        int id = csr.idOf(vertex);
+        if (id < 0) {
+            throw invalid_argument("Vertex not found in graph");
+        }
+        return id;
+    }
+
+    static ShortestPath<T> makePath(const CSRGraph<T>& csr, const vector<int>& ids, long long dist) {
+        ShortestPath<T> result;
+        result.distance = dist;
+        result.path.reserve(ids.size());
+        for (int id : ids) result.path.push_back(csr.vertexAt(id));
+        return result;
+    }
+
+    static ShortestPathTree<T> makeTree(const CSRGraph<T>& csr, const vector<long long>& dist,
+                                        const vector<int>& parent) {
+        ShortestPathTree<T> tree;
+        for (size_t id = 0; id < dist.size(); id++) {
+            if (dist[id] < 0) continue;
+            tree.distance.emplace(csr.vertexAt(static_cast<int>(id)), dist[id]);
+            if (parent[id] >= 0) tree.parent.emplace(csr.vertexAt(static_cast<int>(id)), csr.vertexAt(parent[id]));
+        }
+        return tree;
     }
 };
 #endif
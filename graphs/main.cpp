@@ -97,7 +97,9 @@ int main() {
         dag.addEdge('B', 'D');
         dag.addEdge('C', 'D');
         dag.display(USE_COLORS);
-        cout << endl;
+        cout << "Topological order: ";
+        for (char vertex : dag.topologicalSort()) cout << vertex << " ";
+        cout << endl << endl;
         
         // 10. Bipartite Graph with integers
         cprint(USE_COLORS, "10. BIPARTITE GRAPH (int)\n", BRIGHT_YELLOW, true);
@@ -470,7 +472,23 @@ int main() {
         cprint(USE_COLORS, "└─ DFS explores as deep as possible (depth-first)\n", 
                BRIGHT_MAGNETA);
         cout << endl;
-        
+
+        // Example 7: Frozen CSR snapshot for read-only analytics
+        cprint(USE_COLORS, "\n--- Example 7: CSR Snapshot (freeze) ---\n",
+               BRIGHT_CYAN, true);
+
+        CSRGraph<int> frozen = compareGraph.freeze();
+        cprint(USE_COLORS, "Snapshot BFS from 1: ", BRIGHT_WHITE, true);
+        for (int v : frozen.BFS(1)) {
+            cprint(USE_COLORS, to_string(v) + " ", BRIGHT_BLUE);
+        }
+        cout << "\n";
+        cprint(USE_COLORS, "Snapshot Diameter: ", BRIGHT_WHITE, true);
+        cprint(USE_COLORS, to_string(frozen.getDiameter()) + "\n", BRIGHT_GREEN);
+        cprint(USE_COLORS, "Snapshot Distance(4, 6): ", BRIGHT_WHITE, true);
+        cprint(USE_COLORS, to_string(frozen.getDistance(4, 6)) + "\n", BRIGHT_GREEN);
+        cout << endl;
+
     } catch (const exception& e) {
         cprint(true, "Fatal Error: ", RED, true);
         cprint(true, string(e.what()) + "\n", RED);
@@ -0,0 +1,208 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+/**
+ * @file instrumentation.hpp
+ * @brief Opt-in operation counters for the maps, trees and graphs modules.
+ *
+ * Define SNAZZYDEETS_STATS (or configure CMake with
+ * -DSNAZZYDEETS_ENABLE_STATS=ON) to compile the counters in. Without it:
+ *   - every SNAZZYDEETS_STAT(...) statement expands to nothing,
+ *   - each container's counter slot is an empty [[no_unique_address]] member,
+ *   - stats() still exists and returns an all-zero struct,
+ * so instrumented code builds unchanged and pays nothing.
+ *
+ * With it, counters are relaxed atomics: const lookups from several
+ * threads may update them concurrently. Rare, interesting events (a long
+ * probe, a deep search, a rehash, a finished traversal) are also passed to
+ * an optional process-wide callback sink.
+ *
+ * Usage:
+ * #include "../instrumentation/instrumentation.hpp"
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <type_traits>
+
+// Statements inside SNAZZYDEETS_STAT(...) are pasted unwrapped, so they may
+// declare locals used by a later SNAZZYDEETS_STAT in the same scope. Keep
+// each use a complete statement (not the lone body of an unbraced if).
+#ifdef SNAZZYDEETS_STATS
+#define SNAZZYDEETS_STAT(...) __VA_ARGS__
+#else
+#define SNAZZYDEETS_STAT(...)
+#endif
+
+namespace instrumentation {
+
+#ifdef SNAZZYDEETS_STATS
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+/**
+ * Monotonic counter that copies by value. Reads convert to uint64_t, so a
+ * stats struct made of Counters reads like plain numbers.
+ */
+class Counter {
+private:
+    std::atomic<uint64_t> value{0};
+
+public:
+    Counter() = default;
+    Counter(uint64_t v) : value(v) {}
+    Counter(const Counter& other) : value(other.load()) {}
+
+    Counter& operator=(const Counter& other) {
+        value.store(other.load(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    Counter& operator=(uint64_t v) {
+        value.store(v, std::memory_order_relaxed);
+        return *this;
+    }
+
+    void add(uint64_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+
+    /**
+     * Keep the largest value ever offered (for "max probe", "max depth")
+     */
+    void raiseTo(uint64_t v) {
+        uint64_t current = value.load(std::memory_order_relaxed);
+        while (current < v && !value.compare_exchange_weak(current, v, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t load() const { return value.load(std::memory_order_relaxed); }
+    operator uint64_t() const { return load(); }
+
+    friend std::ostream& operator<<(std::ostream& os, const Counter& counter) {
+        return os << counter.load();
+    }
+};
+
+/**
+ * Stand-in for a container's counters when stats are compiled out
+ */
+struct Disabled {};
+
+template<typename Stats>
+using Slot = std::conditional_t<enabled, Stats, Disabled>;
+
+inline double ratio(uint64_t numerator, uint64_t denominator) {
+    return denominator ? static_cast<double>(numerator) / static_cast<double>(denominator) : 0.0;
+}
+
+// ==================== EVENTS ====================
+/**
+ * One notable occurrence, reported to the sink as it happens
+ *   structure: "HashMap", "TreeMap", "AVLTree", "Graph", ...
+ *   name:      "rehash", "longProbe", "deepSearch", "traversal"
+ *   value:     event-specific (new bucket count, probe length, nodes
+ *              visited, edges relaxed)
+ *   nanos:     duration for timed events, 0 otherwise
+ */
+struct Event {
+    const char* structure;
+    const char* name;
+    uint64_t value;
+    uint64_t nanos;
+};
+
+using Sink = std::function<void(const Event&)>;
+
+/**
+ * Limits above which a single operation is reported as an event
+ */
+struct Thresholds {
+    std::atomic<uint64_t> probeLength{8};   // HashMap chain nodes examined by one lookup
+    std::atomic<uint64_t> searchDepth{64};  // tree nodes visited by one search or insert
+};
+
+inline Thresholds& thresholds() {
+    static Thresholds limits;
+    return limits;
+}
+
+namespace detail {
+struct SinkState {
+    std::mutex lock;
+    std::shared_ptr<const Sink> sink;
+    std::atomic<bool> installed{false};
+};
+
+inline SinkState& sinkState() {
+    static SinkState state;
+    return state;
+}
+}
+
+/**
+ * Install the process-wide event callback (replacing any previous one).
+ * The sink may be called from any thread that operates on a container.
+ */
+inline void setSink(Sink sink) {
+    auto& state = detail::sinkState();
+    std::lock_guard<std::mutex> guard(state.lock);
+    state.sink = sink ? std::make_shared<const Sink>(std::move(sink)) : nullptr;
+    state.installed.store(state.sink != nullptr, std::memory_order_release);
+}
+
+inline void clearSink() {
+    setSink(nullptr);
+}
+
+inline void emit(const Event& event) {
+    auto& state = detail::sinkState();
+    if (!state.installed.load(std::memory_order_acquire)) return;
+    std::shared_ptr<const Sink> sink;
+    {
+        std::lock_guard<std::mutex> guard(state.lock);
+        sink = state.sink;
+    }
+    if (sink) (*sink)(event);
+}
+
+// ==================== SHARED STATS ====================
+/**
+ * Counters kept by every balanced search tree (AVLTree, RedBlackTree,
+ * TreeMap) and the plain BinarySearchTree
+ */
+struct TreeStats {
+    Counter inserts;        // new keys added
+    Counter rotations;      // single rotations; a double rotation counts two
+    Counter searches;       // lookups of one key
+    Counter nodesVisited;   // nodes compared by those lookups
+    Counter maxVisited;     // most nodes a single lookup compared
+
+    double rotationsPerInsert() const { return ratio(rotations, inserts); }
+    double averageVisited() const { return ratio(nodesVisited, searches); }
+
+    void recordSearch(const char* structure, uint64_t visited) {
+        searches.add();
+        nodesVisited.add(visited);
+        maxVisited.raiseTo(visited);
+        if (visited > thresholds().searchDepth.load(std::memory_order_relaxed)) {
+            emit({structure, "deepSearch", visited, 0});
+        }
+    }
+};
+
+/**
+ * Nanoseconds elapsed since `start`, for timed events
+ */
+inline uint64_t nanosSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace instrumentation
+
+#endif
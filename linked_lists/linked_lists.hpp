@@ -5,7 +5,22 @@
 #include <stdexcept>
 #include <functional>
 #include <string>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <memory>
+#include <new>
+#include <iterator>
+#include <memory_resource>
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include "../console_colors/colours.hpp"
+#include "../output/output.hpp"
+#include "../parallel/parallel.hpp"
 
 using namespace colors;
 // ============================================================================
@@ -18,6 +33,9 @@ struct SinglyNode {
     SinglyNode* next;
     
     SinglyNode(const T& value) : data(value), next(nullptr) {}
+    template <typename... Args>
+    explicit SinglyNode(std::in_place_t, Args&&... args)
+        : data(std::forward<Args>(args)...), next(nullptr) {}
 };
 
 template <typename T>
@@ -27,8 +45,300 @@ struct DoublyNode {
     DoublyNode* next;
     
     DoublyNode(const T& value) : data(value), prev(nullptr), next(nullptr) {}
+    template <typename... Args>
+    explicit DoublyNode(std::in_place_t, Args&&... args)
+        : data(std::forward<Args>(args)...), prev(nullptr), next(nullptr) {}
 };
 
+// Node of an UnrolledLinkedList: up to Capacity elements stored inline.
+// Live elements occupy slots [begin, end), so a node can grow at either
+// side without shifting.
+template <typename T, size_t Capacity>
+struct UnrolledNode {
+    UnrolledNode* prev;
+    UnrolledNode* next;
+    size_t begin;
+    size_t end;
+    alignas(T) unsigned char storage[sizeof(T) * Capacity];
+    
+    explicit UnrolledNode(size_t start = 0) : prev(nullptr), next(nullptr), begin(start), end(start) {}
+    UnrolledNode(const UnrolledNode&) = delete;
+    UnrolledNode& operator=(const UnrolledNode&) = delete;
+    ~UnrolledNode() { std::destroy(slots() + begin, slots() + end); }
+    
+    T* slots() { return std::launder(reinterpret_cast<T*>(storage)); }
+    const T* slots() const { return std::launder(reinterpret_cast<const T*>(storage)); }
+    size_t count() const { return end - begin; }
+};
+
+// Default elements per unrolled node: about 256 bytes of payload
+template <typename T>
+constexpr size_t unrolledNodeCapacity() {
+    return std::max<size_t>(4, 256 / sizeof(T));
+}
+
+// ============================================================================
+// NODE ALLOCATION
+// ============================================================================
+// Per-list free list of node-sized blocks. Removed nodes are kept (up to
+// MAX_CACHED) and reused by the next insertion instead of going back to
+// the allocator, so queue-style add/remove cycles stop calling malloc and
+// free. Fresh blocks come from a std::pmr::memory_resource, which callers
+// may replace with a pool or arena of their own.
+template <typename Node>
+class NodeCache {
+private:
+    union Slot {
+        Slot* next;
+        alignas(Node) unsigned char bytes[sizeof(Node)];
+    };
+    
+    std::pmr::memory_resource* upstream;
+    Slot* freeList;
+    size_t cached;
+    
+    void release(void* memory) noexcept {
+        if (cached < MAX_CACHED) {
+            Slot* slot = ::new (memory) Slot;
+            slot->next = freeList;
+            freeList = slot;
+            cached++;
+        } else {
+            upstream->deallocate(memory, sizeof(Slot), alignof(Slot));
+        }
+    }
+
+public:
+    static constexpr size_t MAX_CACHED = 4096;
+    
+    explicit NodeCache(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : upstream(resource), freeList(nullptr), cached(0) {}
+    
+    NodeCache(const NodeCache&) = delete;
+    NodeCache& operator=(const NodeCache&) = delete;
+    
+    // The moved-from cache keeps its resource and stays usable
+    NodeCache(NodeCache&& other) noexcept
+        : upstream(other.upstream), freeList(std::exchange(other.freeList, nullptr)),
+          cached(std::exchange(other.cached, 0)) {}
+    
+    NodeCache& operator=(NodeCache&& other) noexcept {
+        if (this != &other) {
+            shrink();
+            upstream = other.upstream;
+            freeList = std::exchange(other.freeList, nullptr);
+            cached = std::exchange(other.cached, 0);
+        }
+        return *this;
+    }
+    
+    ~NodeCache() {
+        shrink();
+    }
+    
+    template <typename... Args>
+    Node* create(Args&&... args) {
+        void* memory;
+        if (freeList) {
+            memory = freeList;
+            freeList = freeList->next;
+            cached--;
+        } else {
+            memory = upstream->allocate(sizeof(Slot), alignof(Slot));
+        }
+        try {
+            return ::new (memory) Node(std::forward<Args>(args)...);
+        } catch (...) {
+            release(memory);
+            throw;
+        }
+    }
+    
+    void destroy(Node* node) noexcept {
+        node->~Node();
+        release(node);
+    }
+    
+    // Return every cached block to the memory resource
+    void shrink() noexcept {
+        while (freeList) {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            upstream->deallocate(slot, sizeof(Slot), alignof(Slot));
+        }
+        cached = 0;
+    }
+    
+    size_t cachedNodes() const { return cached; }
+    std::pmr::memory_resource* resource() const { return upstream; }
+    
+    // True if nodes created by `other` may be destroyed by this cache,
+    // i.e. whole chains can be spliced between the two lists
+    bool compatible(const NodeCache& other) const {
+        return upstream == other.upstream || upstream->is_equal(*other.upstream);
+    }
+};
+
+// ============================================================================
+// LIST SORTING
+// ============================================================================
+// Bottom-up merge sort over a nullptr-terminated chain of nodes linked
+// through `next`. Shared by every list type: doubly and circular lists open
+// their chain, sort it, then restore prev pointers and the circular link.
+// No recursion, so list length is not limited by the stack, and the
+// comparator is a template parameter so it can be inlined.
+
+// Merge sorted chain `right` into sorted chain `left`. Stable: on ties the
+// node from `left` comes first. If comp throws, `left` is left holding
+// every node of both chains (in some order) before the exception escapes.
+template <typename Node, typename Compare>
+void mergeChains(Node*& left, Node* right, Compare& comp) {
+    Node* merged = nullptr;
+    Node** tail = &merged;
+    Node* a = left;
+    Node* b = right;
+    try {
+        while (a && b) {
+            if (comp(b->data, a->data)) {
+                *tail = b;
+                b = b->next;
+            } else {
+                *tail = a;
+                a = a->next;
+            }
+            tail = &(*tail)->next;
+        }
+    } catch (...) {
+        *tail = a;
+        while (*tail) tail = &(*tail)->next;
+        *tail = b;
+        left = merged;
+        throw;
+    }
+    *tail = a ? a : b;
+    left = merged;
+}
+
+// Sort a chain in O(n log n) time and O(1) extra space. Runs of length 2^i
+// are kept in bins[i] and merged like a binary counter, as std::list does.
+// If comp throws, `head` still owns every node.
+template <typename Node, typename Compare>
+void mergeSortChain(Node*& head, Compare& comp) {
+    Node* bins[64] = {};
+    int used = 0;
+    Node* rest = head;
+    try {
+        while (rest) {
+            Node* carry = rest;
+            rest = rest->next;
+            carry->next = nullptr;
+            int i = 0;
+            for (; i < used && bins[i]; i++) {
+                Node* run = std::exchange(carry, nullptr); // bins[i] absorbs it on throw
+                mergeChains(bins[i], run, comp);
+                carry = std::exchange(bins[i], nullptr);
+            }
+            bins[i] = std::exchange(carry, nullptr);
+            if (i == used) used++;
+        }
+        // Higher bins hold earlier elements, so they go on the left
+        Node* sorted = nullptr;
+        for (int i = 0; i < used; i++) {
+            if (!bins[i]) continue;
+            mergeChains(bins[i], std::exchange(sorted, nullptr), comp);
+            sorted = std::exchange(bins[i], nullptr);
+        }
+        head = sorted;
+    } catch (...) {
+        // Splice every partial run back into one chain
+        Node* all = rest;
+        auto prepend = [&all](Node* chain) {
+            if (!chain) return;
+            Node* last = chain;
+            while (last->next) last = last->next;
+            last->next = all;
+            all = chain;
+        };
+        for (int i = 0; i < used; i++) prepend(bins[i]);
+        head = all;
+        throw;
+    }
+}
+
+// Sort a chain of `length` nodes on up to numThreads threads
+// (0 = hardware concurrency): equal slices are sorted concurrently and then
+// merged pairwise, each round of merges also running in parallel.
+// Short lists, or a single thread, fall back to mergeSortChain.
+template <typename Node, typename Compare>
+void parallelMergeSortChain(Node*& head, size_t length, Compare& comp, unsigned numThreads) {
+    constexpr size_t MIN_SLICE = 1 << 14; // below this threads cost more than they save
+    if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t slices = std::min<size_t>(numThreads, length / MIN_SLICE);
+    if (slices < 2) {
+        mergeSortChain(head, comp);
+        return;
+    }
+    
+    std::vector<Node*> runs(slices);
+    Node* current = head;
+    for (size_t s = 0; s < slices; s++) {
+        runs[s] = current;
+        size_t count = length / slices + (s < length % slices ? 1 : 0);
+        for (size_t i = 1; i < count; i++) current = current->next;
+        Node* next = current->next;
+        current->next = nullptr;
+        current = next;
+    }
+    
+    // Each task gets its own comparator copy; the first exception wins
+    std::vector<std::exception_ptr> errors(slices);
+    auto runTasks = [&](size_t count, auto task) {
+        std::vector<std::thread> workers;
+        workers.reserve(count);
+        for (size_t t = 0; t < count; t++) {
+            workers.emplace_back([&, t]() {
+                try {
+                    Compare localComp = comp;
+                    task(t, localComp);
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+    };
+    auto firstError = [&errors]() {
+        for (auto& error : errors) {
+            if (error) return error;
+        }
+        return std::exception_ptr();
+    };
+    
+    runTasks(slices, [&runs](size_t t, Compare& localComp) {
+        mergeSortChain(runs[t], localComp);
+    });
+    std::exception_ptr error = firstError();
+    for (size_t width = 1; !error && width < slices; width *= 2) {
+        runTasks((slices + 2 * width - 1) / (2 * width), [&runs, width, slices](size_t t, Compare& localComp) {
+            size_t left = 2 * width * t;
+            if (left + width < slices) {
+                mergeChains(runs[left], std::exchange(runs[left + width], nullptr), localComp);
+            }
+        });
+        error = firstError();
+    }
+    
+    // On failure, string the runs back together so no node is lost
+    Node** tail = &head;
+    for (Node* run : runs) {
+        if (!run) continue;
+        *tail = run;
+        while (*tail) tail = &(*tail)->next;
+    }
+    *tail = nullptr;
+    if (error) std::rethrow_exception(error);
+}
+
 // ============================================================================
 // SINGLY LINKED LIST
 // ============================================================================
@@ -38,6 +348,7 @@ class SinglyLinkedList {
 private:
     SinglyNode<T>* head;
     size_t listSize;
+    NodeCache<SinglyNode<T>> nodes;
     
     SinglyNode<T>* getNodeAt(size_t index) const {
         SinglyNode<T>* current = head;
@@ -47,107 +358,132 @@ private:
         return current;
     }
     
-    SinglyNode<T>* merge(SinglyNode<T>* left, SinglyNode<T>* right, 
-                         std::function<bool(const T&, const T&)> comp) {
-        if (!left) return right;
-        if (!right) return left;
-        
-        SinglyNode<T>* result = nullptr;
-        if (comp(left->data, right->data)) {
-            result = left;
-            result->next = merge(left->next, right, comp);
-        } else {
-            result = right;
-            result->next = merge(left, right->next, comp);
+    // The null link after the last node (&head when empty)
+    SinglyNode<T>** lastLink() {
+        SinglyNode<T>** link = &head;
+        while (*link) {
+            link = &(*link)->next;
         }
-        return result;
+        return link;
     }
     
-    SinglyNode<T>* mergeSort(SinglyNode<T>* node, 
-                             std::function<bool(const T&, const T&)> comp) {
-        if (!node || !node->next) return node;
-        
-        SinglyNode<T>* slow = node;
-        SinglyNode<T>* fast = node->next;
-        
-        while (fast && fast->next) {
-            slow = slow->next;
-            fast = fast->next->next;
+    template <typename... Args>
+    SinglyNode<T>* insertFirst(Args&&... args) {
+        SinglyNode<T>* newNode = nodes.create(std::in_place, std::forward<Args>(args)...);
+        newNode->next = head;
+        head = newNode;
+        listSize++;
+        return newNode;
+    }
+    
+    template <typename... Args>
+    SinglyNode<T>* insertLast(Args&&... args) {
+        SinglyNode<T>** link = lastLink();
+        *link = nodes.create(std::in_place, std::forward<Args>(args)...);
+        listSize++;
+        return *link;
+    }
+    
+    template <typename... Args>
+    SinglyNode<T>* insertAt(size_t index, Args&&... args) {
+        if (index > listSize) {
+            throw std::out_of_range("Index out of range");
         }
         
-        SinglyNode<T>* mid = slow->next;
-        slow->next = nullptr;
-        
-        SinglyNode<T>* left = mergeSort(node, comp);
-        SinglyNode<T>* right = mergeSort(mid, comp);
+        if (index == 0) {
+            return insertFirst(std::forward<Args>(args)...);
+        }
         
-        return merge(left, right, comp);
+        SinglyNode<T>* prev = getNodeAt(index - 1);
+        SinglyNode<T>* newNode = nodes.create(std::in_place, std::forward<Args>(args)...);
+        newNode->next = prev->next;
+        prev->next = newNode;
+        listSize++;
+        return newNode;
+    }
+    
+    // Append copies of a chain in one pass instead of one walk per element
+    void appendCopies(const SinglyNode<T>* source) {
+        SinglyNode<T>** link = lastLink();
+        for (; source; source = source->next) {
+            *link = nodes.create(source->data);
+            link = &(*link)->next;
+            listSize++;
+        }
     }
 
 public:
-    SinglyLinkedList() : head(nullptr), listSize(0) {}
+    explicit SinglyLinkedList(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : head(nullptr), listSize(0), nodes(resource) {}
     
     ~SinglyLinkedList() {
         clear();
     }
     
-    SinglyLinkedList(const SinglyLinkedList& other) : head(nullptr), listSize(0) {
-        SinglyNode<T>* current = other.head;
-        while (current) {
-            addLast(current->data);
-            current = current->next;
-        }
+    SinglyLinkedList(const SinglyLinkedList& other) : head(nullptr), listSize(0), nodes(other.nodes.resource()) {
+        appendCopies(other.head);
     }
     
+    SinglyLinkedList(SinglyLinkedList&& other) noexcept
+        : head(std::exchange(other.head, nullptr)), listSize(std::exchange(other.listSize, 0)),
+          nodes(std::move(other.nodes)) {}
+    
     SinglyLinkedList& operator=(const SinglyLinkedList& other) {
         if (this != &other) {
             clear();
-            SinglyNode<T>* current = other.head;
-            while (current) {
-                addLast(current->data);
-                current = current->next;
-            }
+            appendCopies(other.head);
+        }
+        return *this;
+    }
+    
+    SinglyLinkedList& operator=(SinglyLinkedList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head = std::exchange(other.head, nullptr);
+            listSize = std::exchange(other.listSize, 0);
+            nodes = std::move(other.nodes);
         }
         return *this;
     }
     
     void addFirst(const T& value) {
-        SinglyNode<T>* newNode = new SinglyNode<T>(value);
-        newNode->next = head;
-        head = newNode;
-        listSize++;
+        insertFirst(value);
+    }
+    
+    void addFirst(T&& value) {
+        insertFirst(std::move(value));
     }
     
     void addLast(const T& value) {
-        if (!head) {
-            addFirst(value);
-            return;
-        }
-        
-        SinglyNode<T>* current = head;
-        while (current->next) {
-            current = current->next;
-        }
-        
-        current->next = new SinglyNode<T>(value);
-        listSize++;
+        insertLast(value);
+    }
+    
+    void addLast(T&& value) {
+        insertLast(std::move(value));
     }
     
     void addAt(size_t index, const T& value) {
-        if (index > listSize) {
-            throw std::out_of_range("Index out of range");
-        }
-        
-        if (index == 0) {
-            addFirst(value);
-            return;
-        }
-        
-        SinglyNode<T>* prev = getNodeAt(index - 1);
-        SinglyNode<T>* newNode = new SinglyNode<T>(value);
-        newNode->next = prev->next;
-        prev->next = newNode;
-        listSize++;
+        insertAt(index, value);
+    }
+    
+    void addAt(size_t index, T&& value) {
+        insertAt(index, std::move(value));
+    }
+    
+    // Construct an element in place from args; returns a reference to it
+    template <typename... Args>
+    T& emplaceFront(Args&&... args) {
+        return insertFirst(std::forward<Args>(args)...)->data;
+    }
+    
+    template <typename... Args>
+    T& emplaceBack(Args&&... args) {
+        return insertLast(std::forward<Args>(args)...)->data;
+    }
+    
+    template <typename... Args>
+    T& emplaceAt(size_t index, Args&&... args) {
+        return insertAt(index, std::forward<Args>(args)...)->data;
     }
     
     T removeFirst() {
@@ -156,9 +492,9 @@ public:
         }
         
         SinglyNode<T>* temp = head;
-        T value = temp->data;
+        T value = std::move(temp->data);
         head = head->next;
-        delete temp;
+        nodes.destroy(temp);
         listSize--;
         return value;
     }
@@ -177,8 +513,8 @@ public:
             current = current->next;
         }
         
-        T value = current->next->data;
-        delete current->next;
+        T value = std::move(current->next->data);
+        nodes.destroy(current->next);
         current->next = nullptr;
         listSize--;
         return value;
@@ -195,9 +531,9 @@ public:
         
         SinglyNode<T>* prev = getNodeAt(index - 1);
         SinglyNode<T>* toDelete = prev->next;
-        T value = toDelete->data;
+        T value = std::move(toDelete->data);
         prev->next = toDelete->next;
-        delete toDelete;
+        nodes.destroy(toDelete);
         listSize--;
         return value;
     }
@@ -218,7 +554,7 @@ public:
         if (current->next) {
             SinglyNode<T>* toDelete = current->next;
             current->next = toDelete->next;
-            delete toDelete;
+            nodes.destroy(toDelete);
             listSize--;
             return true;
         }
@@ -299,7 +635,7 @@ public:
         while (head) {
             SinglyNode<T>* temp = head;
             head = head->next;
-            delete temp;
+            nodes.destroy(temp);
         }
         listSize = 0;
     }
@@ -319,64 +655,116 @@ public:
         head = prev;
     }
     
-    void sort(bool ascending = true) {
+    void sort(bool ascending = true, unsigned numThreads = 1) {
+        if (ascending) sort(std::less<T>(), numThreads);
+        else sort(std::greater<T>(), numThreads);
+    }
+    
+    // Stable merge sort with a custom order; numThreads > 1 (0 = all
+    // hardware threads) sorts slices of long lists concurrently
+    template <typename Compare>
+        requires std::is_invocable_r_v<bool, Compare&, const T&, const T&>
+    void sort(Compare comp, unsigned numThreads = 1) {
         if (!head || !head->next) return;
-        
-        auto comp = ascending ? 
-            [](const T& a, const T& b) { return a <= b; } :
-            [](const T& a, const T& b) { return a >= b; };
-        
-        head = mergeSort(head, comp);
+        parallelMergeSortChain(head, listSize, comp, numThreads);
     }
     
-    SinglyLinkedList operator+(const SinglyLinkedList& other) const {
+    SinglyLinkedList operator+(const SinglyLinkedList& other) const& {
         SinglyLinkedList result(*this);
-        SinglyNode<T>* current = other.head;
-        while (current) {
-            result.addLast(current->data);
-            current = current->next;
-        }
+        result.merge(other);
+        return result;
+    }
+    
+    SinglyLinkedList operator+(const SinglyLinkedList& other) && {
+        merge(other);
+        return std::move(*this);
+    }
+    
+    SinglyLinkedList operator+(SinglyLinkedList&& other) const& {
+        SinglyLinkedList result(*this);
+        result.merge(std::move(other));
         return result;
     }
     
+    SinglyLinkedList operator+(SinglyLinkedList&& other) && {
+        merge(std::move(other));
+        return std::move(*this);
+    }
+    
     void merge(const SinglyLinkedList& other) {
-        SinglyNode<T>* current = other.head;
-        while (current) {
-            addLast(current->data);
-            current = current->next;
+        if (this == &other) {
+            merge(SinglyLinkedList(other));
+            return;
+        }
+        appendCopies(other.head);
+    }
+    
+    // Moves other's nodes onto the end of this list and leaves it empty.
+    // No element is copied; still O(size()) because there is no tail
+    // pointer to find the end with.
+    void merge(SinglyLinkedList&& other) {
+        if (this == &other || !other.head) return;
+        SinglyNode<T>** link = lastLink();
+        if (nodes.compatible(other.nodes)) {
+            *link = std::exchange(other.head, nullptr);
+            listSize += std::exchange(other.listSize, 0);
+            return;
+        }
+        for (SinglyNode<T>* current = other.head; current; current = current->next) {
+            *link = nodes.create(std::in_place, std::move(current->data));
+            link = &(*link)->next;
+            listSize++;
         }
+        other.clear();
+    }
+    
+    // Release cached free nodes back to the memory resource
+    void shrinkToFit() {
+        nodes.shrink();
+    }
+    
+    std::pmr::memory_resource* resource() const {
+        return nodes.resource();
     }
     
     void display(bool use_color = false) const {
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
       //  std::cout << "Singly Linked List\n";
-        cprint(use_color, "Singly Linked List\n");
+        w.paint("Singly Linked List\n");
       //  std::cout << "    +---+\n";
-        cprint(use_color, "    +----+\n", BRIGHT_YELLOW);
+        w.paint("    +----+\n", BRIGHT_YELLOW);
       //  std::cout << "HEAD|";
       //  std::cout << std::endl;
-        cprint(use_color, "HEAD|", BRIGHT_MAGNETA, true);
+        w.paint("HEAD|", BRIGHT_MAGNETA, true);
         if (!head) {
       //      std::cout << "NULL| --> NULL\n";
-            cprint(use_color, "NULL| --> NULL\n", RED, true);
+            w.paint("NULL| --> NULL\n", RED, true);
        //     std::cout << "    +----+\n";
-            cprint(use_color, "    +----+\n", BRIGHT_YELLOW);
+            w.paint("    +----+\n", BRIGHT_YELLOW);
             return;
         }
         
         SinglyNode<T>* current = head;
         bool first = true;
         while (current) {
-            if (!first) cprint(use_color, "|", YELLOW);
-               cprint(use_color, current->data, BRIGHT_BLUE);
+            if (!first) w.paint("|", YELLOW);
+               w.paint(current->data, BRIGHT_BLUE);
                first = false;
          //   std::cout << "| --> ";
-               cprint(use_color, "| --> ", YELLOW);
+               w.paint("| --> ", YELLOW);
                current = current->next;
         }
       //  std::cout << "NULL\n";
-        cprint(use_color, "NULL\n", BRIGHT_RED);
+        w.paint("NULL\n", BRIGHT_RED);
      //   std::cout << "    +---+\n";
-        cprint(use_color, "    +----+\n", BRIGHT_YELLOW);
+        w.paint("    +----+\n", BRIGHT_YELLOW);
     }
 
 
@@ -410,6 +798,7 @@ private:
     DoublyNode<T>* head;
     DoublyNode<T>* tail;
     size_t listSize;
+    NodeCache<DoublyNode<T>> nodes;
     
     DoublyNode<T>* getNodeAt(size_t index) const {
         if (index < listSize / 2) {
@@ -427,35 +816,19 @@ private:
         }
     }
 
-public:
-    DoublyLinkedList() : head(nullptr), tail(nullptr), listSize(0) {}
-    
-    ~DoublyLinkedList() {
-        clear();
-    }
-    
-    DoublyLinkedList(const DoublyLinkedList& other) : head(nullptr), tail(nullptr), listSize(0) {
-        DoublyNode<T>* current = other.head;
-        while (current) {
-            addLast(current->data);
-            current = current->next;
-        }
-    }
-    
-    DoublyLinkedList& operator=(const DoublyLinkedList& other) {
-        if (this != &other) {
-            clear();
-            DoublyNode<T>* current = other.head;
-            while (current) {
-                addLast(current->data);
-                current = current->next;
-            }
+    // Restore prev pointers and tail after the chain was relinked via next
+    void relinkPrev() {
+        DoublyNode<T>* prev = nullptr;
+        for (DoublyNode<T>* current = head; current; current = current->next) {
+            current->prev = prev;
+            prev = current;
         }
-        return *this;
+        tail = prev;
     }
-    
-    void addFirst(const T& value) {
-        DoublyNode<T>* newNode = new DoublyNode<T>(value);
+
+    template <typename... Args>
+    DoublyNode<T>* insertFirst(Args&&... args) {
+        DoublyNode<T>* newNode = nodes.create(std::in_place, std::forward<Args>(args)...);
         if (!head) {
             head = tail = newNode;
         } else {
@@ -464,10 +837,12 @@ public:
             head = newNode;
         }
         listSize++;
+        return newNode;
     }
     
-    void addLast(const T& value) {
-        DoublyNode<T>* newNode = new DoublyNode<T>(value);
+    template <typename... Args>
+    DoublyNode<T>* insertLast(Args&&... args) {
+        DoublyNode<T>* newNode = nodes.create(std::in_place, std::forward<Args>(args)...);
         if (!tail) {
             head = tail = newNode;
         } else {
@@ -476,31 +851,108 @@ public:
             tail = newNode;
         }
         listSize++;
+        return newNode;
     }
     
-    void addAt(size_t index, const T& value) {
+    template <typename... Args>
+    DoublyNode<T>* insertAt(size_t index, Args&&... args) {
         if (index > listSize) {
             throw std::out_of_range("Index out of range");
         }
         
         if (index == 0) {
-            addFirst(value);
-            return;
+            return insertFirst(std::forward<Args>(args)...);
         }
         
         if (index == listSize) {
-            addLast(value);
-            return;
+            return insertLast(std::forward<Args>(args)...);
         }
         
         DoublyNode<T>* current = getNodeAt(index);
-        DoublyNode<T>* newNode = new DoublyNode<T>(value);
+        DoublyNode<T>* newNode = nodes.create(std::in_place, std::forward<Args>(args)...);
         
         newNode->prev = current->prev;
         newNode->next = current;
         current->prev->next = newNode;
         current->prev = newNode;
         listSize++;
+        return newNode;
+    }
+
+public:
+    explicit DoublyLinkedList(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : head(nullptr), tail(nullptr), listSize(0), nodes(resource) {}
+    
+    ~DoublyLinkedList() {
+        clear();
+    }
+    
+    DoublyLinkedList(const DoublyLinkedList& other)
+        : head(nullptr), tail(nullptr), listSize(0), nodes(other.nodes.resource()) {
+        merge(other);
+    }
+    
+    DoublyLinkedList(DoublyLinkedList&& other) noexcept
+        : head(std::exchange(other.head, nullptr)), tail(std::exchange(other.tail, nullptr)),
+          listSize(std::exchange(other.listSize, 0)), nodes(std::move(other.nodes)) {}
+    
+    DoublyLinkedList& operator=(const DoublyLinkedList& other) {
+        if (this != &other) {
+            clear();
+            merge(other);
+        }
+        return *this;
+    }
+    
+    DoublyLinkedList& operator=(DoublyLinkedList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head = std::exchange(other.head, nullptr);
+            tail = std::exchange(other.tail, nullptr);
+            listSize = std::exchange(other.listSize, 0);
+            nodes = std::move(other.nodes);
+        }
+        return *this;
+    }
+    
+    void addFirst(const T& value) {
+        insertFirst(value);
+    }
+    
+    void addFirst(T&& value) {
+        insertFirst(std::move(value));
+    }
+    
+    void addLast(const T& value) {
+        insertLast(value);
+    }
+    
+    void addLast(T&& value) {
+        insertLast(std::move(value));
+    }
+    
+    void addAt(size_t index, const T& value) {
+        insertAt(index, value);
+    }
+    
+    void addAt(size_t index, T&& value) {
+        insertAt(index, std::move(value));
+    }
+    
+    // Construct an element in place from args; returns a reference to it
+    template <typename... Args>
+    T& emplaceFront(Args&&... args) {
+        return insertFirst(std::forward<Args>(args)...)->data;
+    }
+    
+    template <typename... Args>
+    T& emplaceBack(Args&&... args) {
+        return insertLast(std::forward<Args>(args)...)->data;
+    }
+    
+    template <typename... Args>
+    T& emplaceAt(size_t index, Args&&... args) {
+        return insertAt(index, std::forward<Args>(args)...)->data;
     }
     
     T removeFirst() {
@@ -509,7 +961,7 @@ public:
         }
         
         DoublyNode<T>* temp = head;
-        T value = temp->data;
+        T value = std::move(temp->data);
         
         if (head == tail) {
             head = tail = nullptr;
@@ -518,7 +970,7 @@ public:
             head->prev = nullptr;
         }
         
-        delete temp;
+        nodes.destroy(temp);
         listSize--;
         return value;
     }
@@ -529,7 +981,7 @@ public:
         }
         
         DoublyNode<T>* temp = tail;
-        T value = temp->data;
+        T value = std::move(temp->data);
         
         if (head == tail) {
             head = tail = nullptr;
@@ -538,7 +990,7 @@ public:
             tail->next = nullptr;
         }
         
-        delete temp;
+        nodes.destroy(temp);
         listSize--;
         return value;
     }
@@ -557,12 +1009,12 @@ public:
         }
         
         DoublyNode<T>* toDelete = getNodeAt(index);
-        T value = toDelete->data;
+        T value = std::move(toDelete->data);
         
         toDelete->prev->next = toDelete->next;
         toDelete->next->prev = toDelete->prev;
         
-        delete toDelete;
+        nodes.destroy(toDelete);
         listSize--;
         return value;
     }
@@ -578,7 +1030,7 @@ public:
                 } else {
                     current->prev->next = current->next;
                     current->next->prev = current->prev;
-                    delete current;
+                    nodes.destroy(current);
                     listSize--;
                 }
                 return true;
@@ -658,7 +1110,7 @@ public:
         while (head) {
             DoublyNode<T>* temp = head;
             head = head->next;
-            delete temp;
+            nodes.destroy(temp);
         }
         tail = nullptr;
         listSize = 0;
@@ -681,79 +1133,130 @@ public:
         }
     }
     
-    void sort(bool ascending = true) {
+    void sort(bool ascending = true, unsigned numThreads = 1) {
+        if (ascending) sort(std::less<T>(), numThreads);
+        else sort(std::greater<T>(), numThreads);
+    }
+    
+    // Stable merge sort with a custom order; numThreads > 1 (0 = all
+    // hardware threads) sorts slices of long lists concurrently
+    template <typename Compare>
+        requires std::is_invocable_r_v<bool, Compare&, const T&, const T&>
+    void sort(Compare comp, unsigned numThreads = 1) {
         if (!head || !head->next) return;
-        
-        bool swapped;
-        do {
-            swapped = false;
-            DoublyNode<T>* current = head;
-            while (current->next) {
-                bool shouldSwap = ascending ? 
-                    (current->data > current->next->data) :
-                    (current->data < current->next->data);
-                
-                if (shouldSwap) {
-                    T temp = current->data;
-                    current->data = current->next->data;
-                    current->next->data = temp;
-                    swapped = true;
-                }
-                current = current->next;
-            }
-        } while (swapped);
+        try {
+            parallelMergeSortChain(head, listSize, comp, numThreads);
+        } catch (...) {
+            relinkPrev();
+            throw;
+        }
+        relinkPrev();
     }
     
-    DoublyLinkedList operator+(const DoublyLinkedList& other) const {
+    DoublyLinkedList operator+(const DoublyLinkedList& other) const& {
         DoublyLinkedList result(*this);
-        DoublyNode<T>* current = other.head;
-        while (current) {
-            result.addLast(current->data);
-            current = current->next;
-        }
+        result.merge(other);
+        return result;
+    }
+    
+    DoublyLinkedList operator+(const DoublyLinkedList& other) && {
+        merge(other);
+        return std::move(*this);
+    }
+    
+    DoublyLinkedList operator+(DoublyLinkedList&& other) const& {
+        DoublyLinkedList result(*this);
+        result.merge(std::move(other));
         return result;
     }
     
+    DoublyLinkedList operator+(DoublyLinkedList&& other) && {
+        merge(std::move(other));
+        return std::move(*this);
+    }
+    
     void merge(const DoublyLinkedList& other) {
-        DoublyNode<T>* current = other.head;
-        while (current) {
-            addLast(current->data);
-            current = current->next;
+        if (this == &other) {
+            merge(DoublyLinkedList(other));
+            return;
+        }
+        for (DoublyNode<T>* current = other.head; current; current = current->next) {
+            insertLast(current->data);
         }
     }
     
+    // O(1): links other's nodes onto the end of this list and leaves it
+    // empty. Elements are moved one by one only if the two lists allocate
+    // from incompatible memory resources.
+    void merge(DoublyLinkedList&& other) {
+        if (this == &other || !other.head) return;
+        if (!nodes.compatible(other.nodes)) {
+            for (DoublyNode<T>* current = other.head; current; current = current->next) {
+                insertLast(std::move(current->data));
+            }
+            other.clear();
+            return;
+        }
+        if (!head) {
+            head = other.head;
+        } else {
+            tail->next = other.head;
+            other.head->prev = tail;
+        }
+        tail = std::exchange(other.tail, nullptr);
+        other.head = nullptr;
+        listSize += std::exchange(other.listSize, 0);
+    }
+    
+    // Release cached free nodes back to the memory resource
+    void shrinkToFit() {
+        nodes.shrink();
+    }
+    
+    std::pmr::memory_resource* resource() const {
+        return nodes.resource();
+    }
+    
     void display(bool use_color = false) const {
-        cprint(use_color, "Doubly Linked List:\n");
-        cprint(use_color, "             +---+\n", BRIGHT_YELLOW);
-        cprint(use_color, "NULL <-- HEAD|", MAGNETA);
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("Doubly Linked List:\n");
+        w.paint("             +---+\n", BRIGHT_YELLOW);
+        w.paint("NULL <-- HEAD|", MAGNETA);
         if (!head) {
-            cprint(use_color, "NULL|\n", BRIGHT_RED);
-            cprint(use_color, "             +---+", BRIGHT_YELLOW);
-            cprint(use_color, " <--\n", GREEN);
+            w.paint("NULL|\n", BRIGHT_RED);
+            w.paint("             +---+", BRIGHT_YELLOW);
+            w.paint(" <--\n", GREEN);
             return;
         }
 
         DoublyNode<T>* current = head;
         bool first = true;
         while (current) {
-            if (!first) cprint(use_color, "|", YELLOW);
-            cprint(use_color, current->data, BRIGHT_BLUE);
+            if (!first) w.paint("|", YELLOW);
+            w.paint(current->data, BRIGHT_BLUE);
             first = false;
-            cprint(use_color, "| --> ", GREEN);
+            w.paint("| --> ", GREEN);
             current = current->next;
         }
-        cprint(use_color, "NULL\n", BRIGHT_RED);
-        cprint(use_color, "             +---+", BRIGHT_YELLOW);
-        cprint(use_color, " <-- ", GREEN);
+        w.paint("NULL\n", BRIGHT_RED);
+        w.paint("             +---+", BRIGHT_YELLOW);
+        w.paint(" <-- ", GREEN);
 
         current = tail;
         while (current) {
-            cprint(use_color, " ");
-            cprint(use_color, current->data, BRIGHT_BLUE);
-            cprint(use_color, " <--", GREEN);
+            w.paint(" ");
+            w.paint(current->data, BRIGHT_BLUE);
+            w.paint(" <--", GREEN);
             current = current->prev;
         }
-        std::cout << "\n";
+        w << "\n";
     }
 
 
@@ -789,6 +1292,7 @@ class CircularLinkedList {
 private:
     SinglyNode<T>* tail;  // Pointing to last node for O(1) front/back access
     size_t listSize;
+    NodeCache<SinglyNode<T>> nodes;
     
     SinglyNode<T>* getNodeAt(size_t index) const {
         if (!tail) return nullptr;
@@ -800,42 +1304,9 @@ private:
         return current;
     }
 
-public:
-    CircularLinkedList() : tail(nullptr), listSize(0) {}
-    
-    ~CircularLinkedList() {
-        clear();
-    }
-    
-    // Copy constructor
-    CircularLinkedList(const CircularLinkedList& other) : tail(nullptr), listSize(0) {
-        if (!other.tail) return;
-        
-        SinglyNode<T>* current = other.tail->next;
-        do {
-            addLast(current->data);
-            current = current->next;
-        } while (current != other.tail->next);
-    }
-    
-    // Assignment operator
-    CircularLinkedList& operator=(const CircularLinkedList& other) {
-        if (this != &other) {
-            clear();
-            if (other.tail) {
-                SinglyNode<T>* current = other.tail->next;
-                do {
-                    addLast(current->data);
-                    current = current->next;
-                } while (current != other.tail->next);
-            }
-        }
-        return *this;
-    }
-    
-    // Adding elements
-    void addFirst(const T& value) {
-        SinglyNode<T>* newNode = new SinglyNode<T>(value);
+    template <typename... Args>
+    SinglyNode<T>* insertFirst(Args&&... args) {
+        SinglyNode<T>* newNode = nodes.create(std::in_place, std::forward<Args>(args)...);
         
         if (!tail) {
             tail = newNode;
@@ -845,33 +1316,113 @@ public:
             tail->next = newNode;
         }
         listSize++;
+        return newNode;
     }
     
-    void addLast(const T& value) {
-        addFirst(value);
+    template <typename... Args>
+    SinglyNode<T>* insertLast(Args&&... args) {
+        insertFirst(std::forward<Args>(args)...);
         tail = tail->next;
+        return tail;
     }
     
-    void addAt(size_t index, const T& value) {
+    template <typename... Args>
+    SinglyNode<T>* insertAt(size_t index, Args&&... args) {
         if (index > listSize) {
             throw std::out_of_range("Index out of range");
         }
         
         if (index == 0) {
-            addFirst(value);
-            return;
+            return insertFirst(std::forward<Args>(args)...);
         }
         
         if (index == listSize) {
-            addLast(value);
-            return;
+            return insertLast(std::forward<Args>(args)...);
         }
         
         SinglyNode<T>* prev = getNodeAt(index - 1);
-        SinglyNode<T>* newNode = new SinglyNode<T>(value);
+        SinglyNode<T>* newNode = nodes.create(std::in_place, std::forward<Args>(args)...);
         newNode->next = prev->next;
         prev->next = newNode;
         listSize++;
+        return newNode;
+    }
+
+public:
+    explicit CircularLinkedList(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : tail(nullptr), listSize(0), nodes(resource) {}
+    
+    ~CircularLinkedList() {
+        clear();
+    }
+    
+    // Copy constructor
+    CircularLinkedList(const CircularLinkedList& other) : tail(nullptr), listSize(0), nodes(other.nodes.resource()) {
+        merge(other);
+    }
+    
+    CircularLinkedList(CircularLinkedList&& other) noexcept
+        : tail(std::exchange(other.tail, nullptr)), listSize(std::exchange(other.listSize, 0)),
+          nodes(std::move(other.nodes)) {}
+    
+    // Assignment operator
+    CircularLinkedList& operator=(const CircularLinkedList& other) {
+        if (this != &other) {
+            clear();
+            merge(other);
+        }
+        return *this;
+    }
+    
+    CircularLinkedList& operator=(CircularLinkedList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            tail = std::exchange(other.tail, nullptr);
+            listSize = std::exchange(other.listSize, 0);
+            nodes = std::move(other.nodes);
+        }
+        return *this;
+    }
+    
+    // Adding elements
+    void addFirst(const T& value) {
+        insertFirst(value);
+    }
+    
+    void addFirst(T&& value) {
+        insertFirst(std::move(value));
+    }
+    
+    void addLast(const T& value) {
+        insertLast(value);
+    }
+    
+    void addLast(T&& value) {
+        insertLast(std::move(value));
+    }
+    
+    void addAt(size_t index, const T& value) {
+        insertAt(index, value);
+    }
+    
+    void addAt(size_t index, T&& value) {
+        insertAt(index, std::move(value));
+    }
+    
+    // Construct an element in place from args; returns a reference to it
+    template <typename... Args>
+    T& emplaceFront(Args&&... args) {
+        return insertFirst(std::forward<Args>(args)...)->data;
+    }
+    
+    template <typename... Args>
+    T& emplaceBack(Args&&... args) {
+        return insertLast(std::forward<Args>(args)...)->data;
+    }
+    
+    template <typename... Args>
+    T& emplaceAt(size_t index, Args&&... args) {
+        return insertAt(index, std::forward<Args>(args)...)->data;
     }
     
     // Removing elements
@@ -881,14 +1432,14 @@ public:
         }
         
         SinglyNode<T>* head = tail->next;
-        T value = head->data;
+        T value = std::move(head->data);
         
         if (tail == head) {
-            delete tail;
+            nodes.destroy(tail);
             tail = nullptr;
         } else {
             tail->next = head->next;
-            delete head;
+            nodes.destroy(head);
         }
         
         listSize--;
@@ -900,10 +1451,10 @@ public:
             throw std::runtime_error("List is empty");
         }
         
-        T value = tail->data;
+        T value = std::move(tail->data);
         
         if (tail->next == tail) {
-            delete tail;
+            nodes.destroy(tail);
             tail = nullptr;
         } else {
             SinglyNode<T>* current = tail->next;
@@ -911,7 +1462,7 @@ public:
                 current = current->next;
             }
             current->next = tail->next;
-            delete tail;
+            nodes.destroy(tail);
             tail = current;
         }
         
@@ -934,9 +1485,9 @@ public:
         
         SinglyNode<T>* prev = getNodeAt(index - 1);
         SinglyNode<T>* toDelete = prev->next;
-        T value = toDelete->data;
+        T value = std::move(toDelete->data);
         prev->next = toDelete->next;
-        delete toDelete;
+        nodes.destroy(toDelete);
         listSize--;
         return value;
     }
@@ -959,7 +1510,7 @@ public:
                     tail = current;
                 }
                 current->next = toDelete->next;
-                delete toDelete;
+                nodes.destroy(toDelete);
                 listSize--;
                 return true;
             }
@@ -1053,7 +1604,7 @@ public:
         do {
             SinglyNode<T>* temp = current;
             current = current->next;
-            delete temp;
+            nodes.destroy(temp);
         } while (current != head);
         
         tail = nullptr;
@@ -1078,67 +1629,121 @@ public:
         tail = head;
     }
     
-    void sort(bool ascending = true) {
+    void sort(bool ascending = true, unsigned numThreads = 1) {
+        if (ascending) sort(std::less<T>(), numThreads);
+        else sort(std::greater<T>(), numThreads);
+    }
+    
+    // Stable merge sort with a custom order; numThreads > 1 (0 = all
+    // hardware threads) sorts slices of long lists concurrently
+    template <typename Compare>
+        requires std::is_invocable_r_v<bool, Compare&, const T&, const T&>
+    void sort(Compare comp, unsigned numThreads = 1) {
         if (!tail || tail->next == tail) return;
         
-        bool swapped;
-        do {
-            swapped = false;
-            SinglyNode<T>* current = tail->next;
-            SinglyNode<T>* next = current->next;
-            
-            do {
-                bool shouldSwap = ascending ? 
-                    (current->data > next->data) :
-                    (current->data < next->data);
-                
-                if (shouldSwap) {
-                    T temp = current->data;
-                    current->data = next->data;
-                    next->data = temp;
-                    swapped = true;
-                }
-                
-                current = next;
-                next = next->next;
-            } while (current != tail);
-        } while (swapped);
+        // Open the ring, sort the chain, then close it at the new last node
+        SinglyNode<T>* head = tail->next;
+        tail->next = nullptr;
+        auto close = [this, &head]() {
+            SinglyNode<T>* last = head;
+            while (last->next) last = last->next;
+            last->next = head;
+            tail = last;
+        };
+        try {
+            parallelMergeSortChain(head, listSize, comp, numThreads);
+        } catch (...) {
+            close();
+            throw;
+        }
+        close();
     }
     
     // Merging
-    CircularLinkedList operator+(const CircularLinkedList& other) const {
+    CircularLinkedList operator+(const CircularLinkedList& other) const& {
         CircularLinkedList result(*this);
-        if (other.tail) {
-            SinglyNode<T>* current = other.tail->next;
-            do {
-                result.addLast(current->data);
-                current = current->next;
-            } while (current != other.tail->next);
-        }
+        result.merge(other);
+        return result;
+    }
+    
+    CircularLinkedList operator+(const CircularLinkedList& other) && {
+        merge(other);
+        return std::move(*this);
+    }
+    
+    CircularLinkedList operator+(CircularLinkedList&& other) const& {
+        CircularLinkedList result(*this);
+        result.merge(std::move(other));
         return result;
     }
     
+    CircularLinkedList operator+(CircularLinkedList&& other) && {
+        merge(std::move(other));
+        return std::move(*this);
+    }
+    
     void merge(const CircularLinkedList& other) {
+        if (this == &other) {
+            merge(CircularLinkedList(other));
+            return;
+        }
         if (other.tail) {
             SinglyNode<T>* current = other.tail->next;
             do {
-                addLast(current->data);
+                insertLast(current->data);
                 current = current->next;
             } while (current != other.tail->next);
         }
     }
     
+    // O(1): splices other's ring in after tail and leaves it empty.
+    // Elements are moved one by one only if the two lists allocate from
+    // incompatible memory resources.
+    void merge(CircularLinkedList&& other) {
+        if (this == &other || !other.tail) return;
+        if (!nodes.compatible(other.nodes)) {
+            while (other.tail) {
+                insertLast(other.removeFirst());
+            }
+            return;
+        }
+        if (tail) {
+            SinglyNode<T>* head = tail->next;
+            tail->next = other.tail->next;
+            other.tail->next = head;
+        }
+        tail = std::exchange(other.tail, nullptr);
+        listSize += std::exchange(other.listSize, 0);
+    }
+    
+    // Release cached free nodes back to the memory resource
+    void shrinkToFit() {
+        nodes.shrink();
+    }
+    
+    std::pmr::memory_resource* resource() const {
+        return nodes.resource();
+    }
+    
     // Display
     void display(bool use_color = false) const {
-        cprint(use_color, "Circular Linked List:\n");
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("Circular Linked List:\n");
         if (!tail) {
-            cprint(use_color, "    +----+\n", BRIGHT_YELLOW);
-            cprint(use_color, "HEAD|NULL|\n", BRIGHT_RED);
-            cprint(use_color, "    +----+\n", BRIGHT_YELLOW);
+            w.paint("    +----+\n", BRIGHT_YELLOW);
+            w.paint("HEAD|NULL|\n", BRIGHT_RED);
+            w.paint("    +----+\n", BRIGHT_YELLOW);
             return;
         }
         
-        cprint(use_color, "    +---+  ", BRIGHT_YELLOW);
+        w.paint("    +---+  ", BRIGHT_YELLOW);
         
         SinglyNode<T>* current = tail->next;
         int nodeCount = 0;
@@ -1150,37 +1755,37 @@ public:
         
         // Print top border for tail
         for (int i = 1; i < nodeCount; i++) {
-            std::cout << "        ";
+            w << "        ";
         }
-        cprint(use_color, "+---+\n", BRIGHT_YELLOW);
+        w.paint("+---+\n", BRIGHT_YELLOW);
         // Print nodes
-        cprint(use_color, "HEAD|", BRIGHT_MAGNETA, true);
-        cprint(use_color, current->data, BRIGHT_BLUE);
-        cprint(use_color, "|", YELLOW);
+        w.paint("HEAD|", BRIGHT_MAGNETA, true);
+        w.paint(current->data, BRIGHT_BLUE);
+        w.paint("|", YELLOW);
         current = current->next;
         
         while (current != tail->next) {
-            cprint(use_color, " -->", GREEN);
-            cprint(use_color, " |", YELLOW);
-            cprint(use_color, current->data, BRIGHT_BLUE);
-            cprint(use_color, "|", YELLOW);
+            w.paint(" -->", GREEN);
+            w.paint(" |", YELLOW);
+            w.paint(current->data, BRIGHT_BLUE);
+            w.paint("|", YELLOW);
             current = current->next;
         }
-        std::cout << "\n";
+        w << "\n";
         
         // Print bottom border
-        cprint(use_color, "    +---+", BRIGHT_YELLOW);
+        w.paint("    +---+", BRIGHT_YELLOW);
         for (int i = 1; i < nodeCount; i++) {
-            std::cout << "       ";
+            w << "       ";
         }
-        cprint(use_color, "      +---+\n", BRIGHT_YELLOW);
+        w.paint("      +---+\n", BRIGHT_YELLOW);
         
         // Print connection line
-        cprint(use_color, "      |", BRIGHT_CYAN);
+        w.paint("      |", BRIGHT_CYAN);
         for (int i = 1; i < nodeCount; i++) {
-            cprint(use_color, "---------", BRIGHT_CYAN);
+            w.paint("---------", BRIGHT_CYAN);
         }
-        cprint(use_color, "----|\n", BRIGHT_CYAN);
+        w.paint("----|\n", BRIGHT_CYAN);
     }
 
 
@@ -1227,6 +1832,7 @@ class CircularDoublyLinkedList {
 private:
     DoublyNode<T>* head;
     size_t listSize;
+    NodeCache<DoublyNode<T>> nodes;
     
     DoublyNode<T>* getNodeAt(size_t index) const {
         if (!head) return nullptr;
@@ -1244,39 +1850,9 @@ private:
         return current;
     }
 
-public:
-    CircularDoublyLinkedList() : head(nullptr), listSize(0) {}
-    
-    ~CircularDoublyLinkedList() {
-        clear();
-    }
-    
-    CircularDoublyLinkedList(const CircularDoublyLinkedList& other) : head(nullptr), listSize(0) {
-        if (!other.head) return;
-        
-        DoublyNode<T>* current = other.head;
-        do {
-            addLast(current->data);
-            current = current->next;
-        } while (current != other.head);
-    }
-    
-    CircularDoublyLinkedList& operator=(const CircularDoublyLinkedList& other) {
-        if (this != &other) {
-            clear();
-            if (other.head) {
-                DoublyNode<T>* current = other.head;
-                do {
-                    addLast(current->data);
-                    current = current->next;
-                } while (current != other.head);
-            }
-        }
-        return *this;
-    }
-    
-    void addFirst(const T& value) {
-        DoublyNode<T>* newNode = new DoublyNode<T>(value);
+    template <typename... Args>
+    DoublyNode<T>* insertFirst(Args&&... args) {
+        DoublyNode<T>* newNode = nodes.create(std::in_place, std::forward<Args>(args)...);
         
         if (!head) {
             head = newNode;
@@ -1291,15 +1867,16 @@ public:
             head = newNode;
         }
         listSize++;
+        return newNode;
     }
     
-    void addLast(const T& value) {
+    template <typename... Args>
+    DoublyNode<T>* insertLast(Args&&... args) {
         if (!head) {
-            addFirst(value);
-            return;
+            return insertFirst(std::forward<Args>(args)...);
         }
         
-        DoublyNode<T>* newNode = new DoublyNode<T>(value);
+        DoublyNode<T>* newNode = nodes.create(std::in_place, std::forward<Args>(args)...);
         DoublyNode<T>* tail = head->prev;
         
         newNode->next = head;
@@ -1307,31 +1884,107 @@ public:
         tail->next = newNode;
         head->prev = newNode;
         listSize++;
+        return newNode;
     }
     
-    void addAt(size_t index, const T& value) {
+    template <typename... Args>
+    DoublyNode<T>* insertAt(size_t index, Args&&... args) {
         if (index > listSize) {
             throw std::out_of_range("Index out of range");
         }
         
         if (index == 0) {
-            addFirst(value);
-            return;
+            return insertFirst(std::forward<Args>(args)...);
         }
         
         if (index == listSize) {
-            addLast(value);
-            return;
+            return insertLast(std::forward<Args>(args)...);
         }
         
         DoublyNode<T>* current = getNodeAt(index);
-        DoublyNode<T>* newNode = new DoublyNode<T>(value);
+        DoublyNode<T>* newNode = nodes.create(std::in_place, std::forward<Args>(args)...);
         
         newNode->prev = current->prev;
         newNode->next = current;
         current->prev->next = newNode;
         current->prev = newNode;
         listSize++;
+        return newNode;
+    }
+
+public:
+    explicit CircularDoublyLinkedList(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : head(nullptr), listSize(0), nodes(resource) {}
+    
+    ~CircularDoublyLinkedList() {
+        clear();
+    }
+    
+    CircularDoublyLinkedList(const CircularDoublyLinkedList& other)
+        : head(nullptr), listSize(0), nodes(other.nodes.resource()) {
+        merge(other);
+    }
+    
+    CircularDoublyLinkedList(CircularDoublyLinkedList&& other) noexcept
+        : head(std::exchange(other.head, nullptr)), listSize(std::exchange(other.listSize, 0)),
+          nodes(std::move(other.nodes)) {}
+    
+    CircularDoublyLinkedList& operator=(const CircularDoublyLinkedList& other) {
+        if (this != &other) {
+            clear();
+            merge(other);
+        }
+        return *this;
+    }
+    
+    CircularDoublyLinkedList& operator=(CircularDoublyLinkedList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head = std::exchange(other.head, nullptr);
+            listSize = std::exchange(other.listSize, 0);
+            nodes = std::move(other.nodes);
+        }
+        return *this;
+    }
+    
+    void addFirst(const T& value) {
+        insertFirst(value);
+    }
+    
+    void addFirst(T&& value) {
+        insertFirst(std::move(value));
+    }
+    
+    void addLast(const T& value) {
+        insertLast(value);
+    }
+    
+    void addLast(T&& value) {
+        insertLast(std::move(value));
+    }
+    
+    void addAt(size_t index, const T& value) {
+        insertAt(index, value);
+    }
+    
+    void addAt(size_t index, T&& value) {
+        insertAt(index, std::move(value));
+    }
+    
+    // Construct an element in place from args; returns a reference to it
+    template <typename... Args>
+    T& emplaceFront(Args&&... args) {
+        return insertFirst(std::forward<Args>(args)...)->data;
+    }
+    
+    template <typename... Args>
+    T& emplaceBack(Args&&... args) {
+        return insertLast(std::forward<Args>(args)...)->data;
+    }
+    
+    template <typename... Args>
+    T& emplaceAt(size_t index, Args&&... args) {
+        return insertAt(index, std::forward<Args>(args)...)->data;
     }
     
     T removeFirst() {
@@ -1340,17 +1993,17 @@ public:
         }
         
         DoublyNode<T>* temp = head;
-        T value = temp->data;
+        T value = std::move(temp->data);
         
         if (head->next == head) {
-            delete head;
+            nodes.destroy(head);
             head = nullptr;
         } else {
             DoublyNode<T>* tail = head->prev;
             head = head->next;
             head->prev = tail;
             tail->next = head;
-            delete temp;
+            nodes.destroy(temp);
         }
         
         listSize--;
@@ -1367,11 +2020,11 @@ public:
         }
         
         DoublyNode<T>* tail = head->prev;
-        T value = tail->data;
+        T value = std::move(tail->data);
         
         tail->prev->next = head;
         head->prev = tail->prev;
-        delete tail;
+        nodes.destroy(tail);
         
         listSize--;
         return value;
@@ -1391,12 +2044,12 @@ public:
         }
         
         DoublyNode<T>* toDelete = getNodeAt(index);
-        T value = toDelete->data;
+        T value = std::move(toDelete->data);
         
         toDelete->prev->next = toDelete->next;
         toDelete->next->prev = toDelete->prev;
         
-        delete toDelete;
+        nodes.destroy(toDelete);
         listSize--;
         return value;
     }
@@ -1408,7 +2061,7 @@ public:
         do {
             if (current->data == value) {
                 if (current == head && head->next == head) {
-                    delete head;
+                    nodes.destroy(head);
                     head = nullptr;
                 } else {
                     current->prev->next = current->next;
@@ -1416,7 +2069,7 @@ public:
                     if (current == head) {
                         head = head->next;
                     }
-                    delete current;
+                    nodes.destroy(current);
                 }
                 listSize--;
                 return true;
@@ -1507,7 +2160,7 @@ public:
         do {
             DoublyNode<T>* temp = current;
             current = current->next;
-            delete temp;
+            nodes.destroy(temp);
         } while (current != head);
         
         head = nullptr;
@@ -1528,65 +2181,128 @@ public:
         head = head->next;
     }
     
-    void sort(bool ascending = true) {
+    void sort(bool ascending = true, unsigned numThreads = 1) {
+        if (ascending) sort(std::less<T>(), numThreads);
+        else sort(std::greater<T>(), numThreads);
+    }
+    
+    // Stable merge sort with a custom order; numThreads > 1 (0 = all
+    // hardware threads) sorts slices of long lists concurrently
+    template <typename Compare>
+        requires std::is_invocable_r_v<bool, Compare&, const T&, const T&>
+    void sort(Compare comp, unsigned numThreads = 1) {
         if (!head || head->next == head) return;
         
-        bool swapped;
-        do {
-            swapped = false;
-            DoublyNode<T>* current = head;
-            
-            do {
-                bool shouldSwap = ascending ? 
-                    (current->data > current->next->data) :
-                    (current->data < current->next->data);
-                
-                if (current->next != head && shouldSwap) {
-                    T temp = current->data;
-                    current->data = current->next->data;
-                    current->next->data = temp;
-                    swapped = true;
-                }
-                
-                current = current->next;
-            } while (current->next != head);
-        } while (swapped);
+        // Open the ring, sort the chain, then restore prev and the ring links
+        head->prev->next = nullptr;
+        auto close = [this]() {
+            DoublyNode<T>* prev = nullptr;
+            for (DoublyNode<T>* current = head; current; current = current->next) {
+                current->prev = prev;
+                prev = current;
+            }
+            prev->next = head;
+            head->prev = prev;
+        };
+        try {
+            parallelMergeSortChain(head, listSize, comp, numThreads);
+        } catch (...) {
+            close();
+            throw;
+        }
+        close();
     }
     
-    CircularDoublyLinkedList operator+(const CircularDoublyLinkedList& other) const {
+    CircularDoublyLinkedList operator+(const CircularDoublyLinkedList& other) const& {
         CircularDoublyLinkedList result(*this);
-        if (other.head) {
-            DoublyNode<T>* current = other.head;
-            do {
-                result.addLast(current->data);
-                current = current->next;
-            } while (current != other.head);
-        }
+        result.merge(other);
+        return result;
+    }
+    
+    CircularDoublyLinkedList operator+(const CircularDoublyLinkedList& other) && {
+        merge(other);
+        return std::move(*this);
+    }
+    
+    CircularDoublyLinkedList operator+(CircularDoublyLinkedList&& other) const& {
+        CircularDoublyLinkedList result(*this);
+        result.merge(std::move(other));
         return result;
     }
     
+    CircularDoublyLinkedList operator+(CircularDoublyLinkedList&& other) && {
+        merge(std::move(other));
+        return std::move(*this);
+    }
+    
     void merge(const CircularDoublyLinkedList& other) {
+        if (this == &other) {
+            merge(CircularDoublyLinkedList(other));
+            return;
+        }
         if (other.head) {
             DoublyNode<T>* current = other.head;
             do {
-                addLast(current->data);
+                insertLast(current->data);
                 current = current->next;
             } while (current != other.head);
         }
     }
     
+    // O(1): splices other's ring in before head and leaves it empty.
+    // Elements are moved one by one only if the two lists allocate from
+    // incompatible memory resources.
+    void merge(CircularDoublyLinkedList&& other) {
+        if (this == &other || !other.head) return;
+        if (!nodes.compatible(other.nodes)) {
+            while (other.head) {
+                insertLast(other.removeFirst());
+            }
+            return;
+        }
+        if (!head) {
+            head = other.head;
+        } else {
+            DoublyNode<T>* tail = head->prev;
+            DoublyNode<T>* otherTail = other.head->prev;
+            tail->next = other.head;
+            other.head->prev = tail;
+            otherTail->next = head;
+            head->prev = otherTail;
+        }
+        other.head = nullptr;
+        listSize += std::exchange(other.listSize, 0);
+    }
+    
+    // Release cached free nodes back to the memory resource
+    void shrinkToFit() {
+        nodes.shrink();
+    }
+    
+    std::pmr::memory_resource* resource() const {
+        return nodes.resource();
+    }
+    
     void display(bool use_color = false) const {
-        std::cout << "Doubly Circular Linked List\n";
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w << "Doubly Circular Linked List\n";
         
         if (!head) {
-            cprint(use_color, "    +----+\n", BRIGHT_YELLOW);
-            cprint(use_color, "HEAD|NULL\n", MAGNETA, true);
-            cprint(use_color, "    +----+\n", BRIGHT_YELLOW);
+            w.paint("    +----+\n", BRIGHT_YELLOW);
+            w.paint("HEAD|NULL\n", MAGNETA, true);
+            w.paint("    +----+\n", BRIGHT_YELLOW);
             return;
         }
         
-        std::cout << "\n";
-        cprint(use_color, "    +---+ ", BRIGHT_YELLOW);
+        w << "\n";
+        w.paint("    +---+ ", BRIGHT_YELLOW);
         
         DoublyNode<T>* current = head;
         int nodeCount = 0;
@@ -1598,37 +2314,37 @@ public:
         
         // Print top border for tail
         for (int i = 1; i < nodeCount; i++) {
-            std::cout << "       ";
+            w << "       ";
         }
-        cprint(use_color, "+---+\n", BRIGHT_YELLOW);
+        w.paint("+---+\n", BRIGHT_YELLOW);
         
         // Print forward direction
-        cprint(use_color, "HEAD|", BRIGHT_MAGNETA, true);
-        cprint(use_color, current->data, BRIGHT_BLUE);
-        cprint(use_color, "|", YELLOW);
+        w.paint("HEAD|", BRIGHT_MAGNETA, true);
+        w.paint(current->data, BRIGHT_BLUE);
+        w.paint("|", YELLOW);
         current = current->next;
         
         while (current != head) {
-            cprint(use_color, " --> |", BRIGHT_GREEN);
-            cprint(use_color, current->data, BRIGHT_BLUE);
-            cprint(use_color, "|", YELLOW);
+            w.paint(" --> |", BRIGHT_GREEN);
+            w.paint(current->data, BRIGHT_BLUE);
+            w.paint("|", YELLOW);
             current = current->next;
         }
-        std::cout << "\n";
+        w << "\n";
         
         // Print bottom border
-        cprint(use_color, "    +---+", BRIGHT_YELLOW);
+        w.paint("    +---+", BRIGHT_YELLOW);
         for (int i = 1; i < nodeCount; i++) {
-            std::cout << "        ";
+            w << "        ";
         }
-        cprint(use_color, "+---+\n", BRIGHT_YELLOW);
+        w.paint("+---+\n", BRIGHT_YELLOW);
         
         // Print connection line
-        std::cout << "      |";
+        w << "      |";
         for (int i = 1; i < nodeCount; i++) {
-            cprint(use_color, "-------", BRIGHT_CYAN);
+            w.paint("-------", BRIGHT_CYAN);
         }
-        cprint(use_color, "------|\n", BRIGHT_CYAN);
+        w.paint("------|\n", BRIGHT_CYAN);
     }
 
     class Iterator {
@@ -1670,4 +2386,1128 @@ public:
     Iterator begin() { return Iterator(head); }
     Iterator end() { return Iterator(head, true); }
 };
+
+// ============================================================================
+// UNROLLED LINKED LIST
+// ============================================================================
+// Doubly linked list of fixed-capacity arrays. Positional access walks
+// nodes rather than elements (O(n / NodeCapacity), from whichever end is
+// nearer), neighbouring elements share cache lines, and the per-element
+// pointer overhead is amortized over a whole node.
+template <typename T, size_t NodeCapacity = unrolledNodeCapacity<T>()>
+class UnrolledLinkedList {
+    static_assert(NodeCapacity >= 2, "UnrolledLinkedList nodes must hold at least 2 elements");
+    
+    using Node = UnrolledNode<T, NodeCapacity>;
+    
+private:
+    Node* head;
+    Node* tail;
+    size_t listSize;
+    size_t nodeCount;
+    
+    // Node holding element `index` and the slot it occupies
+    std::pair<Node*, size_t> locate(size_t index) const {
+        if (index < listSize / 2) {
+            Node* current = head;
+            while (index >= current->count()) {
+                index -= current->count();
+                current = current->next;
+            }
+            return {current, current->begin + index};
+        }
+        Node* current = tail;
+        size_t remaining = listSize - 1 - index; // elements after index
+        while (remaining >= current->count()) {
+            remaining -= current->count();
+            current = current->prev;
+        }
+        return {current, current->end - 1 - remaining};
+    }
+    
+    Node* linkNodeAfter(Node* node, size_t start) {
+        Node* created = new Node(start);
+        created->prev = node;
+        created->next = node ? node->next : head;
+        if (created->next) created->next->prev = created;
+        else tail = created;
+        if (node) node->next = created;
+        else head = created;
+        nodeCount++;
+        return created;
+    }
+    
+    void unlinkNode(Node* node) {
+        if (node->prev) node->prev->next = node->next;
+        else head = node->next;
+        if (node->next) node->next->prev = node->prev;
+        else tail = node->prev;
+        delete node;
+        nodeCount--;
+    }
+    
+    // Move the upper half of a full node into a new node after it
+    Node* splitNode(Node* node) {
+        size_t mid = node->begin + node->count() / 2;
+        Node* upper = linkNodeAfter(node, 0);
+        T* from = node->slots();
+        std::uninitialized_move(from + mid, from + node->end, upper->slots());
+        upper->end = node->end - mid;
+        std::destroy(from + mid, from + node->end);
+        node->end = mid;
+        return upper;
+    }
+    
+    // Insert before slot `pos` of a node that has room, shifting whichever
+    // side is shorter
+    void insertInNode(Node* node, size_t pos, T&& value) {
+        T* items = node->slots();
+        bool shiftLeft = node->begin > 0 &&
+                         (node->end == NodeCapacity || pos - node->begin < node->end - pos);
+        if (shiftLeft) {
+            if (pos == node->begin) {
+                ::new (static_cast<void*>(items + pos - 1)) T(std::move(value));
+            } else {
+                ::new (static_cast<void*>(items + node->begin - 1)) T(std::move(items[node->begin]));
+                std::move(items + node->begin + 1, items + pos, items + node->begin);
+                items[pos - 1] = std::move(value);
+            }
+            node->begin--;
+        } else {
+            if (pos == node->end) {
+                ::new (static_cast<void*>(items + pos)) T(std::move(value));
+            } else {
+                ::new (static_cast<void*>(items + node->end)) T(std::move(items[node->end - 1]));
+                std::move_backward(items + pos, items + node->end - 1, items + node->end);
+                items[pos] = std::move(value);
+            }
+            node->end++;
+        }
+        listSize++;
+    }
+    
+    // Insert before slot `pos`, splitting the node first if it is full
+    void insertAt(Node* node, size_t pos, T&& value) {
+        if (node->count() == NodeCapacity) {
+            Node* upper = splitNode(node);
+            if (pos > node->end) {
+                pos = pos - node->end;
+                node = upper;
+            }
+        }
+        insertInNode(node, pos, std::move(value));
+    }
+    
+    // Move every element of node->next into node, which must have room
+    void absorbNext(Node* node) {
+        Node* next = node->next;
+        T* items = node->slots();
+        if (node->begin > 0) {
+            // Compact to the front first
+            size_t n = node->count();
+            size_t moved = std::min(n, node->begin);
+            std::uninitialized_move(items + node->begin, items + node->begin + moved, items);
+            std::move(items + node->begin + moved, items + node->end, items + moved);
+            std::destroy(items + std::max(n, node->begin), items + node->end);
+            node->begin = 0;
+            node->end = n;
+        }
+        T* source = next->slots();
+        std::uninitialized_move(source + next->begin, source + next->end, items + node->end);
+        node->end += next->count();
+        unlinkNode(next);
+    }
+    
+    // Remove slot `pos` of node; drops empty nodes and folds sparse ones
+    // into a neighbour so nodes stay at least a quarter full on average
+    T eraseAt(Node* node, size_t pos) {
+        T* items = node->slots();
+        T value = std::move(items[pos]);
+        if (pos - node->begin < node->end - 1 - pos) {
+            std::move_backward(items + node->begin, items + pos, items + pos + 1);
+            std::destroy_at(items + node->begin);
+            node->begin++;
+        } else {
+            std::move(items + pos + 1, items + node->end, items + pos);
+            std::destroy_at(items + node->end - 1);
+            node->end--;
+        }
+        listSize--;
+        
+        if (node->count() == 0) {
+            unlinkNode(node);
+        } else if (node->count() < NodeCapacity / 4) {
+            if (node->next && node->count() + node->next->count() <= NodeCapacity) {
+                absorbNext(node);
+            } else if (node->prev && node->prev->count() + node->count() <= NodeCapacity) {
+                absorbNext(node->prev);
+            }
+        }
+        return value;
+    }
+    
+    // sort() orders copies of trivially copyable elements, pointers to anything else
+    static constexpr bool sortsPointers = !std::is_trivially_copyable_v<T>;
+    
+    // Replace the contents with `order`: the elements themselves, or
+    // pointers to this list's elements. Every node is allocated before any
+    // element is touched, and pointed-at elements are copied unless their
+    // move cannot throw, so on an exception the list is left as it was.
+    template <typename Entry>
+    void repackInOrder(std::vector<Entry>& order) {
+        UnrolledLinkedList packed;
+        for (size_t i = 0; i < order.size(); i += NodeCapacity) packed.linkNodeAfter(packed.tail, 0);
+        Node* node = packed.head;
+        for (Entry& entry : order) {
+            if (node->end == NodeCapacity) node = node->next;
+            if constexpr (sortsPointers) {
+                ::new (static_cast<void*>(node->slots() + node->end)) T(std::move_if_noexcept(*entry));
+            } else {
+                ::new (static_cast<void*>(node->slots() + node->end)) T(std::move(entry));
+            }
+            node->end++;
+            packed.listSize++;
+        }
+        std::swap(head, packed.head);
+        std::swap(tail, packed.tail);
+        std::swap(listSize, packed.listSize);
+        std::swap(nodeCount, packed.nodeCount);
+    }
+    
+    // Stable sort of `order` by comp on up to numThreads threads: equal
+    // slices sorted concurrently, then merged pairwise. Each slice gets its
+    // own comparator copy; the first exception is rethrown after every
+    // started thread has been joined.
+    template <typename Entry, typename Compare>
+    static void sortEntries(std::vector<Entry>& order, Compare& comp, unsigned numThreads) {
+        auto byValue = [](Compare& c) {
+            return [&c](const Entry& a, const Entry& b) {
+                if constexpr (sortsPointers) return c(*a, *b);
+                else return c(a, b);
+            };
+        };
+        constexpr size_t MIN_SLICE = 1 << 14;
+        if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+        size_t slices = std::min<size_t>(numThreads, order.size() / MIN_SLICE);
+        if (slices < 2) {
+            std::stable_sort(order.begin(), order.end(), byValue(comp));
+            return;
+        }
+        std::vector<size_t> bounds(slices + 1);
+        for (size_t s = 0; s <= slices; s++) bounds[s] = order.size() * s / slices;
+        std::vector<std::exception_ptr> errors(slices);
+        std::vector<std::thread> workers;
+        workers.reserve(slices);
+        try {
+            for (size_t s = 0; s < slices; s++) {
+                workers.emplace_back([&, s]() {
+                    try {
+                        Compare localComp = comp;
+                        std::stable_sort(order.begin() + bounds[s], order.begin() + bounds[s + 1],
+                                         byValue(localComp));
+                    } catch (...) {
+                        errors[s] = std::current_exception();
+                    }
+                });
+            }
+        } catch (...) {
+            for (auto& worker : workers) worker.join();
+            throw;
+        }
+        for (auto& worker : workers) worker.join();
+        for (auto& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+        for (size_t width = 1; width < slices; width *= 2) {
+            for (size_t left = 0; left + width < slices; left += 2 * width) {
+                size_t right = std::min(left + 2 * width, slices);
+                std::inplace_merge(order.begin() + bounds[left], order.begin() + bounds[left + width],
+                                   order.begin() + bounds[right], byValue(comp));
+            }
+        }
+    }
+
+public:
+    static constexpr size_t NODE_CAPACITY = NodeCapacity;
+    
+    UnrolledLinkedList() : head(nullptr), tail(nullptr), listSize(0), nodeCount(0) {}
+    
+    ~UnrolledLinkedList() {
+        clear();
+    }
+    
+    UnrolledLinkedList(const UnrolledLinkedList& other) : UnrolledLinkedList() {
+        for (const Node* node = other.head; node; node = node->next) {
+            for (size_t i = node->begin; i < node->end; i++) addLast(node->slots()[i]);
+        }
+    }
+    
+    UnrolledLinkedList(UnrolledLinkedList&& other) noexcept
+        : head(std::exchange(other.head, nullptr)), tail(std::exchange(other.tail, nullptr)),
+          listSize(std::exchange(other.listSize, 0)), nodeCount(std::exchange(other.nodeCount, 0)) {}
+    
+    UnrolledLinkedList& operator=(const UnrolledLinkedList& other) {
+        if (this != &other) {
+            clear();
+            for (const Node* node = other.head; node; node = node->next) {
+                for (size_t i = node->begin; i < node->end; i++) addLast(node->slots()[i]);
+            }
+        }
+        return *this;
+    }
+    
+    UnrolledLinkedList& operator=(UnrolledLinkedList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head = std::exchange(other.head, nullptr);
+            tail = std::exchange(other.tail, nullptr);
+            listSize = std::exchange(other.listSize, 0);
+            nodeCount = std::exchange(other.nodeCount, 0);
+        }
+        return *this;
+    }
+    
+    void addFirst(const T& value) {
+        addFirst(T(value));
+    }
+    
+    void addFirst(T&& value) {
+        T item(std::move(value)); // value may alias an element of this list
+        // A head with no free slot in front gets a new node rather than
+        // a shift, so deque-style use stays O(1) per operation
+        if (!head || head->begin == 0) {
+            linkNodeAfter(nullptr, NodeCapacity); // fills from the back
+        }
+        insertInNode(head, head->begin, std::move(item));
+    }
+    
+    void addLast(const T& value) {
+        addLast(T(value));
+    }
+    
+    void addLast(T&& value) {
+        T item(std::move(value));
+        if (!tail || tail->end == NodeCapacity) {
+            linkNodeAfter(tail, 0);
+        }
+        insertInNode(tail, tail->end, std::move(item));
+    }
+    
+    void addAt(size_t index, const T& value) {
+        addAt(index, T(value));
+    }
+    
+    void addAt(size_t index, T&& value) {
+        if (index > listSize) {
+            throw std::out_of_range("Index out of range");
+        }
+        
+        if (index == listSize) {
+            addLast(std::move(value));
+            return;
+        }
+        
+        T item(std::move(value));
+        auto [node, pos] = locate(index);
+        insertAt(node, pos, std::move(item));
+    }
+    
+    // Construct an element from args and insert it; returns a reference
+    // to the stored element
+    template <typename... Args>
+    T& emplaceFront(Args&&... args) {
+        addFirst(T(std::forward<Args>(args)...));
+        return front();
+    }
+    
+    template <typename... Args>
+    T& emplaceBack(Args&&... args) {
+        addLast(T(std::forward<Args>(args)...));
+        return back();
+    }
+    
+    template <typename... Args>
+    T& emplaceAt(size_t index, Args&&... args) {
+        addAt(index, T(std::forward<Args>(args)...));
+        return get(index);
+    }
+    
+    T removeFirst() {
+        if (!head) {
+            throw std::runtime_error("List is empty");
+        }
+        return eraseAt(head, head->begin);
+    }
+    
+    T removeLast() {
+        if (!tail) {
+            throw std::runtime_error("List is empty");
+        }
+        return eraseAt(tail, tail->end - 1);
+    }
+    
+    T removeAt(size_t index) {
+        if (index >= listSize) {
+            throw std::out_of_range("Index out of range");
+        }
+        auto [node, pos] = locate(index);
+        return eraseAt(node, pos);
+    }
+    
+    bool remove(const T& value) {
+        for (Node* node = head; node; node = node->next) {
+            T* items = node->slots();
+            for (size_t i = node->begin; i < node->end; i++) {
+                if (items[i] == value) {
+                    eraseAt(node, i);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    
+    T& get(size_t index) {
+        if (index >= listSize) {
+            throw std::out_of_range("Index out of range");
+        }
+        auto [node, pos] = locate(index);
+        return node->slots()[pos];
+    }
+    
+    const T& get(size_t index) const {
+        if (index >= listSize) {
+            throw std::out_of_range("Index out of range");
+        }
+        auto [node, pos] = locate(index);
+        return node->slots()[pos];
+    }
+    
+    T& operator[](size_t index) {
+        return get(index);
+    }
+    
+    const T& operator[](size_t index) const {
+        return get(index);
+    }
+    
+    T& front() {
+        if (!head) throw std::runtime_error("List is empty");
+        return head->slots()[head->begin];
+    }
+    
+    T& back() {
+        if (!tail) throw std::runtime_error("List is empty");
+        return tail->slots()[tail->end - 1];
+    }
+    
+    int indexOf(const T& value) const {
+        int index = 0;
+        for (const Node* node = head; node; node = node->next) {
+            const T* items = node->slots();
+            for (size_t i = node->begin; i < node->end; i++, index++) {
+                if (items[i] == value) return index;
+            }
+        }
+        return -1;
+    }
+    
+    int lastIndexOf(const T& value) const {
+        int index = static_cast<int>(listSize) - 1;
+        for (const Node* node = tail; node; node = node->prev) {
+            const T* items = node->slots();
+            for (size_t i = node->end; i > node->begin; i--, index--) {
+                if (items[i - 1] == value) return index;
+            }
+        }
+        return -1;
+    }
+    
+    bool contains(const T& value) const {
+        return indexOf(value) != -1;
+    }
+    
+    // indexOf on a policy. One walk of the node chain (listSize / NodeCapacity
+    // steps) records where each node starts; the arrays are then scanned in
+    // parallel slices. A slice stops early once a match before it is known.
+    template <parallel::ExecutionPolicy Policy>
+    int indexOf(const Policy& policy, const T& value) const {
+        constexpr size_t GRAIN = (1 << 14) / NodeCapacity + 1; // nodes per slice
+        if (parallel::chunksFor(policy, nodeCount, GRAIN) < 2) return indexOf(value);
+        std::vector<std::pair<const Node*, size_t>> starts; // node, index of its first element
+        starts.reserve(nodeCount);
+        size_t first = 0;
+        for (const Node* node = head; node; node = node->next) {
+            starts.push_back({node, first});
+            first += node->end - node->begin;
+        }
+        constexpr size_t NONE = static_cast<size_t>(-1);
+        std::atomic<size_t> best{NONE};
+        parallel::forRange(policy, starts.size(), GRAIN, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; k++) {
+                auto [node, index] = starts[k];
+                if (index >= best.load(std::memory_order_relaxed)) return;
+                const T* items = node->slots();
+                for (size_t i = node->begin; i < node->end; i++, index++) {
+                    if (!(items[i] == value)) continue;
+                    size_t seen = best.load(std::memory_order_relaxed);
+                    while (index < seen && !best.compare_exchange_weak(seen, index, std::memory_order_relaxed)) {}
+                    return;
+                }
+            }
+        });
+        size_t found = best.load(std::memory_order_relaxed);
+        return found == NONE ? -1 : static_cast<int>(found);
+    }
+    
+    template <parallel::ExecutionPolicy Policy>
+    bool contains(const Policy& policy, const T& value) const {
+        return indexOf(policy, value) != -1;
+    }
+    
+    size_t size() const {
+        return listSize;
+    }
+    
+    bool isEmpty() const {
+        return listSize == 0;
+    }
+    
+    // Number of array nodes currently allocated
+    size_t nodes() const {
+        return nodeCount;
+    }
+    
+    void clear() {
+        while (head) {
+            Node* temp = head;
+            head = head->next;
+            delete temp;
+        }
+        tail = nullptr;
+        listSize = 0;
+        nodeCount = 0;
+    }
+    
+    void reverse() {
+        Node* current = head;
+        while (current) {
+            std::reverse(current->slots() + current->begin, current->slots() + current->end);
+            std::swap(current->prev, current->next);
+            current = current->prev;
+        }
+        std::swap(head, tail);
+    }
+    
+    void sort(bool ascending = true, unsigned numThreads = 1) {
+        if (ascending) sort(std::less<T>(), numThreads);
+        else sort(std::greater<T>(), numThreads);
+    }
+    
+    // Stable sort with a custom order, on numThreads threads (0 = all
+    // hardware threads). Trivially copyable elements are sorted as a copy,
+    // anything else as pointers into the nodes; either way the result is
+    // packed into full nodes only once sorting succeeded, so if comp throws,
+    // or a thread cannot start, the list is unchanged.
+    template <typename Compare>
+        requires std::is_invocable_r_v<bool, Compare&, const T&, const T&>
+    void sort(Compare comp, unsigned numThreads = 1) {
+        if (listSize < 2) return;
+        using Entry = std::conditional_t<sortsPointers, T*, T>;
+        std::vector<Entry> order;
+        order.reserve(listSize);
+        for (Node* node = head; node; node = node->next) {
+            T* items = node->slots();
+            for (size_t i = node->begin; i < node->end; i++) {
+                if constexpr (sortsPointers) order.push_back(items + i);
+                else order.push_back(items[i]);
+            }
+        }
+        sortEntries(order, comp, numThreads);
+        repackInOrder(order);
+    }
+    
+    UnrolledLinkedList operator+(const UnrolledLinkedList& other) const& {
+        UnrolledLinkedList result(*this);
+        result.merge(other);
+        return result;
+    }
+    
+    UnrolledLinkedList operator+(const UnrolledLinkedList& other) && {
+        merge(other);
+        return std::move(*this);
+    }
+    
+    UnrolledLinkedList operator+(UnrolledLinkedList&& other) const& {
+        UnrolledLinkedList result(*this);
+        result.merge(std::move(other));
+        return result;
+    }
+    
+    UnrolledLinkedList operator+(UnrolledLinkedList&& other) && {
+        merge(std::move(other));
+        return std::move(*this);
+    }
+    
+    void merge(const UnrolledLinkedList& other) {
+        if (&other == this) {
+            UnrolledLinkedList copy(other);
+            merge(copy);
+            return;
+        }
+        size_t count = other.listSize;
+        const Node* node = other.head;
+        for (size_t i = node ? node->begin : 0; count > 0; i++, count--) {
+            if (i == node->end) {
+                node = node->next;
+                i = node->begin;
+            }
+            addLast(node->slots()[i]);
+        }
+    }
+    
+    // O(1): links other's nodes after tail and leaves it empty. The seam
+    // is left as is, so two sparse nodes may meet there until the next
+    // erase near it folds them together.
+    void merge(UnrolledLinkedList&& other) {
+        if (this == &other || !other.head) return;
+        if (!head) {
+            head = other.head;
+        } else {
+            tail->next = other.head;
+            other.head->prev = tail;
+        }
+        tail = std::exchange(other.tail, nullptr);
+        other.head = nullptr;
+        listSize += std::exchange(other.listSize, 0);
+        nodeCount += std::exchange(other.nodeCount, 0);
+    }
+    
+    void display(bool use_color = false) const {
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("Unrolled Linked List (", BOLD);
+        w.paint(NodeCapacity, BRIGHT_CYAN);
+        w.paint(" per node):\n", BOLD);
+        w.paint("NULL <-- HEAD", MAGNETA);
+        for (const Node* node = head; node; node = node->next) {
+            w.paint(node == head ? "|[" : " <--> |[", node == head ? BRIGHT_YELLOW : GREEN);
+            const T* items = node->slots();
+            for (size_t i = node->begin; i < node->end; i++) {
+                if (i != node->begin) w.paint(" ");
+                w.paint(items[i], BRIGHT_BLUE);
+            }
+            w.paint("]|", BRIGHT_YELLOW);
+        }
+        if (!head) w.paint("|NULL|", BRIGHT_RED);
+        w.paint(" --> ", GREEN);
+        w.paint("NULL\n", BRIGHT_RED);
+    }
+
+
+    class Iterator {
+    private:
+        Node* node;
+        Node* last;     // the list's tail, so --end() can reach it
+        size_t slot;
+    public:
+        Iterator(Node* current, Node* tailNode, size_t index = 0)
+            : node(current), last(tailNode), slot(current ? current->begin + index : 0) {}
+        
+        T& operator*() { return node->slots()[slot]; }
+        Iterator& operator++() {
+            if (node && ++slot == node->end) {
+                node = node->next;
+                slot = node ? node->begin : 0;
+            }
+            return *this;
+        }
+        Iterator& operator--() {
+            if (!node) {
+                node = last;
+                slot = node ? node->end - 1 : 0;
+            } else if (slot-- == node->begin) {
+                node = node->prev;
+                slot = node ? node->end - 1 : 0;
+            }
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const {
+            return node != other.node || slot != other.slot;
+        }
+    };
+    
+    Iterator begin() { return Iterator(head, tail); }
+    Iterator end() { return Iterator(nullptr, tail); }
+};
+
+// ============================================================================
+// LOCK-FREE CONTAINERS
+// ============================================================================
+// Thread-safe replacements for a mutex-wrapped list used as a work queue.
+// They keep the list naming (addLast/removeFirst/isEmpty) so call sites
+// stay the same; removeFirst still throws on empty, tryRemoveFirst returns
+// std::nullopt instead. size() is omitted where it would be a guess.
+
+// Hazard pointers for the lock-free queue and stack. Before dereferencing
+// a shared node a thread publishes it in one of its hazard slots; unlinked
+// nodes are retired to a per-thread list and freed by scan() once no slot
+// in any thread points at them. Per-thread records are recycled when a
+// thread exits, never freed, and nodes still protected at exit are handed
+// to the next thread that scans, or freed at program exit.
+class HazardPointers {
+public:
+    static constexpr size_t SLOTS_PER_THREAD = 2;
+
+private:
+    struct Record {
+        std::atomic<const void*> hazards[SLOTS_PER_THREAD] = {};
+        std::atomic<bool> inUse{true};
+        Record* next = nullptr;
+    };
+    
+    struct Retired {
+        void* pointer;
+        void (*deleter)(void*);
+    };
+    
+    struct ThreadState {
+        Record* record;
+        std::vector<Retired> retired;
+        
+        ThreadState() : record(acquireRecord()) {}
+        
+        ~ThreadState() {
+            for (auto& hazard : record->hazards) hazard.store(nullptr, std::memory_order_release);
+            scan(*this);
+            if (!retired.empty()) {
+                Orphans& left = orphans();
+                std::lock_guard<std::mutex> lock(left.mutex);
+                left.nodes.insert(left.nodes.end(), retired.begin(), retired.end());
+                left.count.store(left.nodes.size(), std::memory_order_release);
+            }
+            record->inUse.store(false, std::memory_order_release);
+        }
+    };
+    
+    // Nodes left by exited threads. The main thread's ThreadState is
+    // destroyed before this, so the destructor frees whatever no hazard
+    // still points at once every thread is done.
+    struct Orphans {
+        std::mutex mutex;
+        std::vector<Retired> nodes;
+        std::atomic<size_t> count{0};
+        
+        ~Orphans() {
+            std::vector<const void*> hazards = publishedHazards();
+            for (const Retired& node : nodes) {
+                if (!std::binary_search(hazards.begin(), hazards.end(), node.pointer)) node.deleter(node.pointer);
+            }
+        }
+    };
+    
+    inline static std::atomic<Record*> records{nullptr};
+    inline static std::atomic<size_t> recordCount{0};
+    
+    static Orphans& orphans() {
+        static Orphans left;
+        return left;
+    }
+    
+    static Record* acquireRecord() {
+        for (Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+            bool free = false;
+            if (record->inUse.compare_exchange_strong(free, true, std::memory_order_acquire)) {
+                return record;
+            }
+        }
+        Record* record = new Record;
+        record->next = records.load(std::memory_order_relaxed);
+        while (!records.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                              std::memory_order_relaxed)) {}
+        recordCount.fetch_add(1, std::memory_order_relaxed);
+        return record;
+    }
+    
+    static ThreadState& local() {
+        thread_local ThreadState state;
+        return state;
+    }
+    
+    // Every pointer currently in a hazard slot, sorted
+    static std::vector<const void*> publishedHazards() {
+        // Pairs with the fence in Guard::protect: a node unlinked before
+        // this point is either seen here or not yet visible to a reader
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::vector<const void*> hazards;
+        for (Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+            for (auto& hazard : record->hazards) {
+                if (const void* pointer = hazard.load(std::memory_order_acquire)) hazards.push_back(pointer);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+        return hazards;
+    }
+    
+    // Free every retired node no hazard slot points at
+    static void scan(ThreadState& state) {
+        Orphans& left = orphans();
+        if (left.count.load(std::memory_order_acquire) > 0) {
+            std::lock_guard<std::mutex> lock(left.mutex);
+            state.retired.insert(state.retired.end(), left.nodes.begin(), left.nodes.end());
+            left.nodes.clear();
+            left.count.store(0, std::memory_order_relaxed);
+        }
+        
+        std::vector<const void*> hazards = publishedHazards();
+        std::vector<Retired> keep;
+        for (const Retired& node : state.retired) {
+            if (std::binary_search(hazards.begin(), hazards.end(), node.pointer)) keep.push_back(node);
+            else node.deleter(node.pointer);
+        }
+        state.retired.swap(keep);
+    }
+
+public:
+    // Owns hazard slot `index` of the calling thread while in scope
+    class Guard {
+    private:
+        std::atomic<const void*>& hazard;
+    public:
+        explicit Guard(size_t index) : hazard(local().record->hazards[index]) {}
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard() { hazard.store(nullptr, std::memory_order_release); }
+        
+        // Load source and publish the result until the two agree, so the
+        // returned node cannot be freed while this guard holds it
+        template <typename P>
+        P* protect(const std::atomic<P*>& source) {
+            P* pointer = source.load(std::memory_order_relaxed);
+            while (true) {
+                hazard.store(pointer, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                P* current = source.load(std::memory_order_acquire);
+                if (current == pointer) return pointer;
+                pointer = current;
+            }
+        }
+    };
+    
+    // Hand an unlinked node over for deferred deletion
+    template <typename Node>
+    static void retire(Node* node) {
+        ThreadState& state = local();
+        state.retired.push_back({node, [](void* pointer) { delete static_cast<Node*>(pointer); }});
+        size_t threshold = std::max<size_t>(64, 2 * SLOTS_PER_THREAD * recordCount.load(std::memory_order_relaxed));
+        if (state.retired.size() >= threshold) scan(state);
+    }
+};
+
+// Michael-Scott MPMC queue. head always points at a sentinel whose
+// successor holds the first element; a dequeue moves the value out of
+// that successor, which then becomes the new sentinel.
+template <typename T>
+class LockFreeQueue {
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        alignas(T) unsigned char storage[sizeof(T)]; // live only between enqueue and dequeue
+        
+        T* item() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+    static_assert(std::atomic<Node*>::is_always_lock_free);
+    
+    alignas(64) std::atomic<Node*> head;
+    alignas(64) std::atomic<Node*> tail;
+    
+    template <typename... Args>
+    void enqueue(Args&&... args) {
+        Node* node = new Node;
+        try {
+            ::new (static_cast<void*>(node->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            delete node;
+            throw;
+        }
+        
+        HazardPointers::Guard guard(0);
+        while (true) {
+            Node* last = guard.protect(tail);
+            Node* next = last->next.load(std::memory_order_acquire);
+            if (last != tail.load(std::memory_order_acquire)) continue;
+            if (next) {
+                // Another enqueue linked its node but has not swung tail yet
+                tail.compare_exchange_weak(last, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if (last->next.compare_exchange_weak(next, node, std::memory_order_release, std::memory_order_relaxed)) {
+                tail.compare_exchange_strong(last, node, std::memory_order_release, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+public:
+    LockFreeQueue() : head(new Node), tail(head.load(std::memory_order_relaxed)) {}
+    
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+    
+    // Must not race with any other member call
+    ~LockFreeQueue() {
+        Node* sentinel = head.load(std::memory_order_relaxed);
+        Node* current = sentinel->next.load(std::memory_order_relaxed);
+        delete sentinel;
+        while (current) {
+            Node* next = current->next.load(std::memory_order_relaxed);
+            std::destroy_at(current->item());
+            delete current;
+            current = next;
+        }
+    }
+    
+    void addLast(const T& value) {
+        enqueue(value);
+    }
+    
+    void addLast(T&& value) {
+        enqueue(std::move(value));
+    }
+    
+    template <typename... Args>
+    void emplaceBack(Args&&... args) {
+        enqueue(std::forward<Args>(args)...);
+    }
+    
+    std::optional<T> tryRemoveFirst() {
+        HazardPointers::Guard firstGuard(0);
+        HazardPointers::Guard nextGuard(1);
+        while (true) {
+            Node* first = firstGuard.protect(head);
+            Node* last = tail.load(std::memory_order_acquire);
+            Node* next = nextGuard.protect(first->next);
+            if (first != head.load(std::memory_order_acquire)) continue;
+            if (!next) return std::nullopt;
+            if (first == last) {
+                // Never let head pass a lagging tail
+                tail.compare_exchange_weak(last, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if (head.compare_exchange_weak(first, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                // Only the winning thread touches next's value; it is
+                // destroyed here because next is now the sentinel
+                struct DestroyItem {
+                    T* item;
+                    ~DestroyItem() { std::destroy_at(item); }
+                } destroyItem{next->item()};
+                HazardPointers::retire(first);
+                return std::optional<T>(std::move(*destroyItem.item));
+            }
+        }
+    }
+    
+    T removeFirst() {
+        std::optional<T> value = tryRemoveFirst();
+        if (!value) {
+            throw std::runtime_error("Queue is empty");
+        }
+        return std::move(*value);
+    }
+    
+    // A snapshot: other threads may change the answer immediately
+    bool isEmpty() const {
+        HazardPointers::Guard guard(0);
+        return guard.protect(head)->next.load(std::memory_order_acquire) == nullptr;
+    }
+};
+
+// Treiber stack of SinglyNode<T>. A pushed node's next link is never
+// written again, and hazard pointers keep a node alive (so its address
+// cannot be reused, which rules out ABA) while a pop is looking at it.
+template <typename T>
+class LockFreeStack {
+private:
+    std::atomic<SinglyNode<T>*> top;
+    static_assert(std::atomic<SinglyNode<T>*>::is_always_lock_free);
+    
+    void push(SinglyNode<T>* node) {
+        node->next = top.load(std::memory_order_relaxed);
+        while (!top.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+public:
+    LockFreeStack() : top(nullptr) {}
+    
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+    
+    // Must not race with any other member call
+    ~LockFreeStack() {
+        SinglyNode<T>* current = top.load(std::memory_order_relaxed);
+        while (current) {
+            SinglyNode<T>* next = current->next;
+            delete current;
+            current = next;
+        }
+    }
+    
+    void addFirst(const T& value) {
+        push(new SinglyNode<T>(value));
+    }
+    
+    void addFirst(T&& value) {
+        push(new SinglyNode<T>(std::in_place, std::move(value)));
+    }
+    
+    template <typename... Args>
+    void emplaceFront(Args&&... args) {
+        push(new SinglyNode<T>(std::in_place, std::forward<Args>(args)...));
+    }
+    
+    std::optional<T> tryRemoveFirst() {
+        HazardPointers::Guard guard(0);
+        while (true) {
+            SinglyNode<T>* node = guard.protect(top);
+            if (!node) return std::nullopt;
+            SinglyNode<T>* next = node->next;
+            if (top.compare_exchange_weak(node, next, std::memory_order_acquire, std::memory_order_relaxed)) {
+                // Still guarded, so retiring before the move is safe
+                HazardPointers::retire(node);
+                return std::optional<T>(std::move(node->data));
+            }
+        }
+    }
+    
+    T removeFirst() {
+        std::optional<T> value = tryRemoveFirst();
+        if (!value) {
+            throw std::runtime_error("Stack is empty");
+        }
+        return std::move(*value);
+    }
+    
+    // A snapshot: other threads may change the answer immediately
+    bool isEmpty() const {
+        return top.load(std::memory_order_acquire) == nullptr;
+    }
+};
+
+// Bounded single-producer/single-consumer ring. Exactly one thread may
+// add and one (other) thread may remove. Each side keeps a private copy
+// of the other side's index and rereads the shared one only when the
+// copy says the ring is full (or empty), so the indices' cache lines do
+// not bounce on every operation.
+template <typename T>
+class SpscRingBuffer {
+private:
+    static constexpr size_t CACHE_LINE = 64;
+    
+    T* slots;
+    size_t mask;
+    
+    alignas(CACHE_LINE) std::atomic<size_t> readIndex{0};  // written by the consumer
+    size_t cachedWriteIndex = 0;                            // consumer's view of writeIndex
+    alignas(CACHE_LINE) std::atomic<size_t> writeIndex{0}; // written by the producer
+    size_t cachedReadIndex = 0;                             // producer's view of readIndex
+    
+    static size_t roundUpCapacity(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) rounded <<= 1;
+        return rounded;
+    }
+    
+    template <typename... Args>
+    bool tryEnqueue(Args&&... args) {
+        size_t write = writeIndex.load(std::memory_order_relaxed);
+        if (write - cachedReadIndex > mask) {
+            cachedReadIndex = readIndex.load(std::memory_order_acquire);
+            if (write - cachedReadIndex > mask) return false;
+        }
+        ::new (static_cast<void*>(slots + (write & mask))) T(std::forward<Args>(args)...);
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+public:
+    // Capacity is rounded up to a power of two (at least 2)
+    explicit SpscRingBuffer(size_t capacity)
+        : slots(std::allocator<T>().allocate(roundUpCapacity(capacity))), mask(roundUpCapacity(capacity) - 1) {}
+    
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+    
+    ~SpscRingBuffer() {
+        for (size_t i = readIndex.load(std::memory_order_relaxed); i != writeIndex.load(std::memory_order_relaxed); i++) {
+            std::destroy_at(slots + (i & mask));
+        }
+        std::allocator<T>().deallocate(slots, mask + 1);
+    }
+    
+    // Producer side. The try forms return false when the ring is full;
+    // addLast yields until there is room.
+    bool tryAddLast(const T& value) {
+        return tryEnqueue(value);
+    }
+    
+    bool tryAddLast(T&& value) {
+        return tryEnqueue(std::move(value));
+    }
+    
+    template <typename... Args>
+    bool tryEmplaceBack(Args&&... args) {
+        return tryEnqueue(std::forward<Args>(args)...);
+    }
+    
+    void addLast(const T& value) {
+        while (!tryEnqueue(value)) std::this_thread::yield();
+    }
+    
+    void addLast(T&& value) {
+        while (!tryEnqueue(std::move(value))) std::this_thread::yield();
+    }
+    
+    // Consumer side
+    std::optional<T> tryRemoveFirst() {
+        size_t read = readIndex.load(std::memory_order_relaxed);
+        if (read == cachedWriteIndex) {
+            cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+            if (read == cachedWriteIndex) return std::nullopt;
+        }
+        T* item = slots + (read & mask);
+        std::optional<T> value(std::move(*item));
+        std::destroy_at(item);
+        readIndex.store(read + 1, std::memory_order_release);
+        return value;
+    }
+    
+    T removeFirst() {
+        std::optional<T> value = tryRemoveFirst();
+        if (!value) {
+            throw std::runtime_error("Ring buffer is empty");
+        }
+        return std::move(*value);
+    }
+    
+    // Exact from either end's own thread, a snapshot from anywhere else
+    bool isEmpty() const {
+        return readIndex.load(std::memory_order_acquire) == writeIndex.load(std::memory_order_acquire);
+    }
+    
+    size_t size() const {
+        size_t read = readIndex.load(std::memory_order_acquire);
+        return writeIndex.load(std::memory_order_acquire) - read;
+    }
+    
+    size_t capacity() const {
+        return mask + 1;
+    }
+};
+
 #endif
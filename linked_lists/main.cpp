@@ -171,6 +171,85 @@ void testCircularDoublyLinkedList() {
     std::cout << std::endl;
 }
 
+void testUnrolledLinkedList() {
+    std::cout << "\n========== TESTING UNROLLED LINKED LIST ==========\n";
+    
+    UnrolledLinkedList<int, 4> list;
+    
+    for (int i = 1; i <= 10; i++) {
+        list.addLast(i * 10);
+    }
+    list.addFirst(5);
+    list.addAt(6, 55);
+    
+    std::cout << "\nAfter adding elements (5, 10..50, 55, 60..100):\n";
+    list.display(true);
+    std::cout << "Size: " << list.size() << ", nodes: " << list.nodes() << std::endl;
+    
+    std::cout << "\nElement at index 6: " << list[6] << std::endl;
+    std::cout << "Removed at index 3: " << list.removeAt(3) << std::endl;
+    std::cout << "Removed first: " << list.removeFirst() << ", removed last: " << list.removeLast() << std::endl;
+    list.display(true);
+    
+    list.sort(false);
+    std::cout << "\nAfter sorting (descending):\n";
+    list.display(true);
+
+    // uint8_t prints as a character, as std::cout would print it
+    UnrolledLinkedList<uint8_t> letters;
+    for (char c : std::string("unrolled")) letters.addLast(static_cast<uint8_t>(c));
+    letters.sort();
+    std::cout << "\nuint8_t letters, sorted:\n";
+    letters.display(true);
+
+    std::cout << std::endl;
+    std::cout << std::endl;
+}
+
+void testLockFreeContainers() {
+    std::cout << "\n========== TESTING LOCK-FREE CONTAINERS ==========\n";
+    
+    LockFreeQueue<int> queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; p++) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 1; i <= 1000; i++) queue.addLast(p * 1000 + i);
+        });
+    }
+    long long total = 0;
+    int received = 0;
+    while (received < 4000) {
+        if (auto value = queue.tryRemoveFirst()) {
+            total += *value;
+            received++;
+        }
+    }
+    for (auto& producer : producers) producer.join();
+    std::cout << "\nQueue: 4 producers sent 4000 values, sum received = " << total
+              << ", empty = " << std::boolalpha << queue.isEmpty() << std::endl;
+    
+    LockFreeStack<std::string> stack;
+    stack.addFirst("bottom");
+    stack.emplaceFront("top");
+    std::cout << "Stack pops: " << stack.removeFirst() << ", " << stack.removeFirst() << std::endl;
+    
+    SpscRingBuffer<int> ring(8);
+    std::thread producer([&ring]() {
+        for (int i = 1; i <= 100; i++) ring.addLast(i);
+    });
+    int sum = 0;
+    for (int count = 0; count < 100;) {
+        if (auto value = ring.tryRemoveFirst()) {
+            sum += *value;
+            count++;
+        }
+    }
+    producer.join();
+    std::cout << "SPSC ring (capacity " << ring.capacity() << "): sum of 1..100 = " << sum << std::endl;
+
+    std::cout << std::endl;
+}
+
 int main() {
     std::cout << "===============================================\n";
     std::cout << "   COMPREHENSIVE LINKED LIST IMPLEMENTATION\n";
@@ -181,6 +260,8 @@ int main() {
         testDoublyLinkedList();
         testCircularLinkedList();
         testCircularDoublyLinkedList();
+        testUnrolledLinkedList();
+        testLockFreeContainers();
         
         std::cout << "\n===============================================\n";
         std::cout << "         ALL TESTS COMPLETED SUCCESSFULLY\n";
@@ -1,4 +1,5 @@
 #include<iostream>
+#include <thread>
 #include "maps.hpp"
 
 int main() {
@@ -66,6 +67,19 @@ int main() {
         std::cout << "After erasing key 30:\n";
         treeMap.display(true);
 
+        std::cout << "Keys in [40, 70): ";
+        treeMap.range(40, 70, [](const int& key, const std::string& value) {
+            std::cout << key << "=" << value << " ";
+        });
+        std::cout << "\nFirst key above 55: " << treeMap.upperBound(55).key() << "\n";
+
+        // Sorted keys take the bulk-load path, vector<bool> values included
+        TreeMap<int, bool> flags;
+        flags.create_map_from_arrays({1, 2, 3}, {true, false, true});
+        std::cout << "Flags: ";
+        flags.forEach([](const int& key, const bool& on) { std::cout << key << (on ? "=on " : "=off "); });
+        std::cout << "\nAny flag off: " << (flags.existsValue(false) ? "yes" : "no") << "\n\n";
+
         // ========== LINKED LIST MAP DEMO ==========
         std::cout << "\n[3] LINKED LIST MAP DEMONSTRATION\n";
         LinkedListMap<std::string, int> listMap;
@@ -120,6 +134,51 @@ int main() {
         std::cout << "\nAfter clearing:\n";
         numMap.display(true);
 
+        // ========== FLAT HASH MAP DEMO ==========
+        std::cout << "\n[5] FLAT HASH MAP (OPEN ADDRESSING)\n";
+        FlatHashMap<std::string, int> flatMap;
+        flatMap.insert("red", 1);
+        flatMap.insert("green", 2);
+        flatMap.insert("blue", 3);
+        flatMap["alpha"] = 4;
+        flatMap.display(true);
+
+        flatMap.erase("green");
+        std::cout << "After erasing 'green':\n";
+        flatMap.display(true);
+        std::cout << "Value at 'blue': " << flatMap.at("blue") << "\n";
+
+        // ========== CONCURRENT HASH MAP DEMO ==========
+        std::cout << "\n[6] CONCURRENT HASH MAP (SHARDED)\n";
+        ConcurrentHashMap<int, std::string> cache(4);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&cache]() {
+                for (int key = 0; key < 100; ++key) {
+                    cache.computeIfAbsent(key, [](int k) { return "value-" + std::to_string(k); });
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        std::cout << "4 threads filled " << cache.size() << " keys; cache.at(42) = " << cache.at(42) << "\n";
+        cache.display(true);
+
+        // ========== PARALLEL BULK OPERATIONS DEMO ==========
+        std::cout << "\n[7] PARALLEL BULK OPERATIONS\n";
+        std::vector<int> ids(100000), amounts(100000);
+        for (int i = 0; i < 100000; ++i) {
+            ids[i] = i;
+            amounts[i] = i % 1000;
+        }
+        HashMap<int, int> ledger;
+        ledger.create_map_from_arrays(parallel::par, ids, amounts);
+        long long total = ledger.reduce(parallel::par, 0LL,
+            [](int, int amount) { return (long long)amount; }, std::plus<>());
+        auto large = ledger.filter(parallel::par, [](int, int amount) { return amount >= 990; });
+        std::cout << "Built " << ledger.size() << " entries; total = " << total
+                  << ", entries >= 990: " << large.size()
+                  << ", has 999: " << (ledger.existsValue(parallel::par, 999) ? "yes" : "no") << "\n";
+
         std::cout << "\n========================================\n";
         std::cout << "    DEMO COMPLETED SUCCESSFULLY!\n";
         std::cout << "========================================\n";
@@ -8,7 +8,32 @@
 #include <algorithm>
 #include <memory>
 #include <sstream>
+#include <cstdint>
+#include <bit>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <concepts>
+#include <chrono>
+#include <cstring>
+#include <span>
+#include <utility>
 #include "../console_colors/colours.hpp"
+#include "../output/output.hpp"
+#include "../snapshot/snapshot.hpp"
+#include "../instrumentation/instrumentation.hpp"
+#include "../parallel/parallel.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAPS_HAVE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MAPS_HAVE_NEON 1
+#endif
 using namespace colors;
 
 
@@ -32,72 +57,505 @@ public:
         : MapException("Key not found: " + key) {}
 };
 
+// ==================== HETEROGENEOUS LOOKUP ====================
+/**
+ * Default hasher for the hash maps: std::hash<K>, except that std::string
+ * keys are hashed as std::string_view. The standard guarantees both give
+ * the same value, and it lets a string-keyed map be searched with a
+ * string_view or const char* without building a temporary std::string.
+ */
+template<typename K>
+struct DefaultHash : std::hash<K> {};
+
+template<>
+struct DefaultHash<std::string> {
+    using is_transparent = void;
+    size_t operator()(std::string_view key) const noexcept {
+        return std::hash<std::string_view>{}(key);
+    }
+};
+
+/**
+ * Lookups may take a type other than the key type only when every functor
+ * involved declares is_transparent (std::less<>, std::equal_to<>, ...)
+ */
+template<typename... Fns>
+concept TransparentFunctors = (requires { typename Fns::is_transparent; } && ...);
+
+/**
+ * Key types the comparison-based maps (TreeMap, LinkedListMap) search with
+ * directly: K itself, or, with transparent functors, a type that does not
+ * convert to K (string_view for std::string keys). Anything convertible is
+ * converted first, as std::map and HashMap do, so find(3.5) on int keys
+ * still looks up 3 rather than comparing 3.5 against every key.
+ */
+template<typename Q, typename K, typename... Fns>
+concept ComparableLookup = std::same_as<Q, K> ||
+                           (TransparentFunctors<Fns...> && !std::convertible_to<const Q&, K>);
+
 // ==================== HASH MAP IMPLEMENTATION ====================
-template<typename K, typename V>
+/**
+ * HashMap operation counters, see instrumentation.hpp.
+ * All zero unless built with SNAZZYDEETS_STATS.
+ */
+struct HashMapStats {
+    instrumentation::Counter lookups;       // key searches, including those made by insert
+    instrumentation::Counter probes;        // chain nodes examined by those searches
+    instrumentation::Counter maxProbe;      // most nodes a single search examined
+    instrumentation::Counter rehashes;      // resizes started
+    instrumentation::Counter rehashNanos;   // time spent moving nodes to a new table
+    instrumentation::Counter maxChain;      // longest bucket chain, measured by stats()
+
+    double averageProbe() const { return instrumentation::ratio(probes, lookups); }
+};
+
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename KeyEqual = std::equal_to<>>
 class HashMap {
 private:
     struct Node {
         K key;
         V value;
+        size_t hash;    // full hash of key: rehashing and chain scans never recompute it
         Node* next;
-        Node(const K& k, const V& v) : key(k), value(v), next(nullptr) {}
+        Node(const K& k, const V& v, size_t h) : key(k), value(v), hash(h), next(nullptr) {}
     };
 
+    // K itself, or any type Hash and KeyEqual accept when both are transparent
+    template<typename Q>
+    static constexpr bool lookupKey = std::same_as<Q, K> || TransparentFunctors<Hash, KeyEqual>;
+
     std::vector<Node*> table;
+    std::vector<Node*> oldTable;    // non-empty only while an incremental rehash is in flight
+    size_t migrateIndex;            // next oldTable bucket to move into table
     size_t mapSize;
     size_t capacity;
-    const float loadFactor = 0.75f;
+    bool incrementalRehash;
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] KeyEqual keyEqual;
+    [[no_unique_address]] mutable instrumentation::Slot<HashMapStats> counters;
+    static constexpr float loadFactor = 0.75f;
+    static constexpr size_t rehashStep = 8; // buckets migrated per operation
+
+#ifdef SNAZZYDEETS_STATS
+    void recordProbe(size_t steps) const {
+        counters.lookups.add();
+        counters.probes.add(steps);
+        counters.maxProbe.raiseTo(steps);
+        if (steps > instrumentation::thresholds().probeLength.load(std::memory_order_relaxed)) {
+            instrumentation::emit({"HashMap", "longProbe", steps, 0});
+        }
+    }
+#endif
+
+    size_t bucketFor(size_t hash) const {
+        return hash % capacity;
+    }
+
+    size_t oldBucketFor(size_t hash) const {
+        return hash % oldTable.size();
+    }
+
+    bool rehashing() const {
+        return !oldTable.empty();
+    }
+
+    /**
+     * A moved-from map has no bucket array; give it one before linking nodes
+     */
+    void ensureTable() {
+        if (table.empty()) table.assign(capacity, nullptr);
+    }
+
+    /**
+     * Unlink every node of one old bucket and push it onto its new bucket.
+     * Nodes are relinked, never reallocated.
+     */
+    void migrateBucket(size_t i) {
+        Node* current = oldTable[i];
+        oldTable[i] = nullptr;
+        while (current) {
+            Node* next = current->next;
+            size_t index = bucketFor(current->hash);
+            current->next = table[index];
+            table[index] = current;
+            current = next;
+        }
+    }
+
+    /**
+     * Move up to rehashStep old buckets; drop the old table once drained
+     */
+    void migrateStep() {
+        if (!rehashing()) return;
+        SNAZZYDEETS_STAT(auto start = std::chrono::steady_clock::now());
+        size_t end = std::min(migrateIndex + rehashStep, oldTable.size());
+        for (; migrateIndex < end; ++migrateIndex) {
+            migrateBucket(migrateIndex);
+        }
+        if (migrateIndex == oldTable.size()) {
+            std::vector<Node*>().swap(oldTable);
+            migrateIndex = 0;
+            SNAZZYDEETS_STAT(instrumentation::emit({"HashMap", "rehash", capacity, 0}));
+        }
+        SNAZZYDEETS_STAT(counters.rehashNanos.add(instrumentation::nanosSince(start)));
+    }
+
+    void finishRehash() {
+        while (rehashing()) {
+            for (; migrateIndex < oldTable.size(); ++migrateIndex) {
+                migrateBucket(migrateIndex);
+            }
+            std::vector<Node*>().swap(oldTable);
+            migrateIndex = 0;
+        }
+    }
 
-    size_t hashFunction(const K& key) const {
-        return std::hash<K>{}(key) % capacity;
+    /**
+     * Stop-the-world resize to newCapacity buckets, relinking existing nodes
+     */
+    void rehashTo(size_t newCapacity) {
+        SNAZZYDEETS_STAT(auto start = std::chrono::steady_clock::now());
+        finishRehash();
+        oldTable.swap(table);
+        capacity = newCapacity;
+        table.assign(capacity, nullptr);
+        migrateIndex = 0;
+        finishRehash();
+        SNAZZYDEETS_STAT(
+            uint64_t nanos = instrumentation::nanosSince(start);
+            counters.rehashes.add();
+            counters.rehashNanos.add(nanos);
+            instrumentation::emit({"HashMap", "rehash", capacity, nanos}));
     }
 
     void rehash() {
-        size_t oldCapacity = capacity;
+        if (!incrementalRehash) {
+            rehashTo(capacity * 2);
+            return;
+        }
+        // Keep both tables alive; later operations drain the old one
+        SNAZZYDEETS_STAT(counters.rehashes.add());
+        finishRehash();
+        oldTable.swap(table);
         capacity *= 2;
-        std::vector<Node*> oldTable = table;
-        table = std::vector<Node*>(capacity, nullptr);
-        mapSize = 0;
+        table.assign(capacity, nullptr);
+        migrateIndex = 0;
+        migrateStep();
+    }
+
+    /**
+     * Locate key in the new table, or in its old bucket if not yet migrated.
+     * Keys are compared only when the cached hashes match.
+     */
+    template<typename Q>
+    Node* findNode(const Q& key, size_t hash) const {
+        if (table.empty()) return nullptr;
+        [[maybe_unused]] size_t steps = 0;
+        Node* current = table[bucketFor(hash)];
+        while (current) {
+            SNAZZYDEETS_STAT(++steps);
+            if (current->hash == hash && keyEqual(current->key, key)) {
+                SNAZZYDEETS_STAT(recordProbe(steps));
+                return current;
+            }
+            current = current->next;
+        }
+        if (rehashing()) {
+            size_t oldIndex = oldBucketFor(hash);
+            if (oldIndex >= migrateIndex) {
+                current = oldTable[oldIndex];
+                while (current) {
+                    SNAZZYDEETS_STAT(++steps);
+                    if (current->hash == hash && keyEqual(current->key, key)) {
+                        SNAZZYDEETS_STAT(recordProbe(steps));
+                        return current;
+                    }
+                    current = current->next;
+                }
+            }
+        }
+        SNAZZYDEETS_STAT(recordProbe(steps));
+        return nullptr;
+    }
 
-        for (size_t i = 0; i < oldCapacity; ++i) {
-            Node* current = oldTable[i];
-            while (current) {
-                insert(current->key, current->value);
-                Node* temp = current;
-                current = current->next;
-                delete temp;
+    template<typename Q>
+    Node* findNode(const Q& key) const {
+        return findNode(key, hasher(key));
+    }
+
+    /**
+     * Unlink key from a bucket chain; returns true if it was removed
+     */
+    template<typename Q>
+    bool eraseFromBucket(Node*& bucket, const Q& key, size_t hash) {
+        Node* current = bucket;
+        Node* prev = nullptr;
+        while (current) {
+            if (current->hash == hash && keyEqual(current->key, key)) {
+                if (prev) {
+                    prev->next = current->next;
+                } else {
+                    bucket = current->next;
+                }
+                delete current;
+                mapSize--;
+                return true;
+            }
+            prev = current;
+            current = current->next;
+        }
+        return false;
+    }
+
+    template<typename Fn>
+    void forEachNode(Fn fn) const {
+        for (size_t i = migrateIndex; i < oldTable.size(); ++i) {
+            for (Node* current = oldTable[i]; current; current = current->next) {
+                fn(current);
+            }
+        }
+        for (const auto& bucket : table) {
+            for (Node* current = bucket; current; current = current->next) {
+                fn(current);
+            }
+        }
+    }
+
+    void copyFrom(const HashMap& other) {
+        other.forEachNode([this](const Node* node) {
+            Node* newNode = new Node(node->key, node->value, node->hash);
+            size_t index = bucketFor(node->hash);
+            newNode->next = table[index];
+            table[index] = newNode;
+            mapSize++;
+        });
+    }
+
+    // ---- parallel bulk operations ----
+    static constexpr size_t PARALLEL_GRAIN = 1 << 14; // keys per slice: below this a fork costs more than it saves
+    static constexpr size_t BUCKET_GRAIN = 1 << 12;   // buckets per slice of a bucket scan
+
+    /**
+     * Buckets in forEachNode's order: unmigrated old buckets, then table
+     */
+    size_t slotCount() const {
+        return oldTable.size() - migrateIndex + table.size();
+    }
+
+    Node* slotHead(size_t i) const {
+        size_t pending = oldTable.size() - migrateIndex;
+        return i < pending ? oldTable[migrateIndex + i] : table[i - pending];
+    }
+
+    template<typename Policy, typename Fn>
+    void forEachNodeOn(const Policy& policy, Fn&& fn) const {
+        parallel::forRange(policy, slotCount(), BUCKET_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                for (Node* current = slotHead(i); current; current = current->next) fn(current);
             }
+        });
+    }
+
+    /**
+     * Partition p of `partitions` is a contiguous range of buckets
+     */
+    size_t partitionOf(size_t hash, size_t partitions) const {
+        return bucketFor(hash) * partitions / capacity;
+    }
+
+    /**
+     * Second half of a parallel bulk insert. lists[c][p] holds the items of
+     * input slice c that land in partition p. One task fills each
+     * partition, taking the slices in order, so every chain ends up as
+     * sequential inserts would leave it and the last duplicate key wins.
+     * The table must already fit every item, with no rehash in flight.
+     * Every item counts as one lookup in stats(), as it would sequentially.
+     * @param entry: item -> tuple of (key, value, hash)
+     */
+    template<typename Policy, typename Item, typename Entry>
+    void insertPartitions(const Policy& policy, const std::vector<std::vector<std::vector<Item>>>& lists,
+                          size_t partitions, Entry entry) {
+        std::atomic<size_t> added{0};
+        SNAZZYDEETS_STAT(HashMapStats tally);
+        auto publish = [&] {
+            mapSize += added.load(std::memory_order_relaxed);
+            SNAZZYDEETS_STAT(
+                counters.lookups.add(tally.lookups);
+                counters.probes.add(tally.probes);
+                counters.maxProbe.raiseTo(tally.maxProbe);
+            );
+        };
+        try {
+            parallel::forChunks(policy, partitions, partitions, [&](size_t p, size_t, size_t) {
+                size_t fresh = 0;
+                [[maybe_unused]] size_t searched = 0, examined = 0, longest = 0;
+                auto record = [&] {
+                    added.fetch_add(fresh, std::memory_order_relaxed);
+                    SNAZZYDEETS_STAT(
+                        tally.lookups.add(searched);
+                        tally.probes.add(examined);
+                        tally.maxProbe.raiseTo(longest);
+                    );
+                };
+                try {
+                    for (const auto& slice : lists) {
+                        for (const Item& item : slice[p]) {
+                            auto [key, value, hash] = entry(item);
+                            Node*& bucket = table[bucketFor(hash)];
+                            Node* current = bucket;
+                            [[maybe_unused]] size_t steps = 0;
+                            while (current) {
+                                SNAZZYDEETS_STAT(++steps);
+                                if (current->hash == hash && keyEqual(current->key, key)) break;
+                                current = current->next;
+                            }
+                            SNAZZYDEETS_STAT(
+                                ++searched;
+                                examined += steps;
+                                longest = std::max(longest, steps);
+                                if (steps > instrumentation::thresholds().probeLength.load(std::memory_order_relaxed)) {
+                                    instrumentation::emit({"HashMap", "longProbe", steps, 0});
+                                }
+                            );
+                            if (current) {
+                                current->value = value;
+                                continue;
+                            }
+                            Node* newNode = new Node(key, value, hash);
+                            newNode->next = bucket;
+                            bucket = newNode;
+                            ++fresh;
+                        }
+                    }
+                } catch (...) {
+                    record();
+                    throw;
+                }
+                record();
+            });
+        } catch (...) {
+            publish();
+            throw;
         }
+        publish();
     }
 
 public:
-    HashMap(size_t cap = 16) : capacity(cap), mapSize(0) {
+    /**
+     * @param cap: Initial bucket count
+     * @param incremental: Spread resizes over later operations instead of
+     *                     rebuilding the whole table inside one insert
+     */
+    HashMap(size_t cap = 16, bool incremental = false, const Hash& hash = Hash(),
+            const KeyEqual& equal = KeyEqual())
+        : migrateIndex(0), mapSize(0), capacity(cap ? cap : 1), incrementalRehash(incremental),
+          hasher(hash), keyEqual(equal) {
         table.resize(capacity, nullptr);
     }
 
+    HashMap(const HashMap& other)
+        : migrateIndex(0), mapSize(0), capacity(other.capacity),
+          incrementalRehash(other.incrementalRehash), hasher(other.hasher), keyEqual(other.keyEqual) {
+        table.resize(capacity, nullptr);
+        copyFrom(other);
+    }
+
+    /**
+     * Leaves other empty with no bucket array: it keeps its bucket count
+     * and allocates the buckets on its next insert or reserve. Noexcept
+     * whenever copying the functors is; other keeps working copies.
+     */
+    HashMap(HashMap&& other) noexcept(std::is_nothrow_copy_constructible_v<Hash> &&
+                                      std::is_nothrow_copy_constructible_v<KeyEqual>)
+        : table(std::move(other.table)), oldTable(std::move(other.oldTable)),
+          migrateIndex(other.migrateIndex), mapSize(other.mapSize),
+          capacity(other.capacity), incrementalRehash(other.incrementalRehash),
+          hasher(other.hasher), keyEqual(other.keyEqual) {
+        other.table.clear();
+        other.oldTable.clear();
+        other.migrateIndex = 0;
+        other.mapSize = 0;
+    }
+
+    HashMap& operator=(HashMap other) {
+        std::swap(table, other.table);
+        std::swap(oldTable, other.oldTable);
+        std::swap(migrateIndex, other.migrateIndex);
+        std::swap(mapSize, other.mapSize);
+        std::swap(capacity, other.capacity);
+        std::swap(incrementalRehash, other.incrementalRehash);
+        std::swap(hasher, other.hasher);
+        std::swap(keyEqual, other.keyEqual);
+        return *this;
+    }
+
     ~HashMap() {
         clear();
     }
 
-    void insert(const K& key, const V& value) {
-        if ((float)mapSize / capacity >= loadFactor) {
-            rehash();
+    /**
+     * Enable or disable incremental rehashing.
+     * Turning it off completes any migration in progress.
+     */
+    void setIncrementalRehash(bool enabled) {
+        incrementalRehash = enabled;
+        if (!enabled) finishRehash();
+    }
+
+    /**
+     * Size the table once so that n entries fit under the load factor
+     */
+    void reserve(size_t n) {
+        ensureTable();
+        size_t newCapacity = capacity;
+        while ((float)n / newCapacity >= loadFactor) {
+            newCapacity *= 2;
         }
+        if (newCapacity != capacity) {
+            rehashTo(newCapacity);
+        }
+    }
+
+    /**
+     * The hash this map stores for key. A caller that needs it anyway (to
+     * pick a shard, say) can hand it to the hash-taking overloads of
+     * insert/get/erase instead of having the key hashed again.
+     */
+    template<typename Q>
+        requires lookupKey<Q>
+    size_t hashOf(const Q& key) const {
+        return hasher(key);
+    }
 
-        size_t index = hashFunction(key);
-        Node* current = table[index];
+    size_t hashOf(const K& key) const {
+        return hasher(key);
+    }
+
+    void insert(const K& key, const V& value) {
+        insert(key, value, hasher(key));
+    }
+
+    /**
+     * Insert with a precomputed hash, which must equal hashOf(key)
+     */
+    void insert(const K& key, const V& value, size_t hash) {
+        ensureTable();
+        migrateStep();
 
         // Update if key exists
-        while (current) {
-            if (current->key == key) {
-                current->value = value;
-                return;
-            }
-            current = current->next;
+        Node* existing = findNode(key, hash);
+        if (existing) {
+            existing->value = value;
+            return;
+        }
+
+        if ((float)mapSize / capacity >= loadFactor) {
+            rehash();
         }
 
         // Insert new node
-        Node* newNode = new Node(key, value);
+        size_t index = bucketFor(hash);
+        Node* newNode = new Node(key, value, hash);
         newNode->next = table[index];
         table[index] = newNode;
         mapSize++;
@@ -105,225 +563,1511 @@ public:
 
     void create_map_from_arrays(const std::vector<K>& keys, const std::vector<V>& values) {
         if (keys.size() != values.size()) {
-            std::cout << RED;
             throw MapException("Arrays must have equal length");
-            std::cout << RESET;
         }
+        reserve(mapSize + keys.size());
         for (size_t i = 0; i < keys.size(); ++i) {
             insert(keys[i], values[i]);
         }
     }
 
+    /**
+     * Bulk insert on a policy. Under par the keys are hashed and grouped by
+     * bucket range, one slice per thread, then each thread links one range
+     * of buckets, so no two threads touch the same chain. The result,
+     * chain order included, matches the sequential overload. Hash must be
+     * safe to call from several threads at once.
+     */
+    template<parallel::ExecutionPolicy Policy>
+    void create_map_from_arrays(const Policy& policy, const std::vector<K>& keys, const std::vector<V>& values) {
+        if (keys.size() != values.size()) {
+            throw MapException("Arrays must have equal length");
+        }
+        size_t n = keys.size();
+        size_t slices = parallel::chunksFor(policy, n, PARALLEL_GRAIN);
+        if (slices < 2) {
+            create_map_from_arrays(keys, values);
+            return;
+        }
+        finishRehash();
+        reserve(mapSize + n);
+        size_t partitions = parallel::chunksFor(policy, capacity, BUCKET_GRAIN);
+        std::vector<size_t> hashes(n);
+        std::vector<std::vector<std::vector<size_t>>> lists(slices, std::vector<std::vector<size_t>>(partitions));
+        parallel::forChunks(policy, n, slices, [&](size_t slice, size_t begin, size_t end) {
+            auto& mine = lists[slice];
+            for (size_t i = begin; i < end; ++i) {
+                hashes[i] = hasher(keys[i]);
+                mine[partitionOf(hashes[i], partitions)].push_back(i);
+            }
+        });
+        insertPartitions(policy, lists, partitions, [&](size_t i) {
+            return std::forward_as_tuple(keys[i], values[i], hashes[i]);
+        });
+    }
+
     std::vector<K> keys() const {
         std::vector<K> result;
-        for (const auto& bucket : table) {
-            Node* current = bucket;
-            while (current) {
-                result.push_back(current->key);
-                current = current->next;
-            }
-        }
+        result.reserve(mapSize);
+        forEachNode([&result](const Node* node) { result.push_back(node->key); });
         return result;
     }
 
     std::vector<V> values() const {
         std::vector<V> result;
-        for (const auto& bucket : table) {
-            Node* current = bucket;
-            while (current) {
-                result.push_back(current->value);
-                current = current->next;
+        result.reserve(mapSize);
+        forEachNode([&result](const Node* node) { result.push_back(node->value); });
+        return result;
+    }
+
+    std::vector<std::pair<K, V>> pairs() const {
+        std::vector<std::pair<K, V>> result;
+        result.reserve(mapSize);
+        forEachNode([&result](const Node* node) { result.push_back({node->key, node->value}); });
+        return result;
+    }
+
+    /**
+     * fn(key, value) for every entry, in bucket order
+     */
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        forEachNode([&fn](const Node* node) { fn(node->key, node->value); });
+    }
+
+    /**
+     * forEach on a policy. Under par, fn is called from several threads
+     * at once, each over its own range of buckets, in no overall order.
+     */
+    template<parallel::ExecutionPolicy Policy, typename Fn>
+    void forEach(const Policy& policy, Fn fn) const {
+        forEachNodeOn(policy, [&fn](const Node* node) { fn(node->key, node->value); });
+    }
+
+    /**
+     * Fold map(key, value) over every entry into init with combine. Each
+     * bucket range is folded on its own and the partial results are then
+     * combined in bucket order, so combine must be associative (it need
+     * not be commutative).
+     */
+    template<parallel::ExecutionPolicy Policy, typename R, typename Map, typename Combine>
+    R reduce(const Policy& policy, R init, Map map, Combine combine) const {
+        return parallel::reduceRange(policy, slotCount(), BUCKET_GRAIN, std::move(init),
+            [&](size_t begin, size_t end) {
+                std::optional<R> partial;
+                for (size_t i = begin; i < end; ++i) {
+                    for (const Node* current = slotHead(i); current; current = current->next) {
+                        if (partial) partial = combine(std::move(*partial), map(current->key, current->value));
+                        else partial.emplace(map(current->key, current->value));
+                    }
+                }
+                return partial;
+            }, combine);
+    }
+
+    /**
+     * A new map of the entries for which pred(key, value) holds, with this
+     * map's bucket count. Bucket i of the result is built only from bucket i
+     * here, so threads never share a chain and stored hashes are reused.
+     */
+    template<parallel::ExecutionPolicy Policy, typename Pred>
+    HashMap filter(const Policy& policy, Pred pred) const {
+        HashMap result(capacity, incrementalRehash, hasher, keyEqual);
+        // Unmigrated old buckets scatter over the whole table: copy them here first
+        for (size_t i = migrateIndex; i < oldTable.size(); ++i) {
+            for (const Node* current = oldTable[i]; current; current = current->next) {
+                if (!pred(current->key, current->value)) continue;
+                Node* newNode = new Node(current->key, current->value, current->hash);
+                size_t index = bucketFor(current->hash);
+                newNode->next = result.table[index];
+                result.table[index] = newNode;
+                result.mapSize++;
+            }
+        }
+        std::atomic<size_t> kept{0};
+        parallel::forRange(policy, table.size(), BUCKET_GRAIN, [&](size_t begin, size_t end) {
+            size_t count = 0;
+            for (size_t i = begin; i < end; ++i) {
+                Node* chain = nullptr;
+                Node** tail = &chain;
+                try {
+                    for (const Node* current = table[i]; current; current = current->next) {
+                        if (!pred(current->key, current->value)) continue;
+                        *tail = new Node(current->key, current->value, current->hash);
+                        tail = &(*tail)->next;
+                        ++count;
+                    }
+                } catch (...) {
+                    *tail = result.table[i];
+                    result.table[i] = chain;
+                    kept.fetch_add(count, std::memory_order_relaxed);
+                    throw;
+                }
+                *tail = result.table[i];
+                result.table[i] = chain;
+            }
+            kept.fetch_add(count, std::memory_order_relaxed);
+        });
+        result.mapSize += kept.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    V& at(const K& key) {
+        Node* node = findNode(key);
+        if (!node) {
+            throw KeyNotFoundException(toString(key));
+        }
+        return node->value;
+    }
+
+    /**
+     * Look up by any key type the hasher accepts, e.g. a std::string_view
+     * in a std::string-keyed map, without constructing a K
+     */
+    template<typename Q>
+        requires lookupKey<Q>
+    V& at(const Q& key) {
+        Node* node = findNode(key);
+        if (!node) {
+            throw KeyNotFoundException(toString(key));
+        }
+        return node->value;
+    }
+
+    /**
+     * Pointer to the value stored under key, or nullptr if it is absent.
+     * The hash-taking forms expect hashOf(key).
+     */
+    V* get(const K& key) {
+        Node* node = findNode(key);
+        return node ? &node->value : nullptr;
+    }
+
+    const V* get(const K& key) const {
+        const Node* node = findNode(key);
+        return node ? &node->value : nullptr;
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    V* get(const Q& key, size_t hash) {
+        Node* node = findNode(key, hash);
+        return node ? &node->value : nullptr;
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    const V* get(const Q& key, size_t hash) const {
+        const Node* node = findNode(key, hash);
+        return node ? &node->value : nullptr;
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    V* get(const Q& key) {
+        return get(key, hasher(key));
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    const V* get(const Q& key) const {
+        return get(key, hasher(key));
+    }
+
+    V& operator[](const K& key) {
+        Node* node = findNode(key);
+        if (node) {
+            return node->value;
+        }
+        // Insert with default value
+        insert(key, V());
+        return at(key);
+    }
+
+    void erase(const K& key) {
+        erase(key, hasher(key));
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    void erase(const Q& key) {
+        erase(key, hasher(key));
+    }
+
+    /**
+     * Erase with a precomputed hash, which must equal hashOf(key)
+     */
+    template<typename Q>
+        requires lookupKey<Q>
+    void erase(const Q& key, size_t hash) {
+        migrateStep();
+        if (!table.empty() && eraseFromBucket(table[bucketFor(hash)], key, hash)) {
+            return;
+        }
+        if (rehashing()) {
+            size_t oldIndex = oldBucketFor(hash);
+            if (oldIndex >= migrateIndex && eraseFromBucket(oldTable[oldIndex], key, hash)) {
+                return;
             }
         }
+        throw KeyNotFoundException(toString(key));
+    }
+
+    void erase(const std::vector<K>& keysToDelete) {
+        for (const auto& key : keysToDelete) {
+            try {
+                erase(key);
+            } catch (const KeyNotFoundException&) {
+                // Continue deleting other keys
+            }
+        }
+    }
+
+    HashMap operator+(const HashMap& other) const {
+        HashMap result(*this);
+        result.update(other);
         return result;
     }
 
-    std::vector<std::pair<K, V>> pairs() const {
-        std::vector<std::pair<K, V>> result;
-        for (const auto& bucket : table) {
-            Node* current = bucket;
-            while (current) {
-                result.push_back({current->key, current->value});
-                current = current->next;
-            }
+    void update(const HashMap& other) {
+        reserve(mapSize + other.size());
+        auto otherPairs = other.pairs();
+        for (const auto& p : otherPairs) {
+            insert(p.first, p.second);
+        }
+    }
+
+    /**
+     * update on a policy: other's buckets are split between threads, which
+     * hash and group its entries, then merged in like create_map_from_arrays
+     */
+    template<parallel::ExecutionPolicy Policy>
+    void update(const Policy& policy, const HashMap& other) {
+        if (&other == this) return;
+        size_t slots = other.slotCount();
+        size_t slices = parallel::chunksFor(policy, slots, BUCKET_GRAIN);
+        if (slices < 2 || other.size() < PARALLEL_GRAIN) {
+            update(other);
+            return;
+        }
+        finishRehash();
+        reserve(mapSize + other.size());
+        size_t partitions = parallel::chunksFor(policy, capacity, BUCKET_GRAIN);
+        using Item = std::pair<const Node*, size_t>;  // other's node, its hash under this map's hasher
+        std::vector<std::vector<std::vector<Item>>> lists(slices, std::vector<std::vector<Item>>(partitions));
+        parallel::forChunks(policy, slots, slices, [&](size_t slice, size_t begin, size_t end) {
+            auto& mine = lists[slice];
+            for (size_t i = begin; i < end; ++i) {
+                for (const Node* current = other.slotHead(i); current; current = current->next) {
+                    size_t hash = hasher(current->key);
+                    mine[partitionOf(hash, partitions)].push_back({current, hash});
+                }
+            }
+        });
+        insertPartitions(policy, lists, partitions, [](const Item& item) {
+            return std::forward_as_tuple(item.first->key, item.first->value, item.second);
+        });
+    }
+
+    bool find(const K& key) const {
+        return findNode(key) != nullptr;
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    bool find(const Q& key) const {
+        return findNode(key) != nullptr;
+    }
+
+    bool exists(const K& key) const {
+        return find(key);
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    bool exists(const Q& key) const {
+        return find(key);
+    }
+
+    bool existsValue(const V& value) const {
+        bool found = false;
+        forEachNode([&](const Node* node) {
+            if (!found && node->value == value) found = true;
+        });
+        return found;
+    }
+
+    /**
+     * existsValue on a policy; every thread stops once any has a match
+     */
+    template<parallel::ExecutionPolicy Policy>
+    bool existsValue(const Policy& policy, const V& value) const {
+        std::atomic<bool> found{false};
+        parallel::forRange(policy, slotCount(), BUCKET_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end && !found.load(std::memory_order_relaxed); ++i) {
+                for (const Node* current = slotHead(i); current; current = current->next) {
+                    if (current->value == value) {
+                        found.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+            }
+        });
+        return found.load(std::memory_order_relaxed);
+    }
+
+    void sort_by(const std::string& criterion) {
+        auto pairsList = pairs();
+        if (criterion == "key") {
+            std::sort(pairsList.begin(), pairsList.end(),
+                [](const auto& a, const auto& b)
+                { 
+                return a.first < b.first; 
+                });
+        }
+
+        else if (criterion == "key-reverse" || criterion == "keyreverse") {
+            std::sort(pairsList.begin(), pairsList.end(),
+                [](const auto& a, const auto& b) { return a.first > b.first; });
+        }
+
+        else if (criterion == "value") {
+            std::sort(pairsList.begin(), pairsList.end(),
+                [](const auto& a, const auto& b) { return a.second < b.second; });
+        }
+
+
+        else if (criterion == "value-reverse" || criterion == "valuereverse") {
+            std::sort(pairsList.rbegin(), pairsList.rend(),
+                [](const auto& a, const auto& b) { return a.second < b.second; });
+        }
+
+        else {
+              throw std::logic_error("Invalid Sorting criteria. It should be either of: key, key-reverse, value, value-reverse\n");
+        }
+
+        clear();
+        for (const auto& p : pairsList) {
+            insert(p.first, p.second);
+        }
+    }
+
+    size_t size() const { return mapSize; }
+
+    size_t bucketCount() const { return capacity; }
+
+    void clear() {
+        finishRehash();
+        for (auto& bucket : table) {
+            Node* current = bucket;
+            while (current) {
+                Node* temp = current;
+                current = current->next;
+                delete temp;
+            }
+            bucket = nullptr;
+        }
+        mapSize = 0;
+    }
+
+    /**
+     * Counter snapshot. maxChain is measured now, by walking every bucket.
+     * All zero unless built with SNAZZYDEETS_STATS.
+     */
+    HashMapStats stats() const {
+#ifdef SNAZZYDEETS_STATS
+        HashMapStats result = counters;
+        uint64_t longest = 0;
+        auto measure = [&longest](const Node* head) {
+            uint64_t length = 0;
+            for (; head; head = head->next) ++length;
+            longest = std::max(longest, length);
+        };
+        for (size_t i = migrateIndex; i < oldTable.size(); ++i) measure(oldTable[i]);
+        for (const Node* bucket : table) measure(bucket);
+        result.maxChain = longest;
+        return result;
+#else
+        return HashMapStats{};
+#endif
+    }
+
+    void resetStats() {
+#ifdef SNAZZYDEETS_STATS
+        counters = HashMapStats{};
+#endif
+    }
+
+    /**
+     * Write the map as a flat open-addressing image that HashMapView probes
+     * in place: a used-byte array, the stored hashes, then the keys and values.
+     * Slots are a power of two at a load factor of at most 1/2.
+     * Hashes are stored, not recomputed, so readers must use the same Hash.
+     */
+    void saveSnapshot(const std::string& path) const
+        requires snapshot::Storable<K> && snapshot::Storable<V>
+    {
+        size_t slots = std::bit_ceil(std::max<size_t>(16, mapSize * 2));
+        size_t mask = slots - 1;
+        std::vector<uint8_t> used(slots, 0);
+        std::vector<uint64_t> hashes(slots, 0);
+        std::vector<std::byte> keyBytes(slots * sizeof(K));
+        std::vector<std::byte> valueBytes(slots * sizeof(V));
+        forEachNode([&](const Node* node) {
+            size_t i = snapshot::spread(node->hash) & mask;
+            while (used[i]) i = (i + 1) & mask;
+            used[i] = 1;
+            hashes[i] = node->hash;
+            std::memcpy(keyBytes.data() + i * sizeof(K), &node->key, sizeof(K));
+            std::memcpy(valueBytes.data() + i * sizeof(V), &node->value, sizeof(V));
+        });
+
+        auto writer = snapshot::Writer::forTypes<K, V>(path, snapshot::Kind::HashMap);
+        writer.section(used.data(), slots);
+        writer.section(hashes.data(), slots);
+        writer.section(keyBytes.data(), keyBytes.size());
+        writer.section(valueBytes.data(), valueBytes.size());
+        writer.finish(mapSize, slots);
+    }
+
+    /**
+     * Rebuild a mutable map from saveSnapshot output. The table is sized
+     * once and nodes are linked with their stored hashes: no key is
+     * rehashed or compared.
+     */
+    static HashMap loadSnapshot(const std::string& path, bool incremental = false,
+                                const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        requires snapshot::Storable<K> && snapshot::Storable<V>
+    {
+        snapshot::MappedFile file(path);
+        file.expect<K, V>(snapshot::Kind::HashMap);
+        const snapshot::Header& header = file.header();
+        size_t slots = header.extra;
+        if (!std::has_single_bit(slots) || header.count >= slots) {
+            throw snapshot::SnapshotError("'" + path + "' has a corrupt slot table");
+        }
+        auto used = file.section<uint8_t>(0, slots);
+        auto hashes = file.section<uint64_t>(1, slots);
+        auto keySlots = file.section<K>(2, slots);
+        auto valueSlots = file.section<V>(3, slots);
+        size_t occupied = static_cast<size_t>(std::count_if(used.begin(), used.end(),
+                                                            [](uint8_t flag) { return flag != 0; }));
+        if (occupied != header.count) {
+            throw snapshot::SnapshotError("'" + path + "' has a corrupt slot table");
+        }
+
+        HashMap result(16, incremental, hash, equal);
+        result.reserve(header.count);
+        for (size_t i = 0; i < slots; ++i) {
+            if (!used[i]) continue;
+            Node* node = new Node(keySlots[i], valueSlots[i], (size_t)hashes[i]);
+            size_t index = result.bucketFor(node->hash);
+            node->next = result.table[index];
+            result.table[index] = node;
+            result.mapSize++;
+        }
+        return result;
+    }
+
+    void display(bool use_color = false) const {
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("\n╔══════════════ HashMap ══════════════╗\n", BRIGHT_BLACK, true); 
+        if (mapSize == 0) {
+            w.paint("║  (empty)                           ║\n", BRIGHT_RED);
+        } else {
+            forEachNode([&w](const Node* current) {
+                w.paint("║  ", BRIGHT_BLACK, true);
+                w.paint(current->key, BRIGHT_BLUE);
+                w.paint(" → ", BRIGHT_YELLOW);
+                w.paint(current->value, GREEN);
+                w << '\n';
+            });
+        }
+        w << "\n";
+        w.paint("╚═════════════════════════════════════╝\n", BRIGHT_BLACK);
+        w.paint("Size: ");
+        w.paint(mapSize, BRIGHT_CYAN);
+        w << "\n\n";
+    }
+};
+
+// ==================== HASH MAP SNAPSHOT VIEW ====================
+/**
+ * Read-only HashMap over a memory-mapped snapshot. Opening one maps the
+ * file and nothing else; lookups probe the mapped slots directly, so only
+ * the pages a query touches are ever read from disk.
+ *
+ * Hash and KeyEqual must match the map that wrote the snapshot.
+ */
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename KeyEqual = std::equal_to<>>
+    requires snapshot::Storable<K> && snapshot::Storable<V>
+class HashMapView {
+private:
+    snapshot::MappedFile file;
+    std::span<const uint8_t> used;
+    std::span<const uint64_t> hashes;
+    std::span<const K> keySlots;
+    std::span<const V> valueSlots;
+    size_t entries;
+    size_t mask;
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] KeyEqual keyEqual;
+
+    // At most one lap of the table, so a corrupt file with every used byte
+    // set cannot make a miss spin
+    const V* lookup(const K& key) const {
+        uint64_t hash = hasher(key);
+        size_t i = snapshot::spread(hash) & mask;
+        for (size_t probes = 0; probes <= mask && used[i]; ++probes, i = (i + 1) & mask) {
+            if (hashes[i] == hash && keyEqual(keySlots[i], key)) return &valueSlots[i];
+        }
+        return nullptr;
+    }
+
+public:
+    explicit HashMapView(const std::string& path, const Hash& hash = Hash(),
+                         const KeyEqual& equal = KeyEqual())
+        : file(path), hasher(hash), keyEqual(equal) {
+        file.expect<K, V>(snapshot::Kind::HashMap);
+        const snapshot::Header& header = file.header();
+        size_t slots = header.extra;
+        if (!std::has_single_bit(slots) || header.count >= slots) {
+            throw snapshot::SnapshotError("'" + path + "' has a corrupt slot table");
+        }
+        used = file.section<uint8_t>(0, slots);
+        hashes = file.section<uint64_t>(1, slots);
+        keySlots = file.section<K>(2, slots);
+        valueSlots = file.section<V>(3, slots);
+        entries = header.count;
+        mask = slots - 1;
+    }
+
+    /**
+     * Pointer into the mapping for key's value, or nullptr if it is absent
+     */
+    const V* get(const K& key) const {
+        return lookup(key);
+    }
+
+    const V& at(const K& key) const {
+        const V* value = lookup(key);
+        if (!value) {
+            throw KeyNotFoundException(toString(key));
+        }
+        return *value;
+    }
+
+    bool find(const K& key) const {
+        return lookup(key) != nullptr;
+    }
+
+    bool exists(const K& key) const {
+        return find(key);
+    }
+
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        for (size_t i = 0; i <= mask; ++i) {
+            if (used[i]) fn(keySlots[i], valueSlots[i]);
+        }
+    }
+
+    std::vector<std::pair<K, V>> pairs() const {
+        std::vector<std::pair<K, V>> result;
+        result.reserve(entries);
+        forEach([&result](const K& key, const V& value) { result.push_back({key, value}); });
+        return result;
+    }
+
+    size_t size() const { return entries; }
+    bool empty() const { return entries == 0; }
+    size_t slotCount() const { return mask + 1; }
+
+    // True when backed by mmap rather than a buffered read of the file
+    bool isMapped() const { return file.isMapped(); }
+};
+
+// ==================== FLAT HASH MAP (OPEN ADDRESSING) ====================
+namespace flat_detail {
+    // Control byte per slot: EMPTY / DELETED, or the low 7 bits of the hash (H2)
+    using ctrl_t = signed char;
+    constexpr ctrl_t CTRL_EMPTY = -128;
+    constexpr ctrl_t CTRL_DELETED = -2;
+    constexpr size_t GROUP_WIDTH = 16;
+
+    // std::hash<int> is the identity on most standard libraries, so spread the
+    // bits before splitting into H1 (probe position) and H2 (control byte)
+    inline size_t mixHash(size_t h) {
+        uint64_t x = static_cast<uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(x ^ (x >> 32));
+    }
+
+    /**
+     * Set of matching lanes inside a group.
+     * Each lane occupies (1 << shift) bits so NEON's nibble masks and
+     * SSE2's movemask share the same iteration code.
+     */
+    struct BitMask {
+        uint64_t bits;
+        int shift;
+
+        BitMask(uint64_t b, int s) : bits(b), shift(s) {}
+        bool any() const { return bits != 0; }
+        size_t lowest() const { return static_cast<size_t>(std::countr_zero(bits)) >> shift; }
+        void clearLowest() { bits &= bits - 1; }
+    };
+
+    /**
+     * Sixteen control bytes scanned in parallel
+     */
+    struct Group {
+#if defined(MAPS_HAVE_SSE2)
+        __m128i ctrl;
+        explicit Group(const ctrl_t* pos)
+            : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+        BitMask match(ctrl_t h2) const {
+            return BitMask(static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))), 0);
+        }
+        BitMask matchEmpty() const { return match(CTRL_EMPTY); }
+        BitMask matchEmptyOrDeleted() const {
+            // EMPTY and DELETED are the only control values below -1
+            return BitMask(static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl))), 0);
+        }
+#elif defined(MAPS_HAVE_NEON)
+        int8x16_t ctrl;
+        explicit Group(const ctrl_t* pos) : ctrl(vld1q_s8(pos)) {}
+
+        static BitMask toMask(uint8x16_t eq) {
+            uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+            uint64_t m = vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+            return BitMask(m & 0x8888888888888888ull, 2);
+        }
+        BitMask match(ctrl_t h2) const { return toMask(vceqq_s8(vdupq_n_s8(h2), ctrl)); }
+        BitMask matchEmpty() const { return match(CTRL_EMPTY); }
+        BitMask matchEmptyOrDeleted() const { return toMask(vcltq_s8(ctrl, vdupq_n_s8(-1))); }
+#else
+        const ctrl_t* ctrl;
+        explicit Group(const ctrl_t* pos) : ctrl(pos) {}
+
+        BitMask match(ctrl_t h2) const {
+            uint64_t m = 0;
+            for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+                if (ctrl[i] == h2) m |= (uint64_t{1} << i);
+            }
+            return BitMask(m, 0);
+        }
+        BitMask matchEmpty() const { return match(CTRL_EMPTY); }
+        BitMask matchEmptyOrDeleted() const {
+            uint64_t m = 0;
+            for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+                if (ctrl[i] < -1) m |= (uint64_t{1} << i);
+            }
+            return BitMask(m, 0);
+        }
+#endif
+    };
+
+    /**
+     * Open-addressing slot table shared by FlatHashMap and HashSet (sets/).
+     * Slot is the stored element (a key/value pair, or the key itself);
+     * KeyOf::get(slot) returns its key, which is hashed with std::hash.
+     * Slots are raw storage, constructed only where the control byte is
+     * full: findOrPrepareInsert() claims a slot and the caller constructs
+     * it with constructAt().
+     */
+    template<typename Slot, typename KeyOf>
+    class RawTable {
+    public:
+        using Key = std::remove_cvref_t<decltype(KeyOf::get(std::declval<const Slot&>()))>;
+        static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    private:
+        ctrl_t* ctrl;               // one byte per slot, or emptyGroup() with no slots
+        Slot* slots;                // raw storage
+        size_t capacity;            // power of two, multiple of GROUP_WIDTH
+        size_t count;
+        size_t growthLeft;          // inserts into EMPTY slots allowed before resizing
+
+        static size_t maxLoad(size_t cap) { return cap - cap / 8; } // 7/8 load factor
+
+        static size_t normalizeCapacity(size_t cap) {
+            return std::bit_ceil(std::max(cap, GROUP_WIDTH));
+        }
+
+        static ctrl_t h2(size_t hash) { return static_cast<ctrl_t>(hash & 0x7F); }
+        static size_t h1(size_t hash) { return hash >> 7; }
+
+        /**
+         * One shared all-EMPTY group for tables that own no storage (a
+         * moved-from table), so leaving that state never allocates. Lookups
+         * probe it and miss; growthLeft is 0, so the first insert resizes
+         * before any byte of it could be written.
+         */
+        static ctrl_t* emptyGroup() {
+            static ctrl_t group[GROUP_WIDTH] = {
+                CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY,
+                CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY};
+            return group;
+        }
+
+        void becomeEmpty() {
+            ctrl = emptyGroup();
+            slots = nullptr;
+            capacity = GROUP_WIDTH;
+            count = 0;
+            growthLeft = 0;
+        }
+
+        static void releaseCtrl(ctrl_t* bytes) {
+            if (bytes != emptyGroup()) delete[] bytes;
+        }
+
+        /**
+         * Fresh all-EMPTY storage for cap slots. Replaces ctrl and slots
+         * without freeing them; on bad_alloc neither is touched.
+         */
+        void allocate(size_t cap) {
+            ctrl_t* bytes = new ctrl_t[cap];
+            try {
+                slots = std::allocator<Slot>{}.allocate(cap);
+            } catch (...) {
+                delete[] bytes;
+                throw;
+            }
+            std::fill(bytes, bytes + cap, CTRL_EMPTY);
+            ctrl = bytes;
+            capacity = cap;
+            growthLeft = maxLoad(capacity);
+        }
+
+        void destroySlots() {
+            if (!slots) return;
+            for (size_t i = 0; i < capacity; ++i) {
+                if (isFull(ctrl[i])) std::destroy_at(slots + i);
+            }
+            std::allocator<Slot>{}.deallocate(slots, capacity);
+            slots = nullptr;
+        }
+
+        /**
+         * First EMPTY or DELETED slot on the probe sequence of hash
+         */
+        size_t findInsertIndex(size_t hash) const {
+            size_t groupMask = capacity / GROUP_WIDTH - 1;
+            size_t g = h1(hash) & groupMask;
+            for (size_t step = 1; ; ++step) {
+                size_t base = g * GROUP_WIDTH;
+                auto m = Group(ctrl + base).matchEmptyOrDeleted();
+                if (m.any()) return base + m.lowest();
+                g = (g + step) & groupMask;
+            }
+        }
+
+        /**
+         * Rebuild into newCapacity slots, moving entries and dropping tombstones
+         */
+        void resize(size_t newCapacity) {
+            ctrl_t* oldCtrl = ctrl;
+            Slot* oldSlots = slots;
+            size_t oldCapacity = capacity;
+
+            allocate(newCapacity);
+            for (size_t i = 0; i < oldCapacity; ++i) {
+                if (!isFull(oldCtrl[i])) continue;
+                size_t hash = hashOf(KeyOf::get(oldSlots[i]));
+                size_t idx = findInsertIndex(hash);
+                ctrl[idx] = h2(hash);
+                std::construct_at(slots + idx, std::move(oldSlots[i]));
+                std::destroy_at(oldSlots + i);
+            }
+            growthLeft -= count;
+            if (oldSlots) std::allocator<Slot>{}.deallocate(oldSlots, oldCapacity);
+            releaseCtrl(oldCtrl);
+        }
+
+        /**
+         * Make room for one more entry. Tables clogged with tombstones are
+         * rehashed in place; otherwise capacity doubles.
+         */
+        void growIfNeeded() {
+            if (growthLeft > 0) return;
+            if (count * 2 <= maxLoad(capacity)) {
+                resize(capacity);
+            } else {
+                resize(capacity * 2);
+            }
+        }
+
+    public:
+        explicit RawTable(size_t cap = 16) : count(0) {
+            allocate(normalizeCapacity(cap));
+        }
+
+        RawTable(const RawTable& other) : count(0) {
+            becomeEmpty();
+            if (!other.slots) return;
+            allocate(other.capacity);
+            size_t i = 0;
+            try {
+                for (; i < capacity; ++i) {
+                    if (isFull(other.ctrl[i])) std::construct_at(slots + i, other.slots[i]);
+                }
+            } catch (...) {
+                std::copy(other.ctrl, other.ctrl + i, ctrl);    // destroySlots frees exactly these
+                destroySlots();
+                releaseCtrl(ctrl);
+                throw;
+            }
+            std::copy(other.ctrl, other.ctrl + capacity, ctrl);
+            count = other.count;
+            growthLeft = other.growthLeft;
+        }
+
+        // Leaves other empty without allocating (see emptyGroup)
+        RawTable(RawTable&& other) noexcept
+            : ctrl(other.ctrl), slots(other.slots), capacity(other.capacity),
+              count(other.count), growthLeft(other.growthLeft) {
+            other.becomeEmpty();
+        }
+
+        RawTable& operator=(RawTable other) {
+            std::swap(ctrl, other.ctrl);
+            std::swap(slots, other.slots);
+            std::swap(capacity, other.capacity);
+            std::swap(count, other.count);
+            std::swap(growthLeft, other.growthLeft);
+            return *this;
+        }
+
+        ~RawTable() {
+            destroySlots();
+            releaseCtrl(ctrl);
+        }
+
+        static bool isFull(ctrl_t c) { return c >= 0; }
+
+        static size_t hashOf(const Key& key) {
+            return mixHash(std::hash<Key>{}(key));
+        }
+
+        size_t size() const { return count; }
+        size_t slotCount() const { return capacity; }
+        bool full(size_t idx) const { return isFull(ctrl[idx]); }
+        Slot& slot(size_t idx) { return slots[idx]; }
+        const Slot& slot(size_t idx) const { return slots[idx]; }
+
+        /**
+         * Index of the slot holding key, or NPOS.
+         * Groups are probed triangularly; a group with an EMPTY byte ends the probe.
+         */
+        size_t findIndex(const Key& key, size_t hash) const {
+            size_t groupMask = capacity / GROUP_WIDTH - 1;
+            size_t g = h1(hash) & groupMask;
+            for (size_t step = 1; ; ++step) {
+                size_t base = g * GROUP_WIDTH;
+                Group group(ctrl + base);
+                for (auto m = group.match(h2(hash)); m.any(); m.clearLowest()) {
+                    size_t idx = base + m.lowest();
+                    if (KeyOf::get(slots[idx]) == key) return idx;
+                }
+                if (group.matchEmpty().any()) return NPOS;
+                g = (g + step) & groupMask;
+            }
+        }
+
+        size_t findIndex(const Key& key) const {
+            return findIndex(key, hashOf(key));
+        }
+
+        /**
+         * Index of key's slot, claiming a fresh slot if absent.
+         * When inserted is set the slot's ctrl byte is written but the Slot
+         * itself is still unconstructed; the caller must constructAt() it.
+         */
+        size_t findOrPrepareInsert(const Key& key, bool& inserted) {
+            size_t hash = hashOf(key);
+            size_t idx = findIndex(key, hash);
+            if (idx != NPOS) {
+                inserted = false;
+                return idx;
+            }
+            growIfNeeded();
+            idx = findInsertIndex(hash);
+            if (ctrl[idx] == CTRL_EMPTY) growthLeft--;
+            ctrl[idx] = h2(hash);
+            count++;
+            inserted = true;
+            return idx;
+        }
+
+        template<typename... Args>
+        void constructAt(size_t idx, Args&&... args) {
+            std::construct_at(slots + idx, std::forward<Args>(args)...);
+        }
+
+        void eraseAt(size_t idx) {
+            std::destroy_at(slots + idx);
+            count--;
+
+            // A probe never continues past a group that still has an EMPTY byte,
+            // so the slot can be reclaimed outright; otherwise leave a tombstone
+            size_t base = idx & ~(GROUP_WIDTH - 1);
+            if (Group(ctrl + base).matchEmpty().any()) {
+                ctrl[idx] = CTRL_EMPTY;
+                growthLeft++;
+            } else {
+                ctrl[idx] = CTRL_DELETED;
+            }
+        }
+
+        /**
+         * Pre-size the table so that n entries fit without a resize
+         */
+        void reserve(size_t n) {
+            size_t needed = normalizeCapacity(n + n / 7 + 1);
+            if (needed > capacity) resize(needed);
+        }
+
+        void clear() {
+            if (!slots) return;
+            for (size_t i = 0; i < capacity; ++i) {
+                if (isFull(ctrl[i])) std::destroy_at(slots + i);
+            }
+            std::fill(ctrl, ctrl + capacity, CTRL_EMPTY);
+            count = 0;
+            growthLeft = maxLoad(capacity);
+        }
+
+        /**
+         * Calls fn(slot) for every stored element, in slot order
+         */
+        template<typename Fn>
+        void forEach(Fn&& fn) const {
+            for (size_t i = 0; i < capacity; ++i) {
+                if (isFull(ctrl[i])) fn(slots[i]);
+            }
+        }
+    };
+}
+
+/**
+ * FlatHashMap - open-addressing (Swiss table style) alternative to HashMap.
+ * Entries live inline in one flat slot array; a parallel array of control
+ * bytes is probed 16 slots at a time with SSE2/NEON, so a lookup touches
+ * one control group and usually one slot instead of walking a chain.
+ * Offers the same insert/at/erase/find/keys/pairs API as HashMap.
+ */
+template<typename K, typename V>
+class FlatHashMap {
+private:
+    struct Slot {
+        K key;
+        V value;
+        Slot(const K& k, const V& v) : key(k), value(v) {}
+    };
+
+    struct KeyOf {
+        static const K& get(const Slot& slot) { return slot.key; }
+    };
+
+    using Table = flat_detail::RawTable<Slot, KeyOf>;
+    static constexpr size_t NPOS = Table::NPOS;
+
+    Table table;
+
+public:
+    FlatHashMap(size_t cap = 16) : table(cap) {}
+
+    void insert(const K& key, const V& value) {
+        bool inserted;
+        size_t idx = table.findOrPrepareInsert(key, inserted);
+        if (inserted) {
+            table.constructAt(idx, key, value);
+        } else {
+            table.slot(idx).value = value;
+        }
+    }
+
+    /**
+     * Pre-size the table so that n entries fit without a resize
+     */
+    void reserve(size_t n) {
+        table.reserve(n);
+    }
+
+    void create_map_from_arrays(const std::vector<K>& keys, const std::vector<V>& values) {
+        if (keys.size() != values.size()) {
+            throw MapException("Arrays must have equal length");
+        }
+        reserve(table.size() + keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            insert(keys[i], values[i]);
+        }
+    }
+
+    std::vector<K> keys() const {
+        std::vector<K> result;
+        result.reserve(table.size());
+        table.forEach([&result](const Slot& slot) { result.push_back(slot.key); });
+        return result;
+    }
+
+    std::vector<V> values() const {
+        std::vector<V> result;
+        result.reserve(table.size());
+        table.forEach([&result](const Slot& slot) { result.push_back(slot.value); });
+        return result;
+    }
+
+    std::vector<std::pair<K, V>> pairs() const {
+        std::vector<std::pair<K, V>> result;
+        result.reserve(table.size());
+        table.forEach([&result](const Slot& slot) { result.push_back({slot.key, slot.value}); });
+        return result;
+    }
+
+    V& at(const K& key) {
+        size_t idx = table.findIndex(key);
+        if (idx == NPOS) {
+            throw KeyNotFoundException(toString(key));
+        }
+        return table.slot(idx).value;
+    }
+
+    V& operator[](const K& key) {
+        bool inserted;
+        size_t idx = table.findOrPrepareInsert(key, inserted);
+        if (inserted) {
+            table.constructAt(idx, key, V());
+        }
+        return table.slot(idx).value;
+    }
+
+    void erase(const K& key) {
+        size_t idx = table.findIndex(key);
+        if (idx == NPOS) {
+            throw KeyNotFoundException(toString(key));
+        }
+        table.eraseAt(idx);
+    }
+
+    void erase(const std::vector<K>& keysToDelete) {
+        for (const auto& key : keysToDelete) {
+            try {
+                erase(key);
+            } catch (const KeyNotFoundException&) {
+                // Continue deleting other keys
+            }
+        }
+    }
+
+    FlatHashMap<K, V> operator+(const FlatHashMap<K, V>& other) const {
+        FlatHashMap<K, V> result(*this);
+        result.update(other);
+        return result;
+    }
+
+    void update(const FlatHashMap<K, V>& other) {
+        reserve(table.size() + other.size());
+        other.table.forEach([this](const Slot& slot) { insert(slot.key, slot.value); });
+    }
+
+    bool find(const K& key) const {
+        return table.findIndex(key) != NPOS;
+    }
+
+    bool exists(const K& key) const {
+        return find(key);
+    }
+
+    bool existsValue(const V& value) const {
+        for (size_t i = 0; i < table.slotCount(); ++i) {
+            if (table.full(i) && table.slot(i).value == value) return true;
+        }
+        return false;
+    }
+
+    size_t size() const { return table.size(); }
+
+    void clear() {
+        table.clear();
+    }
+
+    void display(bool use_color = false) const {
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("\n╔════════════ FlatHashMap ════════════╗\n", BRIGHT_BLACK, true);
+        if (table.size() == 0) {
+            w.paint("║  (empty)                           ║\n", BRIGHT_RED);
+        } else {
+            table.forEach([&w](const Slot& slot) {
+                w.paint("║  ", BRIGHT_BLACK, true);
+                w.paint(slot.key, BRIGHT_BLUE);
+                w.paint(" → ", BRIGHT_YELLOW);
+                w.paint(slot.value, GREEN);
+                w << "\n";
+            });
+        }
+        w << "\n";
+        w.paint("╚═════════════════════════════════════╝\n", BRIGHT_BLACK);
+        w.paint("Size: ");
+        w.paint(table.size(), BRIGHT_CYAN);
+        w.paint(" | Slots: ");
+        w.paint(table.slotCount(), BRIGHT_CYAN);
+        w << "\n\n";
+    }
+};
+
+// ==================== CONCURRENT HASH MAP ====================
+/**
+ * ConcurrentHashMap - thread-safe HashMap split into independent shards.
+ * Each shard is an ordinary HashMap behind its own reader/writer lock and
+ * resizes on its own, so threads touching different shards never wait on
+ * each other and readers of one shard only wait for its writers.
+ * Lookups return copies: a reference would outlive the lock. Each key is
+ * hashed once per call; the shard reuses that hash for its own lookup.
+ */
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename KeyEqual = std::equal_to<>>
+class ConcurrentHashMap {
+public:
+    struct ShardStats {
+        size_t size;
+        size_t buckets;
+        uint64_t reads;
+        uint64_t writes;
+        uint64_t contendedReads;    // shared lock was not free on first try
+        uint64_t contendedWrites;   // exclusive lock was not free on first try
+    };
+
+private:
+    // One cache line (or more) per shard so locks do not false-share
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        HashMap<K, V, Hash, KeyEqual> map;
+        mutable std::atomic<uint64_t> reads{0};
+        mutable std::atomic<uint64_t> writes{0};
+        mutable std::atomic<uint64_t> contendedReads{0};
+        mutable std::atomic<uint64_t> contendedWrites{0};
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shardMask;
+    [[no_unique_address]] Hash hasher;
+
+    template<typename Q>
+    static constexpr bool lookupKey = std::same_as<Q, K> || TransparentFunctors<Hash, KeyEqual>;
+
+    /**
+     * Pick the shard from mixed hash bits; the shard's HashMap buckets by
+     * the raw hash, so the two choices stay independent
+     */
+    Shard& shardFor(size_t hash) const {
+        return shards[flat_detail::mixHash(hash) & shardMask];
+    }
+
+    template<typename Q>
+    std::optional<V> lookup(const Q& key) const {
+        size_t hash = hasher(key);
+        const Shard& shard = shardFor(hash);
+        auto lock = readLock(shard);
+        if (const V* value = shard.map.get(key, hash)) return *value;
+        return std::nullopt;
+    }
+
+    static std::shared_lock<std::shared_mutex> readLock(const Shard& shard) {
+        shard.reads.fetch_add(1, std::memory_order_relaxed);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            shard.contendedReads.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
         }
-        return result;
+        return lock;
     }
 
-    V& at(const K& key) {
-        size_t index = hashFunction(key);
-        Node* current = table[index];
-        while (current) {
-            if (current->key == key) {
-                return current->value;
-            }
-            current = current->next;
+    static std::unique_lock<std::shared_mutex> writeLock(const Shard& shard) {
+        shard.writes.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            shard.contendedWrites.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
         }
-        throw KeyNotFoundException(std::to_string(key));
+        return lock;
     }
 
-    V& operator[](const K& key) {
-        size_t index = hashFunction(key);
-        Node* current = table[index];
-        while (current) {
-            if (current->key == key) {
-                return current->value;
-            }
-            current = current->next;
+public:
+    /**
+     * @param shardCount: Number of shards, rounded up to a power of two
+     * @param shardCapacity: Initial bucket count of each shard
+     * @param incremental: Let shards spread their resizes over later writes
+     * @param hash: Hasher shared by shard selection and every shard's map
+     * @param equal: Key comparator given to every shard's map
+     */
+    explicit ConcurrentHashMap(size_t shardCount = 64, size_t shardCapacity = 16, bool incremental = false,
+                               const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+        : shards(new Shard[std::bit_ceil(std::max<size_t>(shardCount, 1))]),
+          shardMask(std::bit_ceil(std::max<size_t>(shardCount, 1)) - 1), hasher(hash) {
+        for (size_t i = 0; i <= shardMask; ++i) {
+            shards[i].map = HashMap<K, V, Hash, KeyEqual>(shardCapacity, incremental, hash, equal);
         }
-        // Insert with default value
-        insert(key, V());
-        return at(key);
     }
 
-    void erase(const K& key) {
-        size_t index = hashFunction(key);
-        Node* current = table[index];
-        Node* prev = nullptr;
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
 
-        while (current) {
-            if (current->key == key) {
-                if (prev) {
-                    prev->next = current->next;
-                } else {
-                    table[index] = current->next;
-                }
-                delete current;
-                mapSize--;
-                return;
-            }
-            prev = current;
-            current = current->next;
+    /**
+     * Pre-size every shard for n entries spread evenly across them
+     */
+    void reserve(size_t n) {
+        size_t perShard = n / (shardMask + 1) + 1;
+        for (size_t i = 0; i <= shardMask; ++i) {
+            auto lock = writeLock(shards[i]);
+            shards[i].map.reserve(perShard);
         }
-        throw KeyNotFoundException(toString(key));
     }
 
-    void erase(const std::vector<K>& keysToDelete) {
-        for (const auto& key : keysToDelete) {
-            try {
-                erase(key);
-            } catch (const KeyNotFoundException&) {
-                // Continue deleting other keys
-            }
+    /**
+     * Insert or overwrite, like HashMap::insert
+     */
+    void insert(const K& key, const V& value) {
+        insertOrAssign(key, value);
+    }
+
+    /**
+     * Insert or overwrite atomically; returns true if the key was new
+     */
+    bool insertOrAssign(const K& key, const V& value) {
+        size_t hash = hasher(key);
+        Shard& shard = shardFor(hash);
+        auto lock = writeLock(shard);
+        size_t before = shard.map.size();
+        shard.map.insert(key, value, hash);
+        return shard.map.size() != before;
+    }
+
+    /**
+     * Insert only if the key is missing; returns true if it was inserted
+     */
+    bool insertIfAbsent(const K& key, const V& value) {
+        size_t hash = hasher(key);
+        Shard& shard = shardFor(hash);
+        auto lock = writeLock(shard);
+        if (shard.map.get(key, hash)) return false;
+        shard.map.insert(key, value, hash);
+        return true;
+    }
+
+    /**
+     * Return the value for key, first storing compute(key) if it is
+     * missing. compute runs at most once per key, under the shard's write
+     * lock, so it must not touch this map.
+     */
+    template<typename Compute>
+    V computeIfAbsent(const K& key, Compute&& compute) {
+        size_t hash = hasher(key);
+        Shard& shard = shardFor(hash);
+        {
+            auto lock = readLock(shard);
+            if (const V* value = shard.map.get(key, hash)) return *value;
         }
+        auto lock = writeLock(shard);
+        if (const V* value = shard.map.get(key, hash)) return *value; // another thread won
+        V value = compute(key);
+        shard.map.insert(key, value, hash);
+        return value;
     }
 
-    HashMap<K, V> operator+(const HashMap<K, V>& other) const {
-        HashMap<K, V> result(*this);
-        result.update(other);
-        return result;
+    /**
+     * Lookups also accept any type the hasher takes when Hash and KeyEqual
+     * are transparent, e.g. std::string_view for std::string keys
+     */
+    std::optional<V> get(const K& key) const {
+        return lookup(key);
     }
 
-    void update(const HashMap<K, V>& other) {
-        auto otherPairs = other.pairs();
-        for (const auto& p : otherPairs) {
-            insert(p.first, p.second);
+    template<typename Q>
+        requires lookupKey<Q>
+    std::optional<V> get(const Q& key) const {
+        return lookup(key);
+    }
+
+    V at(const K& key) const {
+        return at<K>(key);
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    V at(const Q& key) const {
+        std::optional<V> value = lookup(key);
+        if (!value) {
+            throw KeyNotFoundException(toString(key));
         }
+        return std::move(*value);
     }
 
     bool find(const K& key) const {
-        size_t index = hashFunction(key);
-        Node* current = table[index];
-        while (current) {
-            if (current->key == key) return true;
-            current = current->next;
-        }
-        return false;
+        return find<K>(key);
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    bool find(const Q& key) const {
+        size_t hash = hasher(key);
+        const Shard& shard = shardFor(hash);
+        auto lock = readLock(shard);
+        return shard.map.get(key, hash) != nullptr;
     }
 
     bool exists(const K& key) const {
         return find(key);
     }
 
-    bool existsValue(const V& value) const {
-        for (const auto& bucket : table) {
-            Node* current = bucket;
-            while (current) {
-                if (current->value == value) return true;
-                current = current->next;
-            }
+    void erase(const K& key) {
+        if (!tryErase(key)) {
+            throw KeyNotFoundException(toString(key));
         }
-        return false;
     }
 
-    void sort_by(const std::string& criterion) {
-        auto pairsList = pairs();
-        if (criterion == "key") {
-            std::sort(pairsList.begin(), pairsList.end(),
-                [](const auto& a, const auto& b)
-                { 
-                return a.first < b.first; 
-                });
-        }
+    /**
+     * Erase without throwing; returns true if the key was present
+     */
+    bool tryErase(const K& key) {
+        size_t hash = hasher(key);
+        Shard& shard = shardFor(hash);
+        auto lock = writeLock(shard);
+        if (!shard.map.get(key, hash)) return false;
+        shard.map.erase(key, hash);
+        return true;
+    }
 
-        else if (criterion == "key-reverse" || criterion == "keyreverse") {
-            std::sort(pairsList.begin(), pairsList.end(),
-                [](const auto& a, const auto& b) { return a.first > b.first; });
+    /**
+     * Snapshot of all entries. Each shard is copied consistently, but
+     * writes to other shards may land while the snapshot is taken.
+     */
+    std::vector<std::pair<K, V>> pairs() const {
+        std::vector<std::pair<K, V>> result;
+        for (size_t i = 0; i <= shardMask; ++i) {
+            auto lock = readLock(shards[i]);
+            auto shardPairs = shards[i].map.pairs();
+            result.insert(result.end(), shardPairs.begin(), shardPairs.end());
         }
+        return result;
+    }
 
-        else if (criterion == "value") {
-            std::sort(pairsList.begin(), pairsList.end(),
-                [](const auto& a, const auto& b) { return a.second < b.second; });
+    std::vector<K> keys() const {
+        std::vector<K> result;
+        for (size_t i = 0; i <= shardMask; ++i) {
+            auto lock = readLock(shards[i]);
+            auto shardKeys = shards[i].map.keys();
+            result.insert(result.end(), shardKeys.begin(), shardKeys.end());
         }
+        return result;
+    }
 
-
-        else if (criterion == "value-reverse" || criterion == "valuereverse") {
-            std::sort(pairsList.rbegin(), pairsList.rend(),
-                [](const auto& a, const auto& b) { return a.second < b.second; });
+    size_t size() const {
+        size_t total = 0;
+        for (size_t i = 0; i <= shardMask; ++i) {
+            auto lock = readLock(shards[i]);
+            total += shards[i].map.size();
         }
+        return total;
+    }
 
-        else {
-              throw std::logic_error("Invalid Sorting criteria. It should be either of: key, key-reverse, value, value-reverse\n");
+    void clear() {
+        for (size_t i = 0; i <= shardMask; ++i) {
+            auto lock = writeLock(shards[i]);
+            shards[i].map.clear();
         }
+    }
 
-        clear();
-        for (const auto& p : pairsList) {
-            insert(p.first, p.second);
+    size_t shardCount() const { return shardMask + 1; }
+
+    /**
+     * Per-shard size, bucket count and lock traffic since construction or
+     * the last resetStats(). A high contended share on a few shards points
+     * at hot keys; on all shards, at too few shards.
+     */
+    std::vector<ShardStats> shardStats() const {
+        std::vector<ShardStats> result;
+        result.reserve(shardMask + 1);
+        for (size_t i = 0; i <= shardMask; ++i) {
+            const Shard& shard = shards[i];
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            result.push_back({shard.map.size(), shard.map.bucketCount(),
+                              shard.reads.load(std::memory_order_relaxed),
+                              shard.writes.load(std::memory_order_relaxed),
+                              shard.contendedReads.load(std::memory_order_relaxed),
+                              shard.contendedWrites.load(std::memory_order_relaxed)});
         }
+        return result;
     }
 
-    size_t size() const { return mapSize; }
-
-    void clear() {
-        for (auto& bucket : table) {
-            Node* current = bucket;
-            while (current) {
-                Node* temp = current;
-                current = current->next;
-                delete temp;
-            }
-            bucket = nullptr;
+    void resetStats() {
+        for (size_t i = 0; i <= shardMask; ++i) {
+            shards[i].reads.store(0, std::memory_order_relaxed);
+            shards[i].writes.store(0, std::memory_order_relaxed);
+            shards[i].contendedReads.store(0, std::memory_order_relaxed);
+            shards[i].contendedWrites.store(0, std::memory_order_relaxed);
         }
-        mapSize = 0;
     }
 
+    /**
+     * Print one line of stats per shard
+     */
     void display(bool use_color = false) const {
-        cprint(use_color,"\n╔══════════════ HashMap ══════════════╗\n", BRIGHT_BLACK, true); 
-        if (mapSize == 0) {
-            cprint(use_color, "║  (empty)                           ║\n", BRIGHT_RED);
-        } else {
-            for (const auto& bucket : table) {
-                Node* current = bucket;
-                while (current) {
-                    cprint(use_color, "║  ", BRIGHT_BLACK, true);
-                    cprint(use_color, current->key, BRIGHT_BLUE);
-                    cprint(use_color, " → ", BRIGHT_YELLOW);
-                    cprint(use_color, current->value, GREEN);
-                    std::cout << std::endl;
-                    current = current->next;
-               }
-            }
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("\n╔═════════ ConcurrentHashMap ═════════╗\n", BRIGHT_BLACK, true);
+        auto stats = shardStats();
+        size_t total = 0;
+        for (size_t i = 0; i < stats.size(); ++i) {
+            total += stats[i].size;
+            w.paint("║  shard ", BRIGHT_BLACK, true);
+            w.paint(i, BRIGHT_BLUE);
+            w.paint(": ");
+            w.paint(stats[i].size, GREEN);
+            w.paint(" entries, ");
+            w.paint(stats[i].reads, BRIGHT_CYAN);
+            w.paint(" reads (");
+            w.paint(stats[i].contendedReads, BRIGHT_RED);
+            w.paint(" contended), ");
+            w.paint(stats[i].writes, BRIGHT_CYAN);
+            w.paint(" writes (");
+            w.paint(stats[i].contendedWrites, BRIGHT_RED);
+            w.paint(" contended)\n");
         }
-        std::cout << "\n";
-        cprint(use_color, "╚═════════════════════════════════════╝\n", BRIGHT_BLACK);
-        cprint(use_color, "Size: ");
-        cprint(use_color, mapSize, BRIGHT_CYAN);
-        std::cout << "\n\n";
+        w.paint("╚═════════════════════════════════════╝\n", BRIGHT_BLACK);
+        w.paint("Size: ");
+        w.paint(total, BRIGHT_CYAN);
+        w.paint(" | Shards: ");
+        w.paint(stats.size(), BRIGHT_CYAN);
+        w << "\n\n";
     }
 };
 
 // ==================== TREE MAP IMPLEMENTATION ====================
-template<typename K, typename V>
+template<typename K, typename V, typename Compare = std::less<>>
 class TreeMap {
 private:
     struct Node {
@@ -339,6 +2083,22 @@ private:
 
     Node* root;
     size_t mapSize;
+    [[no_unique_address]] Compare less;
+    [[no_unique_address]] mutable instrumentation::Slot<instrumentation::TreeStats> counters;
+
+    // Secondary index for sort_by("value"): nodes ordered by value, then
+    // key. Built on first use and dropped by any edit, including handing
+    // out a mutable V& through at() or operator[].
+    mutable std::vector<const Node*> valueOrder;
+    mutable bool valueOrderFresh = false;
+
+    template<typename Q>
+    static constexpr bool lookupKey = ComparableLookup<Q, K, Compare>;
+
+    void valuesChanged() {
+        valueOrderFresh = false;
+        valueOrder.clear();
+    }
 
     int height(Node* node) const {
         return node ? node->height : 0;
@@ -356,6 +2116,7 @@ private:
 
     Node* rotateRight(Node* y) {
         Node* x = y->left;
+        SNAZZYDEETS_STAT(counters.rotations.add());
         Node* T2 = x->right;
         x->right = y;
         y->left = T2;
@@ -366,6 +2127,7 @@ private:
 
     Node* rotateLeft(Node* x) {
         Node* y = x->right;
+        SNAZZYDEETS_STAT(counters.rotations.add());
         Node* T2 = y->left;
         y->left = x;
         x->right = T2;
@@ -396,12 +2158,13 @@ private:
     Node* insertNode(Node* node, const K& key, const V& value, bool& updated) {
         if (!node) {
             mapSize++;
+            SNAZZYDEETS_STAT(counters.inserts.add());
             return new Node(key, value);
         }
 
-        if (key < node->key) {
+        if (less(key, node->key)) {
             node->left = insertNode(node->left, key, value, updated);
-        } else if (key > node->key) {
+        } else if (less(node->key, key)) {
             node->right = insertNode(node->right, key, value, updated);
         } else {
             node->value = value;
@@ -417,12 +2180,13 @@ private:
         return node;
     }
 
-    Node* eraseNode(Node* node, const K& key, bool& found) {
+    template<typename Q>
+    Node* eraseNode(Node* node, const Q& key, bool& found) {
         if (!node) return nullptr;
 
-        if (key < node->key) {
+        if (less(key, node->key)) {
             node->left = eraseNode(node->left, key, found);
-        } else if (key > node->key) {
+        } else if (less(node->key, key)) {
             node->right = eraseNode(node->right, key, found);
         } else {
             found = true;
@@ -442,18 +2206,38 @@ private:
         return balance(node);
     }
 
-    Node* findNode(Node* node, const K& key) const {
-        if (!node) return nullptr;
-        if (key < node->key) return findNode(node->left, key);
-        if (key > node->key) return findNode(node->right, key);
+    template<typename Q>
+    Node* findNode(Node* node, const Q& key) const {
+        [[maybe_unused]] uint64_t visited = 0;
+        while (node) {
+            SNAZZYDEETS_STAT(++visited);
+            if (less(key, node->key)) node = node->left;
+            else if (less(node->key, key)) node = node->right;
+            else break;
+        }
+        SNAZZYDEETS_STAT(counters.recordSearch("TreeMap", visited));
         return node;
     }
 
-    void inorder(Node* node, std::vector<std::pair<K, V>>& result) const {
-        if (!node) return;
-        inorder(node->left, result);
-        result.push_back({node->key, node->value});
-        inorder(node->right, result);
+    /**
+     * Nodes in key order, on a cursor's explicit stack
+     */
+    template<typename Fn>
+    void forEachNode(Fn fn) const {
+        for (Cursor c = cursor(); c.valid(); c.next()) fn(c.pending.back());
+    }
+
+    const std::vector<const Node*>& byValue() const {
+        if (!valueOrderFresh) {
+            valueOrder.clear();
+            valueOrder.reserve(mapSize);
+            forEachNode([this](const Node* node) { valueOrder.push_back(node); });
+            // Stable over key order, so equal values stay sorted by key
+            std::stable_sort(valueOrder.begin(), valueOrder.end(),
+                [](const Node* a, const Node* b) { return a->value < b->value; });
+            valueOrderFresh = true;
+        }
+        return valueOrder;
     }
 
     void destroyTree(Node* node) {
@@ -463,28 +2247,128 @@ private:
         delete node;
     }
 
-    void displayTree(Node* node, const std::string& prefix, bool isLeft, bool use_color) const {
+    Node* cloneTree(const Node* node) const {
+        if (!node) return nullptr;
+        Node* copy = new Node(node->key, node->value);
+        copy->height = node->height;
+        copy->left = cloneTree(node->left);
+        copy->right = cloneTree(node->right);
+        return copy;
+    }
+
+    // Keys is anything indexable: a std::vector (including vector<bool>) or a snapshot span
+    template<typename Keys>
+    bool strictlyIncreasing(const Keys& keys) const {
+        for (size_t i = 1; i < keys.size(); ++i) {
+            if (!less(keys[i - 1], keys[i])) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Perfectly balanced subtree over sorted [lo, hi): O(n), no rotations
+     */
+    template<typename Keys, typename Values>
+    Node* buildBalanced(const Keys& keys, const Values& values, size_t lo, size_t hi) {
+        if (lo >= hi) return nullptr;
+        size_t mid = lo + (hi - lo) / 2;
+        Node* node = new Node(keys[mid], values[mid]);
+        node->left = buildBalanced(keys, values, lo, mid);
+        node->right = buildBalanced(keys, values, mid + 1, hi);
+        updateHeight(node);
+        return node;
+    }
+
+    void displayTree(output::Writer& w, const Node* node, std::string& prefix, bool isLeft) const {
         if (!node) return;
 
-        std::cout << prefix;
-        cprint(use_color, (isLeft ? "├── " : "└── "), BRIGHT_GREEN);
-        cprint(use_color, node->key, BRIGHT_BLUE);
-        cprint(use_color, " → ", YELLOW);
-        cprint(use_color, node->value, GREEN);
-        std::cout << "\n";
+        w << prefix;
+        w.paint((isLeft ? "├── " : "└── "), BRIGHT_GREEN);
+        w.paint(node->key, BRIGHT_BLUE);
+        w.paint(" → ", YELLOW);
+        w.paint(node->value, GREEN);
+        w << "\n";
 
-        if (node->left || node->right) {
-            if (node->left) {
-                displayTree(node->left, prefix + (isLeft ? "│   " : "    "), true, use_color);
+        // One prefix string shared by the whole walk, extended and restored
+        size_t length = prefix.size();
+        prefix += isLeft ? "│   " : "    ";
+        displayTree(w, node->left, prefix, true);
+        displayTree(w, node->right, prefix, false);
+        prefix.resize(length);
+    }
+
+public:
+    /**
+     * In-order position in the map. The explicit stack holds the current
+     * node and the ancestors still to visit, at most the tree height
+     * (O(log n)), so a full scan needs no recursion and no copy of the
+     * entries. Any insert or erase invalidates it.
+     */
+    class Cursor {
+    private:
+        friend class TreeMap;
+        std::vector<const Node*> pending;  // back() is the current node
+
+        void pushLeft(const Node* node) {
+            while (node) {
+                pending.push_back(node);
+                node = node->left;
             }
-            if (node->right) {
-                displayTree(node->right, prefix + (isLeft ? "│   " : "    "), false, use_color);
+        }
+
+        /**
+         * Cursor at the first node `before` rejects; before(node) true
+         * means node and its left subtree come before the target
+         */
+        template<typename Before>
+        static Cursor seek(const Node* node, size_t depth, Before before) {
+            Cursor c;
+            c.pending.reserve(depth);
+            while (node) {
+                if (before(node)) {
+                    node = node->right;
+                } else {
+                    c.pending.push_back(node);
+                    node = node->left;
+                }
             }
+            return c;
+        }
+
+    public:
+        bool valid() const { return !pending.empty(); }
+        explicit operator bool() const { return valid(); }
+
+        const K& key() const { return pending.back()->key; }
+        const V& value() const { return pending.back()->value; }
+
+        /**
+         * Step to the next key in order; the cursor is invalid past the last
+         */
+        void next() {
+            const Node* node = pending.back();
+            pending.pop_back();
+            pushLeft(node->right);
         }
+    };
+
+    explicit TreeMap(const Compare& compare = Compare()) : root(nullptr), mapSize(0), less(compare) {}
+
+    TreeMap(const TreeMap& other) : root(cloneTree(other.root)), mapSize(other.mapSize), less(other.less) {}
+
+    TreeMap(TreeMap&& other) noexcept
+        : root(std::exchange(other.root, nullptr)), mapSize(std::exchange(other.mapSize, 0)),
+          less(other.less) {
+        other.valuesChanged();
     }
 
-public:
-    TreeMap() : root(nullptr), mapSize(0) {}
+    TreeMap& operator=(TreeMap other) {
+        std::swap(root, other.root);
+        std::swap(mapSize, other.mapSize);
+        std::swap(less, other.less);
+        valuesChanged();
+        return *this;
+    }
 
     ~TreeMap() {
         clear();
@@ -493,48 +2377,132 @@ public:
     void insert(const K& key, const V& value) {
         bool updated = false;
         root = insertNode(root, key, value, updated);
+        valuesChanged();
     }
 
+    /**
+     * Into an empty map, keys that are already strictly increasing are
+     * bulk loaded by buildFromSorted in O(n); anything else is inserted
+     * one by one (later duplicates overwrite earlier ones)
+     */
     void create_map_from_arrays(const std::vector<K>& keys, const std::vector<V>& values) {
         if (keys.size() != values.size()) {
             throw MapException("Arrays must have equal length");
         }
+        if (mapSize == 0 && strictlyIncreasing(keys)) {
+            buildFromSorted(keys, values);
+            return;
+        }
         for (size_t i = 0; i < keys.size(); ++i) {
             insert(keys[i], values[i]);
         }
     }
 
+    /**
+     * Replace the contents with strictly increasing keys and their values,
+     * as a perfectly balanced tree: O(n), no comparisons beyond the check
+     * @throws MapException if the lengths differ or keys are not strictly increasing
+     */
+    void buildFromSorted(const std::vector<K>& keys, const std::vector<V>& values) {
+        if (keys.size() != values.size()) {
+            throw MapException("Arrays must have equal length");
+        }
+        if (!strictlyIncreasing(keys)) {
+            throw MapException("buildFromSorted needs strictly increasing keys");
+        }
+        Node* built = buildBalanced(keys, values, 0, keys.size());
+        clear();
+        root = built;
+        mapSize = keys.size();
+    }
+
+    /**
+     * Cursor at the smallest key (invalid when the map is empty)
+     */
+    Cursor cursor() const {
+        Cursor c;
+        c.pending.reserve(static_cast<size_t>(height(root)));
+        c.pushLeft(root);
+        return c;
+    }
+
+    /**
+     * Cursor at the first key not less than key
+     */
+    template<typename Q>
+        requires lookupKey<Q>
+    Cursor lowerBound(const Q& key) const {
+        return Cursor::seek(root, static_cast<size_t>(height(root)),
+                            [&](const Node* node) { return less(node->key, key); });
+    }
+
+    /**
+     * Cursor at the first key greater than key
+     */
+    template<typename Q>
+        requires lookupKey<Q>
+    Cursor upperBound(const Q& key) const {
+        return Cursor::seek(root, static_cast<size_t>(height(root)),
+                            [&](const Node* node) { return !less(key, node->key); });
+    }
+
+    /**
+     * Calls fn(key, value) for every lo <= key < hi, in key order
+     * O(log n + k) for k visited entries; nothing is copied
+     */
+    template<typename Q, typename Fn>
+        requires lookupKey<Q>
+    void range(const Q& lo, const Q& hi, Fn fn) const {
+        for (Cursor c = lowerBound(lo); c.valid() && less(c.key(), hi); c.next()) {
+            fn(c.key(), c.value());
+        }
+    }
+
+    /**
+     * Calls fn(key, value) for every entry, in key order
+     */
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        for (Cursor c = cursor(); c.valid(); c.next()) fn(c.key(), c.value());
+    }
+
     std::vector<K> keys() const {
-        std::vector<std::pair<K, V>> pairsList;
-        inorder(root, pairsList);
         std::vector<K> result;
-        for (const auto& p : pairsList) {
-            result.push_back(p.first);
-        }
+        result.reserve(mapSize);
+        forEach([&result](const K& key, const V&) { result.push_back(key); });
         return result;
     }
 
     std::vector<V> values() const {
-        std::vector<std::pair<K, V>> pairsList;
-        inorder(root, pairsList);
         std::vector<V> result;
-        for (const auto& p : pairsList) {
-            result.push_back(p.second);
-        }
+        result.reserve(mapSize);
+        forEach([&result](const K&, const V& value) { result.push_back(value); });
         return result;
     }
 
     std::vector<std::pair<K, V>> pairs() const {
         std::vector<std::pair<K, V>> result;
-        inorder(root, result);
+        result.reserve(mapSize);
+        forEach([&result](const K& key, const V& value) { result.push_back({key, value}); });
         return result;
     }
 
     V& at(const K& key) {
+        return at<K>(key);
+    }
+
+    /**
+     * Lookups also take any type Compare orders against K, e.g. a
+     * std::string_view or const char* for std::string keys
+     */
+    template<typename Q>
+        requires lookupKey<Q>
+    V& at(const Q& key) {
         Node* node = findNode(root, key);
         if (!node) {
             throw KeyNotFoundException(toString(key));
         }
+        valuesChanged();  // the caller may assign through the reference
         return node->value;
     }
 
@@ -544,15 +2512,23 @@ public:
             insert(key, V());
             node = findNode(root, key);
         }
+        valuesChanged();
         return node->value;
     }
 
     void erase(const K& key) {
+        erase<K>(key);
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    void erase(const Q& key) {
         bool found = false;
         root = eraseNode(root, key, found);
         if (!found) {
             throw KeyNotFoundException(toString(key));
         }
+        valuesChanged();
     }
 
     void erase(const std::vector<K>& keysToDelete) {
@@ -565,73 +2541,247 @@ public:
         }
     }
 
-    TreeMap<K, V> operator+(const TreeMap<K, V>& other) const {
-        TreeMap<K, V> result(*this);
+    TreeMap operator+(const TreeMap& other) const {
+        TreeMap result(*this);
         result.update(other);
         return result;
     }
 
-    void update(const TreeMap<K, V>& other) {
-        auto otherPairs = other.pairs();
-        for (const auto& p : otherPairs) {
-            insert(p.first, p.second);
-        }
+    void update(const TreeMap& other) {
+        other.forEach([this](const K& key, const V& value) { insert(key, value); });
     }
 
     bool find(const K& key) const {
         return findNode(root, key) != nullptr;
     }
 
+    template<typename Q>
+        requires lookupKey<Q>
+    bool find(const Q& key) const {
+        return findNode(root, key) != nullptr;
+    }
+
     bool exists(const K& key) const {
         return find(key);
     }
 
+    template<typename Q>
+        requires lookupKey<Q>
+    bool exists(const Q& key) const {
+        return find(key);
+    }
+
+    /**
+     * O(log n) through the value index once sort_by("value") built it
+     * (for totally ordered values), a scan of the tree otherwise
+     */
     bool existsValue(const V& value) const {
-        auto vals = values();
-        return std::find(vals.begin(), vals.end(), value) != vals.end();
+        if constexpr (std::totally_ordered<V>) {
+            if (valueOrderFresh) {
+                auto it = std::lower_bound(valueOrder.begin(), valueOrder.end(), value,
+                    [](const Node* node, const V& v) { return node->value < v; });
+                return it != valueOrder.end() && !(value < (*it)->value);
+            }
+        }
+        for (Cursor c = cursor(); c.valid(); c.next()) {
+            if (c.value() == value) return true;
+        }
+        return false;
     }
 
+    /**
+     * "value" builds the value-ordered index read by forEachByValue and
+     * pairsByValue; the tree itself stays ordered by key
+     */
     void sort_by(const std::string& criterion) {
-        auto pairsList = pairs();
         if (criterion == "value") {
-            std::sort(pairsList.begin(), pairsList.end(),
-                [](const auto& a, const auto& b) { return a.second < b.second; });
-            clear();
-            for (const auto& p : pairsList) {
-                insert(p.first, p.second);
-            }
+            byValue();
         }
         // TreeMap is already sorted by key
     }
 
+    /**
+     * Calls fn(key, value) in value order, ties in key order
+     * Uses the value index, rebuilt in O(n log n) if an edit dropped it
+     */
+    template<typename Fn>
+    void forEachByValue(Fn fn) const {
+        for (const Node* node : byValue()) fn(node->key, node->value);
+    }
+
+    std::vector<std::pair<K, V>> pairsByValue() const {
+        std::vector<std::pair<K, V>> result;
+        result.reserve(mapSize);
+        forEachByValue([&result](const K& key, const V& value) { result.push_back({key, value}); });
+        return result;
+    }
+
     size_t size() const { return mapSize; }
 
     void clear() {
         destroyTree(root);
         root = nullptr;
         mapSize = 0;
+        valuesChanged();
+    }
+
+    /**
+     * Rotation and search counters. All zero unless built with SNAZZYDEETS_STATS.
+     */
+    instrumentation::TreeStats stats() const {
+#ifdef SNAZZYDEETS_STATS
+        return counters;
+#else
+        return instrumentation::TreeStats{};
+#endif
+    }
+
+    void resetStats() {
+#ifdef SNAZZYDEETS_STATS
+        counters = instrumentation::TreeStats{};
+#endif
+    }
+
+    /**
+     * Write the entries as two sorted arrays, keys then values, which
+     * TreeMapView binary-searches in place
+     */
+    void saveSnapshot(const std::string& path) const
+        requires snapshot::Storable<K> && snapshot::Storable<V>
+    {
+        std::vector<std::byte> keyBytes(mapSize * sizeof(K));
+        std::vector<std::byte> valueBytes(mapSize * sizeof(V));
+        size_t i = 0;
+        forEach([&](const K& key, const V& value) {
+            std::memcpy(keyBytes.data() + i * sizeof(K), &key, sizeof(K));
+            std::memcpy(valueBytes.data() + i * sizeof(V), &value, sizeof(V));
+            ++i;
+        });
+        auto writer = snapshot::Writer::forTypes<K, V>(path, snapshot::Kind::TreeMap);
+        writer.section(keyBytes.data(), keyBytes.size());
+        writer.section(valueBytes.data(), valueBytes.size());
+        writer.finish(mapSize);
+    }
+
+    /**
+     * Rebuild a mutable map from saveSnapshot output in O(n): the sorted
+     * arrays become a perfectly balanced tree without a single comparison
+     */
+    static TreeMap loadSnapshot(const std::string& path, const Compare& compare = Compare())
+        requires snapshot::Storable<K> && snapshot::Storable<V>
+    {
+        snapshot::MappedFile file(path);
+        file.expect<K, V>(snapshot::Kind::TreeMap);
+        size_t n = file.header().count;
+        TreeMap result(compare);
+        result.root = result.buildBalanced(file.section<K>(0, n), file.section<V>(1, n), 0, n);
+        result.mapSize = n;
+        return result;
     }
 
     void display(bool use_color = false) const {
-        cprint(use_color, "\n╔══════════════ TreeMap (AVL) ══════════════╗\n", BRIGHT_BLACK, true);
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("\n╔══════════════ TreeMap (AVL) ══════════════╗\n", BRIGHT_BLACK, true);
         if (mapSize == 0) {
-            cprint(use_color, "║  (empty)                                  ║\n", BRIGHT_RED);
+            w.paint("║  (empty)                                  ║\n", BRIGHT_RED);
         } else {
-            cprint(use_color, "║\n", BRIGHT_BLACK, true);
+            w.paint("║\n", BRIGHT_BLACK, true);
+
+            std::string prefix = "║ ";
+            displayTree(w, root, prefix, false);
+        }
+        w.paint("╚═══════════════════════════════════════════╝\n", BRIGHT_BLACK);
+        w.paint("Size: ");
+        w.paint(mapSize, BRIGHT_CYAN);
+        w.paint(" | Height: ");
+        w.paint(height(root), BRIGHT_CYAN);
+        w << "\n\n";
+    }
+};
+
+// ==================== TREE MAP SNAPSHOT VIEW ====================
+/**
+ * Read-only TreeMap over a memory-mapped snapshot: binary search over the
+ * mapped key array, in-order iteration as a plain walk of both arrays.
+ * Compare must order keys the way the writing map did.
+ */
+template<typename K, typename V, typename Compare = std::less<>>
+    requires snapshot::Storable<K> && snapshot::Storable<V>
+class TreeMapView {
+private:
+    snapshot::MappedFile file;
+    std::span<const K> keySpan;
+    std::span<const V> valueSpan;
+    [[no_unique_address]] Compare less;
+
+public:
+    explicit TreeMapView(const std::string& path, const Compare& compare = Compare())
+        : file(path), less(compare) {
+        file.expect<K, V>(snapshot::Kind::TreeMap);
+        size_t n = file.header().count;
+        keySpan = file.section<K>(0, n);
+        valueSpan = file.section<V>(1, n);
+    }
+
+    /**
+     * Index of the first key not less than key (size() if there is none)
+     */
+    size_t lowerBound(const K& key) const {
+        return std::lower_bound(keySpan.begin(), keySpan.end(), key, less) - keySpan.begin();
+    }
+
+    const V* get(const K& key) const {
+        size_t i = lowerBound(key);
+        if (i == keySpan.size() || less(key, keySpan[i])) return nullptr;
+        return &valueSpan[i];
+    }
+
+    const V& at(const K& key) const {
+        const V* value = get(key);
+        if (!value) {
+            throw KeyNotFoundException(toString(key));
+        }
+        return *value;
+    }
+
+    bool find(const K& key) const {
+        return get(key) != nullptr;
+    }
 
-            displayTree(root, "║ ", false, use_color);
+    bool exists(const K& key) const {
+        return find(key);
+    }
+
+    // Both arrays in key order, pointing into the mapping
+    std::span<const K> keys() const { return keySpan; }
+    std::span<const V> values() const { return valueSpan; }
+
+    const K& keyAt(size_t i) const { return keySpan[i]; }
+    const V& valueAt(size_t i) const { return valueSpan[i]; }
+
+    std::vector<std::pair<K, V>> pairs() const {
+        std::vector<std::pair<K, V>> result;
+        result.reserve(keySpan.size());
+        for (size_t i = 0; i < keySpan.size(); ++i) {
+            result.push_back({keySpan[i], valueSpan[i]});
         }
-        cprint(use_color, "╚═══════════════════════════════════════════╝\n", BRIGHT_BLACK);
-        cprint(use_color, "Size: ");
-        cprint(use_color, mapSize, BRIGHT_CYAN);
-        cprint(use_color, " | Height: ");
-        cprint(use_color, height(root), BRIGHT_CYAN);
-        std::cout << "\n\n";
+        return result;
     }
+
+    size_t size() const { return keySpan.size(); }
+    bool empty() const { return keySpan.empty(); }
+    bool isMapped() const { return file.isMapped(); }
 };
 
 // ==================== LINKED LIST MAP IMPLEMENTATION ====================
-template<typename K, typename V>
+template<typename K, typename V, typename KeyEqual = std::equal_to<>>
 class LinkedListMap {
 private:
     struct Node {
@@ -643,18 +2793,23 @@ private:
 
     Node* head;
     size_t mapSize;
+    [[no_unique_address]] KeyEqual keyEqual;
+
+    template<typename Q>
+    static constexpr bool lookupKey = ComparableLookup<Q, K, KeyEqual>;
 
-    Node* findNode(const K& key) const {
+    template<typename Q>
+    Node* findNode(const Q& key) const {
         Node* current = head;
         while (current) {
-            if (current->key == key) return current;
+            if (keyEqual(current->key, key)) return current;
             current = current->next;
         }
         return nullptr;
     }
 
 public:
-    LinkedListMap() : head(nullptr), mapSize(0) {}
+    explicit LinkedListMap(const KeyEqual& equal = KeyEqual()) : head(nullptr), mapSize(0), keyEqual(equal) {}
 
     ~LinkedListMap() {
         clear();
@@ -713,6 +2868,16 @@ public:
     }
 
     V& at(const K& key) {
+        return at<K>(key);
+    }
+
+    /**
+     * Lookups also take any type KeyEqual compares with K, e.g. a
+     * std::string_view or const char* for std::string keys
+     */
+    template<typename Q>
+        requires lookupKey<Q>
+    V& at(const Q& key) {
         Node* node = findNode(key);
         if (!node) {
             throw KeyNotFoundException(toString(key));
@@ -730,11 +2895,17 @@ public:
     }
 
     void erase(const K& key) {
+        erase<K>(key);
+    }
+
+    template<typename Q>
+        requires lookupKey<Q>
+    void erase(const Q& key) {
         if (!head) {
             throw KeyNotFoundException("");
         }
 
-        if (head->key == key) {
+        if (keyEqual(head->key, key)) {
             Node* temp = head;
             head = head->next;
             delete temp;
@@ -744,7 +2915,7 @@ public:
 
         Node* current = head;
         while (current->next) {
-            if (current->next->key == key) {
+            if (keyEqual(current->next->key, key)) {
                 Node* temp = current->next;
                 current->next = current->next->next;
                 delete temp;
@@ -767,13 +2938,13 @@ public:
         }
     }
 
-    LinkedListMap<K, V> operator+(const LinkedListMap<K, V>& other) const {
-        LinkedListMap<K, V> result(*this);
+    LinkedListMap operator+(const LinkedListMap& other) const {
+        LinkedListMap result(*this);
         result.update(other);
         return result;
     }
 
-    void update(const LinkedListMap<K, V>& other) {
+    void update(const LinkedListMap& other) {
         auto otherPairs = other.pairs();
         for (const auto& p : otherPairs) {
             insert(p.first, p.second);
@@ -784,10 +2955,22 @@ public:
         return findNode(key) != nullptr;
     }
 
+    template<typename Q>
+        requires lookupKey<Q>
+    bool find(const Q& key) const {
+        return findNode(key) != nullptr;
+    }
+
     bool exists(const K& key) const {
         return find(key);
     }
 
+    template<typename Q>
+        requires lookupKey<Q>
+    bool exists(const Q& key) const {
+        return find(key);
+    }
+
     bool existsValue(const V& value) const {
         Node* current = head;
         while (current) {
@@ -824,30 +3007,38 @@ public:
     }
 
     void display(bool use_color = false) const {
-        cprint(use_color, "\n╔══════════════ LinkedListMap ══════════════╗\n", BRIGHT_BLACK, true);
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("\n╔══════════════ LinkedListMap ══════════════╗\n", BRIGHT_BLACK, true);
         if (mapSize == 0) {
-            cprint(use_color, "║  (empty)                                  ║\n", BRIGHT_RED);
+            w.paint("║  (empty)                                  ║\n", BRIGHT_RED);
         } else {
             Node* current = head;
             bool first = true;
-            cprint(use_color, "║  ", BRIGHT_BLACK, true); 
+            w.paint("║  ", BRIGHT_BLACK, true); 
             while (current) {
-                if (!first) cprint(use_color, " → ", BRIGHT_YELLOW);
-                cprint(use_color, "[", BRIGHT_GREEN);
-                cprint(use_color, current->key, BRIGHT_BLUE);
-                cprint(use_color, ":", YELLOW);
-                cprint(use_color, current->value, GREEN);
-                cprint(use_color, "]" , BRIGHT_GREEN);
+                if (!first) w.paint(" → ", BRIGHT_YELLOW);
+                w.paint("[", BRIGHT_GREEN);
+                w.paint(current->key, BRIGHT_BLUE);
+                w.paint(":", YELLOW);
+                w.paint(current->value, GREEN);
+                w.paint("]" , BRIGHT_GREEN);
                 current = current->next;
                 first = false;
             }
-            std::cout << "\n";
-            std::cout << std::endl;
+            w << "\n";
+            w << '\n';
         }
-        cprint(use_color, "╚═══════════════════════════════════════════╝\n", BRIGHT_BLACK);
-        cprint(use_color, "Size: ");
-        cprint(use_color,  mapSize, BRIGHT_CYAN);
-        std::cout << "\n\n";
+        w.paint("╚═══════════════════════════════════════════╝\n", BRIGHT_BLACK);
+        w.paint("Size: ");
+        w.paint( mapSize, BRIGHT_CYAN);
+        w << "\n\n";
     }
 };
 #endif
@@ -0,0 +1,344 @@
+#ifndef OUTPUT_HPP
+#define OUTPUT_HPP
+
+/**
+ * @file output.hpp
+ * @brief Buffered text output shared by every display(), plus DOT and
+ *        JSON exporters for graphs and trees.
+ *
+ * A Writer collects output in one pre-sized buffer and hands it to its
+ * Target (any std::ostream, or a callback receiving string_view chunks)
+ * only when the buffer fills or the export ends. Nothing is flushed per
+ * line, and whether to emit ANSI colors is decided once, when the Writer
+ * is constructed, instead of on every token.
+ *
+ * Usage:
+ * #include "../output/output.hpp"
+ */
+
+#include <charconv>
+#include <concepts>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../console_colors/colours.hpp"
+
+namespace output {
+
+using Callback = std::function<void(std::string_view)>;
+
+/**
+ * Where a Writer's chunks go: a stream, or a callback that receives each
+ * chunk (the view is only valid during the call)
+ */
+class Target {
+private:
+    std::ostream* stream = nullptr;
+    Callback callback;
+
+public:
+    Target(std::ostream& os) : stream(&os) {}
+    Target(Callback sink) : callback(std::move(sink)) {}
+
+    void write(std::string_view chunk) const {
+        if (chunk.empty()) return;
+        if (stream) stream->write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        else if (callback) callback(chunk);
+    }
+
+    void flush() const {
+        if (stream) stream->flush();
+    }
+};
+
+// ==================== WRITER ====================
+/**
+ * Append-only text buffer in front of a Target.
+ * The buffer is delivered when it reaches `capacity` and once more on
+ * flush() or destruction; a stream target is flushed only then.
+ */
+class Writer {
+private:
+    Target target;
+    std::string buffer;
+    size_t capacity;
+    bool colored;
+
+    void append(std::string_view text) {
+        if (buffer.size() + text.size() > capacity) {
+            target.write(buffer);
+            buffer.clear();
+        }
+        if (text.size() >= capacity) target.write(text);
+        else buffer.append(text);
+    }
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    /**
+     * @param use_color: Emit ANSI colors from paint(); fixed for the Writer's lifetime
+     */
+    explicit Writer(Target out, bool use_color = false, size_t bufferSize = DEFAULT_CAPACITY)
+        : target(std::move(out)), capacity(bufferSize ? bufferSize : 1), colored(use_color) {
+        buffer.reserve(capacity);
+    }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    ~Writer() {
+        try {
+            flush();
+        } catch (...) {
+            // A failing sink must not escape a destructor; call flush() to see it
+        }
+    }
+
+    bool colorEnabled() const { return colored; }
+
+    /**
+     * Deliver everything buffered so far
+     */
+    void flush() {
+        target.write(buffer);
+        buffer.clear();
+        target.flush();
+    }
+
+    /**
+     * Format any value the way `std::cout << value` would (see appendText)
+     */
+    template<typename T>
+    Writer& operator<<(const T& value);
+
+    /**
+     * Same contract as colors::cprint: color + text + reset when colors are on
+     */
+    template<typename T>
+    Writer& paint(const T& value, const char* color = colors::BRIGHT_WHITE, bool make_bold = false) {
+        if (!colored) return *this << value;
+        append(color);
+        if (make_bold) append(colors::BOLD);
+        *this << value;
+        append(colors::RESET);
+        return *this;
+    }
+};
+
+/**
+ * char, signed char and unsigned char (so int8_t and uint8_t too): the
+ * types std::ostream prints as a character rather than a number
+ */
+template<typename U>
+constexpr bool isCharacter = std::is_same_v<U, char> || std::is_same_v<U, signed char> ||
+                             std::is_same_v<U, unsigned char>;
+
+/**
+ * Append a value's printed text to `out`, as `std::cout << value` would.
+ * Integers and floating point use std::to_chars; types with only an
+ * operator<< go through a reused string stream.
+ */
+template<typename T>
+void appendText(std::string& out, const T& value) {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (isCharacter<U>) {
+        out.push_back(static_cast<char>(value));
+    } else if constexpr (std::is_same_v<U, bool>) {
+        out.push_back(value ? '1' : '0');
+    } else if constexpr (std::is_integral_v<U>) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    } else if constexpr (std::is_floating_point_v<U>) {
+        // %g with 6 significant digits, std::ostream's default
+        char digits[64];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+        out.append(digits, result.ptr);
+    } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+        out.append(std::string_view(value));
+    } else {
+        thread_local std::ostringstream scratch;
+        scratch.str(std::string());
+        scratch.clear();
+        scratch << value;
+        out.append(scratch.view());
+    }
+}
+
+template<typename T>
+std::string toText(const T& value) {
+    std::string text;
+    appendText(text, value);
+    return text;
+}
+
+template<typename T>
+Writer& Writer::operator<<(const T& value) {
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        append(std::string_view(value));
+    } else if constexpr (std::is_same_v<T, char>) {
+        append(std::string_view(&value, 1));
+    } else {
+        thread_local std::string scratch;
+        scratch.clear();
+        appendText(scratch, value);
+        append(scratch);
+    }
+    return *this;
+}
+
+// ==================== JSON / DOT ESCAPING ====================
+inline void writeJSONString(Writer& w, std::string_view text) {
+    static constexpr char hex[] = "0123456789abcdef";
+    w << '"';
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        w << text.substr(start, i - start);
+        switch (c) {
+            case '"': w << "\\\""; break;
+            case '\\': w << "\\\\"; break;
+            case '\n': w << "\\n"; break;
+            case '\t': w << "\\t"; break;
+            case '\r': w << "\\r"; break;
+            default: {
+                char escaped[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                w << std::string_view(escaped, sizeof(escaped));
+            }
+        }
+        start = i + 1;
+    }
+    w << text.substr(start) << '"';
+}
+
+/**
+ * Numbers (except char) as JSON numbers, bool as true/false, anything
+ * else as a JSON string of its printed text. int8_t and uint8_t are
+ * numbers here even though display() prints them as characters.
+ */
+template<typename T>
+void writeJSONValue(Writer& w, const T& value) {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+        w << (value ? "true" : "false");
+    } else if constexpr (std::is_floating_point_v<U>) {
+        if (!std::isfinite(value)) {
+            w << "null";
+            return;
+        }
+        // Shortest text that round-trips, not the 6 digits display() uses
+        char digits[64];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        w << std::string_view(digits, static_cast<size_t>(result.ptr - digits));
+    } else if constexpr (std::is_same_v<U, signed char> || std::is_same_v<U, unsigned char>) {
+        w << static_cast<int>(value);
+    } else if constexpr (std::is_arithmetic_v<U> && !std::is_same_v<U, char>) {
+        w << value;
+    } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+        writeJSONString(w, std::string_view(value));
+    } else {
+        writeJSONString(w, toText(value));
+    }
+}
+
+/**
+ * Quoted DOT identifier for any printable value
+ */
+template<typename T>
+void writeDOTId(Writer& w, const T& value) {
+    std::string text = toText(value);
+    w << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') w << '\\' << c;
+        else if (c == '\n') w << "\\n";
+        else w << c;
+    }
+    w << '"';
+}
+
+// ==================== BINARY TREE EXPORTERS ====================
+/**
+ * DOT digraph of a binary tree, nodes numbered in preorder.
+ * Iterative, so degenerate (list-shaped) trees of any depth are fine.
+ * @param left, right: Node* -> child, nullptr or `nil` when absent
+ * @param attributes: (Writer&, Node*) -> writes the inside of the node's [ ]
+ */
+template<typename Node, typename Left, typename Right, typename Attributes>
+void binaryTreeDOT(Writer& w, const char* name, Node* root, std::type_identity_t<Node*> nil,
+                   Left left, Right right, Attributes attributes) {
+    w << "digraph " << name << " {\n";
+    w << "  node [shape=circle];\n";
+    std::vector<std::pair<Node*, size_t>> stack; // (node, its id)
+    size_t nextId = 0;
+    if (root && root != nil) stack.push_back({root, nextId++});
+    while (!stack.empty()) {
+        auto [node, id] = stack.back();
+        stack.pop_back();
+        w << "  n" << id << " [";
+        attributes(w, node);
+        w << "];\n";
+        Node* children[2] = {left(node), right(node)};
+        size_t childIds[2] = {0, 0};
+        for (int side = 0; side < 2; side++) {
+            if (children[side] && children[side] != nil) {
+                childIds[side] = nextId++;
+                w << "  n" << id << " -> n" << childIds[side]
+                  << (side == 0 ? " [label=\"L\"];\n" : " [label=\"R\"];\n");
+            }
+        }
+        // Right first so the left subtree is numbered next
+        for (int side = 1; side >= 0; side--) {
+            if (children[side] && children[side] != nil) stack.push_back({children[side], childIds[side]});
+        }
+    }
+    w << "}\n";
+}
+
+/**
+ * Nested JSON of a binary tree: {"value": v, <fields>, "left": ..., "right": ...}
+ * with null for a missing child. Iterative, like binaryTreeDOT.
+ * @param fields: (Writer&, Node*) -> writes the node's members, "value" first
+ */
+template<typename Node, typename Left, typename Right, typename Fields>
+void binaryTreeJSON(Writer& w, Node* root, std::type_identity_t<Node*> nil,
+                    Left left, Right right, Fields fields) {
+    enum Stage { OPEN, RIGHT, CLOSE };
+    std::vector<std::pair<Node*, Stage>> stack;
+    auto visit = [&](Node* child) {
+        if (child && child != nil) stack.push_back({child, OPEN});
+        else w << "null";
+    };
+    visit(root);
+    while (!stack.empty()) {
+        auto& [node, stage] = stack.back();
+        Node* current = node;
+        if (stage == OPEN) {
+            stage = RIGHT;
+            w << '{';
+            fields(w, current);
+            w << ",\"left\":";
+            visit(left(current));
+        } else if (stage == RIGHT) {
+            stage = CLOSE;
+            w << ",\"right\":";
+            visit(right(current));
+        } else {
+            w << '}';
+            stack.pop_back();
+        }
+    }
+    w << '\n';
+}
+
+} // namespace output
+
+#endif
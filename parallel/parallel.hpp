@@ -0,0 +1,347 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+/**
+ * @file parallel.hpp
+ * @brief Execution policies and a work-stealing thread pool for the bulk
+ *        algorithms on maps and lists.
+ *
+ * Containers take a policy as their first argument, the way the standard
+ * algorithms take std::execution::par:
+ *   map.create_map_from_arrays(parallel::par, keys, values);
+ *   map.existsValue(parallel::par(8), value);     // at most 8 threads
+ *   list.indexOf(parallel::seq, value);           // same as indexOf(value)
+ *
+ * std::execution itself is not used: libstdc++ implements it on top of TBB,
+ * which this project does not depend on. Work runs on one process-wide
+ * ThreadPool (hardware_concurrency - 1 workers; the calling thread is the
+ * last one), so on a single core par runs sequentially. Each worker owns a
+ * deque: it pops its own tasks from the back and steals from the front of
+ * the others' when empty, so a thread that finishes its chunks early takes
+ * over another's instead of idling.
+ *
+ * Usage:
+ * #include "../parallel/parallel.hpp"
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace parallel {
+
+// ==================== POLICIES ====================
+struct SequencedPolicy {};
+
+/**
+ * Run on the shared pool. `threads` caps how many run at once (0 = every
+ * worker plus the caller); par(n) builds a capped copy.
+ */
+struct ParallelPolicy {
+    unsigned threads = 0;
+
+    constexpr ParallelPolicy operator()(unsigned maxThreads) const {
+        return ParallelPolicy{maxThreads};
+    }
+};
+
+inline constexpr SequencedPolicy seq{};
+inline constexpr ParallelPolicy par{};
+
+template<typename P>
+concept ExecutionPolicy = std::same_as<std::remove_cvref_t<P>, SequencedPolicy> ||
+                          std::same_as<std::remove_cvref_t<P>, ParallelPolicy>;
+
+template<typename P>
+constexpr bool isSequenced = std::same_as<std::remove_cvref_t<P>, SequencedPolicy>;
+
+// ==================== THREAD POOL ====================
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> nextQueue{0};   // round-robin target for outside submitters
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    // Which pool and queue the current thread works for, if any
+    static inline thread_local const ThreadPool* currentPool = nullptr;
+    static inline thread_local size_t currentQueue = 0;
+
+    bool popOwn(size_t index, Task& task) {
+        Queue& queue = *queues[index];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t thief, Task& task) {
+        size_t n = queues.size();
+        for (size_t k = 1; k <= n; ++k) {
+            Queue& queue = *queues[(thief + k) % n];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            if (queue.tasks.empty()) continue;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(size_t index) {
+        currentPool = this;
+        currentQueue = index;
+        while (true) {
+            if (runPending()) continue;
+            std::unique_lock<std::mutex> guard(sleepLock);
+            wake.wait(guard, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+            if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+
+public:
+    /**
+     * One worker per core but the caller's; none on a single core
+     */
+    static unsigned defaultWorkers() {
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    /**
+     * @param threads: Worker count. With none, submit() runs tasks inline.
+     */
+    explicit ThreadPool(unsigned threads = defaultWorkers()) {
+        for (unsigned i = 0; i < threads; ++i) queues.push_back(std::make_unique<Queue>());
+        workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Runs every task still queued, then joins the workers
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    /**
+     * The process-wide pool, started on first use
+     */
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    size_t size() const {
+        return workers.size();
+    }
+
+    /**
+     * Queue a task. A worker pushes onto its own deque (it will pop it
+     * next unless someone steals it first); other threads spread tasks
+     * round-robin. The task must not throw: TaskGroup wraps it.
+     */
+    void submit(Task task) {
+        if (queues.empty()) {
+            task();
+            return;
+        }
+        size_t index = currentPool == this
+            ? currentQueue
+            : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        {
+            std::lock_guard<std::mutex> guard(queues[index]->lock);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        queued.fetch_add(1, std::memory_order_release);
+        {
+            // Pairs with the predicate check in workerLoop: no wakeup is lost
+            std::lock_guard<std::mutex> guard(sleepLock);
+        }
+        wake.notify_one();
+    }
+
+    /**
+     * Run one queued task on the calling thread: its own newest task if it
+     * is a worker, otherwise the oldest task it can steal.
+     * @return false if every queue was empty
+     */
+    bool runPending() {
+        Task task;
+        if (queues.empty()) return false;
+        bool found = currentPool == this
+            ? popOwn(currentQueue, task) || steal(currentQueue, task)
+            : steal(0, task);
+        if (!found) return false;
+        queued.fetch_sub(1, std::memory_order_acq_rel);
+        task();
+        return true;
+    }
+};
+
+/**
+ * Tasks forked onto a pool and joined by wait(). The waiting thread runs
+ * queued tasks rather than blocking, so groups may nest inside tasks.
+ * The first exception a task throws is rethrown from wait().
+ */
+class TaskGroup {
+private:
+    ThreadPool& pool;
+    std::atomic<size_t> pending{0};
+    std::mutex errorLock;
+    std::exception_ptr error;
+
+    void join() {
+        while (pending.load(std::memory_order_acquire) > 0) {
+            if (!pool.runPending()) std::this_thread::yield();
+        }
+    }
+
+public:
+    explicit TaskGroup(ThreadPool& target = ThreadPool::shared()) : pool(target) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup() {
+        join();
+    }
+
+    template<typename Fn>
+    void run(Fn fn) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.submit([this, fn = std::move(fn)]() mutable {
+            try {
+                fn();
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(errorLock);
+                if (!error) error = std::current_exception();
+            }
+            pending.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    /**
+     * Run fn on this thread, recording its exception like a task's
+     */
+    template<typename Fn>
+    void runHere(Fn&& fn) {
+        try {
+            fn();
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(errorLock);
+            if (!error) error = std::current_exception();
+        }
+    }
+
+    void wait() {
+        join();
+        if (error) std::rethrow_exception(std::exchange(error, nullptr));
+    }
+};
+
+// ==================== LOOPS ====================
+/**
+ * How many chunks to cut n items into, each at least `grain` long.
+ * Uncapped policies get a few chunks per thread so stealing can even out
+ * uneven chunks; par(k) gets at most k, so at most k threads run.
+ */
+template<ExecutionPolicy Policy>
+size_t chunksFor(const Policy& policy, size_t n, size_t grain) {
+    if (grain == 0) grain = 1;
+    size_t most = (n + grain - 1) / grain;
+    if constexpr (isSequenced<Policy>) {
+        return std::min<size_t>(most, 1);
+    } else {
+        size_t threads = ThreadPool::shared().size() + 1;
+        size_t limit = policy.threads ? std::min<size_t>(policy.threads, threads) : threads * 4;
+        return std::min(most, limit);
+    }
+}
+
+/**
+ * fn(chunk, begin, end) for `chunks` equal consecutive slices of [0, n).
+ * The caller runs the last slice itself and helps with the rest; a single
+ * chunk runs inline. Rethrows the first exception after all have finished.
+ */
+template<ExecutionPolicy Policy, typename Fn>
+void forChunks(const Policy&, size_t n, size_t chunks, Fn&& fn) {
+    if (chunks <= 1 || isSequenced<Policy>) {
+        if (n > 0) fn(size_t(0), size_t(0), n);
+        return;
+    }
+    auto begin = [n, chunks](size_t c) { return n / chunks * c + std::min(c, n % chunks); };
+    TaskGroup group;
+    for (size_t c = 0; c + 1 < chunks; ++c) {
+        group.run([&fn, c, from = begin(c), to = begin(c + 1)] { fn(c, from, to); });
+    }
+    group.runHere([&] { fn(chunks - 1, begin(chunks - 1), n); });
+    group.wait();
+}
+
+/**
+ * fn(begin, end) over slices of [0, n) no shorter than grain
+ */
+template<ExecutionPolicy Policy, typename Fn>
+void forRange(const Policy& policy, size_t n, size_t grain, Fn&& fn) {
+    forChunks(policy, n, chunksFor(policy, n, grain), [&fn](size_t, size_t begin, size_t end) {
+        fn(begin, end);
+    });
+}
+
+/**
+ * Fold [0, n): map(begin, end) yields an optional partial per slice (empty
+ * when the slice holds nothing), and the partials are folded into init
+ * left to right with combine, so an associative combine gives the
+ * sequential answer.
+ */
+template<ExecutionPolicy Policy, typename R, typename Map, typename Combine>
+R reduceRange(const Policy& policy, size_t n, size_t grain, R init, Map&& map, Combine&& combine) {
+    size_t chunks = chunksFor(policy, n, grain);
+    std::vector<std::optional<R>> partials(chunks);
+    forChunks(policy, n, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        partials[chunk] = map(begin, end);
+    });
+    for (auto& partial : partials) {
+        if (partial) init = combine(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+} // namespace parallel
+
+#endif
@@ -0,0 +1,67 @@
+#include <iostream>
+#include <string>
+#include "sets.hpp"
+
+int main() {
+    try {
+        std::cout << "========================================\n";
+        std::cout << "    SET DATA STRUCTURES DEMO\n";
+        std::cout << "========================================\n";
+
+        // ========== HASH SET DEMO ==========
+        std::cout << "\n[1] HASH SET DEMONSTRATION\n";
+        HashSet<std::string> fruits = {"Apple", "Banana", "Cherry"};
+        HashSet<std::string> basket = {"Cherry", "Date", "Apple", "Fig"};
+        fruits.display(true);
+        basket.display(true);
+
+        std::cout << "Insert 'Apple' again: " << (fruits.insert("Apple") ? "added" : "already present") << "\n";
+        std::cout << "'Date' in fruits: " << (fruits.contains("Date") ? "Yes" : "No") << "\n";
+
+        std::cout << "\nfruits & basket:\n";
+        (fruits & basket).display(true);
+        std::cout << "fruits - basket:\n";
+        (fruits - basket).display(true);
+
+        // ========== SORTED FLAT SET DEMO ==========
+        std::cout << "\n[2] SORTED FLAT SET DEMONSTRATION\n";
+        SortedFlatSet<int> primes = {13, 2, 7, 3, 11, 5, 2, 17};
+        SortedFlatSet<int> odds(std::vector<int>{1, 3, 5, 7, 9, 11, 13, 15, 17, 19});
+        primes.display(true);
+        odds.display(true);
+
+        std::cout << "Primes below 10: " << primes.rank(10) << "\n";
+        std::cout << "Third smallest prime: " << primes.kth(2) << "\n";
+
+        std::cout << "\nprimes | odds:\n";
+        setUnion(primes, odds).display(true);
+        std::cout << "primes ^ odds:\n";
+        (primes ^ odds).display(true);
+
+        primes.insertRange({19, 23, 29, 23});
+        std::cout << "After insertRange({19, 23, 29, 23}):\n";
+        primes.display(true);
+
+        // ========== DENSE BITSET DEMO ==========
+        std::cout << "\n[3] DENSE BITSET DEMONSTRATION\n";
+        DenseBitset evens(100), multiplesOf3(100);
+        for (size_t i = 0; i < 100; i += 2) evens.insert(i);
+        for (size_t i = 0; i < 100; i += 3) multiplesOf3.insert(i);
+
+        std::cout << "Multiples of 6 below 100:\n";
+        (evens & multiplesOf3).display(true);
+        std::cout << "Even or multiple of 3: " << (evens | multiplesOf3).count() << "\n";
+        std::cout << "intersectionSize: " << intersectionSize(evens, multiplesOf3) << "\n";
+
+        DenseBitset odd = evens;
+        odd.complement();
+        std::cout << "First odd: " << odd.findFirst() << ", next: " << odd.findNext(odd.findFirst()) << "\n";
+
+        std::cout << "\n--- Testing exception ---\n";
+        evens.test(100);
+    } catch (const std::exception& e) {
+        std::cout << "Caught exception: " << e.what() << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,843 @@
+#ifndef SETS_HPP
+#define SETS_HPP
+
+/**
+ * @file sets.hpp
+ * @brief Set containers and set algebra.
+ *
+ *   HashSet<K>         - open addressing on the same Swiss-table engine as
+ *                        FlatHashMap (flat_detail::RawTable); O(1) membership
+ *   SortedFlatSet<T>   - sorted, deduplicated vector; binary-search lookups,
+ *                        ordered iteration, merge-based algebra
+ *   DenseBitset        - one bit per integer in [0, universe); algebra runs
+ *                        over 64-bit words with AVX2 / SSE2 / NEON kernels
+ *
+ * Every type offers setUnion / setIntersection / setDifference /
+ * setSymmetricDifference / intersectionSize (found by ADL) and the
+ * operators | & - ^.
+ *
+ * Usage:
+ * #include "../sets/sets.hpp"
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <span>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include "../console_colors/colours.hpp"
+#include "../output/output.hpp"
+#include "../maps/maps.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SETS_HAVE_AVX2 1
+#endif
+
+using namespace colors;
+
+// ==================== HASH SET ====================
+/**
+ * HashSet - unordered set of K in one flat slot array.
+ * Shares FlatHashMap's table: control bytes probed 16 at a time, 7/8
+ * load factor, tombstone-free erase where possible. Iteration order is
+ * slot order and changes when the table grows.
+ */
+template<typename K>
+class HashSet {
+private:
+    struct KeyOf {
+        static const K& get(const K& key) { return key; }
+    };
+
+    using Table = flat_detail::RawTable<K, KeyOf>;
+    static constexpr size_t NPOS = Table::NPOS;
+
+    Table table;
+
+public:
+    class const_iterator {
+    private:
+        const Table* table;
+        size_t index;
+
+        void skipEmpty() {
+            while (index < table->slotCount() && !table->full(index)) ++index;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = K;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const K*;
+        using reference = const K&;
+
+        const_iterator() : table(nullptr), index(0) {}
+        const_iterator(const Table* t, size_t i) : table(t), index(i) { skipEmpty(); }
+
+        reference operator*() const { return table->slot(index); }
+        pointer operator->() const { return &table->slot(index); }
+
+        const_iterator& operator++() {
+            ++index;
+            skipEmpty();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator before = *this;
+            ++*this;
+            return before;
+        }
+
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+    };
+
+    explicit HashSet(size_t cap = 16) : table(cap) {}
+
+    HashSet(std::initializer_list<K> keys) {
+        table.reserve(keys.size());
+        for (const K& key : keys) insert(key);
+    }
+
+    explicit HashSet(const std::vector<K>& keys) {
+        table.reserve(keys.size());
+        for (const K& key : keys) insert(key);
+    }
+
+    /**
+     * @return false if key was already present
+     */
+    bool insert(const K& key) {
+        bool inserted;
+        size_t idx = table.findOrPrepareInsert(key, inserted);
+        if (inserted) table.constructAt(idx, key);
+        return inserted;
+    }
+
+    /**
+     * @return false if key was not present
+     */
+    bool erase(const K& key) {
+        size_t idx = table.findIndex(key);
+        if (idx == NPOS) return false;
+        table.eraseAt(idx);
+        return true;
+    }
+
+    bool contains(const K& key) const {
+        return table.findIndex(key) != NPOS;
+    }
+
+    bool exists(const K& key) const {
+        return contains(key);
+    }
+
+    /**
+     * Pre-size the table so that n keys fit without a resize
+     */
+    void reserve(size_t n) { table.reserve(n); }
+
+    size_t size() const { return table.size(); }
+    bool empty() const { return table.size() == 0; }
+    void clear() { table.clear(); }
+
+    const_iterator begin() const { return const_iterator(&table, 0); }
+    const_iterator end() const { return const_iterator(&table, table.slotCount()); }
+
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        table.forEach(fn);
+    }
+
+    std::vector<K> values() const {
+        std::vector<K> result;
+        result.reserve(size());
+        table.forEach([&result](const K& key) { result.push_back(key); });
+        return result;
+    }
+
+    bool operator==(const HashSet& other) const {
+        return size() == other.size() && isSubsetOf(other);
+    }
+
+    bool isSubsetOf(const HashSet& other) const {
+        if (size() > other.size()) return false;
+        for (const K& key : *this) {
+            if (!other.contains(key)) return false;
+        }
+        return true;
+    }
+
+    // ---- set algebra: the smaller operand is scanned, the larger probed ----
+
+    friend HashSet setUnion(const HashSet& a, const HashSet& b) {
+        const HashSet& large = a.size() >= b.size() ? a : b;
+        const HashSet& small = a.size() >= b.size() ? b : a;
+        HashSet result(large);
+        result.reserve(large.size() + small.size());
+        for (const K& key : small) result.insert(key);
+        return result;
+    }
+
+    friend HashSet setIntersection(const HashSet& a, const HashSet& b) {
+        const HashSet& large = a.size() >= b.size() ? a : b;
+        const HashSet& small = a.size() >= b.size() ? b : a;
+        HashSet result(small.size());
+        for (const K& key : small) {
+            if (large.contains(key)) result.insert(key);
+        }
+        return result;
+    }
+
+    friend HashSet setDifference(const HashSet& a, const HashSet& b) {
+        HashSet result(a.size());
+        for (const K& key : a) {
+            if (!b.contains(key)) result.insert(key);
+        }
+        return result;
+    }
+
+    friend HashSet setSymmetricDifference(const HashSet& a, const HashSet& b) {
+        HashSet result(a.size() + b.size());
+        for (const K& key : a) {
+            if (!b.contains(key)) result.insert(key);
+        }
+        for (const K& key : b) {
+            if (!a.contains(key)) result.insert(key);
+        }
+        return result;
+    }
+
+    friend size_t intersectionSize(const HashSet& a, const HashSet& b) {
+        const HashSet& large = a.size() >= b.size() ? a : b;
+        const HashSet& small = a.size() >= b.size() ? b : a;
+        size_t count = 0;
+        for (const K& key : small) count += large.contains(key);
+        return count;
+    }
+
+    friend HashSet operator|(const HashSet& a, const HashSet& b) { return setUnion(a, b); }
+    friend HashSet operator&(const HashSet& a, const HashSet& b) { return setIntersection(a, b); }
+    friend HashSet operator-(const HashSet& a, const HashSet& b) { return setDifference(a, b); }
+    friend HashSet operator^(const HashSet& a, const HashSet& b) { return setSymmetricDifference(a, b); }
+
+    void display(bool use_color = false) const {
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("\n╔══════════════ HashSet ══════════════╗\n", BRIGHT_BLACK, true);
+        w.paint("║  {", BRIGHT_BLACK, true);
+        bool first = true;
+        for (const K& key : *this) {
+            if (!first) w.paint(", ", BRIGHT_YELLOW);
+            w.paint(key, BRIGHT_BLUE);
+            first = false;
+        }
+        w.paint("}\n", BRIGHT_BLACK, true);
+        w.paint("╚═════════════════════════════════════╝\n", BRIGHT_BLACK);
+        w.paint("Size: ");
+        w.paint(size(), BRIGHT_CYAN);
+        w.paint(" | Slots: ");
+        w.paint(table.slotCount(), BRIGHT_CYAN);
+        w << "\n\n";
+    }
+};
+
+// ==================== SORTED FLAT SET ====================
+/**
+ * SortedFlatSet - strictly increasing std::vector<T>.
+ * Lookups are binary searches over contiguous memory; single inserts and
+ * erases shift the tail (O(n)), so prefer the range constructor or
+ * insertRange() for bulk loads. Iterators are invalidated by mutation.
+ */
+template<typename T, typename Compare = std::less<>>
+class SortedFlatSet {
+private:
+    std::vector<T> items;
+    [[no_unique_address]] Compare less;
+
+    // Past this size ratio, intersection gallops through the larger set
+    static constexpr size_t GALLOP_RATIO = 16;
+
+    struct Trusted {};
+    SortedFlatSet(Trusted, std::vector<T> sorted, const Compare& compare)
+        : items(std::move(sorted)), less(compare) {}
+
+    bool equivalent(const T& a, const T& b) const {
+        return !less(a, b) && !less(b, a);
+    }
+
+    void sortAndUnique() {
+        std::sort(items.begin(), items.end(), less);
+        items.erase(std::unique(items.begin(), items.end(),
+                                [this](const T& a, const T& b) { return equivalent(a, b); }),
+                    items.end());
+    }
+
+    /**
+     * lower_bound that first doubles its step from `first`: O(log d) for a
+     * match d positions ahead, which keeps skewed intersections sublinear
+     */
+    typename std::vector<T>::const_iterator gallop(typename std::vector<T>::const_iterator first,
+                                                   typename std::vector<T>::const_iterator last,
+                                                   const T& value) const {
+        size_t step = 1;
+        while (static_cast<size_t>(last - first) > step && less(first[step], value)) {
+            first += step;
+            step *= 2;
+        }
+        auto bound = static_cast<size_t>(last - first) > step ? first + step + 1 : last;
+        return std::lower_bound(first, bound, value, less);
+    }
+
+public:
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    explicit SortedFlatSet(const Compare& compare = Compare()) : less(compare) {}
+
+    SortedFlatSet(std::initializer_list<T> values, const Compare& compare = Compare())
+        : items(values), less(compare) {
+        sortAndUnique();
+    }
+
+    /**
+     * Build from arbitrary values: O(n log n) sort, duplicates dropped
+     */
+    explicit SortedFlatSet(std::vector<T> values, const Compare& compare = Compare())
+        : items(std::move(values)), less(compare) {
+        sortAndUnique();
+    }
+
+    /**
+     * Adopt values that are already strictly increasing: O(n) check, no sort
+     * @throws invalid_argument if they are not
+     */
+    static SortedFlatSet fromSorted(std::vector<T> sorted, const Compare& compare = Compare()) {
+        for (size_t i = 1; i < sorted.size(); ++i) {
+            if (!compare(sorted[i - 1], sorted[i])) {
+                throw std::invalid_argument("fromSorted: values must be strictly increasing");
+            }
+        }
+        return SortedFlatSet(Trusted{}, std::move(sorted), compare);
+    }
+
+    /**
+     * @return false if an equivalent value was already present
+     */
+    bool insert(const T& value) {
+        auto it = std::lower_bound(items.begin(), items.end(), value, less);
+        if (it != items.end() && !less(value, *it)) return false;
+        items.insert(it, value);
+        return true;
+    }
+
+    /**
+     * Bulk insert: sort the new values, then one merge, O(n + m log m)
+     */
+    void insertRange(std::vector<T> values) {
+        size_t oldSize = items.size();
+        items.insert(items.end(), std::make_move_iterator(values.begin()),
+                     std::make_move_iterator(values.end()));
+        std::sort(items.begin() + oldSize, items.end(), less);
+        std::inplace_merge(items.begin(), items.begin() + oldSize, items.end(), less);
+        items.erase(std::unique(items.begin(), items.end(),
+                                [this](const T& a, const T& b) { return equivalent(a, b); }),
+                    items.end());
+    }
+
+    /**
+     * @return false if no equivalent value was present
+     */
+    bool erase(const T& value) {
+        auto it = std::lower_bound(items.begin(), items.end(), value, less);
+        if (it == items.end() || less(value, *it)) return false;
+        items.erase(it);
+        return true;
+    }
+
+    bool contains(const T& value) const {
+        auto it = std::lower_bound(items.begin(), items.end(), value, less);
+        return it != items.end() && !less(value, *it);
+    }
+
+    bool exists(const T& value) const {
+        return contains(value);
+    }
+
+    /**
+     * First element not less than value
+     */
+    const_iterator lowerBound(const T& value) const {
+        return std::lower_bound(items.begin(), items.end(), value, less);
+    }
+
+    /**
+     * Number of elements less than value
+     */
+    size_t rank(const T& value) const {
+        return static_cast<size_t>(lowerBound(value) - items.begin());
+    }
+
+    /**
+     * k-th smallest element (0-indexed)
+     * @throws out_of_range if k >= size()
+     */
+    const T& kth(size_t k) const {
+        if (k >= items.size()) throw std::out_of_range("Index out of range");
+        return items[k];
+    }
+
+    const T& operator[](size_t k) const { return items[k]; }
+
+    void reserve(size_t n) { items.reserve(n); }
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    void clear() { items.clear(); }
+
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+
+    /**
+     * Elements as one contiguous, sorted array
+     */
+    std::span<const T> view() const { return items; }
+    const std::vector<T>& values() const { return items; }
+
+    bool operator==(const SortedFlatSet& other) const {
+        return items.size() == other.items.size() &&
+               std::equal(items.begin(), items.end(), other.items.begin(),
+                          [this](const T& a, const T& b) { return equivalent(a, b); });
+    }
+
+    bool isSubsetOf(const SortedFlatSet& other) const {
+        return std::includes(other.items.begin(), other.items.end(), items.begin(), items.end(), less);
+    }
+
+    // ---- set algebra: linear merges of the two sorted arrays ----
+
+    friend SortedFlatSet setUnion(const SortedFlatSet& a, const SortedFlatSet& b) {
+        std::vector<T> out;
+        out.reserve(a.size() + b.size());
+        std::set_union(a.items.begin(), a.items.end(), b.items.begin(), b.items.end(),
+                       std::back_inserter(out), a.less);
+        return SortedFlatSet(Trusted{}, std::move(out), a.less);
+    }
+
+    friend SortedFlatSet setIntersection(const SortedFlatSet& a, const SortedFlatSet& b) {
+        const SortedFlatSet& small = a.size() <= b.size() ? a : b;
+        const SortedFlatSet& large = a.size() <= b.size() ? b : a;
+        std::vector<T> out;
+        out.reserve(small.size());
+        if (small.size() * GALLOP_RATIO < large.size()) {
+            auto cursor = large.items.begin();
+            for (const T& value : small.items) {
+                cursor = a.gallop(cursor, large.items.end(), value);
+                if (cursor == large.items.end()) break;
+                if (!a.less(value, *cursor)) out.push_back(value);
+            }
+        } else {
+            std::set_intersection(small.items.begin(), small.items.end(),
+                                  large.items.begin(), large.items.end(),
+                                  std::back_inserter(out), a.less);
+        }
+        return SortedFlatSet(Trusted{}, std::move(out), a.less);
+    }
+
+    friend SortedFlatSet setDifference(const SortedFlatSet& a, const SortedFlatSet& b) {
+        std::vector<T> out;
+        out.reserve(a.size());
+        std::set_difference(a.items.begin(), a.items.end(), b.items.begin(), b.items.end(),
+                            std::back_inserter(out), a.less);
+        return SortedFlatSet(Trusted{}, std::move(out), a.less);
+    }
+
+    friend SortedFlatSet setSymmetricDifference(const SortedFlatSet& a, const SortedFlatSet& b) {
+        std::vector<T> out;
+        out.reserve(a.size() + b.size());
+        std::set_symmetric_difference(a.items.begin(), a.items.end(), b.items.begin(), b.items.end(),
+                                      std::back_inserter(out), a.less);
+        return SortedFlatSet(Trusted{}, std::move(out), a.less);
+    }
+
+    friend size_t intersectionSize(const SortedFlatSet& a, const SortedFlatSet& b) {
+        size_t count = 0;
+        auto i = a.items.begin(), j = b.items.begin();
+        while (i != a.items.end() && j != b.items.end()) {
+            if (a.less(*i, *j)) ++i;
+            else if (a.less(*j, *i)) ++j;
+            else { ++count; ++i; ++j; }
+        }
+        return count;
+    }
+
+    friend SortedFlatSet operator|(const SortedFlatSet& a, const SortedFlatSet& b) { return setUnion(a, b); }
+    friend SortedFlatSet operator&(const SortedFlatSet& a, const SortedFlatSet& b) { return setIntersection(a, b); }
+    friend SortedFlatSet operator-(const SortedFlatSet& a, const SortedFlatSet& b) { return setDifference(a, b); }
+    friend SortedFlatSet operator^(const SortedFlatSet& a, const SortedFlatSet& b) { return setSymmetricDifference(a, b); }
+
+    void display(bool use_color = false) const {
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("\n╔═══════════ SortedFlatSet ═══════════╗\n", BRIGHT_BLACK, true);
+        w.paint("║  {", BRIGHT_BLACK, true);
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (i > 0) w.paint(", ", BRIGHT_YELLOW);
+            w.paint(items[i], BRIGHT_BLUE);
+        }
+        w.paint("}\n", BRIGHT_BLACK, true);
+        w.paint("╚═════════════════════════════════════╝\n", BRIGHT_BLACK);
+        w.paint("Size: ");
+        w.paint(items.size(), BRIGHT_CYAN);
+        w << "\n\n";
+    }
+};
+
+// ==================== BITSET KERNELS ====================
+namespace set_detail {
+    enum class WordOp { Or, And, AndNot, Xor };
+
+    template<WordOp Op>
+    inline uint64_t applyWord(uint64_t a, uint64_t b) {
+        if constexpr (Op == WordOp::Or) return a | b;
+        else if constexpr (Op == WordOp::And) return a & b;
+        else if constexpr (Op == WordOp::AndNot) return a & ~b;
+        else return a ^ b;
+    }
+
+    /**
+     * dst[i] = dst[i] op src[i] for n words, 256 or 128 bits at a time
+     */
+    template<WordOp Op>
+    inline void combineWords(uint64_t* dst, const uint64_t* src, size_t n) {
+        size_t i = 0;
+#if defined(SETS_HAVE_AVX2)
+        for (; i + 4 <= n; i += 4) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i r;
+            if constexpr (Op == WordOp::Or) r = _mm256_or_si256(a, b);
+            else if constexpr (Op == WordOp::And) r = _mm256_and_si256(a, b);
+            else if constexpr (Op == WordOp::AndNot) r = _mm256_andnot_si256(b, a);
+            else r = _mm256_xor_si256(a, b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+        }
+#elif defined(MAPS_HAVE_SSE2)
+        for (; i + 2 <= n; i += 2) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i r;
+            if constexpr (Op == WordOp::Or) r = _mm_or_si128(a, b);
+            else if constexpr (Op == WordOp::And) r = _mm_and_si128(a, b);
+            else if constexpr (Op == WordOp::AndNot) r = _mm_andnot_si128(b, a);
+            else r = _mm_xor_si128(a, b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+        }
+#elif defined(MAPS_HAVE_NEON)
+        for (; i + 2 <= n; i += 2) {
+            uint64x2_t a = vld1q_u64(dst + i);
+            uint64x2_t b = vld1q_u64(src + i);
+            uint64x2_t r;
+            if constexpr (Op == WordOp::Or) r = vorrq_u64(a, b);
+            else if constexpr (Op == WordOp::And) r = vandq_u64(a, b);
+            else if constexpr (Op == WordOp::AndNot) r = vbicq_u64(a, b);
+            else r = veorq_u64(a, b);
+            vst1q_u64(dst + i, r);
+        }
+#endif
+        for (; i < n; ++i) dst[i] = applyWord<Op>(dst[i], src[i]);
+    }
+
+    /**
+     * popcount(a[i] & b[i]) summed over n words, without materializing the AND.
+     * Four independent accumulators keep the popcount units busy.
+     */
+    inline size_t popcountAnd(const uint64_t* a, const uint64_t* b, size_t n) {
+        size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            c0 += static_cast<size_t>(std::popcount(a[i] & b[i]));
+            c1 += static_cast<size_t>(std::popcount(a[i + 1] & b[i + 1]));
+            c2 += static_cast<size_t>(std::popcount(a[i + 2] & b[i + 2]));
+            c3 += static_cast<size_t>(std::popcount(a[i + 3] & b[i + 3]));
+        }
+        for (; i < n; ++i) c0 += static_cast<size_t>(std::popcount(a[i] & b[i]));
+        return c0 + c1 + c2 + c3;
+    }
+}
+
+// ==================== DENSE BITSET ====================
+/**
+ * DenseBitset - set of integers in [0, universe()), one bit each.
+ * insert() grows the universe as needed; test/set/reset/flip are the
+ * bounds-checked bit operations. Union and symmetric difference grow the
+ * left operand to the larger universe; intersection and difference keep it.
+ */
+class DenseBitset {
+private:
+    static constexpr size_t WORD_BITS = 64;
+
+    std::vector<uint64_t> words;
+    size_t bits;
+
+    static size_t wordsFor(size_t n) { return (n + WORD_BITS - 1) / WORD_BITS; }
+    static uint64_t bitOf(size_t i) { return uint64_t{1} << (i % WORD_BITS); }
+
+    void checkIndex(size_t i) const {
+        if (i >= bits) throw std::out_of_range("Index out of range");
+    }
+
+    /**
+     * Clear the unused high bits of the last word
+     */
+    void trimTail() {
+        if (bits % WORD_BITS != 0) words.back() &= bitOf(bits) - 1;
+    }
+
+    void growTo(size_t n) {
+        if (n > bits) resize(n);
+    }
+
+public:
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    explicit DenseBitset(size_t universe = 0) : words(wordsFor(universe), 0), bits(universe) {}
+
+    DenseBitset(size_t universe, std::initializer_list<size_t> members) : DenseBitset(universe) {
+        for (size_t i : members) insert(i);
+    }
+
+    size_t universe() const { return bits; }
+
+    /**
+     * Change the universe; members at or above n are dropped
+     */
+    void resize(size_t n) {
+        words.resize(wordsFor(n), 0);
+        bits = n;
+        if (!words.empty()) trimTail();
+    }
+
+    /**
+     * Add i, growing the universe to i + 1 if needed
+     * @return false if i was already a member
+     */
+    bool insert(size_t i) {
+        growTo(i + 1);
+        uint64_t& word = words[i / WORD_BITS];
+        bool fresh = !(word & bitOf(i));
+        word |= bitOf(i);
+        return fresh;
+    }
+
+    /**
+     * @return false if i was not a member
+     */
+    bool erase(size_t i) {
+        if (!contains(i)) return false;
+        words[i / WORD_BITS] &= ~bitOf(i);
+        return true;
+    }
+
+    bool contains(size_t i) const {
+        return i < bits && (words[i / WORD_BITS] & bitOf(i));
+    }
+
+    bool test(size_t i) const {
+        checkIndex(i);
+        return words[i / WORD_BITS] & bitOf(i);
+    }
+
+    void set(size_t i) {
+        checkIndex(i);
+        words[i / WORD_BITS] |= bitOf(i);
+    }
+
+    void reset(size_t i) {
+        checkIndex(i);
+        words[i / WORD_BITS] &= ~bitOf(i);
+    }
+
+    void flip(size_t i) {
+        checkIndex(i);
+        words[i / WORD_BITS] ^= bitOf(i);
+    }
+
+    /**
+     * Replace the set with its complement within [0, universe())
+     */
+    void complement() {
+        for (uint64_t& word : words) word = ~word;
+        if (!words.empty()) trimTail();
+    }
+
+    /**
+     * Number of members: one popcount per word
+     */
+    size_t count() const {
+        size_t total = 0;
+        for (uint64_t word : words) total += static_cast<size_t>(std::popcount(word));
+        return total;
+    }
+
+    bool empty() const {
+        return std::all_of(words.begin(), words.end(), [](uint64_t word) { return word == 0; });
+    }
+
+    void clear() { std::fill(words.begin(), words.end(), 0); }
+
+    /**
+     * Smallest member, NPOS if empty
+     */
+    size_t findFirst() const { return findNext(NPOS); }
+
+    /**
+     * Smallest member greater than i (pass NPOS to start), NPOS if none
+     */
+    size_t findNext(size_t i) const {
+        size_t start = i + 1;   // NPOS + 1 wraps to 0
+        if (start >= bits) return NPOS;
+        size_t w = start / WORD_BITS;
+        uint64_t word = words[w] & ~(bitOf(start) - 1);
+        while (true) {
+            if (word) return w * WORD_BITS + static_cast<size_t>(std::countr_zero(word));
+            if (++w == words.size()) return NPOS;
+            word = words[w];
+        }
+    }
+
+    /**
+     * Calls fn(i) for each member in increasing order
+     */
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (uint64_t word = words[w]; word; word &= word - 1) {
+                fn(w * WORD_BITS + static_cast<size_t>(std::countr_zero(word)));
+            }
+        }
+    }
+
+    std::vector<size_t> values() const {
+        std::vector<size_t> result;
+        result.reserve(count());
+        forEach([&result](size_t i) { result.push_back(i); });
+        return result;
+    }
+
+    /**
+     * The raw words, bit i of the set at words[i / 64] bit (i % 64)
+     */
+    std::span<const uint64_t> data() const { return words; }
+
+    DenseBitset& operator|=(const DenseBitset& other) {
+        growTo(other.bits);
+        set_detail::combineWords<set_detail::WordOp::Or>(words.data(), other.words.data(), other.words.size());
+        return *this;
+    }
+
+    DenseBitset& operator&=(const DenseBitset& other) {
+        size_t common = std::min(words.size(), other.words.size());
+        set_detail::combineWords<set_detail::WordOp::And>(words.data(), other.words.data(), common);
+        std::fill(words.begin() + common, words.end(), 0);
+        return *this;
+    }
+
+    DenseBitset& operator-=(const DenseBitset& other) {
+        size_t common = std::min(words.size(), other.words.size());
+        set_detail::combineWords<set_detail::WordOp::AndNot>(words.data(), other.words.data(), common);
+        return *this;
+    }
+
+    DenseBitset& operator^=(const DenseBitset& other) {
+        growTo(other.bits);
+        set_detail::combineWords<set_detail::WordOp::Xor>(words.data(), other.words.data(), other.words.size());
+        return *this;
+    }
+
+    bool intersects(const DenseBitset& other) const {
+        size_t common = std::min(words.size(), other.words.size());
+        for (size_t i = 0; i < common; ++i) {
+            if (words[i] & other.words[i]) return true;
+        }
+        return false;
+    }
+
+    bool isSubsetOf(const DenseBitset& other) const {
+        for (size_t i = 0; i < words.size(); ++i) {
+            uint64_t theirs = i < other.words.size() ? other.words[i] : 0;
+            if (words[i] & ~theirs) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Same members, whatever the two universes are
+     */
+    bool operator==(const DenseBitset& other) const {
+        return isSubsetOf(other) && other.isSubsetOf(*this);
+    }
+
+    // ---- set algebra: word-parallel kernels above ----
+
+    friend DenseBitset setUnion(DenseBitset a, const DenseBitset& b) { return a |= b; }
+    friend DenseBitset setIntersection(DenseBitset a, const DenseBitset& b) { return a &= b; }
+    friend DenseBitset setDifference(DenseBitset a, const DenseBitset& b) { return a -= b; }
+    friend DenseBitset setSymmetricDifference(DenseBitset a, const DenseBitset& b) { return a ^= b; }
+
+    friend size_t intersectionSize(const DenseBitset& a, const DenseBitset& b) {
+        return set_detail::popcountAnd(a.words.data(), b.words.data(),
+                                       std::min(a.words.size(), b.words.size()));
+    }
+
+    friend DenseBitset operator|(DenseBitset a, const DenseBitset& b) { return a |= b; }
+    friend DenseBitset operator&(DenseBitset a, const DenseBitset& b) { return a &= b; }
+    friend DenseBitset operator-(DenseBitset a, const DenseBitset& b) { return a -= b; }
+    friend DenseBitset operator^(DenseBitset a, const DenseBitset& b) { return a ^= b; }
+
+    void display(bool use_color = false) const {
+        displayTo(std::cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w.paint("\n╔════════════ DenseBitset ════════════╗\n", BRIGHT_BLACK, true);
+        w.paint("║  {", BRIGHT_BLACK, true);
+        bool first = true;
+        forEach([&](size_t i) {
+            if (!first) w.paint(", ", BRIGHT_YELLOW);
+            w.paint(i, BRIGHT_BLUE);
+            first = false;
+        });
+        w.paint("}\n", BRIGHT_BLACK, true);
+        w.paint("╚═════════════════════════════════════╝\n", BRIGHT_BLACK);
+        w.paint("Members: ");
+        w.paint(count(), BRIGHT_CYAN);
+        w.paint(" | Universe: ");
+        w.paint(bits, BRIGHT_CYAN);
+        w << "\n\n";
+    }
+};
+
+#endif
@@ -0,0 +1,356 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+/**
+ * @file snapshot.hpp
+ * @brief Versioned binary snapshot files shared by the maps and graphs modules.
+ *
+ * A snapshot is a fixed header followed by up to MAX_SECTIONS raw arrays,
+ * each starting on an ALIGNMENT boundary. Because every array is stored
+ * exactly as it sits in memory, a reader maps the file and points spans
+ * straight at it: opening a snapshot costs one mmap, not one insert per entry.
+ *
+ * Only trivially copyable, non-pointer types can be stored, and their bytes
+ * are written as they are: a struct that holds a pointer, or a view such as
+ * std::string_view, compiles but reads back as a dangling address. The files use
+ * the writer's byte order and type layout; the header records both and a
+ * mismatching reader is rejected with SnapshotError instead of misreading.
+ *
+ * Usage:
+ * #include "../snapshot/snapshot.hpp"
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAPSHOT_HAVE_MMAP 1
+#endif
+
+namespace snapshot {
+
+constexpr char MAGIC[8] = {'S', 'N', 'Z', 'Y', 'S', 'N', 'A', 'P'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr size_t ALIGNMENT = 64;
+constexpr size_t MAX_SECTIONS = 8;
+
+enum class Kind : uint32_t { HashMap = 1, TreeMap = 2, Graph = 3 };
+
+class SnapshotError : public std::runtime_error {
+public:
+    explicit SnapshotError(const std::string& msg) : std::runtime_error("Snapshot error: " + msg) {}
+};
+
+/**
+ * Trivially copyable types other than bare pointers, at most ALIGNMENT
+ * aligned. The check cannot see inside a class: a struct holding a pointer
+ * or a std::string_view passes, and it is the caller's job not to store one.
+ */
+template<typename T>
+concept Storable = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> &&
+                   alignof(T) <= ALIGNMENT;
+
+struct Section {
+    uint64_t offset;    // from the start of the file, a multiple of ALIGNMENT
+    uint64_t bytes;
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t kind;
+    uint32_t flags;         // kind-specific, e.g. directed / weighted for graphs
+    uint32_t keySize;
+    uint32_t keyAlign;
+    uint32_t valueSize;
+    uint32_t valueAlign;
+    uint64_t count;         // entries, or vertices for graphs
+    uint64_t extra;         // kind-specific, e.g. slot count or edge count
+    uint32_t sectionCount;
+    uint32_t reserved;
+    Section sections[MAX_SECTIONS];
+};
+static_assert(std::is_trivially_copyable_v<Header>);
+
+/**
+ * Scramble a hash before masking it to a power-of-two slot count, so that
+ * identity hashes of sequential integers do not pile into one run
+ */
+inline uint64_t spread(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * Streams a header and its sections to disk. Everything goes to
+ * `path + ".tmp"` first and finish() renames it over `path`, so a crash or
+ * failed write mid-save leaves the previous snapshot intact. A Writer
+ * destroyed without finishing removes its temporary file.
+ */
+class Writer {
+private:
+    std::ofstream out;
+    std::string path;
+    std::string tempPath;   // empty once finished or moved from
+    Header header;
+    uint64_t position;
+
+    void pad() {
+        static constexpr char zeros[ALIGNMENT] = {};
+        size_t gap = (ALIGNMENT - position % ALIGNMENT) % ALIGNMENT;
+        out.write(zeros, (std::streamsize)gap);
+        position += gap;
+    }
+
+public:
+    template<typename K, typename V>
+    static Writer forTypes(const std::string& path, Kind kind) {
+        Writer writer(path, kind);
+        writer.header.keySize = sizeof(K);
+        writer.header.keyAlign = alignof(K);
+        writer.header.valueSize = sizeof(V);
+        writer.header.valueAlign = alignof(V);
+        return writer;
+    }
+
+    Writer(const std::string& filePath, Kind kind)
+        : path(filePath), tempPath(filePath + ".tmp"), header{}, position(0) {
+        out.open(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw SnapshotError("cannot open '" + tempPath + "' for writing");
+        }
+        header.version = FORMAT_VERSION;
+        header.byteOrder = BYTE_ORDER_MARK;
+        header.kind = (uint32_t)kind;
+        // Reserve room for the header; it is filled in by finish()
+        position = sizeof(Header);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    }
+
+    Writer(Writer&& other) noexcept
+        : out(std::move(other.out)), path(std::move(other.path)),
+          tempPath(std::exchange(other.tempPath, std::string())), header(other.header),
+          position(other.position) {}
+
+    Writer& operator=(Writer&&) = delete;
+
+    ~Writer() {
+        if (tempPath.empty()) return;
+        out.close();
+        std::remove(tempPath.c_str());
+    }
+
+    /**
+     * Append one array. Sections are numbered in the order they are added.
+     */
+    template<typename T>
+    void section(const T* data, size_t n) {
+        if (header.sectionCount == MAX_SECTIONS) {
+            throw SnapshotError("too many sections");
+        }
+        pad();
+        size_t bytes = n * sizeof(T);
+        header.sections[header.sectionCount++] = {position, bytes};
+        if (bytes) out.write(reinterpret_cast<const char*>(data), (std::streamsize)bytes);
+        position += bytes;
+    }
+
+    void finish(uint64_t count, uint64_t extra = 0, uint32_t flags = 0) {
+        pad();
+        header.count = count;
+        header.extra = extra;
+        header.flags = flags;
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        out.close();
+        if (!out) {
+            throw SnapshotError("write to '" + tempPath + "' failed");
+        }
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            throw SnapshotError("cannot replace '" + path + "' with '" + tempPath + "'");
+        }
+        tempPath.clear();
+    }
+};
+
+/**
+ * A snapshot file opened read-only. On POSIX systems the file is mapped and
+ * pages are loaded by the OS on first touch; elsewhere it is read into one
+ * aligned buffer. Move-only; the mapping lives as long as the object.
+ */
+class MappedFile {
+private:
+    const std::byte* base = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+
+    void release() {
+        if (!base) return;
+#ifdef SNAPSHOT_HAVE_MMAP
+        if (mapped) {
+            ::munmap(const_cast<std::byte*>(base), length);
+            base = nullptr;
+            return;
+        }
+#endif
+        ::operator delete(const_cast<std::byte*>(base), std::align_val_t{ALIGNMENT});
+        base = nullptr;
+    }
+
+    void readWhole(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            throw SnapshotError("cannot open '" + path + "'");
+        }
+        length = (size_t)in.tellg();
+        in.seekg(0);
+        auto* buffer = static_cast<std::byte*>(::operator new(length ? length : 1, std::align_val_t{ALIGNMENT}));
+        if (!in.read(reinterpret_cast<char*>(buffer), (std::streamsize)length)) {
+            ::operator delete(buffer, std::align_val_t{ALIGNMENT});
+            throw SnapshotError("cannot read '" + path + "'");
+        }
+        base = buffer;
+    }
+
+    void validate(const std::string& path) const {
+        if (length < sizeof(Header)) {
+            throw SnapshotError("'" + path + "' is too small to be a snapshot");
+        }
+        const Header& h = header();
+        if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw SnapshotError("'" + path + "' is not a snapshot");
+        }
+        if (h.byteOrder != BYTE_ORDER_MARK) {
+            throw SnapshotError("'" + path + "' was written with a different byte order");
+        }
+        if (h.version != FORMAT_VERSION) {
+            throw SnapshotError("'" + path + "' has format version " + std::to_string(h.version) +
+                                ", expected " + std::to_string(FORMAT_VERSION));
+        }
+        if (h.sectionCount > MAX_SECTIONS) {
+            throw SnapshotError("'" + path + "' has a corrupt section table");
+        }
+        for (uint32_t i = 0; i < h.sectionCount; ++i) {
+            const Section& s = h.sections[i];
+            if (s.offset % ALIGNMENT != 0 || s.offset > length || s.bytes > length - s.offset) {
+                throw SnapshotError("'" + path + "' is truncated or corrupt");
+            }
+        }
+    }
+
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef SNAPSHOT_HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw SnapshotError("cannot open '" + path + "'");
+        }
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            length = (size_t)info.st_size;
+            void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                base = static_cast<const std::byte*>(p);
+                mapped = true;
+            }
+        }
+        ::close(fd);
+        if (!base) readWhole(path);
+#else
+        readWhole(path);
+#endif
+        try {
+            validate(path);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    MappedFile(MappedFile&& other) noexcept
+        : base(std::exchange(other.base, nullptr)), length(std::exchange(other.length, 0)),
+          mapped(std::exchange(other.mapped, false)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            base = std::exchange(other.base, nullptr);
+            length = std::exchange(other.length, 0);
+            mapped = std::exchange(other.mapped, false);
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        release();
+    }
+
+    const Header& header() const {
+        return *reinterpret_cast<const Header*>(base);
+    }
+
+    /**
+     * Throw unless the file is a `kind` snapshot of exactly these K and V
+     */
+    template<typename K, typename V>
+    void expect(Kind kind) const {
+        const Header& h = header();
+        if (h.kind != (uint32_t)kind) {
+            throw SnapshotError("snapshot holds a different container kind");
+        }
+        if (h.keySize != sizeof(K) || h.keyAlign != alignof(K) ||
+            h.valueSize != sizeof(V) || h.valueAlign != alignof(V)) {
+            throw SnapshotError("snapshot key/value layout does not match the requested types");
+        }
+    }
+
+    /**
+     * Section `index` viewed as n elements of T, in place. n usually comes
+     * from the file's own header, so it is checked against the section's
+     * byte count by division: a huge n cannot wrap n * sizeof(T) to a match.
+     */
+    template<typename T>
+    std::span<const T> section(size_t index, size_t n) const {
+        const Header& h = header();
+        if (index >= h.sectionCount) {
+            throw SnapshotError("snapshot has no section " + std::to_string(index));
+        }
+        const Section& s = h.sections[index];
+        if (s.bytes % sizeof(T) != 0 || n != s.bytes / sizeof(T)) {
+            throw SnapshotError("section " + std::to_string(index) + " has an unexpected size");
+        }
+        if (s.offset > length || s.bytes > length - s.offset) {
+            throw SnapshotError("section " + std::to_string(index) + " lies outside the file");
+        }
+        if (n == 0) return {};
+        return {reinterpret_cast<const T*>(base + s.offset), n};
+    }
+
+    bool isMapped() const { return mapped; }
+    size_t bytes() const { return length; }
+};
+
+} // namespace snapshot
+
+#endif
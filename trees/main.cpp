@@ -128,7 +128,21 @@ int main(){
     } catch (const exception& e) {
         cout << "Error: " << e.what() << endl;
     }
-    cout << "\n";
+    
+    cout << "\nOrder statistics:\n";
+    cout << "3rd smallest: " << rbt.kth(2) << ", rank of 20: " << rbt.rank(20)
+         << ", values in [10, 25]: " << rbt.countInRange(10, 25) << endl;
+    RedBlackTree<int> upper = rbt.split(20);
+    cout << "After split(20): ";
+    for (int value : rbt) cout << value << " ";
+    cout << "| ";
+    for (int value : upper) cout << value << " ";
+    cout << endl;
+    rbt.join(std::move(upper));
+    rbt.erase(15);
+    cout << "After join and erase(15): ";
+    for (int value : rbt) cout << value << " ";
+    cout << "\n\n";
     
     // 4. Trie
     cout << "4. TRIE (Prefix Tree):\n";
@@ -163,6 +177,16 @@ int main(){
     } catch (const exception& e) {
         cout << "Error: " << e.what() << endl;
     }
+    
+    cout << "\nRadix (path-compressed) trie with the same words:\n";
+    RadixTrie radix;
+    for (const char* word : {"hello", "world", "help", "heap", "wonder"}) {
+        radix.insert(word);
+    }
+    radix.display(true);
+    cout << "Words starting with 'he': ";
+    radix.collectWithPrefix("he", 10, [](string_view word) { cout << word << " "; });
+    cout << "\nNodes: " << radix.nodeCount() << "\n";
     cout << "\n";
     
     // 5. Segment Tree
@@ -194,7 +218,12 @@ int main(){
     bit.update(5, 11);
     bit.display(true);
     cout << "Prefix sum up to index 2: " << bit.query(2) << "\n";
-    cout << "Range sum [1, 3]: " << bit.rangeQuery(1, 3) << "\n\n";
+    cout << "Range sum [1, 3]: " << bit.rangeQuery(1, 3) << "\n";
+    BinaryIndexedTree counts(vector<int>{4, 0, 2, 5, 1, 3});  // O(n) build
+    counts.batchUpdate({{1, 2}, {4, 1}});
+    cout << "First index with prefix count >= 9: " << counts.lowerBound(9) << "\n";
+    BinaryIndexedTree2D grid(vector<vector<int>>{{1, 2, 3}, {4, 5, 6}});
+    cout << "2D sum of [0,1]x[1,2]: " << grid.rangeQuery(0, 1, 1, 2) << "\n\n";
     
     // 7. N-ary Tree
     cout << "7. N-ARY TREE:\n";
@@ -251,8 +280,26 @@ int main(){
     cout << "\nLevel order traversal:\n";
     nary.levelOrder();
     
+    // 8. B+ Tree
+    cout << "\n8. B+ TREE:\n";
+    cout << "===========\n";
+    BTree<int> btree(2);
+    for (int key : {50, 20, 80, 10, 30, 60, 90, 40, 70}) {
+        btree.insert(key);
+    }
+    btree.display(true);
+    cout << "Inorder traversal: ";
+    btree.inorder();
+    cout << "Keys in [25, 65]: ";
+    for (int key : btree.rangeScan(25, 65)) cout << key << " ";
+    cout << endl;
+    btree.erase(20);
+    btree.erase(30);
+    cout << "After erasing 20 and 30:\n";
+    btree.display(true);
+    
     // Edge case testing
-    cout << "\n8. EDGE CASE TESTING:\n";
+    cout << "\n9. EDGE CASE TESTING:\n";
     cout << "=====================\n";
     
     // Empty tree search
@@ -8,10 +8,227 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <stdexcept>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <string_view>
+#include <cstdint>
+#include <tuple>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <bit>
 #include "../console_colors/colours.hpp"
+#include "../instrumentation/instrumentation.hpp"
+#include "../output/output.hpp"
 
 using namespace std;
 using namespace colors;
+// ============================================================================
+// NODE ALLOCATION
+// ============================================================================
+
+/**
+ * Slab allocator for fixed-size tree nodes
+ * Nodes are carved out of contiguous slabs, so nodes created together sit
+ * together in memory, and freed nodes are recycled through an intrusive
+ * free list. Slabs come from a std::pmr::memory_resource (operator new by
+ * default), e.g. a monotonic_buffer_resource over a stack buffer.
+ * release() hands every slab back at once without touching the nodes.
+ * Slabs are reference counted so trees that split or join can hand nodes
+ * to each other; a slab is returned once no pool shares it any more.
+ */
+template<typename Node>
+class NodePool {
+private:
+    union Slot {
+        Slot* next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+    
+    struct Slab {
+        pmr::memory_resource* upstream;
+        Slot* slots;
+        size_t count;
+        
+        Slab(pmr::memory_resource* resource, size_t n)
+            : upstream(resource),
+              slots(static_cast<Slot*>(resource->allocate(n * sizeof(Slot), alignof(Slot)))),
+              count(n) {}
+        Slab(const Slab&) = delete;
+        Slab& operator=(const Slab&) = delete;
+        ~Slab() { upstream->deallocate(slots, count * sizeof(Slot), alignof(Slot)); }
+    };
+    
+    static constexpr size_t FIRST_SLAB = 32;   // nodes in the first slab
+    static constexpr size_t MAX_SLAB = 4096;   // slab size stops doubling here
+    
+    pmr::memory_resource* upstream;
+    vector<shared_ptr<Slab>> slabs;
+    Slot* freeList;
+    Slot* bump;     // next never-used slot of the newest slab
+    Slot* bumpEnd;
+    size_t lastSlabSize;
+    size_t live;
+    
+    void grow() {
+        size_t count = lastSlabSize == 0 ? FIRST_SLAB : min(lastSlabSize * 2, MAX_SLAB);
+        slabs.push_back(allocate_shared<Slab>(pmr::polymorphic_allocator<Slab>(upstream), upstream, count));
+        lastSlabSize = count;
+        bump = slabs.back()->slots;
+        bumpEnd = bump + count;
+    }
+    
+    /**
+     * Add other's slabs to ours, skipping ones we already share
+     */
+    void shareSlabs(const NodePool& other) {
+        for (const auto& slab : other.slabs) {
+            bool known = any_of(slabs.begin(), slabs.end(),
+                                [&slab](const shared_ptr<Slab>& mine) { return mine == slab; });
+            if (!known) slabs.push_back(slab);
+        }
+    }
+    
+public:
+    explicit NodePool(pmr::memory_resource* resource = pmr::get_default_resource())
+        : upstream(resource), freeList(nullptr), bump(nullptr), bumpEnd(nullptr),
+          lastSlabSize(0), live(0) {}
+    
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    
+    NodePool(NodePool&& other) noexcept
+        : upstream(other.upstream), slabs(std::move(other.slabs)),
+          freeList(exchange(other.freeList, nullptr)), bump(exchange(other.bump, nullptr)),
+          bumpEnd(exchange(other.bumpEnd, nullptr)), lastSlabSize(exchange(other.lastSlabSize, 0)),
+          live(exchange(other.live, 0)) {
+        other.slabs.clear();
+    }
+    
+    NodePool& operator=(NodePool&& other) noexcept {
+        swap(upstream, other.upstream);
+        swap(slabs, other.slabs);
+        swap(freeList, other.freeList);
+        swap(bump, other.bump);
+        swap(bumpEnd, other.bumpEnd);
+        swap(lastSlabSize, other.lastSlabSize);
+        swap(live, other.live);
+        return *this;
+    }
+    
+    ~NodePool() { release(); }
+    
+    /**
+     * Construct a node in a recycled or fresh slot
+     */
+    template<typename... Args>
+    Node* create(Args&&... args) {
+        Slot* slot;
+        if (freeList) {
+            slot = freeList;
+            freeList = slot->next;
+        } else {
+            if (bump == bumpEnd) grow();
+            slot = bump++;
+        }
+        try {
+            Node* node = ::new (static_cast<void*>(slot->storage)) Node(std::forward<Args>(args)...);
+            live++;
+            return node;
+        } catch (...) {
+            slot->next = freeList;
+            freeList = slot;
+            throw;
+        }
+    }
+    
+    /**
+     * Destroy one node and put its slot on the free list
+     */
+    void destroy(Node* node) {
+        node->~Node();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next = freeList;
+        freeList = slot;
+        live--;
+    }
+    
+    /**
+     * Run the destructor of every node reachable from root, without
+     * recycling slots, ahead of release()
+     * Does nothing for trivially destructible nodes
+     * @param forEachChild: Called as forEachChild(node, visit); must call
+     *                      visit(child) for each child of node
+     */
+    template<typename ForEachChild>
+    void destroyAll(Node* root, ForEachChild forEachChild) {
+        if constexpr (!is_trivially_destructible_v<Node>) {
+            vector<Node*> stack;
+            if (root) stack.push_back(root);
+            while (!stack.empty()) {
+                Node* node = stack.back();
+                stack.pop_back();
+                forEachChild(node, [&stack](Node* child) {
+                    if (child) stack.push_back(child);
+                });
+                node->~Node();
+            }
+        }
+        live = 0;
+    }
+    
+    /**
+     * Take over every node of other (after a join)
+     * Its slabs and free slots become ours and other is left empty
+     * Time Complexity: O(slabs + free slots of other)
+     */
+    void adopt(NodePool& other) {
+        if (&other == this) return;
+        shareSlabs(other);
+        if (other.freeList) {
+            Slot* tail = other.freeList;
+            while (tail->next) tail = tail->next;
+            tail->next = freeList;
+            freeList = other.freeList;
+        }
+        live += other.live;
+        other.freeList = other.bump = other.bumpEnd = nullptr;
+        other.live = 0;
+        other.slabs.clear();
+    }
+    
+    /**
+     * Share other's slabs because count of its nodes now belong to us
+     * (after a split); those nodes may later be destroyed through either pool
+     * Time Complexity: O(slabs)
+     */
+    void share(NodePool& other, size_t count) {
+        if (&other == this) return;
+        shareSlabs(other);
+        live += count;
+        other.live -= count;
+    }
+    
+    /**
+     * Drop our share of every slab; a slab goes back upstream with its
+     * last share
+     * Nodes with non-trivial destructors must be destroyed first
+     * Time Complexity: O(slabs)
+     */
+    void release() noexcept {
+        slabs.clear();
+        freeList = bump = bumpEnd = nullptr;
+        lastSlabSize = 0;
+        live = 0;
+    }
+    
+    size_t liveNodes() const { return live; }
+    pmr::memory_resource* resource() const { return upstream; }
+};
+
 // ============================================================================
 // BASE TREE NODE CLASSES
 // ============================================================================
@@ -90,21 +307,26 @@ template<typename T>
 class BinarySearchTree {
 private:
     BSTNode<T>* root;
+    NodePool<BSTNode<T>> pool;
+    [[no_unique_address]] mutable instrumentation::Slot<instrumentation::TreeStats> counters;
     
     /**
-     * Helper function to insert a value recursively
+     * Helper function to insert a value, walking down from the root
+     * Iterative: a degenerate (sorted-input) tree may be as deep as it is large
      */
     BSTNode<T>* insertHelper(BSTNode<T>* node, T value) {
-        if (node == nullptr) {
-            return new BSTNode<T>(value);
-        }
-        
-        if (value < node->data) {
-            node->left = insertHelper(node->left, value);
-        } else if (value > node->data) {
-            node->right = insertHelper(node->right, value);
+        BSTNode<T>** link = &node;
+        while (*link != nullptr) {
+            if (value < (*link)->data) {
+                link = &(*link)->left;
+            } else if (value > (*link)->data) {
+                link = &(*link)->right;
+            } else {
+                return node;
+            }
         }
-        
+        SNAZZYDEETS_STAT(counters.inserts.add());
+        *link = pool.create(value);
         return node;
     }
     
@@ -113,80 +335,105 @@ private:
      * Returns SearchResult with level and position information
      */
     SearchResult searchHelper(BSTNode<T>* node, T value, int currentLevel, int position) {
-        if (node == nullptr) {
-            return SearchResult();
-        }
-        
-        if (node->data == value) {
-            return SearchResult(currentLevel, position);
-        }
-        
-        if (value < node->data) {
-            return searchHelper(node->left, value, currentLevel + 1, position * 2);
+        // Unsigned so paths deeper than the int width wrap instead of overflowing
+        unsigned path = static_cast<unsigned>(position);
+        while (node != nullptr) {
+            if (node->data == value) {
+                SNAZZYDEETS_STAT(counters.recordSearch("BinarySearchTree", currentLevel));
+                return SearchResult(currentLevel, static_cast<int>(path));
+            }
+            bool goRight = !(value < node->data);
+            node = goRight ? node->right : node->left;
+            path = path * 2 + (goRight ? 1 : 0);
+            currentLevel++;
         }
-        return searchHelper(node->right, value, currentLevel + 1, position * 2 + 1);
+        SNAZZYDEETS_STAT(counters.recordSearch("BinarySearchTree", currentLevel - 1));
+        return SearchResult();
     }
     /**
-     * Helper function for inorder traversal
+     * Helper function for inorder traversal, on an explicit stack
      */
     void inorderHelper(BSTNode<T>* node) {
-        if (node == nullptr) return;
-        inorderHelper(node->left);
-        cout << node->data << " ";
-        inorderHelper(node->right);
+        vector<BSTNode<T>*> stack;
+        while (node != nullptr || !stack.empty()) {
+            while (node != nullptr) {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            cout << node->data << " ";
+            node = node->right;
+        }
     }
 
      /**
      * Helper to get height of a specific node with given value
      */
     int getNodeHeightHelper(BSTNode<T>* node, T value) {
-        if (node == nullptr) {
-           throw logic_error("Can't get the height of the node as Tree is empty!");
-        }
-
-        if (node->data == value) {
-            return calculateHeight(node);
-        }
-
-        if (value < node->data) {
-            return getNodeHeightHelper(node->left, value);
+        while (node != nullptr) {
+            if (node->data == value) {
+                return calculateHeight(node);
+            }
+            node = value < node->data ? node->left : node->right;
         }
-        return getNodeHeightHelper(node->right, value);
+        throw logic_error("Can't get the height of the node as Tree is empty!");
     }
 
     /**
      * Calculate height of a given node
      * Height = longest path from node to leaf
+     * Walks the subtree on an explicit (node, depth) stack
      */
     int calculateHeight(BSTNode<T>* node) {
         if (node == nullptr) return -1;
 
-        int leftHeight = calculateHeight(node->left);
-        int rightHeight = calculateHeight(node->right);
-
-        return max(leftHeight, rightHeight) + 1;
+        int height = 0;
+        vector<pair<BSTNode<T>*, int>> stack{{node, 0}};
+        while (!stack.empty()) {
+            auto [current, depth] = stack.back();
+            stack.pop_back();
+            height = max(height, depth);
+            if (current->left) stack.push_back({current->left, depth + 1});
+            if (current->right) stack.push_back({current->right, depth + 1});
+        }
+        return height;
     }
 
     /**
      * Get depth of a specific node (distance from root)
      */
     int getNodeDepthHelper(BSTNode<T>* node, T value, int depth) {
-        if (node == nullptr) {
-            throw logic_error("Tree doesn't have any leaf nodes. Add some nodes using BSTNode.insert() method!");
-        }
-
-        if (node->data == value) {
-            return depth;
-        }
-
-        if (value < node->data) {
-            return getNodeDepthHelper(node->left, value, depth + 1);
+        while (node != nullptr) {
+            if (node->data == value) {
+                return depth;
+            }
+            node = value < node->data ? node->left : node->right;
+            depth++;
         }
-        return getNodeDepthHelper(node->right, value, depth + 1);
+        throw logic_error("Tree doesn't have any leaf nodes. Add some nodes using BSTNode.insert() method!");
     }
 
 public:
-    BinarySearchTree() : root(nullptr) {}
+    /**
+     * @param resource Memory resource the node slabs are drawn from
+     */
+    explicit BinarySearchTree(pmr::memory_resource* resource = pmr::get_default_resource())
+        : root(nullptr), pool(resource) {}
+    
+    ~BinarySearchTree() { clear(); }
+    
+    /**
+     * Remove all nodes, releasing the node slabs in one step
+     */
+    void clear() {
+        pool.destroyAll(root, [](BSTNode<T>* node, auto visit) {
+            visit(node->left);
+            visit(node->right);
+        });
+        pool.release();
+        root = nullptr;
+    }
     
     /**
      * Insert a value into the BST
@@ -196,6 +443,24 @@ public:
         root = insertHelper(root, value);
     }
     
+    /**
+     * Insert, rotation and search counters
+     * All zero unless built with SNAZZYDEETS_STATS
+     */
+    instrumentation::TreeStats stats() const {
+#ifdef SNAZZYDEETS_STATS
+        return counters;
+#else
+        return instrumentation::TreeStats{};
+#endif
+    }
+    
+    void resetStats() {
+#ifdef SNAZZYDEETS_STATS
+        counters = instrumentation::TreeStats{};
+#endif
+    }
+    
      /**
      * Search for a value in the BST
      * Returns SearchResult with level (1-indexed) and position
@@ -222,8 +487,45 @@ public:
      * Display tree structure in ASCII format
      */
     void display(bool use_color = false) {
-        cout << "Binary Search Tree Structure:\n";
-        displayHelper(root, "", true, use_color);
+        displayTo(cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w << "Binary Search Tree Structure:\n";
+        string prefix;
+        displayHelper(w, root, prefix, true);
+    }
+
+    /**
+     * Graphviz DOT digraph of the tree, children labelled L and R
+     */
+    void exportDOT(output::Target target) const {
+        output::Writer w(std::move(target));
+        output::binaryTreeDOT(w, "BST", root, nullptr,
+            [](const BSTNode<T>* node) { return node->left; },
+            [](const BSTNode<T>* node) { return node->right; },
+            [](output::Writer& out, const BSTNode<T>* node) {
+                out << "label=";
+                output::writeDOTId(out, node->data);
+            });
+    }
+
+    /**
+     * Nested JSON: {"value": v, "left": subtree|null, "right": subtree|null}
+     */
+    void exportJSON(output::Target target) const {
+        output::Writer w(std::move(target));
+        output::binaryTreeJSON(w, root, nullptr,
+            [](const BSTNode<T>* node) { return node->left; },
+            [](const BSTNode<T>* node) { return node->right; },
+            [](output::Writer& out, const BSTNode<T>* node) {
+                out << "\"value\":";
+                output::writeJSONValue(out, node->data);
+            });
     }
 
     int getNodeHeight(T value) {
@@ -259,31 +561,38 @@ public:
     
 private:
     /**
-     * Helper function to display tree structure recursively
+     * Helper function to display tree structure
      * Uses box-drawing characters for visual representation
+     * Iterative: each stack entry remembers the prefix length to restore
      */
-   void displayHelper(BSTNode<T>* node, string prefix, bool isRight, bool use_color) {
-        if (node == nullptr) return;
-        
-        cout << prefix;
-        if (isRight) {
-            cprint(use_color, "|-- ", BRIGHT_GREEN);
-        } else {
-            cprint(use_color, "`-- ", BRIGHT_GREEN);
-        }
-        cprint(use_color, "(", BRIGHT_YELLOW);
-        cprint(use_color, node->data, BRIGHT_BLUE);
-        cprint(use_color, ")", BRIGHT_YELLOW);
-        cout << endl;
-        
-        if (node->left != nullptr || node->right != nullptr) {
-            if (node->right != nullptr) {
-                displayHelper(node->right, prefix + (isRight ? "|   " : "    "), true, use_color);
-            }
-            if (node->left != nullptr) {
-                displayHelper(node->left, prefix + (isRight ? "|   " : "    "), false, use_color);
-            }
+    void displayHelper(output::Writer& w, const BSTNode<T>* node, string& prefix, bool isRight) const {
+        struct Frame {
+            const BSTNode<T>* node;
+            size_t prefixLength;
+            bool isRight;
+        };
+        size_t length = prefix.size();
+        vector<Frame> stack;
+        if (node != nullptr) stack.push_back({node, length, isRight});
+        while (!stack.empty()) {
+            Frame frame = stack.back();
+            stack.pop_back();
+
+            // One prefix string shared by the whole walk, cut back and extended
+            prefix.resize(frame.prefixLength);
+            w << prefix;
+            w.paint(frame.isRight ? "|-- " : "`-- ", BRIGHT_GREEN);
+            w.paint("(", BRIGHT_YELLOW);
+            w.paint(frame.node->data, BRIGHT_BLUE);
+            w.paint(")", BRIGHT_YELLOW);
+            w << '\n';
+
+            prefix += frame.isRight ? "|   " : "    ";
+            // Left pushed first so the right subtree prints first
+            if (frame.node->left) stack.push_back({frame.node->left, prefix.size(), false});
+            if (frame.node->right) stack.push_back({frame.node->right, prefix.size(), true});
         }
+        prefix.resize(length);
     }
 };
 
@@ -301,45 +610,65 @@ public:
     AVLNode* left;
     AVLNode* right;
     int height;
+    int size; // nodes in this subtree, for order statistics
     
-    AVLNode(T value) : data(value), left(nullptr), right(nullptr), height(1) {}
+    AVLNode(T value) : data(value), left(nullptr), right(nullptr), height(1), size(1) {}
 };
 
 /**
  * AVL Tree implementation - Self-balancing binary search tree
  * Maintains height balance: |height(left) - height(right)| <= 1
+ * Every node also stores its subtree size, so rank and select are O(log n)
  */
 template<typename T>
 class AVLTree {
 private:
     AVLNode<T>* root;
+    NodePool<AVLNode<T>> pool;
+    [[no_unique_address]] mutable instrumentation::Slot<instrumentation::TreeStats> counters;
     
     /**
      * Get height of a node
      */
-    int getHeight(AVLNode<T>* node) {
+    static int getHeight(const AVLNode<T>* node) {
         return node ? node->height : 0;
     }
     
+    /**
+     * Get subtree size of a node
+     */
+    static int getSize(const AVLNode<T>* node) {
+        return node ? node->size : 0;
+    }
+    
     /**
      * Get balance factor of a node
      */
-    int getBalance(AVLNode<T>* node) {
+    static int getBalance(const AVLNode<T>* node) {
         return node ? getHeight(node->left) - getHeight(node->right) : 0;
     }
     
+    /**
+     * Recompute height and size from the children
+     */
+    static void pull(AVLNode<T>* node) {
+        node->height = max(getHeight(node->left), getHeight(node->right)) + 1;
+        node->size = getSize(node->left) + getSize(node->right) + 1;
+    }
+    
     /**
      * Right rotation for balancing
      */
     AVLNode<T>* rightRotate(AVLNode<T>* y) {
+        SNAZZYDEETS_STAT(counters.rotations.add());
         AVLNode<T>* x = y->left;
         AVLNode<T>* T2 = x->right;
         
         x->right = y;
         y->left = T2;
         
-        y->height = max(getHeight(y->left), getHeight(y->right)) + 1;
-        x->height = max(getHeight(x->left), getHeight(x->right)) + 1;
+        pull(y);
+        pull(x);
         
         return x;
     }
@@ -348,69 +677,167 @@ private:
      * Left rotation for balancing
      */
     AVLNode<T>* leftRotate(AVLNode<T>* x) {
+        SNAZZYDEETS_STAT(counters.rotations.add());
         AVLNode<T>* y = x->right;
         AVLNode<T>* T2 = y->left;
         
         y->left = x;
         x->right = T2;
         
-        x->height = max(getHeight(x->left), getHeight(x->right)) + 1;
-        y->height = max(getHeight(y->left), getHeight(y->right)) + 1;
+        pull(x);
+        pull(y);
         
         return y;
     }
     
+    /**
+     * Restore the AVL property at node after one of its subtrees changed
+     * height by at most one (or more, when joining; applied per spine node)
+     */
+    AVLNode<T>* rebalance(AVLNode<T>* node) {
+        pull(node);
+        int balance = getBalance(node);
+        
+        if (balance > 1) {
+            // Left Right Case
+            if (getBalance(node->left) < 0) {
+                node->left = leftRotate(node->left);
+            }
+            // Left Left Case
+            return rightRotate(node);
+        }
+        if (balance < -1) {
+            // Right Left Case
+            if (getBalance(node->right) > 0) {
+                node->right = rightRotate(node->right);
+            }
+            // Right Right Case
+            return leftRotate(node);
+        }
+        return node;
+    }
+    
     /**
      * Insert a value and maintain AVL property
      */
-    AVLNode<T>* insertHelper(AVLNode<T>* node, T value) {
+    AVLNode<T>* insertHelper(AVLNode<T>* node, const T& value, bool& inserted) {
         if (node == nullptr) {
-            return new AVLNode<T>(value);
+            inserted = true;
+            SNAZZYDEETS_STAT(counters.inserts.add());
+            return pool.create(value);
         }
         
         if (value < node->data) {
-            node->left = insertHelper(node->left, value);
-        } else if (value > node->data) {
-            node->right = insertHelper(node->right, value);
+            node->left = insertHelper(node->left, value, inserted);
+        } else if (node->data < value) {
+            node->right = insertHelper(node->right, value, inserted);
         } else {
             return node; // Duplicate values not allowed
         }
         
-        node->height = 1 + max(getHeight(node->left), getHeight(node->right));
-        
-        int balance = getBalance(node);
-        
-        // Left Left Case
-        if (balance > 1 && value < node->left->data) {
-            return rightRotate(node);
+        return rebalance(node);
+    }
+    
+    /**
+     * Unlink the smallest node of a subtree, returned through minNode
+     */
+    AVLNode<T>* detachMin(AVLNode<T>* node, AVLNode<T>*& minNode) {
+        if (node->left == nullptr) {
+            minNode = node;
+            return node->right;
         }
+        node->left = detachMin(node->left, minNode);
+        return rebalance(node);
+    }
+    
+    /**
+     * Remove a value and maintain AVL property
+     * A node with two children is replaced by its successor node (relinked,
+     * not copied), so T needs no assignment operator
+     */
+    AVLNode<T>* eraseHelper(AVLNode<T>* node, const T& value, bool& erased) {
+        if (node == nullptr) return nullptr;
         
-        // Right Right Case
-        if (balance < -1 && value > node->right->data) {
-            return leftRotate(node);
+        if (value < node->data) {
+            node->left = eraseHelper(node->left, value, erased);
+        } else if (node->data < value) {
+            node->right = eraseHelper(node->right, value, erased);
+        } else {
+            erased = true;
+            AVLNode<T>* replacement;
+            if (node->left == nullptr || node->right == nullptr) {
+                replacement = node->left ? node->left : node->right;
+            } else {
+                AVLNode<T>* successor;
+                AVLNode<T>* rest = detachMin(node->right, successor);
+                successor->left = node->left;
+                successor->right = rest;
+                replacement = rebalance(successor);
+            }
+            pool.destroy(node);
+            return replacement;
         }
         
-        // Left Right Case
-        if (balance > 1 && value > node->left->data) {
-            node->left = leftRotate(node->left);
-            return rightRotate(node);
+        return rebalance(node);
+    }
+    
+    /**
+     * Join left < mid < right into one AVL tree
+     * Descends the spine of the taller side to a subtree of matching height
+     * Time Complexity: O(|height(left) - height(right)| + 1)
+     */
+    AVLNode<T>* joinHelper(AVLNode<T>* left, AVLNode<T>* mid, AVLNode<T>* right) {
+        if (getHeight(left) > getHeight(right) + 1) {
+            left->right = joinHelper(left->right, mid, right);
+            return rebalance(left);
         }
-        
-        // Right Left Case
-        if (balance < -1 && value < node->right->data) {
-            node->right = rightRotate(node->right);
-            return leftRotate(node);
+        if (getHeight(right) > getHeight(left) + 1) {
+            right->left = joinHelper(left, mid, right->left);
+            return rebalance(right);
         }
-        
+        mid->left = left;
+        mid->right = right;
+        pull(mid);
+        return mid;
+    }
+    
+    /**
+     * Split a subtree into (values < key, values >= key)
+     * Time Complexity: O(log n)
+     */
+    pair<AVLNode<T>*, AVLNode<T>*> splitHelper(AVLNode<T>* node, const T& key) {
+        if (node == nullptr) return {nullptr, nullptr};
+        AVLNode<T>* left = node->left;
+        AVLNode<T>* right = node->right;
+        if (node->data < key) {
+            auto [lo, hi] = splitHelper(right, key);
+            return {joinHelper(left, node, lo), hi};
+        }
+        auto [lo, hi] = splitHelper(left, key);
+        return {lo, joinHelper(hi, node, right)};
+    }
+    
+    /**
+     * Build a perfectly balanced subtree from sorted[lo, hi)
+     */
+    AVLNode<T>* buildHelper(const vector<T>& sorted, size_t lo, size_t hi) {
+        if (lo >= hi) return nullptr;
+        size_t mid = lo + (hi - lo) / 2;
+        AVLNode<T>* node = pool.create(sorted[mid]);
+        node->left = buildHelper(sorted, lo, mid);
+        node->right = buildHelper(sorted, mid + 1, hi);
+        pull(node);
         return node;
     }
 
     SearchResult searchHelper(AVLNode<T>* node, T value, int level, int position){
                  if (node == nullptr){
+                    SNAZZYDEETS_STAT(counters.recordSearch("AVLTree", level - 1));
                     return SearchResult();
                  }
 
                  if (node->data == value){
+                    SNAZZYDEETS_STAT(counters.recordSearch("AVLTree", level));
                     return SearchResult(level, position);
                  }
 
@@ -466,40 +893,331 @@ private:
     }
 
 public:
-    AVLTree() : root(nullptr) {}
+    /**
+     * In-order iterator
+     * Keeps the path of pending ancestors on an explicit stack, so a full
+     * traversal is O(n) with no recursion and O(log n) extra space
+     */
+    class const_iterator {
+        vector<const AVLNode<T>*> path;
+        
+        void pushLeftSpine(const AVLNode<T>* node) {
+            for (; node; node = node->left) path.push_back(node);
+        }
+        
+        friend class AVLTree;
+        
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        const_iterator() = default;
+        
+        const T& operator*() const { return path.back()->data; }
+        const T* operator->() const { return &path.back()->data; }
+        
+        const_iterator& operator++() {
+            const AVLNode<T>* node = path.back();
+            path.pop_back();
+            pushLeftSpine(node->right);
+            return *this;
+        }
+        
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+        
+        bool operator==(const const_iterator& other) const {
+            return (path.empty() ? nullptr : path.back()) ==
+                   (other.path.empty() ? nullptr : other.path.back());
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+    
+    /**
+     * @param resource Memory resource the node slabs are drawn from
+     */
+    explicit AVLTree(pmr::memory_resource* resource = pmr::get_default_resource())
+        : root(nullptr), pool(resource) {}
+    
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+    
+    AVLTree(AVLTree&& other) noexcept
+        : root(exchange(other.root, nullptr)), pool(std::move(other.pool)) {}
+    
+    AVLTree& operator=(AVLTree&& other) noexcept {
+        if (this != &other) {
+            clear();
+            root = exchange(other.root, nullptr);
+            pool = std::move(other.pool);
+        }
+        return *this;
+    }
+    
+    ~AVLTree() { clear(); }
+    
+    /**
+     * Remove all nodes, releasing the node slabs in one step
+     * O(1) per slab when T is trivially destructible
+     */
+    void clear() {
+        pool.destroyAll(root, [](AVLNode<T>* node, auto visit) {
+            visit(node->left);
+            visit(node->right);
+        });
+        pool.release();
+        root = nullptr;
+    }
     
     /**
      * Insert a value into AVL tree
      * Time Complexity: O(log n)
+     * @return false if the value was already present
      */
-    void insert(T value) {
-        root = insertHelper(root, value);
+    bool insert(T value) {
+        bool inserted = false;
+        root = insertHelper(root, value, inserted);
+        return inserted;
     }
     
     /**
-     * Display tree in sorted order
+     * Insert, rotation and search counters
+     * All zero unless built with SNAZZYDEETS_STATS
      */
-    void inorder() {
-        inorderHelper(root);
-        cout << endl;
+    instrumentation::TreeStats stats() const {
+#ifdef SNAZZYDEETS_STATS
+        return counters;
+#else
+        return instrumentation::TreeStats{};
+#endif
+    }
+    
+    void resetStats() {
+#ifdef SNAZZYDEETS_STATS
+        counters = instrumentation::TreeStats{};
+#endif
     }
     
     /**
-     * Display AVL tree structure in ASCII format with heights
+     * Remove a value from AVL tree
+     * Time Complexity: O(log n)
+     * @return false if the value was not present
      */
-    void display(bool use_color = false) {
-        cout << "AVL Tree Structure (with heights):\n";
-        displayHelper(root, "", true, use_color);
+    bool erase(const T& value) {
+        bool erased = false;
+        root = eraseHelper(root, value, erased);
+        return erased;
     }
-
-     /**
-     * Get height of a specific node
-     * Returns nullopt if node not found
-     * Time Complexity: O(log n)
+    
+    /**
+     * Replace the contents with the values of a strictly ascending array
+     * Time Complexity: O(n)
      *
-     * @throws runtime_error if tree is empty
+     * @throws invalid_argument if the input is not strictly ascending
      */
-    int getNodeHeight(T value) {
+    void buildFromSorted(const vector<T>& sorted) {
+        for (size_t i = 1; i < sorted.size(); i++) {
+            if (!(sorted[i - 1] < sorted[i])) {
+                throw invalid_argument("buildFromSorted requires strictly ascending keys");
+            }
+        }
+        clear();
+        root = buildHelper(sorted, 0, sorted.size());
+    }
+    
+    /**
+     * Value with the given 0-based rank in sorted order
+     * Time Complexity: O(log n)
+     *
+     * @throws out_of_range if k >= size()
+     */
+    const T& kth(size_t k) const {
+        if (k >= size()) {
+            throw out_of_range("AVL tree rank out of range");
+        }
+        const AVLNode<T>* node = root;
+        while (true) {
+            size_t leftSize = getSize(node->left);
+            if (k < leftSize) {
+                node = node->left;
+            } else if (k == leftSize) {
+                return node->data;
+            } else {
+                k -= leftSize + 1;
+                node = node->right;
+            }
+        }
+    }
+    
+    /**
+     * Number of values strictly less than value
+     * Time Complexity: O(log n)
+     */
+    size_t rank(const T& value) const {
+        size_t count = 0;
+        for (const AVLNode<T>* node = root; node;) {
+            if (node->data < value) {
+                count += getSize(node->left) + 1;
+                node = node->right;
+            } else {
+                node = node->left;
+            }
+        }
+        return count;
+    }
+    
+    /**
+     * Number of values in the closed range [lo, hi]
+     * Time Complexity: O(log n)
+     */
+    size_t countInRange(const T& lo, const T& hi) const {
+        if (hi < lo) return 0;
+        size_t notAbove = 0; // values <= hi
+        for (const AVLNode<T>* node = root; node;) {
+            if (hi < node->data) {
+                node = node->left;
+            } else {
+                notAbove += getSize(node->left) + 1;
+                node = node->right;
+            }
+        }
+        return notAbove - rank(lo);
+    }
+    
+    /**
+     * Move every value >= key into a new tree and return it
+     * Time Complexity: O(log n)
+     */
+    AVLTree split(const T& key) {
+        auto [lo, hi] = splitHelper(root, key);
+        root = lo;
+        AVLTree upper(pool.resource());
+        upper.root = hi;
+        upper.pool.share(pool, getSize(hi));
+        return upper;
+    }
+    
+    /**
+     * Append every value of other, which must all be greater than ours
+     * other is left empty
+     * Time Complexity: O(log n + log m)
+     *
+     * @throws invalid_argument if the key ranges overlap
+     */
+    void join(AVLTree&& other) {
+        if (&other == this || other.root == nullptr) return;
+        if (root != nullptr) {
+            const AVLNode<T>* maxNode = root;
+            while (maxNode->right) maxNode = maxNode->right;
+            const AVLNode<T>* minNode = other.root;
+            while (minNode->left) minNode = minNode->left;
+            if (!(maxNode->data < minNode->data)) {
+                throw invalid_argument("join requires every key of other to be greater");
+            }
+        }
+        AVLNode<T>* mid;
+        AVLNode<T>* rest = other.detachMin(other.root, mid);
+        root = joinHelper(root, mid, rest);
+        other.root = nullptr;
+        pool.adopt(other.pool);
+    }
+    
+    size_t size() const { return getSize(root); }
+    bool empty() const { return root == nullptr; }
+    
+    const_iterator begin() const {
+        const_iterator it;
+        it.pushLeftSpine(root);
+        return it;
+    }
+    
+    const_iterator end() const { return const_iterator(); }
+    
+    /**
+     * Iterator to the first value >= value
+     * Time Complexity: O(log n)
+     */
+    const_iterator lowerBound(const T& value) const {
+        const_iterator it;
+        for (const AVLNode<T>* node = root; node;) {
+            if (node->data < value) {
+                node = node->right;
+            } else {
+                it.path.push_back(node);
+                node = node->left;
+            }
+        }
+        return it;
+    }
+    
+    /**
+     * Display tree in sorted order
+     */
+    void inorder() {
+        inorderHelper(root);
+        cout << endl;
+    }
+    
+    /**
+     * Display AVL tree structure in ASCII format with heights
+     */
+    void display(bool use_color = false) {
+        displayTo(cout, use_color);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w << "AVL Tree Structure (with heights):\n";
+        string prefix;
+        displayHelper(w, root, prefix, true);
+    }
+
+    /**
+     * Graphviz DOT digraph of the tree, children labelled L and R
+     */
+    void exportDOT(output::Target target) const {
+        output::Writer w(std::move(target));
+        output::binaryTreeDOT(w, "AVL", root, nullptr,
+            [](const AVLNode<T>* node) { return node->left; },
+            [](const AVLNode<T>* node) { return node->right; },
+            [](output::Writer& out, const AVLNode<T>* node) {
+                out << "label=";
+                output::writeDOTId(out, node->data);
+            });
+    }
+
+    /**
+     * Nested JSON: {"value": v, "height": h, "left": subtree|null, "right": subtree|null}
+     */
+    void exportJSON(output::Target target) const {
+        output::Writer w(std::move(target));
+        output::binaryTreeJSON(w, root, nullptr,
+            [](const AVLNode<T>* node) { return node->left; },
+            [](const AVLNode<T>* node) { return node->right; },
+            [](output::Writer& out, const AVLNode<T>* node) {
+                out << "\"value\":";
+                output::writeJSONValue(out, node->data);
+                out << ",\"height\":" << node->height;
+            });
+    }
+
+     /**
+     * Get height of a specific node
+     * Returns nullopt if node not found
+     * Time Complexity: O(log n)
+     *
+     * @throws runtime_error if tree is empty
+     */
+    int getNodeHeight(T value) {
         if (root == nullptr) {
             throw runtime_error("Cannot get height from empty tree");
         }
@@ -540,32 +1258,25 @@ private:
     /**
      * Helper to display AVL tree with height information
      */
-    void displayHelper(AVLNode<T>* node, string prefix, bool isRight, bool use_color) {
+    void displayHelper(output::Writer& w, const AVLNode<T>* node, string& prefix, bool isRight) const {
         if (node == nullptr) return;
 
-        cout << prefix;
-        if (isRight) {
-            cprint(use_color, "|-- ", BRIGHT_GREEN);
-        } else {
-            cprint(use_color, "`-- ", BRIGHT_GREEN);
-        }
-        cprint(use_color, "(", BRIGHT_YELLOW);
-        cprint(use_color, node->data, BRIGHT_BLUE);
-        cprint(use_color, ")", BRIGHT_YELLOW);
-        cprint(use_color, "[", BRIGHT_YELLOW);
-        cprint(use_color, "h=", BRIGHT_WHITE);
-        cprint(use_color, node->height, BRIGHT_CYAN);
-        cprint(use_color, "]", BRIGHT_YELLOW);
-        cout << endl;
+        w << prefix;
+        w.paint(isRight ? "|-- " : "`-- ", BRIGHT_GREEN);
+        w.paint("(", BRIGHT_YELLOW);
+        w.paint(node->data, BRIGHT_BLUE);
+        w.paint(")", BRIGHT_YELLOW);
+        w.paint("[", BRIGHT_YELLOW);
+        w.paint("h=", BRIGHT_WHITE);
+        w.paint(node->height, BRIGHT_CYAN);
+        w.paint("]", BRIGHT_YELLOW);
+        w << '\n';
 
-        if (node->left != nullptr || node->right != nullptr) {
-            if (node->right != nullptr) {
-                displayHelper(node->right, prefix + (isRight ? "|   " : "    "), true, use_color);
-            }
-            if (node->left != nullptr) {
-                displayHelper(node->left, prefix + (isRight ? "|   " : "    "), false, use_color);
-            }
-        }
+        size_t length = prefix.size();
+        prefix += isRight ? "|   " : "    ";
+        displayHelper(w, node->right, prefix, true);
+        displayHelper(w, node->left, prefix, false);
+        prefix.resize(length);
     }
 };
 
@@ -574,75 +1285,476 @@ private:
 // ============================================================================
 
 /**
- * Node class for B-Tree
+ * Node class for B+ Tree
+ * Internal nodes hold separator keys and keys.size() + 1 children; every
+ * key lives in a leaf, and leaves are chained left to right through next.
+ * Key (and child) storage is reserved once at the node's maximum size so
+ * a node never reallocates.
  */
 template<typename T>
 class BTreeNode {
 public:
     vector<T> keys;
     vector<BTreeNode*> children;
+    BTreeNode* next; // Right sibling (leaves only)
     bool isLeaf;
     int minDegree; // Minimum degree (t)
     
-    BTreeNode(int t, bool leaf) : isLeaf(leaf), minDegree(t) {}
+    BTreeNode(int t, bool leaf) : next(nullptr), isLeaf(leaf), minDegree(t) {
+        keys.reserve(2 * t); // 2t - 1 keys plus one overflow slot before a split
+        if (!leaf) children.reserve(2 * t + 1);
+    }
     
     /**
-     * Search for a key in this node
+     * Index of the child whose subtree may contain key
+     * Child i holds keys in [keys[i - 1], keys[i]), found by binary search
      */
-    bool search(T key) {
-        int i = 0;
-        while (i < keys.size() && key > keys[i]) {
-            i++;
-        }
-        
-        if (i < keys.size() && keys[i] == key) {
-            return true;
-        }
-        
-        if (isLeaf) {
-            return false;
+    size_t childIndex(const T& key) const {
+        return upper_bound(keys.begin(), keys.end(), key) - keys.begin();
+    }
+    
+    /**
+     * Search for a key in this node's subtree
+     */
+    bool search(const T& key) const {
+        const BTreeNode* node = this;
+        while (!node->isLeaf) {
+            node = node->children[node->childIndex(key)];
         }
-        
-        return children[i]->search(key);
+        return binary_search(node->keys.begin(), node->keys.end(), key);
     }
 };
 
 /**
- * B-Tree implementation
+ * B+ Tree implementation
  * Properties: Balanced tree with multiple keys per node
- * All leaves at same level
+ * All leaves at same level; all keys stored in linked leaves
+ * Non-root nodes hold between t-1 and 2t-1 keys
  */
 template<typename T>
 class BTree {
 private:
     BTreeNode<T>* root;
     int minDegree; // Minimum degree
+    size_t keyCount;
+    NodePool<BTreeNode<T>> pool;
+    
+    // Default node footprint when no degree is given: a handful of cache
+    // lines of keys per node keeps the tree shallow without long scans
+    static constexpr size_t NODE_BYTES = 512;
+    
+    int maxKeys() const { return 2 * minDegree - 1; }
+    int minKeys() const { return minDegree - 1; }
+    
+    /**
+     * Leftmost leaf of the tree
+     */
+    BTreeNode<T>* firstLeaf() const {
+        BTreeNode<T>* node = root;
+        while (node && !node->isLeaf) node = node->children.front();
+        return node;
+    }
+    
+    /**
+     * Split the overfull child at index i of parent
+     * A leaf keeps its left half and copies the right half's first key up;
+     * an internal node moves its middle key up
+     */
+    void splitChild(BTreeNode<T>* parent, size_t i) {
+        BTreeNode<T>* left = parent->children[i];
+        BTreeNode<T>* right = pool.create(minDegree, left->isLeaf);
+        size_t mid = left->keys.size() / 2;
+        T separator = left->keys[mid];
+        
+        if (left->isLeaf) {
+            right->keys.assign(make_move_iterator(left->keys.begin() + mid),
+                               make_move_iterator(left->keys.end()));
+            left->keys.resize(mid);
+            right->next = left->next;
+            left->next = right;
+        } else {
+            right->keys.assign(make_move_iterator(left->keys.begin() + mid + 1),
+                               make_move_iterator(left->keys.end()));
+            right->children.assign(left->children.begin() + mid + 1, left->children.end());
+            left->keys.resize(mid);
+            left->children.resize(mid + 1);
+        }
+        
+        parent->keys.insert(parent->keys.begin() + i, std::move(separator));
+        parent->children.insert(parent->children.begin() + i + 1, right);
+    }
+    
+    /**
+     * Restore the minimum fill of parent's child at index i by borrowing a
+     * key from a sibling, or merging with one when both are at minimum
+     */
+    void fixUnderflow(BTreeNode<T>* parent, size_t i) {
+        BTreeNode<T>* node = parent->children[i];
+        BTreeNode<T>* left = i > 0 ? parent->children[i - 1] : nullptr;
+        BTreeNode<T>* right = i + 1 < parent->children.size() ? parent->children[i + 1] : nullptr;
+        
+        if (left && static_cast<int>(left->keys.size()) > minKeys()) {
+            if (node->isLeaf) {
+                node->keys.insert(node->keys.begin(), std::move(left->keys.back()));
+                left->keys.pop_back();
+                parent->keys[i - 1] = node->keys.front();
+            } else {
+                node->keys.insert(node->keys.begin(), std::move(parent->keys[i - 1]));
+                node->children.insert(node->children.begin(), left->children.back());
+                parent->keys[i - 1] = std::move(left->keys.back());
+                left->keys.pop_back();
+                left->children.pop_back();
+            }
+            return;
+        }
+        if (right && static_cast<int>(right->keys.size()) > minKeys()) {
+            if (node->isLeaf) {
+                node->keys.push_back(std::move(right->keys.front()));
+                right->keys.erase(right->keys.begin());
+                parent->keys[i] = right->keys.front();
+            } else {
+                node->keys.push_back(std::move(parent->keys[i]));
+                node->children.push_back(right->children.front());
+                parent->keys[i] = std::move(right->keys.front());
+                right->keys.erase(right->keys.begin());
+                right->children.erase(right->children.begin());
+            }
+            return;
+        }
+        
+        // Merge the pair (i - 1, i) or (i, i + 1) into its left node
+        size_t leftIndex = left ? i - 1 : i;
+        BTreeNode<T>* into = parent->children[leftIndex];
+        BTreeNode<T>* from = parent->children[leftIndex + 1];
+        if (!into->isLeaf) {
+            into->keys.push_back(std::move(parent->keys[leftIndex]));
+            into->children.insert(into->children.end(), from->children.begin(), from->children.end());
+        } else {
+            into->next = from->next;
+        }
+        into->keys.insert(into->keys.end(), make_move_iterator(from->keys.begin()),
+                          make_move_iterator(from->keys.end()));
+        from->children.clear();
+        pool.destroy(from);
+        parent->keys.erase(parent->keys.begin() + leftIndex);
+        parent->children.erase(parent->children.begin() + leftIndex + 1);
+    }
     
 public:
+    /**
+     * Forward iterator over keys in ascending order, walking the leaf chain
+     */
+    class const_iterator {
+        const BTreeNode<T>* leaf;
+        size_t index;
+        
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        const_iterator(const BTreeNode<T>* node = nullptr, size_t i = 0) : leaf(node), index(i) {
+            // Step past the end of a leaf onto the first key of the next one
+            while (leaf && index >= leaf->keys.size()) {
+                leaf = leaf->next;
+                index = 0;
+            }
+        }
+        
+        const T& operator*() const { return leaf->keys[index]; }
+        const T* operator->() const { return &leaf->keys[index]; }
+        
+        const_iterator& operator++() {
+            if (++index >= leaf->keys.size()) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+        
+        bool operator==(const const_iterator& other) const {
+            return leaf == other.leaf && index == other.index;
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+    
     /**
      * Constructor
-     * @param t Minimum degree (defines range of keys)
+     * @param t Minimum degree (defines range of keys), at least 2;
+     *          0 sizes nodes to roughly NODE_BYTES of keys
+     * @param resource Memory resource the node slabs are drawn from
      */
-    BTree(int t) : root(nullptr), minDegree(t) {}
+    BTree(int t = 0, pmr::memory_resource* resource = pmr::get_default_resource())
+        : root(nullptr), minDegree(t), keyCount(0), pool(resource) {
+        if (minDegree == 0) {
+            minDegree = static_cast<int>(max<size_t>(2, NODE_BYTES / sizeof(T) / 2));
+        }
+        if (minDegree < 2) {
+            throw invalid_argument("B-Tree minimum degree must be at least 2");
+        }
+    }
+    
+    BTree(const BTree&) = delete;
+    BTree& operator=(const BTree&) = delete;
+    
+    BTree(BTree&& other) noexcept
+        : root(other.root), minDegree(other.minDegree), keyCount(other.keyCount),
+          pool(std::move(other.pool)) {
+        other.root = nullptr;
+        other.keyCount = 0;
+    }
+    
+    BTree& operator=(BTree&& other) noexcept {
+        if (this != &other) {
+            clear();
+            root = exchange(other.root, nullptr);
+            minDegree = other.minDegree;
+            keyCount = exchange(other.keyCount, 0);
+            pool = std::move(other.pool);
+        }
+        return *this;
+    }
+    
+    ~BTree() { clear(); }
     
     /**
      * Search for a key in the B-Tree
      * Time Complexity: O(log n)
      */
-    bool search(T key) {
+    bool search(T key) const {
         return root ? root->search(key) : false;
     }
     
     /**
-     * Insert a key into the B-Tree
-     * Note: Full implementation requires split operations
+     * Insert a key into the B-Tree, splitting full nodes on the way back up
+     * Time Complexity: O(log n)
+     * @return false if the key was already present
      */
-    void insert(T key) {
+    bool insert(T key) {
         if (root == nullptr) {
-            root = new BTreeNode<T>(minDegree, true);
-            root->keys.push_back(key);
+            root = pool.create(minDegree, true);
+        }
+        
+        vector<pair<BTreeNode<T>*, size_t>> path;
+        BTreeNode<T>* node = root;
+        while (!node->isLeaf) {
+            size_t i = node->childIndex(key);
+            path.push_back({node, i});
+            node = node->children[i];
+        }
+        
+        auto pos = lower_bound(node->keys.begin(), node->keys.end(), key);
+        if (pos != node->keys.end() && *pos == key) return false;
+        node->keys.insert(pos, std::move(key));
+        keyCount++;
+        
+        while (static_cast<int>(node->keys.size()) > maxKeys()) {
+            if (path.empty()) {
+                BTreeNode<T>* newRoot = pool.create(minDegree, false);
+                newRoot->children.push_back(root);
+                root = newRoot;
+                path.push_back({root, 0});
+            }
+            auto [parent, i] = path.back();
+            path.pop_back();
+            splitChild(parent, i);
+            node = parent;
+        }
+        return true;
+    }
+    
+    /**
+     * Erase a key, borrowing from or merging with siblings on underflow
+     * Time Complexity: O(log n)
+     * @return false if the key was not present
+     */
+    bool erase(const T& key) {
+        if (root == nullptr) return false;
+        
+        vector<pair<BTreeNode<T>*, size_t>> path;
+        BTreeNode<T>* node = root;
+        while (!node->isLeaf) {
+            size_t i = node->childIndex(key);
+            path.push_back({node, i});
+            node = node->children[i];
+        }
+        
+        auto pos = lower_bound(node->keys.begin(), node->keys.end(), key);
+        if (pos == node->keys.end() || !(*pos == key)) return false;
+        node->keys.erase(pos);
+        keyCount--;
+        
+        while (!path.empty() && static_cast<int>(node->keys.size()) < minKeys()) {
+            auto [parent, i] = path.back();
+            path.pop_back();
+            fixUnderflow(parent, i);
+            node = parent;
+        }
+        
+        if (!root->isLeaf && root->keys.empty()) {
+            BTreeNode<T>* oldRoot = root;
+            root = root->children.front();
+            oldRoot->children.clear();
+            pool.destroy(oldRoot);
+        } else if (root->isLeaf && root->keys.empty()) {
+            pool.destroy(root);
+            root = nullptr;
+        }
+        return true;
+    }
+    
+    /**
+     * Replace the contents with keys from strictly ascending input
+     * Leaves and internal levels are packed bottom-up, evenly filled
+     * Time Complexity: O(n)
+     * @throws invalid_argument if input is not strictly ascending
+     */
+    void buildFromSorted(const vector<T>& sorted) {
+        for (size_t i = 1; i < sorted.size(); i++) {
+            if (!(sorted[i - 1] < sorted[i])) {
+                throw invalid_argument("buildFromSorted requires strictly ascending keys");
+            }
+        }
+        clear();
+        if (sorted.empty()) return;
+        
+        // Split count items into the fewest groups of at most cap, as evenly
+        // as possible, so every group except a lone root meets the minimum
+        auto groupSizes = [](size_t count, size_t cap) {
+            size_t groups = (count + cap - 1) / cap;
+            vector<size_t> sizes(groups, count / groups);
+            for (size_t g = 0; g < count % groups; g++) sizes[g]++;
+            return sizes;
+        };
+        
+        vector<BTreeNode<T>*> level;
+        vector<T> lowKeys; // smallest key under each node of the level
+        size_t offset = 0;
+        BTreeNode<T>* prevLeaf = nullptr;
+        for (size_t len : groupSizes(sorted.size(), maxKeys())) {
+            BTreeNode<T>* leaf = pool.create(minDegree, true);
+            leaf->keys.assign(sorted.begin() + offset, sorted.begin() + offset + len);
+            if (prevLeaf) prevLeaf->next = leaf;
+            prevLeaf = leaf;
+            level.push_back(leaf);
+            lowKeys.push_back(sorted[offset]);
+            offset += len;
+        }
+        
+        while (level.size() > 1) {
+            vector<BTreeNode<T>*> parents;
+            vector<T> parentLows;
+            offset = 0;
+            for (size_t len : groupSizes(level.size(), maxKeys() + 1)) {
+                BTreeNode<T>* parent = pool.create(minDegree, false);
+                for (size_t c = offset; c < offset + len; c++) {
+                    if (c > offset) parent->keys.push_back(lowKeys[c]);
+                    parent->children.push_back(level[c]);
+                }
+                parents.push_back(parent);
+                parentLows.push_back(lowKeys[offset]);
+                offset += len;
+            }
+            level.swap(parents);
+            lowKeys.swap(parentLows);
+        }
+        root = level.front();
+        keyCount = sorted.size();
+    }
+    
+    /**
+     * Iterators over all keys in ascending order
+     */
+    const_iterator begin() const { return const_iterator(firstLeaf(), 0); }
+    const_iterator end() const { return const_iterator(); }
+    
+    /**
+     * Iterator to the first key not less than key
+     * Time Complexity: O(log n)
+     */
+    const_iterator lowerBound(const T& key) const {
+        if (root == nullptr) return end();
+        const BTreeNode<T>* node = root;
+        while (!node->isLeaf) {
+            node = node->children[node->childIndex(key)];
+        }
+        size_t i = lower_bound(node->keys.begin(), node->keys.end(), key) - node->keys.begin();
+        return const_iterator(node, i);
+    }
+    
+    /**
+     * Collect all keys in [low, high] in ascending order
+     * Time Complexity: O(log n + k) for k results
+     */
+    vector<T> rangeScan(const T& low, const T& high) const {
+        vector<T> result;
+        for (auto it = lowerBound(low); it != end() && !(high < *it); ++it) {
+            result.push_back(*it);
+        }
+        return result;
+    }
+    
+    /**
+     * Remove all keys, releasing the node slabs in one step
+     */
+    void clear() {
+        pool.destroyAll(root, [](BTreeNode<T>* node, auto visit) {
+            for (BTreeNode<T>* child : node->children) visit(child);
+        });
+        pool.release();
+        root = nullptr;
+        keyCount = 0;
+    }
+    
+    size_t size() const { return keyCount; }
+    bool empty() const { return keyCount == 0; }
+    int getMinDegree() const { return minDegree; }
+    
+    /**
+     * Number of levels, 0 for an empty tree
+     */
+    int getTreeHeight() const {
+        int height = 0;
+        for (const BTreeNode<T>* node = root; node; node = node->isLeaf ? nullptr : node->children.front()) {
+            height++;
+        }
+        return height;
+    }
+    
+    /**
+     * Display all keys in sorted order
+     */
+    void inorder() const {
+        for (const T& key : *this) cout << key << " ";
+        cout << endl;
+    }
+    
+    /**
+     * Display B+ tree level by level, one bracketed group per node
+     */
+    void display(bool use_color = false) const {
+        cout << "B+ Tree Structure (t=" << minDegree << ", " << keyCount << " keys):\n";
+        vector<const BTreeNode<T>*> level;
+        if (root) level.push_back(root);
+        for (int depth = 0; !level.empty(); depth++) {
+            cprint(use_color, "Level ", BRIGHT_WHITE);
+            cprint(use_color, depth, BRIGHT_CYAN);
+            cprint(use_color, ": ", BRIGHT_WHITE);
+            vector<const BTreeNode<T>*> below;
+            for (const BTreeNode<T>* node : level) {
+                cprint(use_color, "[", BRIGHT_YELLOW);
+                for (size_t i = 0; i < node->keys.size(); i++) {
+                    if (i > 0) cout << " ";
+                    cprint(use_color, node->keys[i], node->isLeaf ? BRIGHT_BLUE : BRIGHT_GREEN);
+                }
+                cprint(use_color, "] ", BRIGHT_YELLOW);
+                below.insert(below.end(), node->children.begin(), node->children.end());
+            }
+            cout << endl;
+            level.swap(below);
         }
-        // Full insertion logic with node splitting omitted for brevity
     }
 };
 
@@ -663,9 +1775,11 @@ public:
     RBNode* right;
     RBNode* parent;
     Color color;
+    int size;   // nodes in this subtree, for order statistics
+    int height; // longest path to a leaf, counted in nodes
     
     RBNode(T value) : data(value), left(nullptr), right(nullptr), 
-                      parent(nullptr), color(_RED) {}
+                      parent(nullptr), color(_RED), size(1), height(1) {}
 };
 
 /**
@@ -676,17 +1790,72 @@ public:
  * 3. All leaves (NULL) are black
  * 4. Red nodes have black children
  * 5. All paths from node to leaves have same number of black nodes
+ * Every node also stores its subtree size and height, so rank, select and
+ * getTreeHeight() are O(log n) or better. Duplicate values are kept.
  */
 template<typename T>
 class RedBlackTree {
 private:
     RBNode<T>* root;
     RBNode<T>* NIL; // Sentinel node
+    NodePool<RBNode<T>> pool;
+    [[no_unique_address]] mutable instrumentation::Slot<instrumentation::TreeStats> counters;
+    
+    /**
+     * A standalone subtree and its black height (black nodes on any path
+     * from its root down to NIL, NIL excluded)
+     */
+    struct Piece {
+        RBNode<T>* root;
+        int blackHeight;
+    };
+    
+    /**
+     * Sentinel shared by every tree of this type
+     * It is never written to, so nodes can move between trees on split/join
+     */
+    static RBNode<T>* sentinel() {
+        static RBNode<T> nil = [] {
+            RBNode<T> node{T()};
+            node.color = _BLACK;
+            node.size = 0;
+            node.height = 0;
+            return node;
+        }();
+        return &nil;
+    }
+    
+    /**
+     * Run node destructors ahead of pool.release()
+     */
+    void destroyNodes() {
+        RBNode<T>* nil = NIL;
+        pool.destroyAll(root == NIL ? nullptr : root, [nil](RBNode<T>* node, auto visit) {
+            if (node->left != nil) visit(node->left);
+            if (node->right != nil) visit(node->right);
+        });
+    }
+    
+    /**
+     * Recompute size and height from the children
+     */
+    static void pull(RBNode<T>* node) {
+        node->size = node->left->size + node->right->size + 1;
+        node->height = max(node->left->height, node->right->height) + 1;
+    }
+    
+    /**
+     * Refresh size and height from node up to the root
+     */
+    void pullToRoot(RBNode<T>* node) {
+        for (; node != nullptr; node = node->parent) pull(node);
+    }
     
     /**
      * Left rotation
      */
     void leftRotate(RBNode<T>* x) {
+        SNAZZYDEETS_STAT(counters.rotations.add());
         RBNode<T>* y = x->right;
         x->right = y->left;
         
@@ -706,12 +1875,16 @@ private:
         
         y->left = x;
         x->parent = y;
+        
+        pull(x);
+        pull(y);
     }
     
     /**
      * Right rotation
      */
     void rightRotate(RBNode<T>* y) {
+        SNAZZYDEETS_STAT(counters.rotations.add());
         RBNode<T>* x = y->left;
         y->left = x->right;
         
@@ -731,12 +1904,16 @@ private:
         
         x->right = y;
         y->parent = x;
+        
+        pull(y);
+        pull(x);
     }
     
     /**
      * Fix violations after insertion
+     * @return true if the root was recolored from red, growing the black height
      */
-    void fixInsert(RBNode<T>* k) {
+    bool fixInsert(RBNode<T>* k) {
         while (k->parent && k->parent->color == _RED) {
             if (k->parent == k->parent->parent->left) {
                 RBNode<T>* u = k->parent->parent->right;
@@ -756,74 +1933,584 @@ private:
                     rightRotate(k->parent->parent);
                 }
             } else {
-                RBNode<T>* u = k->parent->parent->left;
-                
-                if (u && u->color == _RED) {
-                    k->parent->color = _BLACK;
-                    u->color = _BLACK;
-                    k->parent->parent->color = _RED;
-                    k = k->parent->parent;
-                } else {
-                    if (k == k->parent->left) {
-                        k = k->parent;
-                        rightRotate(k);
-                    }
-                    k->parent->color = _BLACK;
-                    k->parent->parent->color = _RED;
-                    leftRotate(k->parent->parent);
-                }
+                RBNode<T>* u = k->parent->parent->left;
+                
+                if (u && u->color == _RED) {
+                    k->parent->color = _BLACK;
+                    u->color = _BLACK;
+                    k->parent->parent->color = _RED;
+                    k = k->parent->parent;
+                } else {
+                    if (k == k->parent->left) {
+                        k = k->parent;
+                        rightRotate(k);
+                    }
+                    k->parent->color = _BLACK;
+                    k->parent->parent->color = _RED;
+                    leftRotate(k->parent->parent);
+                }
+            }
+        }
+        bool grew = root->color == _RED;
+        root->color = _BLACK;
+        return grew;
+    }
+    
+    /**
+     * Helper for insertion
+     */
+    void insertHelper(RBNode<T>* node) {
+        RBNode<T>* y = nullptr;
+        RBNode<T>* x = root;
+        
+        while (x != NIL && x != nullptr) {
+            y = x;
+            if (node->data < x->data) {
+                x = x->left;
+            } else {
+                x = x->right;
+            }
+        }
+        
+        node->parent = y;
+        
+        if (y == nullptr) {
+            root = node;
+        } else if (node->data < y->data) {
+            y->left = node;
+        } else {
+            y->right = node;
+        }
+        
+        node->left = NIL;
+        node->right = NIL;
+        node->color = _RED;
+        
+        fixInsert(node);
+        pullToRoot(y);
+    }
+    
+    /**
+     * Put subtree v where subtree u hangs
+     */
+    void transplant(RBNode<T>* u, RBNode<T>* v) {
+        if (u->parent == nullptr) {
+            root = v;
+        } else if (u == u->parent->left) {
+            u->parent->left = v;
+        } else {
+            u->parent->right = v;
+        }
+        if (v != NIL) v->parent = u->parent;
+    }
+    
+    /**
+     * Fix violations after removing a black node
+     * x may be NIL, so its parent is tracked separately; the shared sentinel
+     * is never written
+     */
+    void fixErase(RBNode<T>* x, RBNode<T>* xParent) {
+        while (x != root && x->color == _BLACK) {
+            if (x == xParent->left) {
+                RBNode<T>* w = xParent->right;
+                if (w->color == _RED) {
+                    w->color = _BLACK;
+                    xParent->color = _RED;
+                    leftRotate(xParent);
+                    w = xParent->right;
+                }
+                if (w->left->color == _BLACK && w->right->color == _BLACK) {
+                    w->color = _RED;
+                    x = xParent;
+                    xParent = x->parent;
+                } else {
+                    if (w->right->color == _BLACK) {
+                        w->left->color = _BLACK;
+                        w->color = _RED;
+                        rightRotate(w);
+                        w = xParent->right;
+                    }
+                    w->color = xParent->color;
+                    xParent->color = _BLACK;
+                    w->right->color = _BLACK;
+                    leftRotate(xParent);
+                    x = root;
+                }
+            } else {
+                RBNode<T>* w = xParent->left;
+                if (w->color == _RED) {
+                    w->color = _BLACK;
+                    xParent->color = _RED;
+                    rightRotate(xParent);
+                    w = xParent->left;
+                }
+                if (w->left->color == _BLACK && w->right->color == _BLACK) {
+                    w->color = _RED;
+                    x = xParent;
+                    xParent = x->parent;
+                } else {
+                    if (w->left->color == _BLACK) {
+                        w->right->color = _BLACK;
+                        w->color = _RED;
+                        leftRotate(w);
+                        w = xParent->left;
+                    }
+                    w->color = xParent->color;
+                    xParent->color = _BLACK;
+                    w->left->color = _BLACK;
+                    rightRotate(xParent);
+                    x = root;
+                }
+            }
+        }
+        if (x != NIL) x->color = _BLACK;
+    }
+    
+    /**
+     * Unlink node z from the tree without destroying it
+     */
+    void unlinkNode(RBNode<T>* z) {
+        RBNode<T>* x;
+        RBNode<T>* xParent;
+        Color removedColor = z->color;
+        
+        if (z->left == NIL) {
+            x = z->right;
+            xParent = z->parent;
+            transplant(z, z->right);
+        } else if (z->right == NIL) {
+            x = z->left;
+            xParent = z->parent;
+            transplant(z, z->left);
+        } else {
+            RBNode<T>* y = z->right;
+            while (y->left != NIL) y = y->left;
+            removedColor = y->color;
+            x = y->right;
+            if (y->parent == z) {
+                xParent = y;
+            } else {
+                xParent = y->parent;
+                transplant(y, y->right);
+                y->right = z->right;
+                y->right->parent = y;
+            }
+            transplant(z, y);
+            y->left = z->left;
+            y->left->parent = y;
+            y->color = z->color;
+        }
+        
+        if (removedColor == _BLACK) fixErase(x, xParent);
+        pullToRoot(xParent);
+    }
+    
+    /**
+     * Locate a node holding value, or nullptr
+     */
+    RBNode<T>* findNode(const T& value) const {
+        RBNode<T>* node = root;
+        while (node != NIL) {
+            if (value < node->data) {
+                node = node->left;
+            } else if (node->data < value) {
+                node = node->right;
+            } else {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+    
+    /**
+     * Black height of the whole tree, walking the left spine
+     */
+    int blackHeight() const {
+        int height = 0;
+        for (RBNode<T>* node = root; node != NIL; node = node->left) {
+            if (node->color == _BLACK) height++;
+        }
+        return height;
+    }
+    
+    /**
+     * Turn a child subtree into a standalone tree with a black root
+     * @param blackHeight: Black height of the subtree as it hung in the tree
+     */
+    Piece detach(RBNode<T>* node, int blackHeight) {
+        if (node == NIL) return {NIL, 0};
+        node->parent = nullptr;
+        if (node->color == _RED) {
+            node->color = _BLACK;
+            blackHeight++;
+        }
+        return {node, blackHeight};
+    }
+    
+    /**
+     * Join left < mid < right into one tree
+     * mid is hung on the spine of the taller side beside a black node of
+     * matching black height and then repaired like an ordinary insertion
+     * Uses root as scratch; the caller stores the returned tree
+     * Time Complexity: O(|blackHeight difference| + 1)
+     */
+    Piece joinHelper(Piece left, RBNode<T>* mid, Piece right) {
+        mid->parent = nullptr;
+        if (left.blackHeight == right.blackHeight) {
+            mid->left = left.root;
+            mid->right = right.root;
+            if (left.root != NIL) left.root->parent = mid;
+            if (right.root != NIL) right.root->parent = mid;
+            mid->color = _BLACK;
+            pull(mid);
+            root = mid;
+            return {mid, left.blackHeight + 1};
+        }
+        
+        bool leftTaller = left.blackHeight > right.blackHeight;
+        Piece tall = leftTaller ? left : right;
+        Piece shortSide = leftTaller ? right : left;
+        
+        // Walk the inner spine of the taller tree down to a black node
+        // whose black height matches the shorter tree
+        RBNode<T>* spine = tall.root;
+        RBNode<T>* spineParent = nullptr;
+        int height = tall.blackHeight;
+        while (spine->color == _RED || height > shortSide.blackHeight) {
+            if (spine->color == _BLACK) height--;
+            spineParent = spine;
+            spine = leftTaller ? spine->right : spine->left;
+        }
+        
+        if (leftTaller) {
+            mid->left = spine;
+            mid->right = shortSide.root;
+            spineParent->right = mid;
+        } else {
+            mid->left = shortSide.root;
+            mid->right = spine;
+            spineParent->left = mid;
+        }
+        if (spine != NIL) spine->parent = mid;
+        if (shortSide.root != NIL) shortSide.root->parent = mid;
+        mid->parent = spineParent;
+        mid->color = _RED;
+        pull(mid);
+        
+        root = tall.root;
+        bool grew = fixInsert(mid);
+        pullToRoot(spineParent);
+        return {root, tall.blackHeight + (grew ? 1 : 0)};
+    }
+    
+    /**
+     * Split a standalone subtree into (values < key, values >= key)
+     * Time Complexity: O(log n)
+     */
+    pair<Piece, Piece> splitHelper(Piece piece, const T& key) {
+        RBNode<T>* node = piece.root;
+        if (node == NIL) return {{NIL, 0}, {NIL, 0}};
+        int childHeight = piece.blackHeight - 1; // node is black
+        Piece left = detach(node->left, childHeight);
+        Piece right = detach(node->right, childHeight);
+        if (node->data < key) {
+            auto [lo, hi] = splitHelper(right, key);
+            return {joinHelper(left, node, lo), hi};
+        }
+        auto [lo, hi] = splitHelper(left, key);
+        return {lo, joinHelper(hi, node, right)};
+    }
+    
+    /**
+     * Build a balanced subtree from sorted[lo, hi); nodes on the deepest
+     * level are red so every path has the same black count
+     */
+    RBNode<T>* buildHelper(const vector<T>& sorted, size_t lo, size_t hi, int depth, int redDepth) {
+        if (lo >= hi) return NIL;
+        size_t mid = lo + (hi - lo) / 2;
+        RBNode<T>* node = pool.create(sorted[mid]);
+        node->color = depth == redDepth ? _RED : _BLACK;
+        node->left = buildHelper(sorted, lo, mid, depth + 1, redDepth);
+        node->right = buildHelper(sorted, mid + 1, hi, depth + 1, redDepth);
+        if (node->left != NIL) node->left->parent = node;
+        if (node->right != NIL) node->right->parent = node;
+        pull(node);
+        return node;
+    }
+
+public:
+    /**
+     * In-order iterator
+     * Steps through parent pointers: O(1) amortized per step, no recursion
+     * and no extra space
+     */
+    class const_iterator {
+        const RBNode<T>* node;
+        const RBNode<T>* nil;
+        
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        const_iterator(const RBNode<T>* current = nullptr, const RBNode<T>* sentinel = nullptr)
+            : node(current), nil(sentinel) {}
+        
+        const T& operator*() const { return node->data; }
+        const T* operator->() const { return &node->data; }
+        
+        const_iterator& operator++() {
+            if (node->right != nil) {
+                node = node->right;
+                while (node->left != nil) node = node->left;
+            } else {
+                const RBNode<T>* child = node;
+                node = node->parent;
+                while (node && child == node->right) {
+                    child = node;
+                    node = node->parent;
+                }
+            }
+            return *this;
+        }
+        
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+        
+        bool operator==(const const_iterator& other) const { return node == other.node; }
+        bool operator!=(const const_iterator& other) const { return node != other.node; }
+    };
+    
+    /**
+     * @param resource Memory resource the node slabs are drawn from
+     */
+    explicit RedBlackTree(pmr::memory_resource* resource = pmr::get_default_resource())
+        : root(sentinel()), NIL(sentinel()), pool(resource) {}
+    
+    RedBlackTree(const RedBlackTree&) = delete;
+    RedBlackTree& operator=(const RedBlackTree&) = delete;
+    
+    RedBlackTree(RedBlackTree&& other) noexcept
+        : root(exchange(other.root, sentinel())), NIL(sentinel()), pool(std::move(other.pool)) {}
+    
+    RedBlackTree& operator=(RedBlackTree&& other) noexcept {
+        if (this != &other) {
+            clear();
+            root = exchange(other.root, NIL);
+            pool = std::move(other.pool);
+        }
+        return *this;
+    }
+    
+    ~RedBlackTree() {
+        destroyNodes();
+        pool.release();
+    }
+    
+    /**
+     * Remove all nodes, releasing the node slabs in one step
+     * O(1) per slab when T is trivially destructible
+     */
+    void clear() {
+        destroyNodes();
+        pool.release();
+        root = NIL;
+    }
+    
+    /**
+     * Insert a value into the Red-Black tree
+     * Time Complexity: O(log n)
+     */
+    void insert(T value) {
+        RBNode<T>* node = pool.create(value);
+        SNAZZYDEETS_STAT(counters.inserts.add());
+        insertHelper(node);
+    }
+    
+    /**
+     * Insert, rotation and search counters
+     * All zero unless built with SNAZZYDEETS_STATS
+     */
+    instrumentation::TreeStats stats() const {
+#ifdef SNAZZYDEETS_STATS
+        return counters;
+#else
+        return instrumentation::TreeStats{};
+#endif
+    }
+    
+    void resetStats() {
+#ifdef SNAZZYDEETS_STATS
+        counters = instrumentation::TreeStats{};
+#endif
+    }
+    
+    /**
+     * Remove one occurrence of value
+     * Time Complexity: O(log n)
+     * @return false if the value was not present
+     */
+    bool erase(const T& value) {
+        RBNode<T>* node = findNode(value);
+        if (node == nullptr) return false;
+        unlinkNode(node);
+        pool.destroy(node);
+        return true;
+    }
+    
+    /**
+     * Replace the contents with the values of an ascending array
+     * Time Complexity: O(n)
+     *
+     * @throws invalid_argument if the input is not sorted
+     */
+    void buildFromSorted(const vector<T>& sorted) {
+        for (size_t i = 1; i < sorted.size(); i++) {
+            if (sorted[i] < sorted[i - 1]) {
+                throw invalid_argument("buildFromSorted requires ascending keys");
+            }
+        }
+        clear();
+        if (sorted.empty()) return;
+        // Levels above the deepest one are full, so only it may be ragged
+        int deepest = static_cast<int>(bit_width(sorted.size())) - 1;
+        root = buildHelper(sorted, 0, sorted.size(), 0, deepest == 0 ? -1 : deepest);
+        root->parent = nullptr;
+    }
+    
+    /**
+     * Value with the given 0-based rank in sorted order
+     * Time Complexity: O(log n)
+     *
+     * @throws out_of_range if k >= size()
+     */
+    const T& kth(size_t k) const {
+        if (k >= size()) {
+            throw out_of_range("Red-Black tree rank out of range");
+        }
+        const RBNode<T>* node = root;
+        while (true) {
+            size_t leftSize = node->left->size;
+            if (k < leftSize) {
+                node = node->left;
+            } else if (k == leftSize) {
+                return node->data;
+            } else {
+                k -= leftSize + 1;
+                node = node->right;
             }
         }
-        root->color = _BLACK;
     }
     
     /**
-     * Helper for insertion
+     * Number of values strictly less than value
+     * Time Complexity: O(log n)
      */
-    void insertHelper(RBNode<T>* node) {
-        RBNode<T>* y = nullptr;
-        RBNode<T>* x = root;
-        
-        while (x != NIL && x != nullptr) {
-            y = x;
-            if (node->data < x->data) {
-                x = x->left;
+    size_t rank(const T& value) const {
+        size_t count = 0;
+        for (const RBNode<T>* node = root; node != NIL;) {
+            if (node->data < value) {
+                count += node->left->size + 1;
+                node = node->right;
             } else {
-                x = x->right;
+                node = node->left;
             }
         }
-        
-        node->parent = y;
-        
-        if (y == nullptr) {
-            root = node;
-        } else if (node->data < y->data) {
-            y->left = node;
-        } else {
-            y->right = node;
+        return count;
+    }
+    
+    /**
+     * Number of values in the closed range [lo, hi], duplicates included
+     * Time Complexity: O(log n)
+     */
+    size_t countInRange(const T& lo, const T& hi) const {
+        if (hi < lo) return 0;
+        size_t notAbove = 0; // values <= hi
+        for (const RBNode<T>* node = root; node != NIL;) {
+            if (hi < node->data) {
+                node = node->left;
+            } else {
+                notAbove += node->left->size + 1;
+                node = node->right;
+            }
         }
-        
-        node->left = NIL;
-        node->right = NIL;
-        node->color = _RED;
-        
-        fixInsert(node);
+        return notAbove - rank(lo);
     }
-
-public:
-    RedBlackTree() {
-        NIL = new RBNode<T>(T());
-        NIL->color = _BLACK;
-        root = NIL;
+    
+    /**
+     * Move every value >= key into a new tree and return it
+     * Time Complexity: O(log n)
+     */
+    RedBlackTree split(const T& key) {
+        RedBlackTree upper(pool.resource());
+        if (root == NIL) return upper;
+        auto [lo, hi] = splitHelper({root, blackHeight()}, key);
+        root = lo.root;
+        if (root != NIL) root->parent = nullptr;
+        if (hi.root != NIL) hi.root->parent = nullptr;
+        upper.root = hi.root;
+        upper.pool.share(pool, hi.root->size);
+        return upper;
     }
     
     /**
-     * Insert a value into the Red-Black tree
+     * Append every value of other, which must all be >= ours
+     * other is left empty
+     * Time Complexity: O(log n + log m)
+     *
+     * @throws invalid_argument if the key ranges overlap
+     */
+    void join(RedBlackTree&& other) {
+        if (&other == this || other.root == NIL) return;
+        RBNode<T>* minNode = other.root;
+        while (minNode->left != NIL) minNode = minNode->left;
+        if (root != NIL) {
+            const RBNode<T>* maxNode = root;
+            while (maxNode->right != NIL) maxNode = maxNode->right;
+            if (minNode->data < maxNode->data) {
+                throw invalid_argument("join requires no key of other to be smaller");
+            }
+        }
+        other.unlinkNode(minNode);
+        Piece left{root, blackHeight()};
+        Piece right{other.root, other.blackHeight()};
+        root = joinHelper(left, minNode, right).root;
+        other.root = NIL;
+        pool.adopt(other.pool);
+    }
+    
+    size_t size() const { return root->size; }
+    bool empty() const { return root == NIL; }
+    
+    const_iterator begin() const {
+        const RBNode<T>* node = root;
+        if (node == NIL) return end();
+        while (node->left != NIL) node = node->left;
+        return const_iterator(node, NIL);
+    }
+    
+    const_iterator end() const { return const_iterator(nullptr, NIL); }
+    
+    /**
+     * Iterator to the first value >= value
      * Time Complexity: O(log n)
      */
-    void insert(T value) {
-        RBNode<T>* node = new RBNode<T>(value);
-        insertHelper(node);
+    const_iterator lowerBound(const T& value) const {
+        const RBNode<T>* best = nullptr;
+        for (const RBNode<T>* node = root; node != NIL;) {
+            if (node->data < value) {
+                node = node->right;
+            } else {
+                best = node;
+                node = node->left;
+            }
+        }
+        return const_iterator(best, NIL);
     }
 
     SearchResult search(T value) {
@@ -837,9 +2524,49 @@ public:
      * Display Red-Black tree structure with color coding
      */
     void display() {
-        cout << "Red-Black Tree Structure:\n";
-        cout << "(R) = Red node, (B) = Black node\n";
-        displayHelper(root, "", true);
+        displayTo(cout);
+    }
+
+    /**
+     * display() into any stream or chunk callback, through one buffer
+     */
+    void displayTo(output::Target target, bool use_color = false) const {
+        output::Writer w(std::move(target), use_color);
+        w << "Red-Black Tree Structure:\n(R) = Red node, (B) = Black node\n";
+        string prefix;
+        displayHelper(w, root, prefix, true);
+    }
+
+    /**
+     * Graphviz DOT digraph of the tree, children labelled L and R
+     * Red nodes are filled red, black nodes black
+     */
+    void exportDOT(output::Target target) const {
+        output::Writer w(std::move(target));
+        output::binaryTreeDOT(w, "RedBlack", root, NIL,
+            [](const RBNode<T>* node) { return node->left; },
+            [](const RBNode<T>* node) { return node->right; },
+            [](output::Writer& out, const RBNode<T>* node) {
+                out << "label=";
+                output::writeDOTId(out, node->data);
+                out << (node->color == _RED ? ", style=filled, fillcolor=red, fontcolor=white"
+                                            : ", style=filled, fillcolor=black, fontcolor=white");
+            });
+    }
+
+    /**
+     * Nested JSON: {"value": v, "color": "red"|"black", "left": subtree|null, "right": subtree|null}
+     */
+    void exportJSON(output::Target target) const {
+        output::Writer w(std::move(target));
+        output::binaryTreeJSON(w, root, NIL,
+            [](const RBNode<T>* node) { return node->left; },
+            [](const RBNode<T>* node) { return node->right; },
+            [](output::Writer& out, const RBNode<T>* node) {
+                out << "\"value\":";
+                output::writeJSONValue(out, node->data);
+                out << (node->color == _RED ? ",\"color\":\"red\"" : ",\"color\":\"black\"");
+            });
     }
 
     /**
@@ -872,11 +2599,11 @@ public:
 
     /**
      * Get height of entire tree
-     * Time Complexity: O(n)
+     * Time Complexity: O(1)
      */
     int getTreeHeight() {
         if (root == NIL || root == nullptr) return -1;
-        return calculateHeight(root);
+        return root->height - 1;
     }
     
 private:
@@ -890,7 +2617,7 @@ private:
         
         
         if (node->data == value) {
-            return calculateHeight(node);
+            return node->height - 1;
         }
         
         if (value < node->data) {
@@ -901,10 +2628,12 @@ private:
 
     SearchResult searchHelper(RBNode<T>* node, T value, int level, int position) {
         if (node == nullptr || node == NIL) {
+            SNAZZYDEETS_STAT(counters.recordSearch("RedBlackTree", level - 1));
             return SearchResult();
         }
 
         if (node->data == value) {
+            SNAZZYDEETS_STAT(counters.recordSearch("RedBlackTree", level));
             return SearchResult(level, position);
         }
 
@@ -914,18 +2643,6 @@ private:
         return searchHelper(node->right, value, level + 1, position * 2 + 1);
     }
     
-    /**
-     * Calculate height from a given node
-     */
-    int calculateHeight(RBNode<T>* node) {
-        if (node == nullptr || node == NIL) return -1;
-        
-        int leftHeight = calculateHeight(node->left);
-        int rightHeight = calculateHeight(node->right);
-        
-        return max(leftHeight, rightHeight) + 1;
-    }
-    
     /**
      * Get depth of specific node
      */
@@ -947,23 +2664,20 @@ private:
     /**
      * Helper to display Red-Black tree with colors
      */
-    void displayHelper(RBNode<T>* node, string prefix, bool isRight) {
+    void displayHelper(output::Writer& w, const RBNode<T>* node, string& prefix, bool isRight) const {
         if (node == nullptr || node == NIL) return;
         
-        cout << prefix;
-        cout << (isRight ?  "|-- "  :  "`-- " );
-        cout << "(" << node->data << ")";
-        cout << (node->color == _RED ?  "[R]"  :  "[B]" ) << endl;
+        w << prefix << (isRight ?  "|-- "  :  "`-- " );
+        w << "(" << node->data << ")";
+        if (node->color == _RED) w.paint("[R]", RED);
+        else w.paint("[B]", BRIGHT_BLACK);
+        w << '\n';
         
-        if ((node->left != NIL && node->left != nullptr) || 
-            (node->right != NIL && node->right != nullptr)) {
-            if (node->right != NIL && node->right != nullptr) {
-                displayHelper(node->right, prefix + (isRight ?  "|   "  : "    "), true);
-            }
-            if (node->left != NIL && node->left != nullptr) {
-                displayHelper(node->left, prefix + (isRight ?  "|   "  : "    "), false);
-            }
-        }
+        size_t length = prefix.size();
+        prefix += isRight ?  "|   "  : "    ";
+        displayHelper(w, node->right, prefix, true);
+        displayHelper(w, node->left, prefix, false);
+        prefix.resize(length);
     }
 };
 
@@ -989,10 +2703,29 @@ public:
 class Trie {
 private:
     TrieNode* root;
+    NodePool<TrieNode> pool;
 
 public:
-    Trie() {
-        root = new TrieNode();
+    /**
+     * @param resource Memory resource the node slabs are drawn from
+     */
+    explicit Trie(pmr::memory_resource* resource = pmr::get_default_resource())
+        : pool(resource) {
+        root = pool.create();
+    }
+    
+    ~Trie() {
+        destroyNodes();
+        pool.release();
+    }
+    
+    /**
+     * Remove all words, releasing the node slabs in one step
+     */
+    void clear() {
+        destroyNodes();
+        pool.release();
+        root = pool.create();
     }
     
     /**
@@ -1004,7 +2737,7 @@ public:
         
         for (char ch : word) {
             if (current->children.find(ch) == current->children.end()) {
-                current->children[ch] = new TrieNode();
+                current->children[ch] = pool.create();
             }
             current = current->children[ch];
         }
@@ -1085,6 +2818,60 @@ public:
         
         return true;
     }
+    /**
+     * Stream words starting with prefix, in lexicographic order
+     * Words are assembled in one reused buffer; visit receives a
+     * string_view into it that is only valid during the call
+     * @param limit: Stop after this many words
+     * @return Number of words visited
+     */
+    template<typename Visitor>
+    size_t collectWithPrefix(const string& prefix, size_t limit, Visitor visit) const {
+        TrieNode* current = root;
+        for (char ch : prefix) {
+            auto it = current->children.find(ch);
+            if (it == current->children.end()) return 0;
+            current = it->second;
+        }
+        
+        string buffer = prefix;
+        size_t count = 0;
+        // (node, its character, buffer length before it); the prefix node
+        // carries no character of its own
+        vector<tuple<TrieNode*, char, size_t>> stack{{current, '\0', buffer.size()}};
+        vector<pair<char, TrieNode*>> ordered;
+        while (!stack.empty() && count < limit) {
+            auto [node, ch, length] = stack.back();
+            stack.pop_back();
+            buffer.resize(length);
+            if (node != current) buffer.push_back(ch);
+            if (node->isEndOfWord) {
+                visit(string_view(buffer));
+                count++;
+            }
+            ordered.assign(node->children.begin(), node->children.end());
+            sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+                return static_cast<unsigned char>(a.first) < static_cast<unsigned char>(b.first);
+            });
+            for (auto it = ordered.rbegin(); it != ordered.rend(); ++it) {
+                stack.emplace_back(it->second, it->first, buffer.size());
+            }
+        }
+        return count;
+    }
+    
+    /**
+     * Words starting with prefix, in lexicographic order
+     * @param limit: Maximum number of words returned
+     */
+    vector<string> collectWithPrefix(const string& prefix, size_t limit = SIZE_MAX) const {
+        vector<string> words;
+        collectWithPrefix(prefix, limit, [&words](string_view word) {
+            words.emplace_back(word);
+        });
+        return words;
+    }
+
      /**
      * Get depth of a word (number of characters)
      * Returns nullopt if word not found
@@ -1135,6 +2922,15 @@ public:
     }
     
 private:
+    /**
+     * Run node destructors ahead of pool.release()
+     */
+    void destroyNodes() {
+        pool.destroyAll(root, [](TrieNode* node, auto visit) {
+            for (auto& entry : node->children) visit(entry.second);
+        });
+    }
+
      /**
      * Helper to get maximum depth
      */
@@ -1155,125 +2951,515 @@ private:
     void displayHelper(TrieNode* node, string prefix, bool isLast, bool use_color) {
         if (node == nullptr) return;
 
-        int count = 0;
-        for (auto& pair : node->children) {
-            count++;
-            bool isLastChild = (count == node->children.size());
+        int count = 0;
+        for (auto& pair : node->children) {
+            count++;
+            bool isLastChild = (count == node->children.size());
+
+            cout << prefix;
+            if (isLast) {
+                cprint(use_color, "`-- ", BRIGHT_GREEN);
+            } else {
+                cprint(use_color, "|-- ", BRIGHT_GREEN);
+            }
+            cprint(use_color, "[", BRIGHT_YELLOW);
+            cprint(use_color, pair.first, BRIGHT_BLUE);
+            cprint(use_color, "]", BRIGHT_YELLOW);
+
+            if (pair.second->isEndOfWord) {
+                cprint(use_color, " *", RED, true);
+            }
+            cout << endl;
+
+            displayHelper(pair.second, prefix + (isLast ? "    " : "|   "), isLastChild, use_color);
+        }
+    }
+};
+
+/**
+ * Path-compressed (radix) trie for large dictionaries
+ * Each node owns one edge label, stored as a slice of a shared character
+ * arena rather than one node per character. Nodes are 16 bytes in a
+ * single vector and link by index: first child / next sibling, siblings
+ * ordered by their label's first byte. Splitting an edge only re-slices
+ * the arena, so inserted text is written once.
+ */
+class RadixTrie {
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint32_t MAX_LABEL = (1u << 23) - 1; // longer edges are chained
+    
+    struct Node {
+        uint32_t labelStart;   // offset into labels
+        uint32_t labelLength : 23;
+        uint32_t terminal : 1; // a word ends here
+        uint32_t firstByte : 8;
+        uint32_t firstChild;
+        uint32_t nextSibling;
+    };
+    
+    vector<Node> nodes;   // nodes[0] is the root, with an empty label
+    string labels;        // every edge label, back to back
+    size_t wordCount;
+    
+    string_view labelOf(const Node& node) const {
+        return string_view(labels).substr(node.labelStart, node.labelLength);
+    }
+    
+    uint32_t newNode(uint32_t start, uint32_t length) {
+        if (nodes.size() >= NONE) {
+            throw length_error("RadixTrie node limit reached");
+        }
+        Node node{};
+        node.labelStart = start;
+        node.labelLength = length;
+        node.terminal = 0;
+        node.firstByte = length ? static_cast<unsigned char>(labels[start]) : 0;
+        node.firstChild = NONE;
+        node.nextSibling = NONE;
+        nodes.push_back(node);
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+    
+    /**
+     * Child of parent whose label starts with ch, or NONE
+     * prevOut receives the sibling after which such a child would go
+     */
+    uint32_t findChild(uint32_t parent, unsigned char ch, uint32_t* prevOut = nullptr) const {
+        uint32_t prev = NONE;
+        for (uint32_t c = nodes[parent].firstChild; c != NONE; c = nodes[c].nextSibling) {
+            if (nodes[c].firstByte == ch) return c;
+            if (nodes[c].firstByte > ch) break;
+            prev = c;
+        }
+        if (prevOut) *prevOut = prev;
+        return NONE;
+    }
+    
+    /**
+     * Append text to the arena as a chain of nodes under parent
+     * @return The last node of the chain
+     */
+    uint32_t appendChain(uint32_t parent, uint32_t prev, string_view text) {
+        if (labels.size() + text.size() > NONE) {
+            throw length_error("RadixTrie label storage limit reached");
+        }
+        uint32_t start = static_cast<uint32_t>(labels.size());
+        labels.append(text);
+        while (true) {
+            uint32_t length = static_cast<uint32_t>(min<size_t>(text.size(), MAX_LABEL));
+            uint32_t node = newNode(start, length);
+            if (prev == NONE) {
+                nodes[node].nextSibling = nodes[parent].firstChild;
+                nodes[parent].firstChild = node;
+            } else {
+                nodes[node].nextSibling = nodes[prev].nextSibling;
+                nodes[prev].nextSibling = node;
+            }
+            text.remove_prefix(length);
+            start += length;
+            if (text.empty()) return node;
+            parent = node;
+            prev = NONE;
+        }
+    }
+    
+    /**
+     * Walk key from the root
+     * @param node: Set to the deepest node reached
+     * @param matched: Set to how much of that node's label the key used up
+     * @return True if the whole key was matched
+     */
+    bool walk(string_view key, uint32_t& node, size_t& matched) const {
+        node = 0;
+        matched = 0;
+        size_t pos = 0;
+        while (pos < key.size()) {
+            uint32_t child = findChild(node, static_cast<unsigned char>(key[pos]));
+            if (child == NONE) return false;
+            string_view label = labelOf(nodes[child]);
+            size_t len = min(label.size(), key.size() - pos);
+            if (label.compare(0, len, key.substr(pos, len)) != 0) return false;
+            node = child;
+            matched = len;
+            pos += len;
+        }
+        return true;
+    }
+    
+    void displayHelper(uint32_t node, const string& prefix, bool use_color) const {
+        for (uint32_t c = nodes[node].firstChild; c != NONE; c = nodes[c].nextSibling) {
+            bool isLastChild = nodes[c].nextSibling == NONE;
+            cout << prefix;
+            cprint(use_color, isLastChild ? "`-- " : "|-- ", BRIGHT_GREEN);
+            cprint(use_color, "[", BRIGHT_YELLOW);
+            cprint(use_color, string(labelOf(nodes[c])), BRIGHT_BLUE);
+            cprint(use_color, "]", BRIGHT_YELLOW);
+            if (nodes[c].terminal) {
+                cprint(use_color, " *", RED, true);
+            }
+            cout << endl;
+            displayHelper(c, prefix + (isLastChild ? "    " : "|   "), use_color);
+        }
+    }
+    
+public:
+    RadixTrie() : wordCount(0) {
+        newNode(0, 0);
+    }
+    
+    /**
+     * Insert a word
+     * Time Complexity: O(m * s) for word length m and sibling fan-out s
+     * @return false if the word was already present
+     */
+    bool insert(string_view word) {
+        uint32_t node = 0;
+        size_t pos = 0;
+        while (pos < word.size()) {
+            uint32_t prev = NONE;
+            uint32_t child = findChild(node, static_cast<unsigned char>(word[pos]), &prev);
+            if (child == NONE) {
+                node = appendChain(node, prev, word.substr(pos));
+                pos = word.size();
+                break;
+            }
+            
+            string_view label = labelOf(nodes[child]);
+            size_t common = 0;
+            size_t limit = min(label.size(), word.size() - pos);
+            while (common < limit && label[common] == word[pos + common]) common++;
+            
+            if (common < label.size()) {
+                // Split: child keeps the shared head and its sibling slot;
+                // a new node takes the tail along with child's subtree
+                uint32_t tail = newNode(nodes[child].labelStart + static_cast<uint32_t>(common),
+                                        static_cast<uint32_t>(label.size() - common));
+                nodes[tail].terminal = nodes[child].terminal;
+                nodes[tail].firstChild = nodes[child].firstChild;
+                nodes[child].labelLength = static_cast<uint32_t>(common);
+                nodes[child].terminal = 0;
+                nodes[child].firstChild = tail;
+            }
+            node = child;
+            pos += common;
+        }
+        
+        if (nodes[node].terminal) return false;
+        nodes[node].terminal = 1;
+        wordCount++;
+        return true;
+    }
+    
+    /**
+     * Search for a complete word
+     * Time Complexity: O(m * s)
+     */
+    bool search(string_view word) const {
+        uint32_t node;
+        size_t matched;
+        return walk(word, node, matched) && matched == nodes[node].labelLength &&
+               nodes[node].terminal;
+    }
+    
+    /**
+     * Check if any word starts with prefix
+     * Time Complexity: O(m * s)
+     */
+    bool startsWith(string_view prefix) const {
+        uint32_t node;
+        size_t matched;
+        return walk(prefix, node, matched) && (node != 0 || wordCount > 0);
+    }
+    
+    /**
+     * Stream words starting with prefix, in lexicographic order
+     * Words are assembled in one reused buffer; visit receives a
+     * string_view into it that is only valid during the call
+     * @param limit: Stop after this many words
+     * @return Number of words visited
+     */
+    template<typename Visitor>
+    size_t collectWithPrefix(string_view prefix, size_t limit, Visitor visit) const {
+        uint32_t start;
+        size_t matched;
+        if (limit == 0 || !walk(prefix, start, matched)) return 0;
+        
+        string buffer(prefix);
+        buffer.append(labelOf(nodes[start]).substr(matched));
+        size_t count = 0;
+        if (nodes[start].terminal) {
+            visit(string_view(buffer));
+            if (++count == limit) return count;
+        }
+        
+        // (node, buffer length before its label); siblings are pushed
+        // before children so the walk stays in preorder
+        vector<pair<uint32_t, size_t>> stack;
+        if (nodes[start].firstChild != NONE) stack.push_back({nodes[start].firstChild, buffer.size()});
+        while (!stack.empty()) {
+            auto [node, length] = stack.back();
+            stack.pop_back();
+            buffer.resize(length);
+            buffer.append(labelOf(nodes[node]));
+            if (nodes[node].nextSibling != NONE) stack.push_back({nodes[node].nextSibling, length});
+            if (nodes[node].firstChild != NONE) stack.push_back({nodes[node].firstChild, buffer.size()});
+            if (nodes[node].terminal) {
+                visit(string_view(buffer));
+                if (++count == limit) break;
+            }
+        }
+        return count;
+    }
+    
+    /**
+     * Words starting with prefix, in lexicographic order
+     * @param limit: Maximum number of words returned
+     */
+    vector<string> collectWithPrefix(string_view prefix, size_t limit = SIZE_MAX) const {
+        vector<string> words;
+        collectWithPrefix(prefix, limit, [&words](string_view word) {
+            words.emplace_back(word);
+        });
+        return words;
+    }
+    
+    /**
+     * Remove all words
+     */
+    void clear() {
+        nodes.clear();
+        labels.clear();
+        wordCount = 0;
+        newNode(0, 0);
+    }
+    
+    /**
+     * Drop spare capacity once the dictionary is fully loaded
+     */
+    void shrinkToFit() {
+        nodes.shrink_to_fit();
+        labels.shrink_to_fit();
+    }
+    
+    size_t size() const { return wordCount; }
+    bool empty() const { return wordCount == 0; }
+    size_t nodeCount() const { return nodes.size(); }
+    
+    /**
+     * Bytes held by node and label storage
+     */
+    size_t memoryUsage() const {
+        return nodes.capacity() * sizeof(Node) + labels.capacity();
+    }
+    
+    /**
+     * Display the compressed structure in ASCII format
+     * Each edge shows its full label
+     */
+    void display(bool use_color = false) const {
+        cout << "Radix Trie Structure (* = word ending):\n";
+        cout << "Root\n";
+        displayHelper(0, "", use_color);
+    }
+};
+
+// ============================================================================
+// 6. SEGMENT TREE
+// ============================================================================
+
+/**
+ * Monoids for SegmentTree / LazySegmentTree
+ * A monoid supplies identity() and an associative combine(a, b);
+ * combine need not be commutative. Any struct with the same two static
+ * members can be used as a custom monoid.
+ */
+template<typename T>
+struct SumMonoid {
+    static T identity() { return T(); }
+    static T combine(const T& a, const T& b) { return a + b; }
+};
+
+template<typename T>
+struct MinMonoid {
+    static T identity() { return numeric_limits<T>::max(); }
+    static T combine(const T& a, const T& b) { return min(a, b); }
+};
+
+template<typename T>
+struct MaxMonoid {
+    static T identity() { return numeric_limits<T>::lowest(); }
+    static T combine(const T& a, const T& b) { return max(a, b); }
+};
 
-            cout << prefix;
-            if (isLast) {
-                cprint(use_color, "`-- ", BRIGHT_GREEN);
-            } else {
-                cprint(use_color, "|-- ", BRIGHT_GREEN);
-            }
-            cprint(use_color, "[", BRIGHT_YELLOW);
-            cprint(use_color, pair.first, BRIGHT_BLUE);
-            cprint(use_color, "]", BRIGHT_YELLOW);
+template<typename T>
+struct GcdMonoid {
+    static T identity() { return T(); }
+    static T combine(const T& a, const T& b) { return gcd(a, b); }
+};
 
-            if (pair.second->isEndOfWord) {
-                cprint(use_color, " *", RED, true);
-            }
-            cout << endl;
+/**
+ * Range update actions for LazySegmentTree
+ * An action supplies a Tag type, identity(), compose(newer, older) and
+ * apply(value, tag, length), where value is the aggregate of a segment of
+ * length elements.
+ */
+template<typename T>
+struct AddForSum {
+    using Tag = T;
+    static Tag identity() { return T(); }
+    static Tag compose(const Tag& newer, const Tag& older) { return newer + older; }
+    static T apply(const T& value, const Tag& tag, size_t length) {
+        return value + tag * static_cast<T>(length);
+    }
+};
 
-            displayHelper(pair.second, prefix + (isLast ? "    " : "|   "), isLastChild, use_color);
-        }
+template<typename T>
+struct AddForMinMax {
+    using Tag = T;
+    static Tag identity() { return T(); }
+    static Tag compose(const Tag& newer, const Tag& older) { return newer + older; }
+    static T apply(const T& value, const Tag& tag, size_t) { return value + tag; }
+};
+
+template<typename T>
+struct AssignForSum {
+    using Tag = optional<T>;
+    static Tag identity() { return nullopt; }
+    static Tag compose(const Tag& newer, const Tag& older) { return newer ? newer : older; }
+    static T apply(const T& value, const Tag& tag, size_t length) {
+        return tag ? *tag * static_cast<T>(length) : value;
     }
 };
 
-// ============================================================================
-// 6. SEGMENT TREE
-// ============================================================================
+/**
+ * Assignment for any idempotent monoid (min, max, gcd, ...)
+ */
+template<typename T>
+struct AssignForMinMax {
+    using Tag = optional<T>;
+    static Tag identity() { return nullopt; }
+    static Tag compose(const Tag& newer, const Tag& older) { return newer ? newer : older; }
+    static T apply(const T& value, const Tag& tag, size_t) { return tag ? *tag : value; }
+};
 
 /**
  * Segment Tree implementation for range queries
- * Supports range sum queries and point updates
+ * Supports range queries over any monoid (sum by default) and point updates
+ * Iterative bottom-up layout: leaves at [size, 2 * size), node k combines
+ * 2k and 2k + 1, with size the next power of two >= n
  */
+template<typename T = int, typename Monoid = SumMonoid<T>>
 class SegmentTree {
 private:
-    vector<int> tree;
+    vector<T> tree;
     int n;
+    int size;
+    
+    void checkIndex(int idx) const {
+        if (idx < 0 || idx >= n) {
+            throw out_of_range("Segment tree index out of range");
+        }
+    }
     
+    void pull(int k) {
+        tree[k] = Monoid::combine(tree[2 * k], tree[2 * k + 1]);
+    }
+
+public:
     /**
-     * Build the segment tree recursively
+     * Constructor: build segment tree from array
+     * Time Complexity: O(n)
      */
-    void build(const vector<int>& arr, int node, int start, int end) {
-        if (start == end) {
-            tree[node] = arr[start];
-        } else {
-            int mid = (start + end) / 2;
-            build(arr, 2 * node, start, mid);
-            build(arr, 2 * node + 1, mid + 1, end);
-            tree[node] = tree[2 * node] + tree[2 * node + 1];
-        }
+    SegmentTree(const vector<T>& arr) : n(static_cast<int>(arr.size())) {
+        size = static_cast<int>(bit_ceil(max<size_t>(1, arr.size())));
+        tree.assign(2 * size, Monoid::identity());
+        copy(arr.begin(), arr.end(), tree.begin() + size);
+        for (int k = size - 1; k >= 1; k--) pull(k);
     }
     
     /**
-     * Update a value at given index
+     * Update value at index
+     * Time Complexity: O(log n)
      */
-    void updateHelper(int node, int start, int end, int idx, int value) {
-        if (start == end) {
-            tree[node] = value;
-        } else {
-            int mid = (start + end) / 2;
-            if (idx <= mid) {
-                updateHelper(2 * node, start, mid, idx, value);
-            } else {
-                updateHelper(2 * node + 1, mid + 1, end, idx, value);
-            }
-            tree[node] = tree[2 * node] + tree[2 * node + 1];
-        }
+    void update(int idx, T value) {
+        checkIndex(idx);
+        int k = idx + size;
+        tree[k] = std::move(value);
+        for (k >>= 1; k >= 1; k >>= 1) pull(k);
     }
     
     /**
-     * Query sum in range [L, R]
+     * Apply several point updates, then repair each affected ancestor once
+     * Time Complexity: O(k log n) worst case, O(n) at most
      */
-    int queryHelper(int node, int start, int end, int L, int R) {
-        if (R < start || end < L) {
-            return 0; // Outside range
+    void batchUpdate(const vector<pair<int, T>>& updates) {
+        vector<int> dirty;
+        dirty.reserve(updates.size());
+        for (const auto& [idx, value] : updates) {
+            checkIndex(idx);
+            tree[idx + size] = value;
+            dirty.push_back((idx + size) >> 1);
         }
-        
-        if (L <= start && end <= R) {
-            return tree[node]; // Completely inside range
+        // Walk up level by level; siblings share a parent, so dedupe each level
+        while (!dirty.empty() && dirty.front() >= 1) {
+            sort(dirty.begin(), dirty.end());
+            dirty.erase(unique(dirty.begin(), dirty.end()), dirty.end());
+            for (int& k : dirty) {
+                pull(k);
+                k >>= 1;
+            }
         }
-        
-        int mid = (start + end) / 2;
-        int leftSum = queryHelper(2 * node, start, mid, L, R);
-        int rightSum = queryHelper(2 * node + 1, mid + 1, end, L, R);
-        
-        return leftSum + rightSum;
     }
-
-public:
+    
     /**
-     * Constructor: build segment tree from array
+     * Query aggregate of range [L, R]
+     * Time Complexity: O(log n)
      */
-    SegmentTree(const vector<int>& arr) {
-        n = arr.size();
-        tree.resize(4 * n);
-        build(arr, 1, 0, n - 1);
+    T query(int L, int R) const {
+        if (L > R) return Monoid::identity();
+        checkIndex(L);
+        checkIndex(R);
+        T left = Monoid::identity();
+        T right = Monoid::identity();
+        for (int l = L + size, r = R + size + 1; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) left = Monoid::combine(left, tree[l++]);
+            if (r & 1) right = Monoid::combine(tree[--r], right);
+        }
+        return Monoid::combine(left, right);
     }
     
     /**
-     * Update value at index
-     * Time Complexity: O(log n)
+     * Answer many [L, R] queries in one call
      */
-    void update(int idx, int value) {
-        updateHelper(1, 0, n - 1, idx, value);
+    vector<T> batchQuery(const vector<pair<int, int>>& ranges) const {
+        vector<T> results;
+        results.reserve(ranges.size());
+        for (const auto& [L, R] : ranges) results.push_back(query(L, R));
+        return results;
     }
     
     /**
-     * Query sum in range [L, R]
-     * Time Complexity: O(log n)
+     * Value at index
+     * Time Complexity: O(1)
      */
-    int query(int L, int R) {
-        return queryHelper(1, 0, n - 1, L, R);
+    const T& get(int idx) const {
+        checkIndex(idx);
+        return tree[idx + size];
     }
     
+    /**
+     * Aggregate of the whole array
+     */
+    const T& total() const { return tree[1]; }
+    
+    int getSize() const { return n; }
+    
     /**
      * Display Segment Tree structure
      * Shows internal nodes with their ranges and values
      */
-    void display(bool use_color = false) {
+    void display(bool use_color = false) const {
        cprint(use_color, "Segment Tree Structure:\n", BOLD);
        cprint(use_color, "Format: ", BRIGHT_WHITE);
        cprint(use_color, "[", BRIGHT_YELLOW);
@@ -1282,19 +3468,26 @@ public:
        cprint(use_color, " = ", BRIGHT_WHITE);
        cprint(use_color, "value", BRIGHT_CYAN);
        cout << endl;
-       displayHelper(1, 0, n - 1, "", true, use_color);
+       if (n > 0) displayHelper(1, 0, size - 1, "", true, use_color);
    }
 
 private:
     /**
      * Helper to display segment tree with ranges
+     * Padding past the last element is not shown
      */
-    void displayHelper(int node, int start, int end, string prefix, bool isRight, bool use_color) {
-        if (node >= tree.size() || start > end) return;
+    void displayHelper(int node, int start, int end, string prefix, bool isRight, bool use_color) const {
+        if (start >= n) return;
+        bool isRoot = node == 1;
+        // A node whose right half is all padding is shown as its left child
+        while (start != end && (start + end) / 2 >= n - 1) {
+            node *= 2;
+            end = (start + end) / 2;
+        }
 
         cout << prefix;
-        if (node == 1) {
-            cprint(use_color, node, MAGNETA, true);
+        if (isRoot) {
+            cprint(use_color, 1, MAGNETA, true);
         } else if (isRight) {
             cprint(use_color, "|-- ", BRIGHT_GREEN);
         } else {
@@ -1303,7 +3496,7 @@ private:
         cprint(use_color, "[", BRIGHT_YELLOW);
         cprint(use_color, start, BRIGHT_BLUE);
         cprint(use_color, ",", BRIGHT_WHITE);
-        cprint(use_color, end, BRIGHT_BLUE);
+        cprint(use_color, min(end, n - 1), BRIGHT_BLUE);
         cprint(use_color, "]", BRIGHT_YELLOW);
         cprint(use_color, " = ", BRIGHT_WHITE);
         cprint(use_color, tree[node], BRIGHT_CYAN);
@@ -1311,13 +3504,153 @@ private:
 
         if (start != end) {
             int mid = (start + end) / 2;
-            string newPrefix = (node == 1) ? "" : prefix + (isRight ? "|   " : "    ");
+            string newPrefix = isRoot ? "" : prefix + (isRight ? "|   " : "    ");
             displayHelper(2 * node, start, mid, newPrefix, true, use_color);
             displayHelper(2 * node + 1, mid + 1, end, newPrefix, false, use_color);
         }
     }
 };
 
+/**
+ * Segment Tree with lazy propagation for range updates
+ * Same bottom-up layout as SegmentTree, plus one pending tag per internal
+ * node. Updates and queries push pending tags down along the two boundary
+ * paths only, then work bottom-up without recursion.
+ */
+template<typename T = int, typename Monoid = SumMonoid<T>, typename Action = AddForSum<T>>
+class LazySegmentTree {
+private:
+    using Tag = typename Action::Tag;
+    
+    vector<T> tree;
+    vector<Tag> lazy; // pending tag per internal node
+    int n;
+    int size;
+    int levels;       // log2(size)
+    
+    void checkIndex(int idx) const {
+        if (idx < 0 || idx >= n) {
+            throw out_of_range("Segment tree index out of range");
+        }
+    }
+    
+    size_t lengthOf(int k) const {
+        return static_cast<size_t>(size) >> (bit_width(static_cast<unsigned>(k)) - 1);
+    }
+    
+    void pull(int k) {
+        tree[k] = Monoid::combine(tree[2 * k], tree[2 * k + 1]);
+    }
+    
+    void applyTag(int k, const Tag& tag) {
+        tree[k] = Action::apply(tree[k], tag, lengthOf(k));
+        if (k < size) lazy[k] = Action::compose(tag, lazy[k]);
+    }
+    
+    void push(int k) {
+        applyTag(2 * k, lazy[k]);
+        applyTag(2 * k + 1, lazy[k]);
+        lazy[k] = Action::identity();
+    }
+    
+    /**
+     * Push pending tags down to the boundary leaves of [l, r)
+     */
+    void pushBoundary(int l, int r) {
+        for (int i = levels; i >= 1; i--) {
+            if (((l >> i) << i) != l) push(l >> i);
+            if (((r >> i) << i) != r) push((r - 1) >> i);
+        }
+    }
+    
+public:
+    /**
+     * Constructor: build from array
+     * Time Complexity: O(n)
+     */
+    LazySegmentTree(const vector<T>& arr) : n(static_cast<int>(arr.size())) {
+        size = static_cast<int>(bit_ceil(max<size_t>(1, arr.size())));
+        levels = countr_zero(static_cast<unsigned>(size));
+        tree.assign(2 * size, Monoid::identity());
+        lazy.assign(size, Action::identity());
+        copy(arr.begin(), arr.end(), tree.begin() + size);
+        for (int k = size - 1; k >= 1; k--) pull(k);
+    }
+    
+    /**
+     * Apply tag to every element of [L, R]
+     * Time Complexity: O(log n)
+     */
+    void updateRange(int L, int R, const Tag& tag) {
+        if (L > R) return;
+        checkIndex(L);
+        checkIndex(R);
+        int l = L + size, r = R + size + 1;
+        pushBoundary(l, r);
+        for (int a = l, b = r; a < b; a >>= 1, b >>= 1) {
+            if (a & 1) applyTag(a++, tag);
+            if (b & 1) applyTag(--b, tag);
+        }
+        for (int i = 1; i <= levels; i++) {
+            if (((l >> i) << i) != l) pull(l >> i);
+            if (((r >> i) << i) != r) pull((r - 1) >> i);
+        }
+    }
+    
+    /**
+     * Set value at index
+     * Time Complexity: O(log n)
+     */
+    void update(int idx, T value) {
+        checkIndex(idx);
+        int k = idx + size;
+        for (int i = levels; i >= 1; i--) push(k >> i);
+        tree[k] = std::move(value);
+        for (int i = 1; i <= levels; i++) pull(k >> i);
+    }
+    
+    /**
+     * Query aggregate of range [L, R]
+     * Time Complexity: O(log n)
+     */
+    T query(int L, int R) {
+        if (L > R) return Monoid::identity();
+        checkIndex(L);
+        checkIndex(R);
+        int l = L + size, r = R + size + 1;
+        pushBoundary(l, r);
+        T left = Monoid::identity();
+        T right = Monoid::identity();
+        for (; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) left = Monoid::combine(left, tree[l++]);
+            if (r & 1) right = Monoid::combine(tree[--r], right);
+        }
+        return Monoid::combine(left, right);
+    }
+    
+    /**
+     * Answer many [L, R] queries in one call
+     */
+    vector<T> batchQuery(const vector<pair<int, int>>& ranges) {
+        vector<T> results;
+        results.reserve(ranges.size());
+        for (const auto& [L, R] : ranges) results.push_back(query(L, R));
+        return results;
+    }
+    
+    /**
+     * Value at index
+     * Time Complexity: O(log n)
+     */
+    T get(int idx) {
+        return query(idx, idx);
+    }
+    
+    const T& total() const { return tree[1]; }
+    
+    int getSize() const { return n; }
+};
+
 // ============================================================================
 // 7. BINARY INDEXED TREE (FENWICK TREE)
 // ============================================================================
@@ -1326,58 +3659,194 @@ private:
  * Binary Indexed Tree (Fenwick Tree) implementation
  * Efficient for prefix sum queries and point updates
  */
+template<typename T = long long>
 class BinaryIndexedTree {
 private:
-    vector<int> tree;
+    vector<T> tree;
     int n;
+    
+    static int lowbit(int i) { return i & (-i); }
+    
+    void checkIndex(int idx) const {
+        if (idx < 0 || idx >= n) {
+            throw out_of_range("Binary indexed tree index out of range");
+        }
+    }
+    
+    /**
+     * Turn raw values in tree[1..n] into Fenwick sums in place
+     * Each node pushes its sum to its parent once, so this is O(n)
+     */
+    void buildInPlace() {
+        for (int i = 1; i <= n; i++) {
+            int parent = i + lowbit(i);
+            if (parent <= n) tree[parent] += tree[i];
+        }
+    }
+    
+    /**
+     * Inverse of buildInPlace: recover raw values in tree[1..n]
+     */
+    void unbuildInPlace() {
+        for (int i = n; i >= 1; i--) {
+            int parent = i + lowbit(i);
+            if (parent <= n) tree[parent] -= tree[i];
+        }
+    }
+    
+    /**
+     * Batches at least this large are cheaper as one O(n) rebuild
+     * than as k separate O(log n) walks
+     */
+    size_t rebuildThreshold() const {
+        return static_cast<size_t>(n) / (bit_width(static_cast<unsigned>(n)) + 1) + 1;
+    }
 
 public:
     /**
      * Constructor: initialize BIT with given size
      */
     BinaryIndexedTree(int size) : n(size) {
-        tree.resize(n + 1, 0);
+        if (size < 0) throw invalid_argument("Binary indexed tree size must be non-negative");
+        tree.resize(n + 1, T{});
+    }
+    
+    /**
+     * Constructor: build BIT from array
+     * Time Complexity: O(n)
+     */
+    template<typename U>
+    BinaryIndexedTree(const vector<U>& arr) : n(static_cast<int>(arr.size())) {
+        tree.resize(n + 1);
+        for (int i = 0; i < n; i++) tree[i + 1] = static_cast<T>(arr[i]);
+        buildInPlace();
     }
     
     /**
      * Update value at index by adding delta
      * Time Complexity: O(log n)
      */
-    void update(int idx, int delta) {
-        idx++; // BIT uses 1-based indexing
-        while (idx <= n) {
+    void update(int idx, T delta) {
+        checkIndex(idx);
+        for (idx++; idx <= n; idx += lowbit(idx)) { // BIT uses 1-based indexing
             tree[idx] += delta;
-            idx += idx & (-idx); // Add last set bit
         }
     }
     
+    /**
+     * Apply several (index, delta) updates
+     * Large batches are folded into the raw array and rebuilt in O(n + k),
+     * small ones fall back to individual walks
+     * Time Complexity: O(min(k log n, n + k))
+     */
+    void batchUpdate(const vector<pair<int, T>>& updates) {
+        for (const auto& entry : updates) checkIndex(entry.first);
+        if (updates.size() < rebuildThreshold()) {
+            for (const auto& [idx, delta] : updates) update(idx, delta);
+            return;
+        }
+        unbuildInPlace();
+        for (const auto& [idx, delta] : updates) tree[idx + 1] += delta;
+        buildInPlace();
+    }
+    
     /**
      * Query prefix sum from 0 to idx
      * Time Complexity: O(log n)
      */
-    int query(int idx) {
-        idx++; // BIT uses 1-based indexing
-        int sum = 0;
-        while (idx > 0) {
+    T query(int idx) const {
+        checkIndex(idx);
+        T sum{};
+        for (idx++; idx > 0; idx -= lowbit(idx)) { // BIT uses 1-based indexing
             sum += tree[idx];
-            idx -= idx & (-idx); // Remove last set bit
         }
         return sum;
     }
     
     /**
      * Query range sum from L to R
+     * Both descents stop at their common ancestor instead of going to 0
+     * Time Complexity: O(log n)
+     */
+    T rangeQuery(int L, int R) const {
+        if (L > R) return T{};
+        checkIndex(L);
+        checkIndex(R);
+        T sum{};
+        int r = R + 1, l = L;
+        while (r != l) {
+            if (r > l) {
+                sum += tree[r];
+                r -= lowbit(r);
+            } else {
+                sum -= tree[l];
+                l -= lowbit(l);
+            }
+        }
+        return sum;
+    }
+    
+    /**
+     * Answer many [L, R] range sums in one call
+     * Large batches materialize the prefix sums once and answer in O(1) each
+     * Time Complexity: O(min(k log n, n + k))
+     */
+    vector<T> batchQuery(const vector<pair<int, int>>& ranges) const {
+        vector<T> results;
+        results.reserve(ranges.size());
+        if (ranges.size() < rebuildThreshold()) {
+            for (const auto& [L, R] : ranges) results.push_back(rangeQuery(L, R));
+            return results;
+        }
+        for (const auto& [L, R] : ranges) {
+            if (L <= R) {
+                checkIndex(L);
+                checkIndex(R);
+            }
+        }
+        // prefix[i] = sum of arr[0..i-1]: recover raw values, then scan
+        vector<T> prefix(tree);
+        for (int i = n; i >= 1; i--) {
+            int parent = i + lowbit(i);
+            if (parent <= n) prefix[parent] -= prefix[i];
+        }
+        partial_sum(prefix.begin(), prefix.end(), prefix.begin());
+        for (const auto& [L, R] : ranges) {
+            results.push_back(L > R ? T{} : prefix[R + 1] - prefix[L]);
+        }
+        return results;
+    }
+    
+    /**
+     * Value at index
      * Time Complexity: O(log n)
      */
-    int rangeQuery(int L, int R) {
-        return query(R) - (L > 0 ? query(L - 1) : 0);
+    T get(int idx) const { return rangeQuery(idx, idx); }
+    
+    /**
+     * Smallest index whose prefix sum is >= target, or getSize() if none
+     * Requires all values to be non-negative (e.g. frequency counts)
+     * Time Complexity: O(log n)
+     */
+    int lowerBound(T target) const {
+        if (!(T{} < target)) return 0;
+        int pos = 0;
+        for (int step = n > 0 ? static_cast<int>(bit_floor(static_cast<unsigned>(n))) : 0; step > 0; step >>= 1) {
+            if (pos + step <= n && tree[pos + step] < target) {
+                pos += step;
+                target -= tree[pos];
+            }
+        }
+        return pos; // 1-based pos is the last prefix below target
     }
     
+    int getSize() const { return n; }
+    
     /**
      * Display Binary Indexed Tree structure
      * Shows the internal representation
      */
-    void display(bool use_color = false) {
+    void display(bool use_color = false) const {
         cprint(use_color, "Binary Indexed Tree (Fenwick Tree):\n", BOLD);
         cprint(use_color, "Index --> Value (cumulative)\n", BRIGHT_WHITE);
         for (int i = 1; i <= n; i++) {
@@ -1387,7 +3856,7 @@ public:
             cprint(use_color, tree[i], BRIGHT_BLUE);
 
             // Show which indices this node is responsible for
-            int range = i & (-i);
+            int range = lowbit(i);
             cprint(use_color, " [", BRIGHT_YELLOW);
             cprint(use_color, "covers ", BRIGHT_WHITE);
             cprint(use_color, (i - range + 1), BRIGHT_CYAN);
@@ -1399,6 +3868,134 @@ public:
     }
 };
 
+// Integral arrays build 64-bit counters so sums of many small values don't overflow
+template<typename U>
+BinaryIndexedTree(const vector<U>&) -> BinaryIndexedTree<conditional_t<is_integral_v<U>, long long, U>>;
+
+/**
+ * 2D Binary Indexed Tree for rectangle sums over a rows x cols grid
+ * Stored row-major in one flat array
+ */
+template<typename T = long long>
+class BinaryIndexedTree2D {
+private:
+    vector<T> tree; // (rows + 1) x (cols + 1), 1-based
+    int rows;
+    int cols;
+    
+    static int lowbit(int i) { return i & (-i); }
+    
+    T& at(int r, int c) { return tree[static_cast<size_t>(r) * (cols + 1) + c]; }
+    const T& at(int r, int c) const { return tree[static_cast<size_t>(r) * (cols + 1) + c]; }
+    
+    void checkIndex(int r, int c) const {
+        if (r < 0 || r >= rows || c < 0 || c >= cols) {
+            throw out_of_range("Binary indexed tree index out of range");
+        }
+    }
+
+public:
+    /**
+     * Constructor: initialize an all-zero rows x cols grid
+     */
+    BinaryIndexedTree2D(int rows, int cols) : rows(rows), cols(cols) {
+        if (rows < 0 || cols < 0) throw invalid_argument("Binary indexed tree size must be non-negative");
+        tree.assign(static_cast<size_t>(rows + 1) * (cols + 1), T{});
+    }
+    
+    /**
+     * Constructor: build from a rectangular grid
+     * Builds along each row, then along each column
+     * Time Complexity: O(rows * cols)
+     */
+    template<typename U>
+    BinaryIndexedTree2D(const vector<vector<U>>& grid)
+        : BinaryIndexedTree2D(static_cast<int>(grid.size()), grid.empty() ? 0 : static_cast<int>(grid[0].size())) {
+        for (int r = 0; r < rows; r++) {
+            if (static_cast<int>(grid[r].size()) != cols) {
+                throw invalid_argument("Binary indexed tree grid must be rectangular");
+            }
+            for (int c = 0; c < cols; c++) at(r + 1, c + 1) = static_cast<T>(grid[r][c]);
+        }
+        for (int r = 1; r <= rows; r++) {
+            for (int c = 1; c <= cols; c++) {
+                int parent = c + lowbit(c);
+                if (parent <= cols) at(r, parent) += at(r, c);
+            }
+        }
+        for (int r = 1; r <= rows; r++) {
+            int parent = r + lowbit(r);
+            if (parent > rows) continue;
+            for (int c = 1; c <= cols; c++) at(parent, c) += at(r, c);
+        }
+    }
+    
+    /**
+     * Add delta to cell (r, c)
+     * Time Complexity: O(log rows * log cols)
+     */
+    void update(int r, int c, T delta) {
+        checkIndex(r, c);
+        for (int i = r + 1; i <= rows; i += lowbit(i)) {
+            for (int j = c + 1; j <= cols; j += lowbit(j)) {
+                at(i, j) += delta;
+            }
+        }
+    }
+    
+    /**
+     * Sum of the rectangle [0, r] x [0, c]
+     * Time Complexity: O(log rows * log cols)
+     */
+    T query(int r, int c) const {
+        checkIndex(r, c);
+        T sum{};
+        for (int i = r + 1; i > 0; i -= lowbit(i)) {
+            for (int j = c + 1; j > 0; j -= lowbit(j)) {
+                sum += at(i, j);
+            }
+        }
+        return sum;
+    }
+    
+    /**
+     * Sum of the rectangle [r1, r2] x [c1, c2]
+     * Time Complexity: O(log rows * log cols)
+     */
+    T rangeQuery(int r1, int c1, int r2, int c2) const {
+        if (r1 > r2 || c1 > c2) return T{};
+        checkIndex(r1, c1);
+        checkIndex(r2, c2);
+        T sum = query(r2, c2);
+        if (r1 > 0) sum -= query(r1 - 1, c2);
+        if (c1 > 0) sum -= query(r2, c1 - 1);
+        if (r1 > 0 && c1 > 0) sum += query(r1 - 1, c1 - 1);
+        return sum;
+    }
+    
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    
+    /**
+     * Display the grid values the tree currently represents
+     */
+    void display(bool use_color = false) const {
+        cprint(use_color, "2D Binary Indexed Tree (", BOLD);
+        cprint(use_color, rows, BRIGHT_CYAN);
+        cprint(use_color, " x ", BOLD);
+        cprint(use_color, cols, BRIGHT_CYAN);
+        cprint(use_color, "):\n", BOLD);
+        for (int r = 0; r < rows; r++) {
+            cprint(use_color, "  ");
+            for (int c = 0; c < cols; c++) {
+                cprint(use_color, rangeQuery(r, c, r, c), BRIGHT_BLUE);
+                cout << (c + 1 < cols ? " " : "");
+            }
+            cout << endl;
+        }
+    }
+};
+
 // ============================================================================
 // 8. N-ARY TREE
 // ============================================================================
@@ -1425,6 +4022,7 @@ template<typename T>
 class NaryTree {
 private:
     NaryNode<T>* root;
+    NodePool<NaryNode<T>> pool;
     
     /**
      * Helper for level order traversal
@@ -1482,13 +4080,31 @@ public:
          return SearchResult(); // Not found
     }
 
-    NaryTree() : root(nullptr) {}
+    /**
+     * @param resource Memory resource the node slabs are drawn from
+     */
+    explicit NaryTree(pmr::memory_resource* resource = pmr::get_default_resource())
+        : root(nullptr), pool(resource) {}
+    
+    ~NaryTree() { clear(); }
+    
+    /**
+     * Remove all nodes, releasing the node slabs in one step
+     */
+    void clear() {
+        pool.destroyAll(root, [](NaryNode<T>* node, auto visit) {
+            for (NaryNode<T>* child : node->children) visit(child);
+        });
+        pool.release();
+        root = nullptr;
+    }
     
     /**
-     * Create root node with given value
+     * Create root node with given value, replacing any existing tree
      */
     void createRoot(T value) {
-        root = new NaryNode<T>(value);
+        clear();
+        root = pool.create(value);
     }
     
     /**
@@ -1497,7 +4113,7 @@ public:
      */
     void addChild(NaryNode<T>* parent, T value) {
         if (parent == nullptr) return;
-        parent->children.push_back(new NaryNode<T>(value));
+        parent->children.push_back(pool.create(value));
     }
     
     /**
@@ -1541,16 +4157,21 @@ public:
     
 private:
     /**
-     * Find a node with given value
+     * Find a node with given value (first match in preorder)
+     * Iterative, like the other helpers below, so deep chains are fine
      */
     NaryNode<T>* findNode(NaryNode<T>* node, T value) {
         if (node == nullptr) return nullptr;
 
-        if (node->data == value) return node;
-
-        for (auto child : node->children) {
-            NaryNode<T>* result = findNode(child, value);
-            if (result != nullptr) return result;
+        vector<NaryNode<T>*> stack{node};
+        while (!stack.empty()) {
+            NaryNode<T>* current = stack.back();
+            stack.pop_back();
+            if (current->data == value) return current;
+            // Reversed so the first child is examined first
+            for (auto it = current->children.rbegin(); it != current->children.rend(); ++it) {
+                stack.push_back(*it);
+            }
         }
 
         return nullptr;
@@ -1562,14 +4183,18 @@ private:
     int calculateHeight(NaryNode<T>* node) {
         if (node == nullptr) return -1;
 
-        if (node->children.empty()) return 0;
-
-        int maxHeight = -1;
-        for (auto child : node->children) {
-            maxHeight = max(maxHeight, calculateHeight(child));
+        int height = 0;
+        vector<pair<NaryNode<T>*, int>> stack{{node, 0}};
+        while (!stack.empty()) {
+            auto [current, depth] = stack.back();
+            stack.pop_back();
+            height = max(height, depth);
+            for (auto child : current->children) {
+                stack.push_back({child, depth + 1});
+            }
         }
 
-        return maxHeight + 1;
+        return height;
     }
 
     /**
@@ -1577,10 +4202,14 @@ private:
      */
     int getNodeDepthHelper(NaryNode<T>* node, T value, int depth) {
         if (node == nullptr) throw logic_error("Can't retrieve node height as the Nary Tree has no leaf nodes");
-        if (node->data == value) return depth;
-        for (auto child : node->children) {
-            int result = getNodeDepthHelper(child, value, depth + 1);
-            if (result != -1) return result;
+        vector<pair<NaryNode<T>*, int>> stack{{node, depth}};
+        while (!stack.empty()) {
+            auto [current, currentDepth] = stack.back();
+            stack.pop_back();
+            if (current->data == value) return currentDepth;
+            for (auto it = current->children.rbegin(); it != current->children.rend(); ++it) {
+                stack.push_back({*it, currentDepth + 1});
+            }
         }
         return -1;
     }